@@ -0,0 +1,290 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+/*
+ * inflateBench.cpp  –  Equivalence checks and throughput benchmark for the
+ *                      table-driven DAA/GBI inflate decoder
+ *
+ * Builds against daa2iso.cpp directly so the file-local decoder is reachable,
+ * and uses zlib as the reference. Run through `make bench`.
+ */
+
+// C++ Standard Library Headers
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// C / System Headers
+#include <zlib.h>
+
+// Project Headers
+#include "../src/isocmd/daa2iso.cpp"
+
+namespace {
+
+using Bytes = std::vector<unsigned char>;
+
+const unsigned PLAIN_BTYPE[3] = {0, 1, 2};
+
+unsigned rngState = 12345;
+
+unsigned rnd() {
+    rngState = rngState * 1103515245u + 12345u;
+    return rngState >> 8;
+}
+
+/**
+ * @brief Fills @p v with one of four data shapes: random, small alphabet,
+ *        LZ-friendly back-references and long runs.
+ */
+void generate(Bytes &v, int kind) {
+    for (size_t i = 0; i < v.size(); ++i) {
+        switch (kind) {
+            case 0:  v[i] = (unsigned char)rnd(); break;
+            case 1:  v[i] = (unsigned char)"abcdefgh"[rnd() % 3]; break;
+            case 2:  v[i] = (i > 16 && rnd() % 4) ? v[i - 1 - rnd() % 16] : (unsigned char)rnd(); break;
+            default: v[i] = (unsigned char)(i / 300); break;
+        }
+    }
+}
+
+Bytes deflateRaw(const Bytes &src, int level, int strategy) {
+    z_stream z{};
+    deflateInit2(&z, level, Z_DEFLATED, -15, 9, strategy);
+    Bytes out(2 * src.size() + 4096);
+    z.next_in   = const_cast<Bytef *>(src.data());
+    z.avail_in  = (uInt)src.size();
+    z.next_out  = out.data();
+    z.avail_out = (uInt)out.size();
+    deflate(&z, Z_FINISH);
+    out.resize(z.total_out);
+    deflateEnd(&z);
+    return out;
+}
+
+/**
+ * @brief Reference decode. Returns false unless zlib reaches the end of the stream.
+ */
+bool zlibInflate(const Bytes &in, Bytes &out) {
+    z_stream z{};
+    inflateInit2(&z, -15);
+    z.next_in   = const_cast<Bytef *>(in.data());
+    z.avail_in  = (uInt)in.size();
+    z.next_out  = out.data();
+    z.avail_out = (uInt)out.size();
+    const bool ok = inflate(&z, Z_FINISH) == Z_STREAM_END;
+    out.resize(z.total_out);
+    inflateEnd(&z);
+    return ok;
+}
+
+bool daaInflate(const Bytes &in, Bytes &out, const unsigned btype[3] = PLAIN_BTYPE) {
+    size_t len = out.size();
+    const bool ok = daa_inflate(out.data(), &len, in.data(), in.size(), btype) == INFLATE_OK;
+    out.resize(len);
+    return ok;
+}
+
+// LSB-first bit writer, as deflate packs its fields
+struct BitWriter {
+    Bytes    out;
+    unsigned bits = 0;
+
+    void put(unsigned value, unsigned n) {
+        for (unsigned i = 0; i < n; ++i, ++bits) {
+            if ((bits & 7) == 0) out.push_back(0);
+            out.back() |= (unsigned char)(((value >> i) & 1) << (bits & 7));
+        }
+    }
+    // Huffman codes go out most significant bit first
+    void code(unsigned value, unsigned n) {
+        for (unsigned i = n; i-- > 0;) put((value >> i) & 1, 1);
+    }
+};
+
+/**
+ * @brief Assigns canonical Huffman codes to @p lengths (RFC 1951, 3.2.2).
+ */
+std::vector<unsigned> canonicalCodes(const std::vector<unsigned> &lengths) {
+    unsigned count[16] = {0}, next[16] = {0};
+    for (unsigned l : lengths) if (l) ++count[l];
+    for (unsigned bits = 1, code = 0; bits < 16; ++bits) {
+        code = (code + count[bits - 1]) << 1;
+        next[bits] = code;
+    }
+    std::vector<unsigned> codes(lengths.size());
+    for (size_t i = 0; i < lengths.size(); ++i)
+        if (lengths[i]) codes[i] = next[lengths[i]]++;
+    return codes;
+}
+
+/**
+ * @brief A fixed block of @p prefix literals >= 144 (9 bits each) followed by
+ *        a final dynamic block that sends all 19 code-length code lengths.
+ *
+ * The prefix walks the dynamic header through every bit alignment; the one
+ * that leaves exactly 56 bits buffered before the 57-bit HCLEN=19 read is
+ * the case a single refill cannot cover.
+ */
+Bytes hclen19Stream(unsigned prefix, Bytes &expected) {
+    BitWriter w;
+    expected.clear();
+
+    w.put(0, 1);                                // BFINAL
+    w.put(1, 2);                                // fixed Huffman
+    for (unsigned i = 0; i < prefix; ++i) {
+        const unsigned lit = 144 + (i * 37) % 112;
+        w.code(0x190 + (lit - 144), 9);
+        expected.push_back((unsigned char)lit);
+    }
+    w.code(0, 7);                               // end of block
+
+    // Literal/length code: 255 symbols of 8 bits and two of 9, complete.
+    // Distance code: a single 1-bit code, as zlib emits for literal-only data.
+    std::vector<unsigned> litLengths(257, 8);
+    litLengths[255] = litLengths[256] = 9;
+    const std::vector<unsigned> symbols = [&] {
+        std::vector<unsigned> s(litLengths);
+        s.push_back(1);
+        return s;
+    }();
+
+    // Code-length code: 13 symbols of 4 bits and 6 of 5, complete over all 19
+    std::vector<unsigned> clLengths(19, 4);
+    for (unsigned s : {0u, 2u, 3u, 4u, 5u, 6u}) clLengths[s] = 5;
+    const std::vector<unsigned> clCodes = canonicalCodes(clLengths);
+
+    w.put(1, 1);                                // BFINAL
+    w.put(2, 2);                                // dynamic Huffman
+    w.put(257 - 257, 5);                        // HLIT
+    w.put(1 - 1, 5);                            // HDIST
+    w.put(19 - 4, 4);                           // HCLEN
+    for (unsigned i = 0; i < 19; ++i) w.put(clLengths[clcidx[i]], 3);
+    for (unsigned s : symbols) w.code(clCodes[s], clLengths[s]);
+
+    const std::vector<unsigned> litCodes = canonicalCodes(litLengths);
+    for (unsigned i = 0; i < 300; ++i) {
+        const unsigned lit = (i * 97 + prefix) & 0xff;
+        w.code(litCodes[lit], litLengths[lit]);
+        expected.push_back((unsigned char)lit);
+    }
+    w.code(litCodes[256], litLengths[256]);
+    return w.out;
+}
+
+/**
+ * @brief Decodes zlib-produced streams of every shape, the HCLEN=19
+ *        alignment cases and the GBI btype permutations.
+ * @return Number of mismatches.
+ */
+int checkValidStreams() {
+    static const unsigned perms[4][3] = {{0, 1, 2}, {1, 2, 0}, {0, 2, 1}, {1, 0, 2}};
+    static const int strategies[] = {Z_DEFAULT_STRATEGY, Z_FIXED, Z_HUFFMAN_ONLY, Z_RLE, Z_FILTERED};
+    int cases = 0, fails = 0;
+
+    for (int kind = 0; kind < 4; ++kind)
+    for (size_t n : {1ul, 7ul, 100ul, 4096ul, 65536ul, 300000ul})
+    for (int level : {0, 1, 6, 9})
+    for (int strategy : strategies) {
+        Bytes src(n);
+        generate(src, kind);
+        const Bytes packed = deflateRaw(src, level, strategy);
+        for (int p = 0; p < 4; ++p) {
+            Bytes in = packed;
+            if (p) {
+                // Only a single final block can be re-typed without re-packing bits
+                if (!(in[0] & 1)) continue;
+                const unsigned btype = (in[0] >> 1) & 3;
+                in[0] = (unsigned char)((in[0] & ~6) | (perms[p][btype] << 1));
+            }
+            Bytes out(n + 64);
+            ++cases;
+            if (!daaInflate(in, out, perms[p]) || out != src) {
+                if (++fails < 10)
+                    printf("FAIL kind=%d n=%zu level=%d strategy=%d perm=%d\n", kind, n, level, strategy, p);
+            }
+        }
+    }
+
+    for (unsigned prefix = 0; prefix < 16; ++prefix) {
+        Bytes expected;
+        const Bytes in = hclen19Stream(prefix, expected);
+        Bytes ref(expected.size() + 64), out(expected.size() + 64);
+        ++cases;
+        if (!zlibInflate(in, ref) || ref != expected) {
+            printf("FAIL hclen19 prefix=%u: zlib rejects the crafted stream\n", prefix);
+            ++fails;
+        } else if (!daaInflate(in, out) || out != expected) {
+            printf("FAIL hclen19 prefix=%u\n", prefix);
+            ++fails;
+        }
+    }
+
+    printf("valid streams: %d cases, %d failures\n", cases, fails);
+    return fails;
+}
+
+/**
+ * @brief Flips bits in and truncates valid streams. Anything zlib decodes
+ *        must decode identically; everything else must fail cleanly.
+ * @return Number of disagreements.
+ */
+int checkCorruptStreams() {
+    static const int strategies[] = {Z_DEFAULT_STRATEGY, Z_FIXED, Z_HUFFMAN_ONLY, Z_RLE, Z_FILTERED};
+    int agree = 0, fails = 0;
+    const int total = 20000;
+
+    for (int it = 0; it < total; ++it) {
+        Bytes src(2000 + rnd() % 20000);
+        generate(src, (int)(rnd() % 4));
+        Bytes in = deflateRaw(src, 6, strategies[rnd() % 5]);
+        for (unsigned f = 1 + rnd() % 4; f > 0; --f) in[rnd() % in.size()] ^= (unsigned char)(1u << (rnd() % 8));
+        if (rnd() % 3 == 0) in.resize(rnd() % in.size() + 1);
+
+        Bytes ref(src.size()), out(src.size());
+        const bool refOk = zlibInflate(in, ref);
+        const bool ok    = daaInflate(in, out);
+        if (refOk && ok && ref == out) ++agree;
+        else if (refOk) ++fails;
+    }
+
+    printf("corrupt streams: %d/%d decoded by both and equal, %d disagreements\n", agree, total, fails);
+    return fails;
+}
+
+template <typename Decode>
+double throughput(const std::vector<Bytes> &chunks, size_t chunkSize, Decode decode) {
+    const int reps = 3;
+    Bytes out(chunkSize + 16);
+    const auto t0 = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < reps; ++rep)
+        for (const Bytes &c : chunks) {
+            out.resize(chunkSize + 16);
+            decode(c, out);
+        }
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return reps * (double)chunkSize * chunks.size() / 1048576.0 / s;
+}
+
+/**
+ * @brief Decodes 64 MiB of 64 KiB DAA-sized chunks with each decoder.
+ */
+void benchmark() {
+    const size_t chunkSize = 65536, count = 1024;
+    std::vector<Bytes> chunks;
+    for (size_t i = 0; i < count; ++i) {
+        Bytes src(chunkSize);
+        generate(src, 2);
+        chunks.push_back(deflateRaw(src, 6, Z_DEFAULT_STRATEGY));
+    }
+    printf("daa_inflate: %.0f MiB/s\n", throughput(chunks, chunkSize, [](const Bytes &in, Bytes &out) { daaInflate(in, out); }));
+    printf("zlib:        %.0f MiB/s\n", throughput(chunks, chunkSize, [](const Bytes &in, Bytes &out) { zlibInflate(in, out); }));
+}
+
+} // namespace
+
+int main() {
+    const int fails = checkValidStreams() + checkCorruptStreams();
+    benchmark();
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,78 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ASYNCIO_H
+#define ASYNCIO_H
+
+// C++ Standard Library Headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+// Project Headers
+#include "./cancellation.h"
+
+/**
+ * @brief One positional copy between two descriptors, as run by @ref copyStream.
+ *
+ * Neither descriptor's file offset is used or moved; the source must be a
+ * regular file or block device (its size bounds the copy), the destination
+ * anything pwrite(2) accepts.
+ */
+struct StreamCopy {
+    static constexpr uint64_t TO_END = UINT64_MAX;
+
+    uint64_t srcOffset = 0;
+    uint64_t dstOffset = 0;
+    uint64_t length    = TO_END;            ///< Clipped to the source's size.
+
+    size_t   chunkSize = 2 * 1024 * 1024;   ///< Bytes per read/write request.
+    unsigned depth     = 2;                 ///< Reads and writes kept in flight each (1-8).
+
+    /// Non-zero for O_DIRECT destinations: buffers are aligned to it, chunks
+    /// are a multiple of it and the last write is zero-padded up to it.
+    size_t   writeAlignment = 0;
+
+    /// Credited with source bytes (never padding) as each write lands.
+    std::atomic<size_t>* completedBytes = nullptr;
+
+    /// Stops the copy, waking it even while every request is blocked on a
+    /// slow device; an empty token means Cancellation::operation().
+    CancellationToken cancel;
+};
+
+/// @brief Outcome of @ref copyStream.
+struct StreamCopyResult {
+    uint64_t bytes = 0;       ///< Source bytes written, excluding padding.
+    std::error_code error;    ///< `operation_canceled` when stopped by the cancel token.
+
+    explicit operator bool() const noexcept { return !error; }
+};
+
+/**
+ * @brief Copies @p job's byte range from @p inFd to @p outFd with reads and
+ *        writes overlapped, so the source is read while the destination writes.
+ *
+ * Uses io_uring where the kernel offers it: @c 2 × depth chunk buffers cycle
+ * between read and write requests, registered with the ring (fixed buffers)
+ * together with both descriptors (fixed files) when the kernel allows, and
+ * in-flight requests are cancelled on abort. Without io_uring (old kernel,
+ * seccomp, `kernel.io_uring_disabled`) a reader thread fills the same buffers
+ * ahead of the calling thread's writes. Copies that fit one chunk skip both
+ * and run as a plain pread/pwrite on the calling thread.
+ *
+ * Buffers are @ref NodeLocalBuffer allocations of the calling thread.
+ * Nothing is removed or truncated on failure; that is left to the caller.
+ */
+StreamCopyResult copyStream(int inFd, int outFd, const StreamCopy& job);
+
+/// @brief pread(2) until @p len bytes are in; a source that ends early is `io_error`.
+bool readFully(int fd, char* buf, size_t len, uint64_t off, std::error_code& ec);
+
+/// @brief pwrite(2) until all @p len bytes are out.
+bool writeFully(int fd, const char* buf, size_t len, uint64_t off, std::error_code& ec);
+
+/// @brief "io_uring" or "threads": the engine @ref copyStream uses in this process.
+const char* asyncIoBackend();
+
+#endif // ASYNCIO_H
@@ -0,0 +1,179 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CANCELLATION_H
+#define CANCELLATION_H
+
+// C++ Standard Library Headers
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+class CancellationCallback;
+
+/**
+ * @brief One node of the cancellation tree. Internal to the classes below.
+ *
+ * A node holds its parent alive and is registered with it, so cancelling a
+ * node cancels every node below it. Links and callbacks are guarded by one
+ * process-wide mutex; the flag itself is read without it.
+ */
+struct CancellationNode {
+    std::atomic<bool> flag{false};
+    std::shared_ptr<CancellationNode> parent;
+    std::vector<CancellationNode*> children;
+    std::vector<CancellationCallback*> callbacks;
+
+    ~CancellationNode();
+};
+
+/**
+ * @class CancellationToken
+ * @brief Read side of a cancellation node: asks whether the work it was
+ *        handed to should stop.
+ *
+ * Copies share the node. A default-constructed token is never cancelled.
+ * Checking is one atomic load, cheap enough for per-chunk loops; code that
+ * blocks instead of polling registers a @ref CancellationCallback to be woken.
+ */
+class CancellationToken {
+public:
+    CancellationToken() = default;
+
+    bool cancelled() const noexcept {
+        return flag().load(std::memory_order_acquire);
+    }
+
+    /// @brief The flag itself, for std::atomic::wait and APIs that poll an atomic<bool>.
+    ///        It is notified (notify_all) when set.
+    const std::atomic<bool>& flag() const noexcept {
+        return node_ ? node_->flag : neverCancelled();
+    }
+
+    /// @brief True unless default-constructed.
+    explicit operator bool() const noexcept { return node_ != nullptr; }
+
+private:
+    friend class CancellationSource;
+    friend class CancellationCallback;
+
+    explicit CancellationToken(std::shared_ptr<CancellationNode> node) noexcept : node_(std::move(node)) {}
+    static const std::atomic<bool>& neverCancelled() noexcept;
+
+    std::shared_ptr<CancellationNode> node_;
+};
+
+/**
+ * @class CancellationSource
+ * @brief Owner side of a cancellation node: the one that cancels.
+ *
+ * A source built from a token is that token's child and is cancelled along
+ * with it; cancelling the child leaves the parent and its other children
+ * running. Cancellation is one-way, a cancelled node never resets; work that
+ * starts over takes a fresh source. Copies share the node.
+ */
+class CancellationSource {
+public:
+    /// @brief A new root, cancelled only through this source.
+    CancellationSource();
+
+    /// @brief A child of @p parent; already cancelled if @p parent is.
+    explicit CancellationSource(const CancellationToken& parent);
+
+    /// @brief Cancels this node and everything below it, running their callbacks.
+    ///        Later calls do nothing.
+    void cancel();
+
+    bool cancelled() const noexcept { return node_->flag.load(std::memory_order_acquire); }
+    CancellationToken token() const noexcept { return CancellationToken(node_); }
+
+private:
+    std::shared_ptr<CancellationNode> node_;
+};
+
+/**
+ * @class CancellationCallback
+ * @brief Runs a function once when a token is cancelled, for waking waits
+ *        that don't poll: a condition variable, an eventfd an io_uring read
+ *        is parked on, a blocked syscall.
+ *
+ * The function runs on the thread that calls cancel() (immediately, in the
+ * constructor, if the token is already cancelled) and must not block.
+ * Destroying the callback deregisters it; if it is running at that moment,
+ * the destructor waits for it to return, so whatever it touches only has to
+ * outlive the callback object. It must not destroy its own callback object.
+ */
+class CancellationCallback {
+public:
+    template <typename F>
+    CancellationCallback(const CancellationToken& token, F&& fn)
+        : fn_(std::forward<F>(fn)) {
+        attach(token);
+    }
+
+    ~CancellationCallback();
+
+    CancellationCallback(const CancellationCallback&) = delete;
+    CancellationCallback& operator=(const CancellationCallback&) = delete;
+
+private:
+    friend class CancellationSource;
+
+    enum class State : uint8_t { Detached, Registered, Running, Done };
+
+    void attach(const CancellationToken& token);
+
+    std::function<void()> fn_;
+    std::shared_ptr<CancellationNode> node_;
+    State state_ = State::Detached;
+};
+
+/**
+ * @brief The process's cancellation tree.
+ *
+ * @code
+ *   process()                    cancelled once, at shutdown
+ *   ├── operation()              the interactive operation; Ctrl+C cancels it
+ *   │   └── per-file children    e.g. one per cp/mv transfer
+ *   └── background jobs          e.g. the auto-update import
+ * @endcode
+ *
+ * Each interactive operation calls beginOperation() as it starts, which
+ * replaces the Ctrl+C target with a fresh node. A stale Ctrl+C can therefore
+ * never leak into the next operation, and an operation starting never
+ * un-cancels work that is still winding down from the last one. Background
+ * jobs hang off process() directly and so keep running through a Ctrl+C.
+ */
+namespace Cancellation {
+
+    /// @brief The root. Children of it stop only at shutdown.
+    CancellationToken process();
+
+    /// @brief Cancels the root, and with it every token in the process.
+    void shutdown();
+
+    /// @brief Starts a new interactive operation and returns its token.
+    CancellationToken beginOperation();
+
+    /// @brief Token of the current interactive operation.
+    CancellationToken operation();
+
+    /// @brief Cancels the current interactive operation.
+    void cancelOperation();
+
+    /**
+     * @brief Forwards Ctrl+C from a signal handler to cancelOperation().
+     *
+     * Async-signal-safe: it only writes to an eventfd that a relay thread
+     * reads, since cancelling takes a mutex and runs callbacks. Does nothing
+     * before installSignalRelay().
+     */
+    void requestFromSignal() noexcept;
+
+    /// @brief Starts the relay thread for requestFromSignal(). Idempotent.
+    void installSignalRelay();
+}
+
+#endif // CANCELLATION_H
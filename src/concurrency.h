@@ -11,9 +11,15 @@
 //=======================================
 namespace GlobalConcurrency {
 
-    // Global cap for static threads
+    // Global cap for static threads; the pool grows up to it for I/O-bound work
     inline size_t MAX_USEFUL_THREADS = 16;
 
+    // Threads the static pool keeps when idle (0 = one per core)
+    inline size_t MIN_POOL_THREADS   = 0;
+
+    // Bind static pool workers to NUMA nodes / last-level caches
+    inline bool   PIN_POOL_WORKERS   = false;
+
     // Operation thread caps for static pool
 
     // High I/O
@@ -32,6 +38,9 @@ namespace GlobalConcurrency {
     inline size_t SORT_THREAD_CAP   = 2;
     inline size_t FILTER_THREAD_CAP = 2;
 
+    // CPU-bound, per conversion (own threads, outside the static pool)
+    inline size_t DAA_DECODE_THREAD_CAP = 4;
+
 }
 
 #endif // CONCURRENCY_H
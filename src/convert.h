@@ -6,21 +6,32 @@
 // C++ Standard Library Headers
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 
+class CancellationToken;
+
+// Each converter stops, removing its partial output, once its cancel token is set.
+
 // CCD2ISO
-bool convertCcdToIso(const std::string& ccdPath, const std::string& isoPath, std::atomic<size_t>* completedBytes);
+bool convertCcdToIso(const std::string& ccdPath, const std::string& isoPath, std::atomic<size_t>* completedBytes,
+                     const CancellationToken& cancel);
 
 // CHD2ISO
-bool convertChdToIso(const std::string& chdPath, const std::string& isoPath, std::atomic<size_t>* completedBytes);
+bool convertChdToIso(const std::string& chdPath, const std::string& isoPath, std::atomic<size_t>* completedBytes,
+                     const CancellationToken& cancel);
+uint64_t chdIsoSize(const std::string& chdPath);
 
 // DAA2ISO
-bool convertDaaToIso(const std::string &inputFile, const std::string &outputFile, std::atomic<size_t> *completedBytes);
+bool convertDaaToIso(const std::string &inputFile, const std::string &outputFile, std::atomic<size_t> *completedBytes,
+                     const CancellationToken& cancel);
 
 // MDF2ISO
-bool convertMdfToIso(const std::string& mdfPath, const std::string& isoPath, std::atomic<size_t>* completedBytes);
+bool convertMdfToIso(const std::string& mdfPath, const std::string& isoPath, std::atomic<size_t>* completedBytes,
+                     const CancellationToken& cancel);
 
 // NRG2ISO
-bool convertNrgToIso(const std::string& inputFile, const std::string& outputFile, std::atomic<size_t>* completedBytes);
+bool convertNrgToIso(const std::string& inputFile, const std::string& outputFile, std::atomic<size_t>* completedBytes,
+                     const CancellationToken& cancel);
 
 #endif // CONVERT
@@ -9,7 +9,6 @@
 #include <functional>
 #include <filesystem>
 #include <iterator>
-#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_set>
@@ -19,9 +18,12 @@
 #include <readline/readline.h>
 
 // Project Headers
+#include "./cancellation.h"
 #include "./readline.h"
 #include "./display.h"
 
+class ResultChannel;
+
 /**
  * @struct RlFormFeedGuard
  * @brief RAII guard to restore the '\f' key binding to @c prevent_readline_keybindings.
@@ -67,102 +69,24 @@ struct RlStartupHookGuard {
 // Helper classes & functions
 // ======================================================================
 
-/**
- * @brief Thread-local batched reporter for success/error messages.
- *
- * Each worker thread creates its own instance. Messages are first buffered
- * locally; when the buffer reaches a threshold they are flushed under the
- * global mutex to the shared verboseSets containers. This reduces mutex
- * contention compared to locking on every message.
- *
- * @note Must call flush() when the thread finishes to ensure no messages
- *       are left in the local buffers.
- */
-class BatchReporter {
-public:
-    /**
-     * @brief Constructs a batched reporter tied to global sets.
-     * @param globalIsos  Reference to the global completed operations set.
-     * @param globalErrors Reference to the global failed operations set.
-     * @param mutex       Mutex protecting both global sets.
-     * @param batchSize   Number of messages to accumulate before auto-flushing.
-     */
-    BatchReporter(std::unordered_set<std::string>& globalIsos,
-                  std::unordered_set<std::string>& globalErrors,
-                  std::mutex& mutex,
-                  size_t batchSize = 50)
-        : globalIsos_(globalIsos), globalErrors_(globalErrors),
-          mutex_(mutex), batchSize_(batchSize) {}
-
-    /**
-     * @brief Buffers a success message and flushes if the batch size is reached.
-     * @param msg The formatted success message to add.
-     */
-    void addSuccess(std::string msg) {
-        localIsos_.push_back(std::move(msg));
-        tryFlush();
-    }
-
-    /**
-     * @brief Buffers an error message and flushes if the batch size is reached.
-     * @param msg The formatted error message to add.
-     */
-    void addError(std::string msg) {
-        localErrors_.push_back(std::move(msg));
-        tryFlush();
-    }
-
-    /**
-     * @brief Immediately flushes all buffered messages to the global sets.
-     * @details Must be called when the worker thread finishes processing
-     *          to ensure no messages remain in local buffers.
-     */
-    void flush() {
-        if (!localIsos_.empty() || !localErrors_.empty()) {
-            std::lock_guard<std::mutex> lock(mutex_);
-            globalIsos_.insert(std::make_move_iterator(localIsos_.begin()),
-                              std::make_move_iterator(localIsos_.end()));
-            globalErrors_.insert(std::make_move_iterator(localErrors_.begin()),
-                                std::make_move_iterator(localErrors_.end()));
-            localIsos_.clear();
-            localErrors_.clear();
-        }
-    }
-
-private:
-    /**
-     * @brief Checks if either local buffer has reached the batch threshold
-     *        and flushes if so.
-     */
-    void tryFlush() {
-        if (localIsos_.size() >= batchSize_ || localErrors_.size() >= batchSize_)
-            flush();
-    }
-
-    std::vector<std::string> localIsos_;          ///< Thread-local success buffer
-    std::vector<std::string> localErrors_;        ///< Thread-local error buffer
-    std::unordered_set<std::string>& globalIsos_; ///< Global completed set
-    std::unordered_set<std::string>& globalErrors_; ///< Global failed set
-    std::mutex& mutex_;                           ///< Protects global sets
-    const size_t batchSize_;                      ///< Flush threshold
-};
-
 /**
  * @brief Bundles all shared state that flows through every file operation.
  *
- * Groups counters, batch reporting, the operation success flag, and an optional
+ * Groups counters, the result channel, the operation success flag, and an optional
  * ownership-change callback into a single object. This eliminates the need to
  * pass 8–12 separate parameters to every operation function.
  *
- * Thread‑local; one instance per worker thread.
+ * One instance per batch, shared by all of its tasks; only the atomics
+ * behind it are written once the batch starts.
  */
 struct OperationContext {
-    BatchReporter& reporter;                            ///< Batched message output
+    ResultChannel&       results;                       ///< Success/failure messages and dest paths
     std::atomic<size_t>* completedTasks = nullptr;      ///< Successful operation counter
     std::atomic<size_t>* failedTasks    = nullptr;      ///< Failed operation counter
     std::atomic<bool>&   operationSuccessful;           ///< Set to false on any failure
     /// Optional callback to chown newly created files to the real user.
     std::function<void(const std::filesystem::path&)> changeOwnership;
+    CancellationToken    cancel;                        ///< The operation the batch belongs to
 };
 
 /**
@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef CPUTOPOLOGY_H
+#define CPUTOPOLOGY_H
+
+// C++ Standard Library Headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A set of CPUs worker threads are placed on together.
+ *
+ * On a multi-node machine each domain is one NUMA node; on a single node it
+ * is one last-level cache (an L3 slice, a CCX), so placement still keeps a
+ * worker's data in the cache it was loaded into.
+ */
+struct CpuDomain {
+    int node = 0;              ///< NUMA node the CPUs belong to.
+    bool numaNode = false;     ///< True when the domain is a whole node rather than a cache.
+    std::string cpuList;       ///< As sysfs prints it, e.g. "0-15,32-47".
+    std::vector<int> cpus;     ///< Only CPUs this process may run on.
+};
+
+/**
+ * @brief The placement domains of this machine, read once from
+ *        /sys/devices/system/node and /sys/devices/system/cpu.
+ *
+ * Restricted to the process's affinity mask; never empty (a machine whose
+ * topology can't be read is one domain holding every allowed CPU).
+ */
+const std::vector<CpuDomain>& cpuDomains();
+
+/**
+ * @brief Restricts the calling thread to the CPUs of domain @p domain and
+ *        records its node for @ref NodeLocalBuffer.
+ * @return false if the affinity call failed; the thread is then left unbound.
+ */
+bool bindCurrentThreadToDomain(std::size_t domain);
+
+/// @brief NUMA node the calling thread is bound to, or -1 if it isn't bound to one.
+int currentThreadNode() noexcept;
+
+/// @brief Totals of @ref NodeLocalBuffer allocations, for the stats view.
+struct NodeBufferCounters {
+    std::atomic<uint64_t> bound{0};       ///< Placed on the allocating thread's node.
+    std::atomic<uint64_t> firstTouch{0};  ///< Left to the kernel's first-touch policy.
+};
+NodeBufferCounters& nodeBufferCounters() noexcept;
+
+/**
+ * @class NodeLocalBuffer
+ * @brief Page-aligned, anonymously mapped I/O buffer placed on the NUMA node
+ *        of the thread that allocates it.
+ *
+ * On a pool worker bound to a node (see @ref bindCurrentThreadToDomain) the
+ * mapping gets a preferred-node policy before any page is touched, so the
+ * pages land on that node even when the first write comes from the kernel
+ * (read(2) into the buffer) or the heap would have handed back memory freed
+ * on another node. Elsewhere it is an ordinary mapping. Contents start zeroed.
+ */
+class NodeLocalBuffer {
+public:
+    NodeLocalBuffer() = default;
+    explicit NodeLocalBuffer(std::size_t size);
+    ~NodeLocalBuffer();
+
+    NodeLocalBuffer(NodeLocalBuffer&& other) noexcept;
+    NodeLocalBuffer& operator=(NodeLocalBuffer&& other) noexcept;
+    NodeLocalBuffer(const NodeLocalBuffer&) = delete;
+    NodeLocalBuffer& operator=(const NodeLocalBuffer&) = delete;
+
+    char* data() const noexcept { return data_; }
+    std::size_t size() const noexcept { return size_; }
+    explicit operator bool() const noexcept { return data_ != nullptr; }
+
+    /// @brief Node the buffer was placed on, or -1 if placement was left to the kernel.
+    int node() const noexcept { return node_; }
+
+private:
+    void release() noexcept;
+
+    char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t mapped_ = 0;
+    int node_ = -1;
+};
+
+#endif // CPUTOPOLOGY_H
@@ -15,22 +15,28 @@
 
 // Forward declaration of shared state
 struct RefreshState;
+class CancellationToken;
+class DirSnapshot;
+class PathList;
+class PathSearchIndex;
 
 // --- Filesystem Traversal ---
 
 /**
- * Recursively scans the filesystem for ISO files.
- * Uses mutexes for thread-safe updates to shared lists and error sets.
+ * Recursively scans the filesystem for ISO files under every root at once.
+ * Subdirectories are spread across the thread pool by a work-stealing walker.
+ * With a previous snapshot, directories whose stamp is unchanged are not re-read.
  */
 void traverse(
-    const std::filesystem::path& path,
+    const std::vector<std::string>& roots,
     std::vector<std::string>& isoFiles,
     std::unordered_set<std::string>& uniqueErrorMessages,
     std::atomic<size_t>& totalFiles,
-    std::mutex& traverseFilesMutex,
-    std::mutex& traverseErrorsMutex,
     int maxDepth,
-    bool promptFlag
+    bool promptFlag,
+    const CancellationToken* cancel = nullptr,
+    const DirSnapshot* previousSnapshot = nullptr,
+    DirSnapshot* snapshotOut = nullptr
 );
 
 
@@ -39,12 +45,29 @@ void traverse(
 /**
  * Populates the global list by reading existing entries from the database.
  */
-void loadFromDatabase(std::vector<std::string>& globalIsoFileList);
+void loadFromDatabase(PathList& globalIsoFileList);
+
+/**
+ * Returns the trigram search index for the table behind @p list, or null until
+ * its background build has finished.
+ */
+std::shared_ptr<const PathSearchIndex> isoSearchIndexFor(const PathList& list);
 
 /**
  * Populates the ISO database with ISOs from scanned folders.
  */
-bool saveToDatabase(const std::vector<std::string>& globalIsoFileList, bool* newISOFound);
+bool saveToDatabase(const std::vector<std::string>& globalIsoFileList, bool* newISOFound,
+                    bool* allStored = nullptr);
+
+/**
+ * Marks database entries as recently used for LRU eviction.
+ */
+void touchDatabaseEntries(const std::vector<std::string>& isoFiles);
+
+/**
+ * Reports whether the database has reached its configured capacity.
+ */
+bool isDatabaseFull();
 
 /**
  * Triggers a refresh logic to sync disk state with the database.
@@ -59,7 +82,7 @@ void refreshForDatabase(
 /**
  * Identifies and removes database entries that no longer exist on the physical disk.
  */
-void removeNonExistentPathsFromDatabase(std::vector<std::string>& globalIsoFileList);
+void removeNonExistentPathsFromDatabase(PathList& globalIsoFileList);
 
 
 // --- Background Operations ---
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef DIRWALKER_H
+#define DIRWALKER_H
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Identity and change stamp of one directory as seen by `fstat`.
+ *
+ * A directory's mtime/ctime move whenever an entry is created, removed or
+ * renamed directly inside it, so an identical stamp means its own listing is
+ * unchanged; subdirectories carry their own stamps.
+ */
+struct DirStamp {
+    std::uint64_t dev = 0;
+    std::uint64_t ino = 0;
+    std::int64_t  mtimeSec = 0;
+    std::int64_t  mtimeNsec = 0;
+    std::int64_t  ctimeSec = 0;
+    std::int64_t  ctimeNsec = 0;
+
+    bool operator==(const DirStamp&) const = default;
+};
+
+/**
+ * @class DirSnapshot
+ * @brief Persisted map of directory path to @ref DirStamp from a previous walk.
+ *
+ * Handed to @ref ParallelDirWalker as the previous snapshot, it lets the walker
+ * skip reading any directory whose stamp still matches and descend straight
+ * into the subdirectories recorded for it. Stored as a small text file, one
+ * directory per line, in the same directory as the ISO database.
+ *
+ * Directories modified within a second of the snapshot being written are
+ * treated as changed on load, since a second write in the same timestamp
+ * tick would otherwise go unnoticed.
+ */
+class DirSnapshot {
+public:
+    /// @brief Loads @p filePath; returns false (leaving the snapshot empty) if
+    /// it is missing, unreadable or from another format version.
+    bool load(const std::string& filePath);
+
+    /// @brief Writes the snapshot via a temporary file and an atomic rename.
+    bool save(const std::string& filePath) const;
+
+    /// @brief Records @p dir with its current @p stamp.
+    void record(std::string dir, const DirStamp& stamp);
+
+    /// @brief Returns the stored stamp for @p dir, or nullptr if unknown or untrusted.
+    const DirStamp* find(const std::string& dir) const;
+
+    /// @brief Subdirectories recorded under @p dir (full paths).
+    const std::vector<std::string>& children(const std::string& dir) const;
+
+    std::size_t size() const noexcept { return stamps_.size(); }
+    bool empty() const noexcept { return stamps_.empty(); }
+
+private:
+    std::unordered_map<std::string, DirStamp> stamps_;
+    std::unordered_map<std::string, std::vector<std::string>> children_;
+};
+
+/**
+ * @brief Tuning knobs for a single @ref ParallelDirWalker::walk call.
+ */
+struct DirWalkOptions {
+    /// Maximum depth of reported entries; -1 for unlimited. Entries directly
+    /// inside a root are depth 0, matching `recursive_directory_iterator::depth()`.
+    int maxDepth = -1;
+
+    /// When true, symlinks are ignored entirely. When false, symlinks to regular
+    /// files are reported as files; symlinked directories are never descended.
+    bool skipSymlinks = false;
+
+    /// Lower-case suffixes (e.g. ".iso") a file name must end with, compared
+    /// case-insensitively on the raw entry bytes. Empty reports every file.
+    std::vector<std::string> suffixes;
+
+    /// Stamps from a previous walk. Directories whose stamp is unchanged are
+    /// not read; their recorded subdirectories are walked instead. Only valid
+    /// with the same roots, suffixes and an unlimited @ref maxDepth.
+    const DirSnapshot* previousSnapshot = nullptr;
+
+    /// When set, receives the stamp of every directory fully read or skipped
+    /// as unchanged during this walk.
+    DirSnapshot* snapshotOut = nullptr;
+
+    /// Polled once per directory and periodically while scanning one; returning
+    /// true stops the walk as soon as every worker finishes its current entry.
+    std::function<bool()> cancelled;
+};
+
+/**
+ * @class ParallelDirWalker
+ * @brief Work-stealing recursive directory walker backed by @ref getStaticThreadPool.
+ *
+ * Every directory is an independent task. A worker that reads a directory
+ * pushes its subdirectories onto its own deque and pops from the back (depth
+ * first, so the working set stays small), while idle workers steal from the
+ * front of other workers' deques. A single huge root is therefore spread over
+ * every pool thread instead of being walked by one.
+ *
+ * The calling thread takes part as worker 0, so a walk always completes even
+ * when the pool is saturated or already shut down; pool threads that start late
+ * simply find nothing left to do.
+ *
+ * Directories are read with `getdents64` into a large per-thread buffer and
+ * classified by `d_type`, so the common case costs no `stat` and no
+ * `std::filesystem::path` per entry.
+ *
+ * Callbacks run concurrently on several threads. The @c worker argument is a
+ * stable index in `[0, workerCount())` for the duration of one walk, letting
+ * callers keep per-worker accumulators without locking.
+ */
+class ParallelDirWalker {
+public:
+    using FileCallback  = std::function<void(std::size_t worker, const std::string& dir, std::string_view name)>;
+    using ErrorCallback = std::function<void(const std::string& dir, const std::error_code& ec)>;
+    using CountCallback = std::function<void(std::size_t regularFiles)>;
+
+    explicit ParallelDirWalker(DirWalkOptions options = {});
+
+    /// @brief Number of distinct worker indices a callback may observe.
+    std::size_t workerCount() const noexcept { return workers_; }
+
+    /**
+     * @brief Walks every root, invoking @p onFile for each matching regular file.
+     *
+     * @param roots   Directories to scan; roots are expected not to overlap.
+     * @param onFile  Receives the containing directory (without a trailing
+     *                slash, except for "/") and the entry name. The name
+     *                view is only valid for the duration of the call.
+     * @param onError Receives any directory that could not be opened or read.
+     *                The walk continues with the remaining directories.
+     * @param onCount Receives, once per directory, how many regular files it
+     *                held before suffix filtering; used for progress output.
+     */
+    void walk(const std::vector<std::string>& roots,
+              const FileCallback& onFile,
+              const ErrorCallback& onError = {},
+              const CountCallback& onCount = {}) const;
+
+private:
+    DirWalkOptions options_;
+    std::size_t workers_;
+};
+
+/**
+ * @brief Joins a directory and an entry name with exactly one separator.
+ */
+inline std::string joinDirEntry(const std::string& dir, std::string_view name) {
+    std::string out;
+    out.reserve(dir.size() + 1 + name.size());
+    out.append(dir);
+    if (out.empty() || out.back() != '/') out.push_back('/');
+    out.append(name);
+    return out;
+}
+
+#endif // DIRWALKER_H
@@ -9,23 +9,20 @@
 #include <string_view>
 #include <vector>
 
+class PathList;
+
 /**
  * DATA STRUCTURES
  */
 
 /**
- * @brief Represents a single search token with precomputed Boyer-Moore tables.
+ * @brief Represents a single search token; tokens containing an upper-case
+ *        letter match case-sensitively, others match on @c lower.
  */
 struct QueryToken {
     std::string original;
     std::string lower;
     bool isCaseSensitive;
-
-    std::vector<int> originalBadChar;
-    std::vector<int> originalGoodSuffix;
-
-    std::vector<int> lowerBadChar;
-    std::vector<int> lowerGoodSuffix;
 };
 
 /**
@@ -47,6 +44,7 @@ struct FilterContext {
     bool& filterHistory;
     size_t& currentPage;
     const std::vector<std::string>* sourceOverride = nullptr;
+    const PathList* pathSource = nullptr;  ///< Interned source; takes precedence over sourceOverride.
     bool isUnmount = false;
     bool toggleFullListUmount = false;
 };
@@ -57,6 +55,7 @@ struct FilterContext {
 struct FilterCallConfig {
     std::vector<std::string>* files = nullptr;
     const std::vector<std::string>* sourceOverride = nullptr;
+    const PathList* pathSource = nullptr;
     std::string operation;
     std::string_view operationColor;
     bool* isFiltered = nullptr;
@@ -83,7 +82,7 @@ inline std::vector<FilteringState> filteringStack;
  */
 
 /**
- * @brief Filters file indices based on a search query using the Boyer-Moore algorithm.
+ * @brief Filters file indices based on a search query using a vectorised substring search.
  */
 std::vector<size_t> filterFilesIndices(const std::vector<std::string>& files, const std::string& query);
 
@@ -91,7 +90,7 @@ std::vector<size_t> filterFilesIndices(const std::vector<std::string>& files, co
  * @brief Synchronizes the filtered results by iteratively applying the filtering stack.
  */
 void syncFilteringStackForIso(
-    const std::vector<std::string>& globalIsoFileList, 
+    const PathList& globalIsoFileList, 
     std::vector<FilteringState>& filteringStack, 
     std::vector<std::string>& filteredFiles, 
     bool& isFiltered
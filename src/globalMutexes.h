@@ -19,11 +19,6 @@ namespace GlobalMutexes {
 
     // --- Global State Mutexes ---
     inline std::mutex updateListMutex;
-    inline std::mutex binImgCacheMutex;
-    inline std::mutex mdfMdsCacheMutex;
-    inline std::mutex nrgCacheMutex;
-    inline std::mutex chdCacheMutex;
-    inline std::mutex daaGbiCacheMutex;
     inline std::mutex readLineMutex;
 }
 
@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef IMAGEFILECACHE_H
+#define IMAGEFILECACHE_H
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// Project Headers
+#include "./caches.h"
+
+/**
+ * @class ShardedStringSet
+ * @brief Hash set of paths split over independently locked shards.
+ *
+ * A path always lands in the shard picked by its hash, so threads checking or
+ * inserting different paths rarely touch the same lock. Used where many
+ * scanner threads test membership at once.
+ */
+class ShardedStringSet {
+public:
+    static constexpr std::size_t SHARDS = 64;
+
+    bool contains(std::string_view path) const {
+        const Shard& s = shardFor(path);
+        std::shared_lock lock(s.mutex);
+        return s.set.find(path) != s.set.end();
+    }
+
+    /// @brief Inserts @p path; returns true if it was not present.
+    bool insert(const std::string& path) {
+        Shard& s = shardFor(path);
+        std::unique_lock lock(s.mutex);
+        return s.set.insert(path).second;
+    }
+
+    /// @brief Erases @p path; returns true if it was present.
+    bool erase(std::string_view path) {
+        Shard& s = shardFor(path);
+        std::unique_lock lock(s.mutex);
+        auto it = s.set.find(path);
+        if (it == s.set.end()) return false;
+        s.set.erase(it);
+        return true;
+    }
+
+    void clear() {
+        for (Shard& s : shards_) {
+            std::unique_lock lock(s.mutex);
+            Set().swap(s.set);
+        }
+    }
+
+    /// @brief Moves every path out into one set, leaving this one empty.
+    std::unordered_set<std::string> extract() {
+        std::unordered_set<std::string> out;
+        for (Shard& s : shards_) {
+            std::unique_lock lock(s.mutex);
+            while (!s.set.empty()) out.insert(std::move(s.set.extract(s.set.begin()).value()));
+        }
+        return out;
+    }
+
+private:
+    friend class ImageFileCache;
+
+    using Set = std::unordered_set<std::string, StringViewHash, std::equal_to<>>;
+
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        Set set;
+    };
+
+    Shard& shardFor(std::string_view path) {
+        return shards_[StringViewHash{}(path) % SHARDS];
+    }
+    const Shard& shardFor(std::string_view path) const {
+        return shards_[StringViewHash{}(path) % SHARDS];
+    }
+
+    std::array<Shard, SHARDS> shards_;
+};
+
+/**
+ * @class ImageFileCache
+ * @brief RAM cache of discovered BIN/IMG, MDF, NRG, CHD or DAA/GBI files.
+ *
+ * Each path is stored once, in the node of a @ref ShardedStringSet that
+ * answers membership in O(1) without a global lock. The display order is a
+ * vector of pointers to those nodes (node addresses are stable across
+ * rehashing), so sorting or reordering never moves a string. Index and order
+ * are updated under the path's shard lock, keeping the two consistent per path
+ * even when scanners insert and converters erase at once.
+ *
+ * Erasing moves the node out of the index into a side set, leaving its pointer
+ * valid; the vector is pruned in one pass the next time it is read, so erasing
+ * many paths costs O(erased + cache) rather than O(erased × cache).
+ */
+class ImageFileCache {
+public:
+    bool contains(std::string_view path) const { return index_.contains(path); }
+
+    /// @brief Appends @p path unless cached; returns true if it was added.
+    bool insert(const std::string& path) {
+        ShardedStringSet::Shard& s = index_.shardFor(path);
+        std::unique_lock shardLock(s.mutex);
+        if (s.set.find(path) != s.set.end()) return false;
+
+        std::lock_guard<std::mutex> lock(orderMutex_);
+        // Erased but not yet pruned: the node is still in the vector, so move it back.
+        if (!erased_.empty()) {
+            if (auto node = erased_.extract(path)) {
+                s.set.insert(std::move(node));
+                return true;
+            }
+        }
+        ordered_.push_back(&*s.set.insert(path).first);
+        return true;
+    }
+
+    /// @brief Appends every uncached path in order; returns how many were added.
+    std::size_t insert(const std::vector<std::string>& paths) {
+        std::size_t added = 0;
+        for (const auto& p : paths) added += insert(p);
+        return added;
+    }
+
+    /// @brief Removes @p path; returns true if it was cached.
+    bool erase(std::string_view path) {
+        ShardedStringSet::Shard& s = index_.shardFor(path);
+        std::unique_lock shardLock(s.mutex);
+        auto it = s.set.find(path);
+        if (it == s.set.end()) return false;
+
+        std::lock_guard<std::mutex> lock(orderMutex_);
+        erased_.insert(s.set.extract(it));
+        return true;
+    }
+
+    /// @brief Empties the cache and releases its memory; returns false if it was already empty.
+    bool clear() {
+        // Same lock order as insert/erase: shards first, then the vector.
+        std::array<std::unique_lock<std::shared_mutex>, ShardedStringSet::SHARDS> shardLocks;
+        for (std::size_t i = 0; i < ShardedStringSet::SHARDS; ++i)
+            shardLocks[i] = std::unique_lock(index_.shards_[i].mutex);
+        std::lock_guard<std::mutex> lock(orderMutex_);
+
+        const bool wasEmpty = ordered_.size() == erased_.size();
+        std::vector<const std::string*>().swap(ordered_);
+        for (auto& s : index_.shards_)
+            ShardedStringSet::Set().swap(s.set);
+        ShardedStringSet::Set().swap(erased_);
+        return !wasEmpty;
+    }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(orderMutex_);
+        return ordered_.size() - erased_.size();
+    }
+
+    bool empty() const { return size() == 0; }
+
+    /// @brief Copy of the cached paths in display order.
+    std::vector<std::string> snapshot() const {
+        std::lock_guard<std::mutex> lock(orderMutex_);
+        pruneLocked();
+        std::vector<std::string> out;
+        out.reserve(ordered_.size());
+        for (const std::string* p : ordered_) out.push_back(*p);
+        return out;
+    }
+
+    /**
+     * @brief Runs @p fn on the display order under the cache lock.
+     *
+     * @p fn receives `std::vector<const std::string*>&`; it may reorder the
+     * pointers (e.g. sort them) but must not add or remove any.
+     */
+    template <typename Fn>
+    decltype(auto) withOrdered(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(orderMutex_);
+        pruneLocked();
+        return std::forward<Fn>(fn)(ordered_);
+    }
+
+    void reserve(std::size_t n) {
+        std::lock_guard<std::mutex> lock(orderMutex_);
+        ordered_.reserve(n);
+    }
+
+private:
+    void pruneLocked() const {
+        if (erased_.empty()) return;
+        ordered_.erase(std::remove_if(ordered_.begin(), ordered_.end(),
+                                      [this](const std::string* p) { return erased_.count(*p) != 0; }),
+                       ordered_.end());
+        erased_.clear();
+    }
+
+    ShardedStringSet index_;
+    mutable std::mutex orderMutex_;
+    mutable std::vector<const std::string*> ordered_;
+    mutable ShardedStringSet::Set erased_;   ///< Nodes erased since the last prune.
+};
+
+#endif // IMAGEFILECACHE_H
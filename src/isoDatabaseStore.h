@@ -0,0 +1,214 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef ISODATABASESTORE_H
+#define ISODATABASESTORE_H
+
+// C++ Standard Library Headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @class IsoDatabaseStore
+ * @brief Versioned binary ISO database, memory-mapped for reads and updated in place.
+ *
+ * @details
+ * The file is laid out as one fixed header followed by three preallocated
+ * sections:
+ *
+ * | Section      | Contents                                                  |
+ * |--------------|-----------------------------------------------------------|
+ * | Header       | magic, version, section offsets/capacities, live counters |
+ * | Entry table  | `{arena offset, length, flags}` per path, insertion order |
+ * | Hash index   | open-addressing slots: 32-bit hash tag + entry index      |
+ * | String arena | raw path bytes, appended back to back                     |
+ *
+ * The whole file is mapped `PROT_READ`; lookups and iteration read straight
+ * from the mapping and never copy a path. Mutations are written with
+ * `pwrite` into the free tail of each section, synced, and only then made
+ * visible by rewriting the header, so a crash mid-update leaves the previous
+ * state intact (slots pointing past the committed entry count are ignored).
+ * Appends, lookups and removals therefore cost O(batch), not O(database).
+ *
+ * When a section runs out of room, or removed entries outnumber live ones,
+ * the file is rebuilt once into a fresh one with doubled capacities and
+ * atomically renamed into place, keeping growth amortised O(1).
+ *
+ * Small mutations (the common case after a copy, move, convert or mount) do
+ * not touch the database file at all: they are appended as checksummed
+ * add / remove / touch records to a journal next to it (`<file>.journal`),
+ * costing one `write` and one `fdatasync` each, and mirrored in an
+ * in-memory overlay that every read consults. Once the journal passes a size threshold it is
+ * folded into the database on the thread pool and truncated. On open the
+ * journal is replayed over the database, stopping at the first torn or
+ * corrupt record. Records already folded replay as no-ops, and a fold drops
+ * a touched row before re-adding its path, so replay re-adds a touched path
+ * it finds missing; a crash anywhere before truncation loses nothing.
+ *
+ * Values are stored in native byte order; the file is a local cache, not an
+ * interchange format. The legacy newline-separated text file remains the
+ * interchange format via @ref importText / @ref exportText.
+ *
+ * All public members are thread-safe; they serialise on an internal mutex
+ * and take an `flock` on the file for the duration of each call.
+ */
+class IsoDatabaseStore {
+public:
+    /// @brief Returns the process-wide store bound to GlobalState::databaseFilePath,
+    ///        with the database_* capacity settings applied as they stand now.
+    static IsoDatabaseStore& instance();
+
+    explicit IsoDatabaseStore(std::string filePath);
+    ~IsoDatabaseStore();
+
+    IsoDatabaseStore(const IsoDatabaseStore&) = delete;
+    IsoDatabaseStore& operator=(const IsoDatabaseStore&) = delete;
+
+    /**
+     * @brief Capacity enforced by @ref append; zero means unlimited.
+     *
+     * Bytes are counted as @ref dataBytes counts them. When full, either the
+     * least recently used entries are evicted (entries are ordered by when
+     * they were added or last passed to @ref touch) or new paths are refused.
+     */
+    struct Limits {
+        std::size_t   maxEntries = 0;
+        std::uint64_t maxBytes = 0;
+        bool          refuseWhenFull = false;
+    };
+
+    /// @brief What @ref append had to do to stay within the @ref Limits, and
+    /// whether an I/O error kept it from storing the paths.
+    struct AppendStats {
+        std::size_t evicted = 0;
+        std::size_t refused = 0;
+        bool        failed = false;
+    };
+
+    void setLimits(const Limits& limits);
+
+    /**
+     * @brief Appends every path not already present, in order.
+     * @param paths Candidate paths; duplicates within the batch are ignored.
+     * @param stats If non-null, receives eviction / refusal counts.
+     * @return Number of paths actually added, or 0 on I/O error.
+     */
+    std::size_t append(const std::vector<std::string>& paths, AppendStats* stats = nullptr);
+
+    /**
+     * @brief Marks every listed live path as most recently used.
+     * @return Number of entries touched.
+     */
+    std::size_t touch(const std::vector<std::string>& paths);
+
+    /**
+     * @brief Removes every listed path that is present.
+     * @return Number of entries removed.
+     */
+    std::size_t remove(const std::vector<std::string>& paths);
+
+    /**
+     * @brief Removes the @p count least recently used live entries.
+     * @return Number of entries removed.
+     */
+    std::size_t evictOldest(std::size_t count);
+
+    /// @brief Returns true if @p path is a live entry.
+    bool contains(std::string_view path);
+
+    /**
+     * @brief Invokes @p fn for every live entry, least recently used first.
+     *
+     * The view points into the mapping and is only valid during the call.
+     */
+    void forEach(const std::function<void(std::string_view)>& fn);
+
+    /// @brief Removes every entry, leaving an empty database file.
+    bool clear();
+
+    /// @brief Merges a newline-separated text database into the store, within
+    ///        the @ref Limits like @ref append (whose counts land in @p stats).
+    /// @return Number of paths added, or -1 if @p textPath cannot be read.
+    long importText(const std::string& textPath, AppendStats* stats = nullptr);
+
+    /// @brief Writes all live entries as a newline-separated text database.
+    bool exportText(const std::string& textPath);
+
+    std::size_t liveCount();
+
+    /// @brief Bytes the live entries account for: the header plus, per entry,
+    /// its path, table row and share of the hash index. This is what
+    /// @ref Limits::maxBytes is measured against.
+    std::uint64_t dataBytes();
+
+    /// @brief Blocks actually allocated on disk by the database and journal.
+    std::uint64_t diskBytes();
+
+    /// @brief Folds the journal into the database and truncates it.
+    bool compact();
+
+private:
+    struct Header;
+    struct Entry;
+
+    bool openAndLockLocked(int lockOp);
+    bool ensureOpenLocked();
+    bool writeFileLocked(const std::vector<std::string_view>& paths, std::uint64_t tableCap, std::uint64_t arenaCap,
+                         bool replace, int* lockedFd = nullptr);
+    bool adoptLocked(int fd);
+    bool mapLocked();
+    void unmapLocked();
+    bool recountLocked(bool exclusive);
+    bool rebuildLocked(std::uint64_t minEntries, std::uint64_t minArena);
+    bool commitHeaderLocked(const Header& h);
+    bool markRemovedLocked(const std::vector<std::uint64_t>& indices);
+    bool appendLocked(const std::vector<std::string_view>& paths, std::size_t& added);
+    std::int64_t findLocked(std::string_view path, std::uint64_t hash) const;
+    bool liveLocked(std::string_view path) const;
+
+    bool syncJournalLocked(bool exclusive);
+    bool resetJournalLocked();
+    bool writeJournalLocked(char op, const std::vector<std::string_view>& paths);
+    void applyRecordLocked(char op, std::string_view path);
+    bool compactLocked();
+    void scheduleCompactionLocked();
+    std::uint64_t dataBytesLocked() const;
+    std::size_t liveCountLocked() const;
+    std::size_t evictLocked(std::size_t entries, std::uint64_t bytes);
+    void addPendingLocked(std::string path);
+    void erasePendingLocked(const std::string& path);
+
+    const Header* header() const;
+    const Entry* entries() const;
+    const std::uint64_t* slots() const;
+    std::string_view pathAt(std::uint64_t index) const;
+
+    std::string filePath_;
+    std::mutex mutex_;
+    int fd_ = -1;
+    void* map_ = nullptr;
+    std::size_t mapSize_ = 0;
+    std::uint64_t liveBytes_ = 0;      ///< Path bytes of live database entries.
+    bool countsStale_ = false;         ///< Mapped, but live counts not yet taken under the lock.
+    Limits limits_;
+
+    std::string journalPath_;
+    int journalFd_ = -1;
+    std::uint64_t journalEpoch_ = 0;   ///< Bumped by every truncation.
+    std::uint64_t journalSize_ = 0;    ///< Bytes replayed into the overlay.
+    std::uint64_t journalRecords_ = 0;
+    std::vector<std::string> pendingAdds_;            ///< Journalled adds / touches, most recent last.
+    std::unordered_set<std::string> pendingAddSet_;
+    std::unordered_set<std::string> pendingRemoves_;  ///< Journalled removes / touches of database entries.
+
+    bool backgroundCompaction_ = false;  ///< Only the process-wide instance uses the pool.
+    std::atomic<bool> compactionQueued_{false};
+};
+
+#endif // ISODATABASESTORE_H
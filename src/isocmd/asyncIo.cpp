@@ -0,0 +1,611 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// C / System Headers
+#include <linux/fs.h>
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+// Project Headers
+#include "../asyncIo.h"
+#include "../cpuTopology.h"
+
+bool readFully(int fd, char* buf, size_t len, uint64_t off, std::error_code& ec) {
+    while (len > 0) {
+        const ssize_t n = ::pread(fd, buf, len, static_cast<off_t>(off));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            ec = n < 0 ? std::error_code(errno, std::system_category())
+                       : std::make_error_code(std::errc::io_error);
+            return false;
+        }
+        buf += n; len -= static_cast<size_t>(n); off += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+bool writeFully(int fd, const char* buf, size_t len, uint64_t off, std::error_code& ec) {
+    while (len > 0) {
+        const ssize_t n = ::pwrite(fd, buf, len, static_cast<off_t>(off));
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            ec = n < 0 ? std::error_code(errno, std::system_category())
+                       : std::make_error_code(std::errc::io_error);
+            return false;
+        }
+        buf += n; len -= static_cast<size_t>(n); off += static_cast<uint64_t>(n);
+    }
+    return true;
+}
+
+namespace {
+
+constexpr unsigned MAX_DEPTH = 8;
+
+std::error_code errnoCode(int err) {
+    return std::error_code(err, std::system_category());
+}
+
+// ─── Chunk buffers ───────────────────────────────────────────────────────────
+
+/// @brief 2 × depth chunk buffers in one allocation, aligned for O_DIRECT.
+class ChunkBuffers {
+public:
+    ChunkBuffers(unsigned count, size_t chunkSize, size_t alignment) : count_(count), chunkSize_(chunkSize) {
+        const size_t bytes = static_cast<size_t>(count) * chunkSize;
+        if (alignment <= static_cast<size_t>(::sysconf(_SC_PAGESIZE))) {
+            mapping_ = NodeLocalBuffer(bytes);
+            base_ = mapping_.data();
+        } else {
+            aligned_.reset(static_cast<char*>(std::aligned_alloc(alignment, bytes)));
+            base_ = aligned_.get();
+        }
+    }
+
+    explicit operator bool() const noexcept { return base_ != nullptr; }
+    char* operator[](unsigned i) const noexcept { return base_ + static_cast<size_t>(i) * chunkSize_; }
+    unsigned count() const noexcept { return count_; }
+    size_t chunkSize() const noexcept { return chunkSize_; }
+
+private:
+    struct Free { void operator()(char* p) const noexcept { std::free(p); } };
+
+    unsigned count_;
+    size_t chunkSize_;
+    NodeLocalBuffer mapping_;
+    std::unique_ptr<char, Free> aligned_;
+    char* base_ = nullptr;
+};
+
+/// @brief Resolved extent of a copy and the knobs derived from a @ref StreamCopy.
+struct Plan {
+    uint64_t total = 0;      ///< Source bytes to copy.
+    size_t chunk = 0;        ///< Multiple of @c align.
+    size_t align = 1;
+    unsigned chunks = 0;     ///< Buffers cycling between reads and writes.
+    CancellationToken cancel;
+    std::atomic<size_t>* completedBytes = nullptr;
+
+    /// @brief Bytes to write for a chunk holding @p len source bytes.
+    size_t padded(size_t len) const noexcept { return (len + align - 1) / align * align; }
+
+    void credit(size_t len) const noexcept {
+        if (completedBytes) completedBytes->fetch_add(len, std::memory_order_relaxed);
+    }
+};
+
+bool planCopy(int inFd, const StreamCopy& job, Plan& plan, std::error_code& ec) {
+    struct stat st{};
+    if (::fstat(inFd, &st) != 0) {
+        ec = errnoCode(errno);
+        return false;
+    }
+    uint64_t size = 0;
+    if (S_ISREG(st.st_mode)) {
+        size = static_cast<uint64_t>(st.st_size);
+    } else if (!S_ISBLK(st.st_mode) || ::ioctl(inFd, BLKGETSIZE64, &size) != 0) {
+        ec = std::make_error_code(std::errc::invalid_argument);
+        return false;
+    }
+
+    plan.total  = size > job.srcOffset ? std::min(job.length, size - job.srcOffset) : 0;
+    plan.align  = std::max<size_t>(1, job.writeAlignment);
+    plan.chunk  = std::max(plan.align, job.chunkSize / plan.align * plan.align);
+    plan.chunks = 2 * std::clamp(job.depth, 1u, MAX_DEPTH);
+    plan.cancel = job.cancel ? job.cancel : Cancellation::operation();
+    plan.completedBytes = job.completedBytes;
+    return true;
+}
+
+bool cancelled(const Plan& plan) {
+    return plan.cancel.cancelled();
+}
+
+/// @brief Reads @p len source bytes at @p pos into @p buf and writes them, zero-padded.
+bool copyChunk(int inFd, int outFd, const StreamCopy& job, const Plan& plan,
+               char* buf, uint64_t pos, size_t len, std::error_code& ec) {
+    if (!readFully(inFd, buf, len, job.srcOffset + pos, ec)) return false;
+    const size_t out = plan.padded(len);
+    std::memset(buf + len, 0, out - len);
+    if (!writeFully(outFd, buf, out, job.dstOffset + pos, ec)) return false;
+    plan.credit(len);
+    return true;
+}
+
+// ─── io_uring engine ─────────────────────────────────────────────────────────
+
+/**
+ * @brief Minimal io_uring instance over the raw syscalls (no liburing).
+ *
+ * One per thread that copies, created on first use; its two fixed-file slots
+ * are pointed at a copy's descriptors for its duration and cleared after, so
+ * the ring never keeps a closed file (or a device) referenced.
+ */
+class Uring {
+public:
+    static constexpr unsigned ENTRIES = 64;   ///< Chunks + their cancels + the wake read, with room to spare.
+
+    ~Uring() {
+        if (sqes_) ::munmap(sqes_, sqesLen_);
+        if (cq_ && cq_ != sq_) ::munmap(cq_, cqLen_);
+        if (sq_) ::munmap(sq_, sqLen_);
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    /// @brief Sets the ring up; false if the kernel lacks io_uring or an opcode this engine uses.
+    bool open() {
+        io_uring_params p{};
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, ENTRIES, &p));
+        if (fd_ < 0) return false;
+
+        sqLen_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cqLen_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+        if (single) sqLen_ = cqLen_ = std::max(sqLen_, cqLen_);
+
+        sq_ = map(sqLen_, IORING_OFF_SQ_RING);
+        cq_ = single ? sq_ : map(cqLen_, IORING_OFF_CQ_RING);
+        sqesLen_ = p.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqesLen_, IORING_OFF_SQES));
+        if (!sq_ || !cq_ || !sqes_) return false;
+
+        auto* sq = static_cast<char*>(sq_);
+        auto* cq = static_cast<char*>(cq_);
+        sqHead_  = reinterpret_cast<unsigned*>(sq + p.sq_off.head);
+        sqTail_  = reinterpret_cast<unsigned*>(sq + p.sq_off.tail);
+        sqMask_  = *reinterpret_cast<unsigned*>(sq + p.sq_off.ring_mask);
+        sqArray_ = reinterpret_cast<unsigned*>(sq + p.sq_off.array);
+        sqEntries_ = p.sq_entries;
+        cqHead_  = reinterpret_cast<unsigned*>(cq + p.cq_off.head);
+        cqTail_  = reinterpret_cast<unsigned*>(cq + p.cq_off.tail);
+        cqMask_  = *reinterpret_cast<unsigned*>(cq + p.cq_off.ring_mask);
+        cqes_    = reinterpret_cast<io_uring_cqe*>(cq + p.cq_off.cqes);
+        tail_    = *sqTail_;
+
+        if (!supportsOpcodes()) return false;
+
+        const int none[2] = {-1, -1};
+        fixedFiles_ = reg(IORING_REGISTER_FILES, none, 2) == 0;
+        return true;
+    }
+
+    /// @brief Next free submission entry, zeroed; null if the queue is full.
+    io_uring_sqe* sqe() {
+        const unsigned head = std::atomic_ref<unsigned>(*sqHead_).load(std::memory_order_acquire);
+        if (tail_ - head >= sqEntries_) return nullptr;
+        const unsigned idx = tail_ & sqMask_;
+        io_uring_sqe* e = &sqes_[idx];
+        std::memset(e, 0, sizeof(*e));
+        sqArray_[idx] = idx;
+        ++tail_;
+        ++pending_;
+        return e;
+    }
+
+    /// @brief Submits queued entries and waits for at least @p waitFor completions.
+    int submitAndWait(unsigned waitFor) {
+        std::atomic_ref<unsigned>(*sqTail_).store(tail_, std::memory_order_release);
+        for (;;) {
+            const long r = ::syscall(__NR_io_uring_enter, fd_, pending_, waitFor,
+                                     waitFor ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (r >= 0) {
+                pending_ -= std::min(pending_, static_cast<unsigned>(r));
+                return 0;
+            }
+            if (errno != EINTR) return -errno;
+        }
+    }
+
+    /// @brief Passes every available completion to @p f.
+    template <class F>
+    void reap(F&& f) {
+        unsigned head = *cqHead_;
+        const unsigned tail = std::atomic_ref<unsigned>(*cqTail_).load(std::memory_order_acquire);
+        while (head != tail) {
+            const io_uring_cqe cqe = cqes_[head & cqMask_];
+            ++head;
+            std::atomic_ref<unsigned>(*cqHead_).store(head, std::memory_order_release);
+            f(cqe);
+        }
+    }
+
+    /// @brief Points fixed-file slots 0 and 1 at @p in and @p out (-1 clears them).
+    bool setFiles(int in, int out) {
+        if (!fixedFiles_) return false;
+        int fds[2] = {in, out};
+        io_uring_files_update update{};
+        update.offset = 0;
+        update.fds = reinterpret_cast<uintptr_t>(fds);
+        return reg(IORING_REGISTER_FILES_UPDATE, &update, 2) == 2;
+    }
+
+    bool registerBuffers(const ChunkBuffers& bufs) {
+        std::vector<iovec> iov(bufs.count());
+        for (unsigned i = 0; i < bufs.count(); ++i) iov[i] = {bufs[i], bufs.chunkSize()};
+        return reg(IORING_REGISTER_BUFFERS, iov.data(), bufs.count()) == 0;
+    }
+
+    void unregisterBuffers() { reg(IORING_UNREGISTER_BUFFERS, nullptr, 0); }
+
+private:
+    void* map(size_t len, uint64_t off) {
+        void* p = ::mmap(nullptr, len, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_, static_cast<off_t>(off));
+        return p == MAP_FAILED ? nullptr : p;
+    }
+
+    int reg(unsigned op, const void* arg, unsigned n) {
+        return static_cast<int>(::syscall(__NR_io_uring_register, fd_, op, arg, n));
+    }
+
+    bool supportsOpcodes() {
+        constexpr unsigned OPS = 64;
+        std::vector<unsigned char> mem(sizeof(io_uring_probe) + OPS * sizeof(io_uring_probe_op), 0);
+        auto* probe = reinterpret_cast<io_uring_probe*>(mem.data());
+        if (reg(IORING_REGISTER_PROBE, probe, OPS) != 0) return false;
+        for (unsigned op : {IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED, IORING_OP_WRITE_FIXED,
+                            IORING_OP_ASYNC_CANCEL}) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED)) return false;
+        }
+        return true;
+    }
+
+    int fd_ = -1;
+    void* sq_ = nullptr;
+    void* cq_ = nullptr;
+    size_t sqLen_ = 0, cqLen_ = 0, sqesLen_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    unsigned* sqHead_ = nullptr;
+    unsigned* sqTail_ = nullptr;
+    unsigned* sqArray_ = nullptr;
+    unsigned sqMask_ = 0, sqEntries_ = 0;
+    unsigned* cqHead_ = nullptr;
+    unsigned* cqTail_ = nullptr;
+    unsigned cqMask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+    unsigned tail_ = 0;      ///< Local SQ tail, published by submitAndWait.
+    unsigned pending_ = 0;   ///< Entries queued but not yet taken by the kernel.
+    bool fixedFiles_ = false;
+};
+
+/// @brief 1 = io_uring works, 0 = it doesn't, -1 = not probed yet.
+std::atomic<int> g_uringState{-1};
+
+/// @brief The calling thread's ring, or null once io_uring is known not to work.
+Uring* threadRing() {
+    thread_local std::unique_ptr<Uring> ring;
+    if (ring) return ring.get();
+    if (g_uringState.load(std::memory_order_relaxed) == 0) return nullptr;
+
+    auto fresh = std::make_unique<Uring>();
+    const bool ok = fresh->open();
+    g_uringState.store(ok ? 1 : 0, std::memory_order_relaxed);
+    if (ok) ring = std::move(fresh);
+    return ring.get();
+}
+
+constexpr uint64_t WAKE_TAG    = UINT64_MAX;       ///< The read parked on the cancel eventfd.
+constexpr uint64_t CONTROL_TAG = UINT64_MAX - 1;   ///< Cancel requests.
+
+/**
+ * @brief The io_uring copy loop.
+ *
+ * Each buffer is Free, Reading or Writing; a finished read turns straight into
+ * the write of the same bytes at the matching destination offset, so up to
+ * depth reads and depth writes are in flight and complete in any order. Short
+ * transfers are resubmitted for the remainder. A read of an eventfd that the
+ * cancel token's callback writes sits in the ring next to the transfers, so a
+ * cancel completes the wait at once however slow the device is; on cancel or
+ * error every in-flight request is cancelled and the loop runs until all have
+ * completed, since the kernel owns their buffers until then.
+ */
+StreamCopyResult uringCopy(Uring& ring, int inFd, int outFd, const StreamCopy& job, const Plan& plan,
+                           const ChunkBuffers& bufs) {
+    enum class State : uint8_t { Free, Reading, Writing };
+    struct Chunk {
+        State state = State::Free;
+        uint64_t pos = 0;     ///< Offset within the copied range.
+        size_t len = 0;       ///< Source bytes held.
+        size_t target = 0;    ///< Bytes the current request has to move in total.
+        size_t done = 0;
+    };
+    std::vector<Chunk> chunks(bufs.count());
+
+    const bool fixedFiles = ring.setFiles(inFd, outFd);
+    const bool fixedBufs = ring.registerBuffers(bufs);
+
+    StreamCopyResult result;
+    uint64_t next = 0;
+    unsigned inFlight = 0;
+    bool stopping = false;
+
+    // Declared before the callback so it outlives any write the callback makes.
+    struct FdGuard {
+        int fd;
+        ~FdGuard() { if (fd >= 0) ::close(fd); }
+    } wake{::eventfd(0, EFD_CLOEXEC)};
+    uint64_t wakeValue = 0;
+    bool wakeArmed = false;
+    CancellationCallback wakeOnCancel(plan.cancel, [fd = wake.fd] {
+        if (fd < 0) return;
+        const uint64_t one = 1;
+        [[maybe_unused]] const ssize_t n = ::write(fd, &one, sizeof(one));
+    });
+
+    auto submitTransfer = [&](unsigned i) {
+        Chunk& c = chunks[i];
+        const bool reading = c.state == State::Reading;
+        io_uring_sqe* e = ring.sqe();
+        if (fixedBufs) {
+            e->opcode = reading ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+            e->buf_index = static_cast<uint16_t>(i);
+        } else {
+            e->opcode = reading ? IORING_OP_READ : IORING_OP_WRITE;
+        }
+        if (fixedFiles) {
+            e->fd = reading ? 0 : 1;
+            e->flags = IOSQE_FIXED_FILE;
+        } else {
+            e->fd = reading ? inFd : outFd;
+        }
+        e->addr = reinterpret_cast<uintptr_t>(bufs[i] + c.done);
+        e->len = static_cast<uint32_t>(c.target - c.done);
+        e->off = (reading ? job.srcOffset : job.dstOffset) + c.pos + c.done;
+        e->user_data = i;
+    };
+
+    auto stop = [&](std::error_code ec) {
+        if (stopping) return;
+        stopping = true;
+        result.error = ec;
+        for (unsigned i = 0; i < chunks.size(); ++i) {
+            if (chunks[i].state == State::Free) continue;
+            io_uring_sqe* e = ring.sqe();
+            e->opcode = IORING_OP_ASYNC_CANCEL;
+            e->addr = i;
+            e->user_data = CONTROL_TAG;
+        }
+    };
+
+    auto complete = [&](const io_uring_cqe& cqe) {
+        if (cqe.user_data == WAKE_TAG) { wakeArmed = false; return; }
+        if (cqe.user_data == CONTROL_TAG) return;
+
+        const unsigned i = static_cast<unsigned>(cqe.user_data);
+        Chunk& c = chunks[i];
+        auto release = [&] { c.state = State::Free; --inFlight; };
+
+        if (cqe.res == -EINTR || cqe.res == -EAGAIN) {
+            if (stopping) release(); else submitTransfer(i);
+            return;
+        }
+        if (cqe.res <= 0) {
+            release();
+            stop(cqe.res < 0 ? errnoCode(-cqe.res) : std::make_error_code(std::errc::io_error));
+            return;
+        }
+        c.done += static_cast<size_t>(cqe.res);
+        if (c.done < c.target) {
+            if (stopping) release(); else submitTransfer(i);
+            return;
+        }
+        if (c.state == State::Reading && !stopping) {
+            c.target = plan.padded(c.len);
+            std::memset(bufs[i] + c.len, 0, c.target - c.len);
+            c.state = State::Writing;
+            c.done = 0;
+            submitTransfer(i);
+            return;
+        }
+        if (c.state == State::Writing) {
+            plan.credit(c.len);
+            result.bytes += c.len;
+        }
+        release();
+    };
+
+    for (;;) {
+        if (!stopping && cancelled(plan)) stop(std::make_error_code(std::errc::operation_canceled));
+
+        for (unsigned i = 0; !stopping && next < plan.total && i < chunks.size(); ++i) {
+            Chunk& c = chunks[i];
+            if (c.state != State::Free) continue;
+            c = Chunk{State::Reading, next, static_cast<size_t>(std::min<uint64_t>(plan.chunk, plan.total - next)), 0, 0};
+            c.target = c.len;
+            next += c.len;
+            ++inFlight;
+            submitTransfer(i);
+        }
+        if (inFlight == 0) break;
+
+        if (!wakeArmed && !stopping && wake.fd >= 0) {
+            io_uring_sqe* e = ring.sqe();
+            e->opcode = IORING_OP_READ;
+            e->fd = wake.fd;
+            e->addr = reinterpret_cast<uintptr_t>(&wakeValue);
+            e->len = sizeof(wakeValue);
+            e->user_data = WAKE_TAG;
+            wakeArmed = true;
+        }
+        if (const int err = ring.submitAndWait(1); err < 0 && err != -EAGAIN && err != -EBUSY)
+            stop(errnoCode(-err));
+        ring.reap(complete);
+    }
+
+    // Retire the wake read before its buffer goes and the ring's next user
+    // can mistake its completion.
+    while (wakeArmed) {
+        io_uring_sqe* e = ring.sqe();
+        e->opcode = IORING_OP_ASYNC_CANCEL;
+        e->addr = WAKE_TAG;
+        e->user_data = CONTROL_TAG;
+        ring.submitAndWait(1);
+        ring.reap(complete);
+    }
+
+    if (fixedBufs) ring.unregisterBuffers();
+    if (fixedFiles) ring.setFiles(-1, -1);
+    return result;
+}
+
+// ─── Thread fallback ─────────────────────────────────────────────────────────
+
+/**
+ * @brief Copy loop for kernels without io_uring: a reader thread fills free
+ *        buffers in order while the calling thread writes the filled ones.
+ */
+StreamCopyResult threadCopy(int inFd, int outFd, const StreamCopy& job, const Plan& plan, const ChunkBuffers& bufs) {
+    struct Filled { unsigned index; uint64_t pos; size_t len; };
+
+    std::mutex m;
+    std::condition_variable cv;
+    CancellationCallback wakeOnCancel(plan.cancel, [&] {
+        std::lock_guard<std::mutex> lock(m);
+        cv.notify_all();
+    });
+    std::vector<unsigned> freeList;
+    std::deque<Filled> filled;
+    bool readerDone = false;
+    bool stop = false;
+    std::error_code readError;
+    for (unsigned i = 0; i < bufs.count(); ++i) freeList.push_back(i);
+
+    std::thread reader([&] {
+        for (uint64_t pos = 0; pos < plan.total;) {
+            unsigned i;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [&] { return stop || !freeList.empty(); });
+                if (stop) break;
+                i = freeList.back();
+                freeList.pop_back();
+            }
+            const size_t len = static_cast<size_t>(std::min<uint64_t>(plan.chunk, plan.total - pos));
+            std::error_code ec;
+            const bool ok = readFully(inFd, bufs[i], len, job.srcOffset + pos, ec);
+            std::lock_guard<std::mutex> lock(m);
+            if (!ok) { readError = ec; break; }
+            filled.push_back({i, pos, len});
+            cv.notify_all();
+            pos += len;
+        }
+        std::lock_guard<std::mutex> lock(m);
+        readerDone = true;
+        cv.notify_all();
+    });
+
+    StreamCopyResult result;
+    for (;;) {
+        Filled f;
+        {
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [&] { return readerDone || !filled.empty() || cancelled(plan); });
+            if (cancelled(plan)) {
+                result.error = std::make_error_code(std::errc::operation_canceled);
+                break;
+            }
+            if (filled.empty()) {
+                if (!readerDone) continue;
+                result.error = readError;
+                break;
+            }
+            f = filled.front();
+            filled.pop_front();
+        }
+        const size_t out = plan.padded(f.len);
+        std::memset(bufs[f.index] + f.len, 0, out - f.len);
+        std::error_code ec;
+        if (!writeFully(outFd, bufs[f.index], out, job.dstOffset + f.pos, ec)) {
+            result.error = ec;
+            break;
+        }
+        plan.credit(f.len);
+        result.bytes += f.len;
+
+        std::lock_guard<std::mutex> lock(m);
+        freeList.push_back(f.index);
+        cv.notify_all();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m);
+        stop = true;
+        cv.notify_all();
+    }
+    reader.join();
+    return result;
+}
+
+} // namespace
+
+StreamCopyResult copyStream(int inFd, int outFd, const StreamCopy& job) {
+    StreamCopyResult result;
+    Plan plan;
+    if (!planCopy(inFd, job, plan, result.error)) return result;
+    if (cancelled(plan)) {
+        result.error = std::make_error_code(std::errc::operation_canceled);
+        return result;
+    }
+    if (plan.total == 0) return result;
+
+    // One chunk: nothing to overlap, so skip the engine and the big buffers.
+    if (plan.total <= plan.chunk) {
+        ChunkBuffers buf(1, plan.padded(static_cast<size_t>(plan.total)), plan.align);
+        if (!buf) result.error = std::make_error_code(std::errc::not_enough_memory);
+        else if (copyChunk(inFd, outFd, job, plan, buf[0], 0, static_cast<size_t>(plan.total), result.error))
+            result.bytes = plan.total;
+        return result;
+    }
+
+    ChunkBuffers bufs(plan.chunks, plan.chunk, plan.align);
+    if (!bufs) {
+        result.error = std::make_error_code(std::errc::not_enough_memory);
+        return result;
+    }
+    if (Uring* ring = threadRing()) return uringCopy(*ring, inFd, outFd, job, plan, bufs);
+    return threadCopy(inFd, outFd, job, plan, bufs);
+}
+
+const char* asyncIoBackend() {
+    return threadRing() ? "io_uring" : "threads";
+}
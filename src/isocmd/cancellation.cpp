@@ -0,0 +1,195 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+// C / System Headers
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+// Project Headers
+#include "../cancellation.h"
+
+namespace {
+
+// Guards every node's children/callbacks and every callback's state. Never
+// held while a node is freed or a callback runs.
+std::mutex& treeMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Signalled as callbacks finish, for destructors waiting on a running one.
+std::condition_variable& callbackFinished() {
+    static std::condition_variable cv;
+    return cv;
+}
+
+CancellationSource& rootSource() {
+    static CancellationSource root;
+    return root;
+}
+
+struct CurrentOperation {
+    std::mutex mutex;
+    CancellationSource source{rootSource().token()};
+};
+
+CurrentOperation& currentOperation() {
+    static CurrentOperation op;
+    return op;
+}
+
+std::atomic<int> g_signalFd{-1};
+
+} // namespace
+
+CancellationNode::~CancellationNode() {
+    if (!parent) return;
+    std::lock_guard<std::mutex> lock(treeMutex());
+    std::erase(parent->children, this);
+}
+
+const std::atomic<bool>& CancellationToken::neverCancelled() noexcept {
+    static const std::atomic<bool> never{false};
+    return never;
+}
+
+CancellationSource::CancellationSource()
+    : node_(std::make_shared<CancellationNode>()) {}
+
+CancellationSource::CancellationSource(const CancellationToken& parent)
+    : node_(std::make_shared<CancellationNode>()) {
+    if (!parent.node_) return;
+    std::lock_guard<std::mutex> lock(treeMutex());
+    node_->parent = parent.node_;
+    if (parent.node_->flag.load(std::memory_order_relaxed))
+        node_->flag.store(true, std::memory_order_release);
+    else
+        parent.node_->children.push_back(node_.get());
+}
+
+void CancellationSource::cancel() {
+    std::vector<CancellationCallback*> due;
+    {
+        std::lock_guard<std::mutex> lock(treeMutex());
+        // A set flag means the whole subtree is already cancelled: children
+        // registered later were born cancelled and never linked.
+        std::vector<CancellationNode*> pending{node_.get()};
+        while (!pending.empty()) {
+            CancellationNode* node = pending.back();
+            pending.pop_back();
+            if (node->flag.load(std::memory_order_relaxed)) continue;
+
+            node->flag.store(true, std::memory_order_release);
+            node->flag.notify_all();
+            for (CancellationCallback* cb : node->callbacks) {
+                cb->state_ = CancellationCallback::State::Running;
+                due.push_back(cb);
+            }
+            node->callbacks.clear();
+            pending.insert(pending.end(), node->children.begin(), node->children.end());
+        }
+    }
+
+    // A Running callback's destructor blocks until it is marked Done, so each
+    // one stays valid up to that store and must not be touched after it.
+    for (CancellationCallback* cb : due) {
+        cb->fn_();
+        {
+            std::lock_guard<std::mutex> lock(treeMutex());
+            cb->state_ = CancellationCallback::State::Done;
+        }
+        callbackFinished().notify_all();
+    }
+}
+
+void CancellationCallback::attach(const CancellationToken& token) {
+    if (!token.node_) return;
+    {
+        std::lock_guard<std::mutex> lock(treeMutex());
+        if (!token.node_->flag.load(std::memory_order_relaxed)) {
+            node_ = token.node_;
+            node_->callbacks.push_back(this);
+            state_ = State::Registered;
+            return;
+        }
+    }
+    state_ = State::Done;
+    fn_();
+}
+
+CancellationCallback::~CancellationCallback() {
+    std::shared_ptr<CancellationNode> node;
+    {
+        std::unique_lock<std::mutex> lock(treeMutex());
+        if (state_ == State::Registered)
+            std::erase(node_->callbacks, this);
+        else if (state_ == State::Running)
+            callbackFinished().wait(lock, [this] { return state_ != State::Running; });
+        node = std::move(node_);
+    }
+}
+
+namespace Cancellation {
+
+    CancellationToken process() {
+        return rootSource().token();
+    }
+
+    void shutdown() {
+        rootSource().cancel();
+    }
+
+    CancellationToken beginOperation() {
+        CancellationSource next(rootSource().token());
+        CurrentOperation& op = currentOperation();
+        std::lock_guard<std::mutex> lock(op.mutex);
+        op.source = next;
+        return next.token();
+    }
+
+    CancellationToken operation() {
+        CurrentOperation& op = currentOperation();
+        std::lock_guard<std::mutex> lock(op.mutex);
+        return op.source.token();
+    }
+
+    void cancelOperation() {
+        CancellationSource current = [] {
+            CurrentOperation& op = currentOperation();
+            std::lock_guard<std::mutex> lock(op.mutex);
+            return op.source;
+        }();
+        current.cancel();
+    }
+
+    void requestFromSignal() noexcept {
+        const int fd = g_signalFd.load(std::memory_order_relaxed);
+        if (fd < 0) return;
+        const uint64_t one = 1;
+        [[maybe_unused]] const ssize_t n = ::write(fd, &one, sizeof(one));
+    }
+
+    void installSignalRelay() {
+        static std::once_flag once;
+        std::call_once(once, [] {
+            const int fd = ::eventfd(0, EFD_CLOEXEC);
+            if (fd < 0) return;
+            std::thread([fd] {
+                for (;;) {
+                    uint64_t requests = 0;
+                    const ssize_t n = ::read(fd, &requests, sizeof(requests));
+                    if (n == static_cast<ssize_t>(sizeof(requests))) cancelOperation();
+                    else if (n < 0 && errno != EINTR) return;
+                }
+            }).detach();
+            g_signalFd.store(fd, std::memory_order_release);
+        });
+    }
+}
@@ -3,15 +3,22 @@
 // C++ Standard Library Headers
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <string>
-#include <vector>
+
+// C / System Headers
+#include <fcntl.h>
+#include <unistd.h>
 
 // Project Headers
+#include "../asyncIo.h"
+#include "../cancellation.h"
 #include "../ccd.h"
-#include "../state.h"
+#include "../mdf.h"
+#include "../sectorStrip.h"
 
 namespace fs = std::filesystem;
 
@@ -47,101 +54,58 @@ namespace fs = std::filesystem;
 */
 
 
-bool convertMdfToIso(const std::string& mdfPath, const std::string& isoPath, std::atomic<size_t>* completedBytes) {
-    if (GlobalState::g_operationCancelled.load()) {
-        GlobalState::g_operationCancelled.store(true);
-        return false;
-    }
-
-    std::ifstream mdfFile(mdfPath, std::ios::binary);
-    if (!mdfFile.is_open()) {
-        return false;
-    }
-
-    mdfFile.seekg(32768);
-    char buf[12];
-    if (!mdfFile.read(buf, 8) || std::memcmp("CD001", buf + 1, 5) == 0) {
-        return false;
-    }
-
-    if (GlobalState::g_operationCancelled.load()) {
-        GlobalState::g_operationCancelled.store(true);
+bool convertMdfToIso(const std::string& mdfPath, const std::string& isoPath, std::atomic<size_t>* completedBytes,
+                     const CancellationToken& cancel) {
+    if (cancel.cancelled()) {
         return false;
     }
 
-    std::ofstream isoFile(isoPath, std::ios::binary);
-    if (!isoFile.is_open()) {
-        return false;
-    }
-
-    size_t seek_ecc = 0, sector_size = 0, seek_head = 0, sector_data = 0;
-
-    mdfFile.seekg(0);
-    if (!mdfFile.read(buf, 12)) {
-        return false;
-    }
-
-    if (std::memcmp("\x00\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x00", buf, 12) == 0) {
-        mdfFile.seekg(2352);
-        if (!mdfFile.read(buf, 12)) {
+    MdfTypeInfo mdfInfo;
+    {
+        std::ifstream mdfFile(mdfPath, std::ios::binary);
+        if (!mdfFile.is_open()) {
             return false;
         }
-        if (std::memcmp("\x00\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x00", buf, 12) == 0) {
-            seek_ecc = 288;
-            sector_size = 2352;
-            sector_data = 2048;
-            seek_head = 16;
-        } else {
-            seek_ecc = 384;
-            sector_size = 2448;
-            sector_data = 2048;
-            seek_head = 16;
-        }
-    } else {
-        seek_head = 0;
-        sector_size = 2448;
-        seek_ecc = 96;
-        sector_data = 2352;
-    }
-
-    mdfFile.seekg(0, std::ios::end);
-    size_t source_length = static_cast<size_t>(mdfFile.tellg()) / sector_size;
-    mdfFile.seekg(0, std::ios::beg);
-
-    std::vector<char> sectorBuffer(sector_data);
-
-    while (source_length > 0) {
-        if (GlobalState::g_operationCancelled.load()) {
-            isoFile.close();
-            fs::remove(isoPath);
-            GlobalState::g_operationCancelled.store(true);
-            return false;
-        }
-
-        mdfFile.seekg(static_cast<std::streamoff>(seek_head), std::ios::cur);
-
-        if (!mdfFile.read(sectorBuffer.data(), sector_data)) {
-            return false;
-        }
-
-        mdfFile.seekg(static_cast<std::streamoff>(seek_ecc), std::ios::cur);
 
-        if (GlobalState::g_operationCancelled.load()) {
-            isoFile.close();
-            fs::remove(isoPath);
-            GlobalState::g_operationCancelled.store(true);
+        mdfFile.seekg(32768);
+        char buf[8];
+        if (!mdfFile.read(buf, 8) || std::memcmp("CD001", buf + 1, 5) == 0) {
             return false;
         }
 
-        if (!isoFile.write(sectorBuffer.data(), sector_data)) {
+        if (!mdfInfo.determineMdfType(mdfFile)) {
             return false;
         }
+    }
 
-        if (completedBytes) {
-            completedBytes->fetch_add(sector_data, std::memory_order_relaxed);
-        }
+    if (cancel.cancelled()) {
+        return false;
+    }
 
-        --source_length;
+    const int in = ::open(mdfPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return false;
+    }
+    const int out = ::open(isoPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    SectorStrip job;
+    job.layout = {static_cast<uint32_t>(mdfInfo.sector_size),
+                  static_cast<uint32_t>(mdfInfo.seek_head),
+                  static_cast<uint32_t>(mdfInfo.sector_data)};
+    job.completedBytes = completedBytes;
+    job.cancel = cancel;
+    const SectorStripResult stripped = stripSectorStream(in, out, job);
+
+    ::close(in);
+    const bool closed = ::close(out) == 0;
+    if (!stripped || !closed) {
+        fs::remove(isoPath);
+        return false;
     }
 
     return true;
@@ -174,64 +138,65 @@ bool convertMdfToIso(const std::string& mdfPath, const std::string& isoPath, std
  ***************************************************************************/
 
 
-bool convertCcdToIso(const std::string& ccdPath, const std::string& isoPath, std::atomic<size_t>* completedBytes) {
-    if (GlobalState::g_operationCancelled.load()) {
-        GlobalState::g_operationCancelled.store(true);
+bool convertCcdToIso(const std::string& ccdPath, const std::string& isoPath, std::atomic<size_t>* completedBytes,
+                     const CancellationToken& cancel) {
+    if (cancel.cancelled()) {
         return false;
     }
 
-    std::ifstream ccdFile(ccdPath, std::ios::binary);
-    if (!ccdFile) return false;
-    std::ofstream isoFile(isoPath, std::ios::binary);
-    if (!isoFile) return false;
-
-    CcdSector sector;
-
-    while (ccdFile.read(reinterpret_cast<char*>(&sector), sizeof(CcdSector))) {
-        if (GlobalState::g_operationCancelled.load()) {
-            isoFile.close();
-            fs::remove(isoPath);
-            GlobalState::g_operationCancelled.store(true);
-            return false;
-        }
-        size_t bytesWritten = 0;
-
-        switch (sector.sectheader.header.mode) {
-            case 1: {
-                isoFile.write(reinterpret_cast<char*>(sector.content.mode1.data), DATA_SIZE);
-                bytesWritten = DATA_SIZE;
-                break;
-            }
-            case 2: {
-                isoFile.write(reinterpret_cast<char*>(sector.content.mode2.data), DATA_SIZE);
-                bytesWritten = DATA_SIZE;
-                break;
-            }
-            case 0xe2:
-                return true;
-            default:
-                return false;
-        }
-        if (GlobalState::g_operationCancelled.load()) {
-            isoFile.close();
-            fs::remove(isoPath);
-            GlobalState::g_operationCancelled.store(true);
-            return false;
-        }
-        if (!isoFile || bytesWritten != DATA_SIZE) {
-            return false;
+    const int in = ::open(ccdPath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        return false;
+    }
+    const int out = ::open(isoPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // Each run of same-mode sectors is stripped in bulk; the run ends at a
+    // mode change, the 0xe2 lead-out marker, or the last whole sector.
+    SectorStrip job;
+    job.completedBytes = completedBytes;
+    job.cancel = cancel;
+
+    bool ok = true;
+    for (;;) {
+        uint8_t mode = 0;
+        std::error_code ec;
+        if (!readFully(in, reinterpret_cast<char*>(&mode), 1,
+                       job.srcOffset + sizeof(CcdSectheaderSyn) + offsetof(CcdSectheaderHeader, mode), ec)) {
+            break;
         }
-        if (completedBytes) {
-            completedBytes->fetch_add(bytesWritten, std::memory_order_relaxed);
+
+        if (mode == 1) {
+            job.layout = {sizeof(CcdSector), sizeof(CcdSectheader), DATA_SIZE};
+        } else if (mode == 2) {
+            job.layout = {sizeof(CcdSector), sizeof(CcdSectheader) + 8, DATA_SIZE};
+        } else {
+            ok = mode == 0xe2;
+            break;
         }
-        if (GlobalState::g_operationCancelled.load()) {
-            isoFile.close();
-            fs::remove(isoPath);
-            GlobalState::g_operationCancelled.store(true);
-            return false;
+        job.modeByte = mode;
+
+        const SectorStripResult stripped = stripSectorStream(in, out, job);
+        if (!stripped) {
+            ok = false;
+            break;
         }
+        if (stripped.sectors == 0) break;
+        job.srcOffset += stripped.sectors * sizeof(CcdSector);
+        job.dstOffset += stripped.bytes;
+    }
 
+    ::close(in);
+    const bool closed = ::close(out) == 0;
+    if (!ok || !closed || cancel.cancelled()) {
+        fs::remove(isoPath);
+        return false;
     }
+
     return true;
 }
 
@@ -258,9 +223,9 @@ bool convertCcdToIso(const std::string& ccdPath, const std::string& isoPath, std
 */
 
 
-bool convertNrgToIso(const std::string& inputFile, const std::string& outputFile, std::atomic<size_t>* completedBytes) {
-    if (GlobalState::g_operationCancelled.load()) {
-        GlobalState::g_operationCancelled.store(true);
+bool convertNrgToIso(const std::string& inputFile, const std::string& outputFile, std::atomic<size_t>* completedBytes,
+                     const CancellationToken& cancel) {
+    if (cancel.cancelled()) {
         return false;
     }
 
@@ -281,55 +246,35 @@ bool convertNrgToIso(const std::string& inputFile, const std::string& outputFile
         return false;
     }
 
-    nrgFile.clear();
-    nrgFile.seekg(307200, std::ios::beg);
+    nrgFile.close();
 
-    if (GlobalState::g_operationCancelled.load()) {
-        GlobalState::g_operationCancelled.store(true);
+    if (cancel.cancelled()) {
         return false;
     }
 
-    std::ofstream isoFile(outputFile, std::ios::binary);
-    if (!isoFile) {
+    const int in = ::open(inputFile.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
         return false;
     }
-
-    constexpr size_t BUFFER_SIZE = 1024 * 1024;
-    std::vector<char> buffer(BUFFER_SIZE);
-
-    while (nrgFile) {
-        if (GlobalState::g_operationCancelled.load()) {
-            isoFile.close();
-            fs::remove(outputFile);
-            GlobalState::g_operationCancelled.store(true);
-            return false;
-        }
-
-        nrgFile.read(buffer.data(), BUFFER_SIZE);
-        std::streamsize bytesRead = nrgFile.gcount();
-
-        if (bytesRead > 0) {
-            if (GlobalState::g_operationCancelled.load()) {
-                isoFile.close();
-                fs::remove(outputFile);
-                GlobalState::g_operationCancelled.store(true);
-                return false;
-            }
-
-            if (!isoFile.write(buffer.data(), bytesRead)) {
-                isoFile.close();
-                fs::remove(outputFile);
-                return false;
-            }
-
-            if (completedBytes) {
-                completedBytes->fetch_add(bytesRead, std::memory_order_relaxed);
-            }
-        }
-
-        if (nrgFile.eof() || nrgFile.fail()) {
-            break;
-        }
+    const int out = ::open(outputFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (out < 0) {
+        ::close(in);
+        return false;
+    }
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    // Everything past the 300 KiB Nero header is the ISO track.
+    StreamCopy job;
+    job.srcOffset = 307200;
+    job.completedBytes = completedBytes;
+    job.cancel = cancel;
+    const StreamCopyResult copied = copyStream(in, out, job);
+
+    ::close(in);
+    const bool closed = ::close(out) == 0;
+    if (!copied || !closed) {
+        fs::remove(outputFile);
+        return false;
     }
 
     return true;
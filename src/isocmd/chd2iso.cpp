@@ -3,26 +3,613 @@
 // C++ Standard Library Headers
 #include <algorithm>
 #include <atomic>
+#include <condition_variable>
 #include <cstddef>
 #include <cstring>
 #include <filesystem>
-#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <string>
+#include <system_error>
 #include <thread>
+#include <unordered_map>
 #include <vector>
 
 // C / System Headers
 #include <fcntl.h>
-#include <sys/mman.h>
 #include <stdint.h>
 #include <unistd.h>
 
 // Project Headers
+#include "../asyncIo.h"
+#include "../cancellation.h"
 #include "../chd.h"
+#include "../concurrency.h"
+#include "../cpuTopology.h"
+#include "../sectorStrip.h"
 #include "../state.h"
 
 namespace fs = std::filesystem;
 
+void toLowerInPlace(std::string& str);
+
+namespace {
+
+// --- Parent chains ---
+
+// A child of a child of ... deeper than this is treated as a broken chain.
+constexpr size_t MAX_CHAIN_DEPTH = 8;
+
+bool allZero(const uint8_t* bytes, size_t len) {
+    return std::all_of(bytes, bytes + len, [](uint8_t b) { return b == 0; });
+}
+
+uint32_t readBe32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+/// @brief The checksums a CHD is known by, and those of its parent if it has one.
+struct ChdIdentity {
+    uint8_t md5[CHD_MD5_BYTES]{}, parentMd5[CHD_MD5_BYTES]{};
+    uint8_t sha1[CHD_SHA1_BYTES]{}, parentSha1[CHD_SHA1_BYTES]{};
+    bool hasParent = false;
+};
+
+/**
+ * @brief Reads @p path's identity from its on-disk header (layouts in chd.h).
+ *
+ * chd_open() refuses a child without its parent, and this libchdr's
+ * chd_read_header() validates through a partly uninitialised handle, so it
+ * can reject good files.
+ */
+bool readChdIdentity(const std::string& path, ChdIdentity& id) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    uint8_t raw[124];
+    std::error_code ec;
+    const bool read = readFully(fd, reinterpret_cast<char*>(raw), sizeof(raw), 0, ec);
+    ::close(fd);
+    if (!read || std::memcmp(raw, "MComprHD", 8) != 0) return false;
+
+    const uint32_t version = readBe32(raw + 12);
+    const bool flaggedParent = (readBe32(raw + 16) & CHDFLAGS_HAS_PARENT) != 0;
+    switch (version) {
+    case 1: case 2: case 3:
+        std::memcpy(id.md5, raw + 44, CHD_MD5_BYTES);
+        std::memcpy(id.parentMd5, raw + 60, CHD_MD5_BYTES);
+        if (version == 3) {
+            std::memcpy(id.sha1, raw + 80, CHD_SHA1_BYTES);
+            std::memcpy(id.parentSha1, raw + 100, CHD_SHA1_BYTES);
+        }
+        id.hasParent = flaggedParent;
+        return true;
+    case 4:
+        std::memcpy(id.sha1, raw + 48, CHD_SHA1_BYTES);
+        std::memcpy(id.parentSha1, raw + 68, CHD_SHA1_BYTES);
+        id.hasParent = flaggedParent;
+        return true;
+    case 5:
+        std::memcpy(id.sha1, raw + 84, CHD_SHA1_BYTES);
+        std::memcpy(id.parentSha1, raw + 104, CHD_SHA1_BYTES);
+        id.hasParent = !allZero(id.parentSha1, CHD_SHA1_BYTES);
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// @brief True if @p candidate is the parent @p child was made against, by
+///        the same checksums libchdr checks when the two are opened together.
+bool isParentOf(const ChdIdentity& candidate, const ChdIdentity& child) {
+    if (!allZero(child.parentSha1, CHD_SHA1_BYTES))
+        return std::memcmp(candidate.sha1, child.parentSha1, CHD_SHA1_BYTES) == 0;
+    if (!allZero(child.parentMd5, CHD_MD5_BYTES))
+        return std::memcmp(candidate.md5, child.parentMd5, CHD_MD5_BYTES) == 0;
+    return false;
+}
+
+/**
+ * @brief Looks for the parent of @p childPath among the .chd files of the
+ *        child's own folder, then of each chd_parent_search_path folder.
+ *
+ * Files already in @p chain are skipped, so a corrupt image can't name itself
+ * or its child as its parent.
+ *
+ * @return The parent's path, or an empty string if none matches.
+ */
+std::string findParentChd(const std::string& childPath, const ChdIdentity& child,
+                          const std::vector<std::string>& chain) {
+    const fs::path childDir = fs::path(childPath).parent_path();
+    std::vector<fs::path> dirs{childDir.empty() ? fs::path(".") : childDir};
+    dirs.insert(dirs.end(), GlobalState::chdParentSearchDirs.begin(), GlobalState::chdParentSearchDirs.end());
+
+    for (const fs::path& dir : dirs) {
+        std::error_code ec;
+        fs::directory_iterator it(dir, fs::directory_options::skip_permission_denied, ec);
+        for (; !ec && it != fs::directory_iterator(); it.increment(ec)) {
+            std::string ext = it->path().extension().string();
+            toLowerInPlace(ext);
+            if (ext != ".chd" || !it->is_regular_file(ec)) continue;
+
+            const std::string candidate = it->path().string();
+            const bool inChain = std::any_of(chain.begin(), chain.end(), [&](const std::string& p) {
+                std::error_code eqEc;
+                return fs::equivalent(candidate, p, eqEc);
+            });
+            if (inChain) continue;
+
+            ChdIdentity id;
+            if (readChdIdentity(candidate, id) && isParentOf(id, child))
+                return candidate;
+        }
+    }
+    return {};
+}
+
+/// @brief Paths of @p chdPath and the parents it depends on, child first.
+///        Empty if a parent can't be found or a header can't be read.
+std::vector<std::string> findChdChain(const std::string& chdPath) {
+    std::vector<std::string> chain{chdPath};
+    for (;;) {
+        ChdIdentity id;
+        if (!readChdIdentity(chain.back(), id)) return {};
+        if (!id.hasParent) return chain;
+        if (chain.size() == MAX_CHAIN_DEPTH) return {};
+
+        std::string parent = findParentChd(chain.back(), id, chain);
+        if (parent.empty()) return {};
+        chain.push_back(std::move(parent));
+    }
+}
+
+/// @brief A CHD opened against its parents. The child handle owns the chain:
+///        chd_close() closes a handle's parent along with it.
+struct ChdChain {
+    ChdFilePtr file;
+    std::vector<chd_file*> levels;   // levels[0] is file.get(), then its parent, ...
+};
+
+/// @brief Opens the files of @p paths (child first) from the root parent down.
+bool openChdChain(const std::vector<std::string>& paths, ChdChain& chain) {
+    std::vector<chd_file*> levels(paths.size());
+    chd_file* parent = nullptr;
+    for (size_t i = paths.size(); i-- > 0;) {
+        chd_file* raw = nullptr;
+        // The parent now belongs to the new handle. A failed open may already
+        // have closed it, so it is dropped rather than closed again.
+        if (chd_open(paths[i].c_str(), CHD_OPEN_READ, parent, &raw) != CHDERR_NONE)
+            return false;
+        levels[i] = parent = raw;
+    }
+    chain.file.reset(parent);
+    chain.levels = std::move(levels);
+    return true;
+}
+
+/// @brief Raw bytes per sector of a CD image CHD, judged by the hunk size
+///        (a hunk holds whole sectors); 0 if it fits none.
+uint32_t rawSectorSizeFor(uint32_t hunkBytes) {
+    if (hunkBytes % 2448 == 0) return 2448;
+    if (hunkBytes % 2352 == 0) return 2352;
+    if (hunkBytes % 2048 == 0) return 2048;
+    return 0;
+}
+
+// --- Hunk cache ---
+
+/**
+ * @brief Decoded hunks shared by the decode workers of one conversion.
+ *
+ * Entries are keyed by chain level and hunk number and evicted least
+ * recently used first once they exceed the chd_hunk_cache_mb budget. A hunk
+ * asked for while another worker is decoding it is waited for rather than
+ * decoded twice. A budget of 0 disables the cache.
+ */
+class ChdHunkCache {
+public:
+    using Hunk = std::shared_ptr<const std::vector<uint8_t>>;
+
+    explicit ChdHunkCache(size_t capacityBytes) : capacity_(capacityBytes) {}
+
+    /// @brief The hunk, from the cache or from @p decode (nullptr on error).
+    template <typename Decode>
+    Hunk get(uint32_t level, uint32_t hunk, Decode&& decode) {
+        if (capacity_ == 0) return decode();
+
+        const uint64_t key = (static_cast<uint64_t>(level) << 32) | hunk;
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (auto it = entries_.find(key); it != entries_.end(); it = entries_.find(key)) {
+            if (it->second.data) {
+                lru_.splice(lru_.begin(), lru_, it->second.position);
+                return it->second.data;
+            }
+            decoded_.wait(lock);   // Another worker is decoding it
+        }
+        entries_.emplace(key, Entry{});
+        lock.unlock();
+
+        Hunk data;
+        try {
+            data = decode();
+        } catch (const std::bad_alloc&) {}
+
+        lock.lock();
+        auto it = entries_.find(key);
+        if (!data) {
+            entries_.erase(it);   // Waiters retry, and fail the same way
+        } else {
+            it->second.data = data;
+            lru_.push_front(key);
+            it->second.position = lru_.begin();
+            bytes_ += data->size();
+            evict();
+        }
+        lock.unlock();
+        decoded_.notify_all();
+        return data;
+    }
+
+private:
+    struct Entry {
+        Hunk data;                              // Null while being decoded
+        std::list<uint64_t>::iterator position;
+    };
+
+    void evict() {
+        while (bytes_ > capacity_ && lru_.size() > 1) {
+            auto it = entries_.find(lru_.back());
+            bytes_ -= it->second.data->size();
+            entries_.erase(it);
+            lru_.pop_back();
+        }
+    }
+
+    const size_t capacity_;
+    std::mutex mutex_;
+    std::condition_variable decoded_;
+    std::unordered_map<uint64_t, Entry> entries_;
+    std::list<uint64_t> lru_;   // Most recently used first
+    size_t bytes_ = 0;
+};
+
+// --- Reference-resolving reader ---
+
+// Entry types of a decoded V5 map (header.rawmap, 12 bytes per hunk). libchdr
+// expands the RLE and relative forms while loading the map, so only these
+// two reference kinds remain; chd.h doesn't export the names.
+constexpr uint8_t V5_MAP_SELF   = 5;   // Same data as an earlier hunk; offset = its number
+constexpr uint8_t V5_MAP_PARENT = 6;   // Data from the parent; offset = parent unit
+
+uint64_t readBe48(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 6; ++i) v = (v << 8) | p[i];
+    return v;
+}
+
+/// @brief Hunks of @p header that a later hunk of the same file refers back to.
+std::vector<bool> selfReferencedHunks(const chd_header& header) {
+    std::vector<bool> referenced(header.totalhunks, false);
+    if (header.version < 5 || !header.rawmap || header.mapentrybytes != 12) return referenced;
+    for (uint32_t hunk = 0; hunk < header.totalhunks; ++hunk) {
+        const uint8_t* entry = header.rawmap + static_cast<size_t>(hunk) * 12;
+        const uint64_t target = readBe48(entry + 4);
+        if (entry[0] == V5_MAP_SELF && target < hunk) referenced[target] = true;
+    }
+    return referenced;
+}
+
+/**
+ * @brief Reads the hunks of a chain's child for one decode worker.
+ *
+ * chd_read() resolves a hunk that repeats an earlier one, or that comes from
+ * the parent, by decoding the source hunk again, every time, through one
+ * handle's single-hunk buffer. This reader looks those references up in the
+ * map itself and fetches their sources through the shared ChdHunkCache, so
+ * a duplicated hunk is decoded once per conversion and a parent hunk once no
+ * matter how many child hunks, or workers, need it. Ordinary hunks nothing
+ * refers to bypass the cache.
+ */
+class ChdChainReader {
+public:
+    ChdChainReader(const std::vector<chd_file*>& levels, ChdHunkCache& cache,
+                   const std::vector<bool>& selfReferenced)
+        : levels_(levels), cache_(cache), selfReferenced_(selfReferenced) {
+        for (chd_file* level : levels_) headers_.push_back(chd_get_header(level));
+        buffer_.resize(headers_[0]->hunkbytes);
+    }
+
+    /// @brief The bytes of child hunk @p hunk, valid until the next call;
+    ///        nullptr on error.
+    const uint8_t* read(uint32_t hunk) {
+        held_.reset();
+        if (lookup(0, hunk).kind == Ref::Data && !selfReferenced_[hunk])
+            return chd_read(levels_[0], hunk, buffer_.data()) == CHDERR_NONE ? buffer_.data() : nullptr;
+        held_ = shared(0, hunk);
+        return held_ ? held_->data() : nullptr;
+    }
+
+private:
+    struct Ref {
+        enum Kind { Data, Self, Parent } kind;
+        uint64_t value;   // Self: source hunk. Parent: byte offset in the parent
+    };
+
+    Ref lookup(size_t level, uint32_t hunk) const {
+        const chd_header& header = *headers_[level];
+        const bool parentOpen = level + 1 < levels_.size();
+        if (header.version < 5 || !header.rawmap) return {Ref::Data, 0};
+
+        const uint8_t* entry = header.rawmap + static_cast<size_t>(hunk) * header.mapentrybytes;
+        if (header.mapentrybytes == 12) {
+            const uint64_t offset = readBe48(entry + 4);
+            if (entry[0] == V5_MAP_SELF) return {Ref::Self, offset};
+            if (entry[0] == V5_MAP_PARENT && parentOpen) return {Ref::Parent, offset * header.unitbytes};
+        } else if (header.mapentrybytes == 4 && parentOpen && readBe32(entry) == 0) {
+            // Uncompressed map: an unstored hunk is the parent's hunk at the same place
+            return {Ref::Parent, static_cast<uint64_t>(hunk) * header.hunkbytes};
+        }
+        return {Ref::Data, 0};
+    }
+
+    ChdHunkCache::Hunk shared(size_t level, uint32_t hunk) {
+        return cache_.get(static_cast<uint32_t>(level), hunk, [&] { return decode(level, hunk); });
+    }
+
+    /// @brief Decodes, or resolves, one hunk of any level. References only
+    ///        lead to earlier hunks or to the parent, so resolution always
+    ///        ends and never waits on a hunk this worker is decoding.
+    ChdHunkCache::Hunk decode(size_t level, uint32_t hunk) {
+        const chd_header& header = *headers_[level];
+        if (hunk >= header.totalhunks) return nullptr;
+
+        const Ref ref = lookup(level, hunk);
+        if (ref.kind == Ref::Self) {
+            if (ref.value >= hunk) return nullptr;
+            return shared(level, static_cast<uint32_t>(ref.value));
+        }
+
+        auto data = std::make_shared<std::vector<uint8_t>>(header.hunkbytes);
+        if (ref.kind == Ref::Data)
+            return chd_read(levels_[level], hunk, data->data()) == CHDERR_NONE ? data : nullptr;
+
+        // Parent data starts on a unit, not necessarily a hunk, boundary: an
+        // aligned reference is one parent hunk, any other straddles two.
+        const uint32_t parentHunkBytes = headers_[level + 1]->hunkbytes;
+        if (ref.value % parentHunkBytes == 0 && parentHunkBytes == header.hunkbytes)
+            return shared(level + 1, static_cast<uint32_t>(ref.value / parentHunkBytes));
+
+        uint64_t pos = ref.value;
+        for (size_t done = 0; done < header.hunkbytes;) {
+            const uint64_t parentHunk = pos / parentHunkBytes;
+            const size_t skip = static_cast<size_t>(pos % parentHunkBytes);
+            const size_t len = std::min<size_t>(parentHunkBytes - skip, header.hunkbytes - done);
+            if (parentHunk > UINT32_MAX) return nullptr;
+
+            ChdHunkCache::Hunk source = shared(level + 1, static_cast<uint32_t>(parentHunk));
+            if (!source) return nullptr;
+            std::memcpy(data->data() + done, source->data() + skip, len);
+            done += len;
+            pos += len;
+        }
+        return data;
+    }
+
+    const std::vector<chd_file*>& levels_;
+    std::vector<const chd_header*> headers_;
+    ChdHunkCache& cache_;
+    const std::vector<bool>& selfReferenced_;
+
+    std::vector<uint8_t> buffer_;   // Ordinary child hunks
+    ChdHunkCache::Hunk held_;       // Keeps a cached hunk alive until the next read
+};
+
+// --- Pipeline ---
+
+/**
+ * @brief Hunk pipeline behind convertChdToIso().
+ *
+ * The image is cut into blocks of whole hunks (~4 MiB of user data). Decode
+ * workers claim blocks in order from a shared counter, each through its own
+ * chain of chd_file handles (libchdr handles are not thread-safe) and a
+ * ChdChainReader over the pipeline's shared hunk cache, and strip them into
+ * one of @c slots pooled buffers; block @c b lives in slot <tt>b % slots</tt>.
+ * The converting thread writes finished blocks out in order with one pwrite
+ * each and frees their slots, so at most @c slots blocks are ever decoded
+ * ahead of the file. When its next block isn't ready it decodes one itself.
+ *
+ * Helpers are plain threads, not pool tasks: the conversion already holds a
+ * pool worker, and blocking it until more pool tasks start and finish would
+ * deadlock once every worker is such a conversion.
+ */
+class ChdHunkPipeline {
+public:
+    static constexpr size_t BLOCK_BYTES = 4 * 1024 * 1024;
+
+    // Written-but-unflushed output kept in the page cache before the older
+    // half is waited on and dropped (see writeBehind()).
+    static constexpr uint64_t WRITE_BEHIND = 64ull * 1024 * 1024;
+
+    ChdHunkPipeline(const std::vector<std::string>& chainPaths, const chd_header& header, const SectorLayout& layout,
+                    unsigned workers, std::atomic<size_t>* completedBytes, const CancellationToken& cancel)
+        : chainPaths_(chainPaths), layout_(layout), cancel_(cancel), completedBytes_(completedBytes),
+          totalHunks_(header.totalhunks), sectorsPerHunk_(header.hunkbytes / layout.sectorSize),
+          userDataPerHunk_(sectorsPerHunk_ * layout.dataLen),
+          hunksPerBlock_(static_cast<uint32_t>(std::max<size_t>(1, BLOCK_BYTES / userDataPerHunk_))),
+          totalBlocks_((totalHunks_ + hunksPerBlock_ - 1) / hunksPerBlock_),
+          slots_(std::max(2u, std::min(2 * workers, totalBlocks_))),
+          selfReferenced_(selfReferencedHunks(header)),
+          cache_(GlobalState::chdHunkCacheBytes),
+          slotBlock_(slots_, NO_BLOCK) {}
+
+    /// @brief Runs the conversion into @p out, decoding on this thread through
+    ///        @p chain and on up to @p helpers threads. False on error or
+    ///        cancellation.
+    bool run(const ChdChain& chain, int out, size_t helpers) {
+        buffers_.reserve(slots_);
+        for (unsigned i = 0; i < slots_; ++i) {
+            buffers_.emplace_back(static_cast<size_t>(hunksPerBlock_) * userDataPerHunk_);
+            if (!buffers_.back()) return false;
+        }
+
+        std::vector<std::thread> threads;
+        threads.reserve(helpers);
+        try {
+            for (size_t i = 0; i < helpers; ++i) threads.emplace_back([this] { helper(); });
+        } catch (const std::system_error&) {
+            // Fewer helpers only means more blocks decoded on this thread
+        }
+
+        ChdChainReader reader(chain.levels, cache_, selfReferenced_);
+        bool ok = true;
+        while (ok) {
+            uint32_t block = NO_BLOCK;
+            bool write = false;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                for (;;) {
+                    if (failed_ || cancel_.cancelled() || written_ == totalBlocks_) break;
+                    if (slotBlock_[written_ % slots_] == written_) { block = written_; write = true; break; }
+                    if (claimable()) { block = next_++; break; }
+                    ready_.wait(lock);
+                }
+            }
+            if (block == NO_BLOCK) break;
+            ok = write ? writeBlock(out, block) : decodeBlock(reader, block);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ok = ok && !failed_ && written_ == totalBlocks_ && !cancel_.cancelled();
+            failed_ = !ok;
+        }
+        ready_.notify_all();
+        for (auto& t : threads) t.join();
+        return ok;
+    }
+
+private:
+    static constexpr uint32_t NO_BLOCK = UINT32_MAX;
+
+    bool claimable() const { return next_ < totalBlocks_ && next_ < written_ + slots_; }
+
+    void fail() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            failed_ = true;
+        }
+        ready_.notify_all();
+    }
+
+    /// @brief Helper thread: decodes blocks through its own handles until none are left.
+    void helper() {
+        ChdChain chain;
+        if (!openChdChain(chainPaths_, chain))
+            return;   // The converting thread decodes what this one would have
+        ChdChainReader reader(chain.levels, cache_, selfReferenced_);
+
+        for (;;) {
+            uint32_t block;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                ready_.wait(lock, [this] {
+                    return failed_ || cancel_.cancelled() || next_ >= totalBlocks_ || claimable();
+                });
+                if (failed_ || cancel_.cancelled() || next_ >= totalBlocks_) return;
+                block = next_++;
+            }
+            if (!decodeBlock(reader, block)) return;
+        }
+    }
+
+    bool decodeBlock(ChdChainReader& reader, uint32_t block) {
+        const uint32_t first = block * hunksPerBlock_;
+        const uint32_t last = std::min(first + hunksPerBlock_, totalHunks_);
+        char* dst = buffers_[block % slots_].data();
+
+        for (uint32_t hunk = first; hunk < last; ++hunk) {
+            const uint8_t* data = cancel_.cancelled() ? nullptr : reader.read(hunk);
+            if (!data) {
+                fail();
+                return false;
+            }
+            dst += stripSectors(layout_, reinterpret_cast<const char*>(data), sectorsPerHunk_, dst);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slotBlock_[block % slots_] = block;
+        }
+        ready_.notify_all();
+        return true;
+    }
+
+    bool writeBlock(int out, uint32_t block) {
+        const uint32_t first = block * hunksPerBlock_;
+        const uint32_t hunks = std::min(hunksPerBlock_, totalHunks_ - first);
+        const size_t bytes = static_cast<size_t>(hunks) * userDataPerHunk_;
+        const uint64_t offset = static_cast<uint64_t>(first) * userDataPerHunk_;
+
+        std::error_code ec;
+        if (!writeFully(out, buffers_[block % slots_].data(), bytes, offset, ec)) {
+            fail();
+            return false;
+        }
+        if (completedBytes_) completedBytes_->fetch_add(bytes, std::memory_order_relaxed);
+        writeBehind(out, offset + bytes);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            slotBlock_[block % slots_] = NO_BLOCK;
+            ++written_;
+        }
+        ready_.notify_all();
+        return true;
+    }
+
+    /// @brief Starts writeback of each new WRITE_BEHIND of output, then waits
+    ///        for the previous one and drops it from the page cache, so a
+    ///        multi-GiB conversion holds two windows of dirty pages, not all of them.
+    void writeBehind(int out, uint64_t end) {
+        if (end - flushed_ < WRITE_BEHIND) return;
+        ::sync_file_range(out, static_cast<off_t>(flushed_), static_cast<off_t>(end - flushed_),
+                          SYNC_FILE_RANGE_WRITE);
+        if (flushed_ > dropped_) {
+            const off_t from = static_cast<off_t>(dropped_), len = static_cast<off_t>(flushed_ - dropped_);
+            ::sync_file_range(out, from, len,
+                              SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+            ::posix_fadvise(out, from, len, POSIX_FADV_DONTNEED);
+            dropped_ = flushed_;
+        }
+        flushed_ = end;
+    }
+
+    const std::vector<std::string>& chainPaths_;
+    const SectorLayout layout_;
+    const CancellationToken cancel_;
+    std::atomic<size_t>* const completedBytes_;
+
+    const uint32_t totalHunks_, sectorsPerHunk_, userDataPerHunk_;
+    const uint32_t hunksPerBlock_, totalBlocks_;
+    const unsigned slots_;
+
+    const std::vector<bool> selfReferenced_;
+    ChdHunkCache cache_;
+    std::vector<NodeLocalBuffer> buffers_;
+
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    uint32_t next_ = 0;                  // Next block to decode
+    uint32_t written_ = 0;               // Blocks written; the window starts here
+    std::vector<uint32_t> slotBlock_;    // Decoded block held by each slot
+    bool failed_ = false;
+
+    uint64_t flushed_ = 0, dropped_ = 0; // Writer thread only
+};
+
+} // namespace
+
 /**
  * @brief Converts a CHD (Compressed Hunks of Data) file to a raw ISO image.
  *
@@ -36,50 +623,51 @@ namespace fs = std::filesystem;
  * data offset for this specific image. This unified approach works for both
  * legacy CHDs (created with older tools) and modern CHDs (e.g., from chdman).
  *
- * Conversion strategy is chosen based on the output ISO size:
- * - For files ≤ 1 GiB: a single‑threaded, buffered write is used (low overhead).
- * - For files > 1 GiB: two threads decompress hunks in parallel, writing directly
- *   into a memory‑mapped output file. This provides a significant speedup without
- *   saturating all CPU cores, leaving system resources available for other tasks.
+ * A child CHD is opened against its parent, found by checksum among the .chd
+ * files of its own folder and then of the chd_parent_search_path folders
+ * (and likewise the parent's parent). Hunks that repeat an earlier hunk or
+ * come from a parent are decoded once and shared through an LRU cache of
+ * chd_hunk_cache_mb (see ChdChainReader).
+ *
+ * Hunks are decompressed by K workers — this thread plus up to K-1 helper
+ * threads, K = min(cores, thread_cap_for_convert2iso) —
+ * and written out in order in ~4 MiB pwrites (see ChdHunkPipeline). At most
+ * 2K blocks are decoded ahead of the file, and written output is flushed and
+ * dropped from the page cache as it goes, so memory stays bounded whatever
+ * the image size.
  *
  * @param chdPath        Path to the source CHD file.
  * @param isoPath        Path where the output ISO file will be written.
  * @param completedBytes Optional atomic counter updated with the number of
  *                       user data bytes written so far. Useful for progress
  *                       reporting. May be nullptr.
+ * @param cancel         Token checked before every hunk.
  *
- * @return true if conversion completed successfully, false on error or cancellation.
- *
- * @note The conversion can be cancelled by setting GlobalState::g_operationCancelled to true.
- *       If cancelled, the partial ISO file is removed.
+ * @return true if conversion completed successfully, false on error or
+ *         cancellation, or if a required parent CHD wasn't found.
  *
- * @note For large files, two independent CHD handles are opened internally;
- *       the original handle is used only for header reading and offset detection.
+ * @note If cancelled, the partial ISO file is removed.
  *
- * @see GlobalState::g_operationCancelled Global cancellation flag.
+ * @note Each helper thread opens its own CHD handles; this thread decodes
+ *       through the ones opened for header reading and offset detection.
  */
 bool convertChdToIso(const std::string& chdPath, const std::string& isoPath,
-                     std::atomic<size_t>* completedBytes) {
-    if (GlobalState::g_operationCancelled.load()) return false;
+                     std::atomic<size_t>* completedBytes,
+                     const CancellationToken& cancel) {
+    if (cancel.cancelled()) return false;
 
-    chd_file* rawChd = nullptr;
-    if (chd_open(chdPath.c_str(), CHD_OPEN_READ, nullptr, &rawChd) != CHDERR_NONE)
-        return false;
-    ChdFilePtr chd(rawChd);
-    const chd_header* header = chd_get_header(chd.get());
+    const std::vector<std::string> chainPaths = findChdChain(chdPath);
+    ChdChain chain;
+    if (chainPaths.empty() || !openChdChain(chainPaths, chain)) return false;
+    const chd_header* header = chd_get_header(chain.file.get());
     if (!header) return false;
 
     uint32_t hunkSize = header->hunkbytes;
-    uint32_t rawSectorSize = 0;
-    if (hunkSize % 2448 == 0)      rawSectorSize = 2448;
-    else if (hunkSize % 2352 == 0) rawSectorSize = 2352;
-    else if (hunkSize % 2048 == 0) rawSectorSize = 2048;
-    else return false;
+    const uint32_t rawSectorSize = rawSectorSizeFor(hunkSize);
+    if (rawSectorSize == 0) return false;
 
     uint32_t sectorsPerHunk = hunkSize / rawSectorSize;
     const uint32_t userDataSize = 2048;
-    const uint32_t userDataPerHunk = sectorsPerHunk * userDataSize;
-    const uint64_t totalUserData = static_cast<uint64_t>(header->totalhunks) * userDataPerHunk;
 
     // --- Detect user data offset ---
     uint32_t userDataOffset = 0;
@@ -90,7 +678,7 @@ bool convertChdToIso(const std::string& chdPath, const std::string& isoPath,
         uint32_t sectorIndex = 16 % sectorsPerHunk;
         std::vector<uint8_t> testBuf(hunkSize);
         bool detected = false;
-        if (chd_read(chd.get(), targetHunk, testBuf.data()) == CHDERR_NONE) {
+        if (chd_read(chain.file.get(), targetHunk, testBuf.data()) == CHDERR_NONE) {
             const uint8_t* s16 = testBuf.data() + (sectorIndex * rawSectorSize);
             std::vector<uint32_t> candidates;
             if (rawSectorSize == 2352) {
@@ -111,112 +699,40 @@ bool convertChdToIso(const std::string& chdPath, const std::string& isoPath,
         }
     }
 
-    // --- Decide strategy based on file size ---
-    const uint64_t ONE_GB = 1ULL << 30;
-    if (totalUserData <= ONE_GB) {
-        // ---------- SINGLE‑THREADED (original path) ----------
-        std::ofstream isoFile(isoPath, std::ios::binary);
-        if (!isoFile.is_open()) return false;
-        std::vector<char> writeBuf(1024 * 1024);
-        isoFile.rdbuf()->pubsetbuf(writeBuf.data(), writeBuf.size());
-
-        std::vector<uint8_t> hunkBuffer(hunkSize);
-        std::vector<uint8_t> hunkUserData(userDataPerHunk);
+    const SectorLayout layout{rawSectorSize, userDataOffset, userDataSize};
 
-        for (uint32_t hunk = 0; hunk < header->totalhunks; ++hunk) {
-            if (GlobalState::g_operationCancelled.load()) {
-                isoFile.close();
-                fs::remove(isoPath);
-                return false;
-            }
-            if (chd_read(chd.get(), hunk, hunkBuffer.data()) != CHDERR_NONE)
-                return false;
+    // --- Decode on this thread plus up to K-1 helper threads ---
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t workers = std::min(cores, std::max<size_t>(1, GlobalConcurrency::CONV_THREAD_CAP));
 
-            uint8_t* dest = hunkUserData.data();
-            for (uint32_t s = 0; s < sectorsPerHunk; ++s) {
-                const uint8_t* src = hunkBuffer.data() + (s * rawSectorSize);
-                std::memcpy(dest, src + userDataOffset, userDataSize);
-                dest += userDataSize;
-            }
-            isoFile.write(reinterpret_cast<const char*>(hunkUserData.data()), userDataPerHunk);
-            if (completedBytes)
-                completedBytes->fetch_add(userDataPerHunk, std::memory_order_relaxed);
-        }
-        return true;
-    }
+    const int out = ::open(isoPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (out < 0) return false;
 
-    // ---------- LARGE FILE (>1GB) : 2‑THREAD PARALLEL with memory mapping ----------
-    // Pre‑allocate and memory‑map the output file
-    int fd = ::open(isoPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
-    if (fd == -1) return false;
-    if (::ftruncate(fd, totalUserData) == -1) {
-        ::close(fd);
+    ChdHunkPipeline pipeline(chainPaths, *header, layout, static_cast<unsigned>(workers), completedBytes, cancel);
+    const bool converted = pipeline.run(chain, out, workers - 1);
+    const bool closed = ::close(out) == 0;
+    if (!converted || !closed) {
         fs::remove(isoPath);
         return false;
     }
-    void* mapped = ::mmap(nullptr, totalUserData, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    ::close(fd);
-    if (mapped == MAP_FAILED) {
-        fs::remove(isoPath);
-        return false;
-    }
-    auto unmap = [&] { ::munmap(mapped, totalUserData); };
-
-    const unsigned int numThreads = 2;
-    std::vector<std::thread> threads;
-    std::atomic<bool> errorOccurred = false;
-
-    uint32_t totalHunks = header->totalhunks;
-    uint32_t hunksPerThread = (totalHunks + numThreads - 1) / numThreads;
-
-    for (unsigned int t = 0; t < numThreads; ++t) {
-        uint32_t start = t * hunksPerThread;
-        uint32_t end = std::min(start + hunksPerThread, totalHunks);
-        if (start >= end) continue;
-
-        threads.emplace_back([&, start, end]() {
-            // Each thread opens its own CHD handle (libchdr is not thread‑safe otherwise)
-            chd_file* threadChd = nullptr;
-            if (chd_open(chdPath.c_str(), CHD_OPEN_READ, nullptr, &threadChd) != CHDERR_NONE) {
-                errorOccurred = true;
-                return;
-            }
-            ChdFilePtr threadChdPtr(threadChd);
-
-            std::vector<uint8_t> hunkBuffer(hunkSize);
-            std::vector<uint8_t> userDataBuffer(userDataPerHunk);
-
-            for (uint32_t hunk = start; hunk < end && !errorOccurred; ++hunk) {
-                if (GlobalState::g_operationCancelled.load()) {
-                    errorOccurred = true;
-                    return;
-                }
-                if (chd_read(threadChd, hunk, hunkBuffer.data()) != CHDERR_NONE) {
-                    errorOccurred = true;
-                    return;
-                }
-                uint8_t* dest = userDataBuffer.data();
-                for (uint32_t s = 0; s < sectorsPerHunk; ++s) {
-                    const uint8_t* src = hunkBuffer.data() + (s * rawSectorSize);
-                    std::memcpy(dest, src + userDataOffset, userDataSize);
-                    dest += userDataSize;
-                }
-                uint64_t offset = static_cast<uint64_t>(hunk) * userDataPerHunk;
-                std::memcpy(static_cast<char*>(mapped) + offset, userDataBuffer.data(), userDataPerHunk);
-                if (completedBytes)
-                    completedBytes->fetch_add(userDataPerHunk, std::memory_order_relaxed);
-            }
-        });
-    }
+    return true;
+}
 
-    for (auto& th : threads) {
-        if (th.joinable()) th.join();
-    }
-    unmap();
+/**
+ * @brief Bytes of ISO that convertChdToIso() writes for @p chdPath: 2048 per
+ *        sector. The CHD is opened against its parents the same way, so a
+ *        child CHD is sized as long as its parent can be found.
+ *
+ * @return The size, or 0 if the CHD can't be opened or isn't a CD image.
+ */
+uint64_t chdIsoSize(const std::string& chdPath) {
+    const std::vector<std::string> chainPaths = findChdChain(chdPath);
+    ChdChain chain;
+    if (chainPaths.empty() || !openChdChain(chainPaths, chain)) return 0;
+    const chd_header* header = chd_get_header(chain.file.get());
+    if (!header) return 0;
 
-    if (errorOccurred || GlobalState::g_operationCancelled.load()) {
-        fs::remove(isoPath);
-        return false;
-    }
-    return true;
+    const uint32_t rawSectorSize = rawSectorSizeFor(header->hunkbytes);
+    if (rawSectorSize == 0) return 0;
+    return static_cast<uint64_t>(header->totalhunks) * (header->hunkbytes / rawSectorSize) * 2048;
 }
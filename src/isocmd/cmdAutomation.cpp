@@ -6,9 +6,12 @@
 #include <cstddef>
 #include <filesystem>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 // C / System Headers
@@ -17,6 +20,8 @@
 #include <unistd.h>
 
 // Project Headers
+#include "../cancellation.h"
+#include "../dirWalker.h"
 #include "../inputHandling.h"
 #include "../mount.h"
 #include "../state.h"
@@ -77,44 +82,47 @@ static void errMsg(std::string_view msg) {
 /**
  * @brief Recursively scan @p dir for ISO files up to @p maxDepth levels deep.
  *
+ * Subdirectories are spread across the thread pool by a ParallelDirWalker.
  * Results are inserted into @p isoFiles (canonical paths).
  * Symlinks are skipped.  Filesystem errors emit a warning but do not abort.
  *
  * @param dir          Directory to scan.
  * @param maxDepth     Maximum descent depth; -1 = unlimited, 0 = surface only.
- * @param currentDepth Current recursion depth (caller passes 0).
  * @param isoFiles     Accumulator for discovered ISO paths.
  * @param hasErrors    Set to true if any non-fatal error is encountered.
  * @param silentMode   Suppress per-entry warnings when true.
  */
 static void scanDirectoryForISOs(const fs::path& dir,
                                  int maxDepth,
-                                 int currentDepth,
                                  std::unordered_set<std::string>& isoFiles,
                                  bool& hasErrors,
                                  bool silentMode) {
-    try {
-        for (const auto& entry : fs::directory_iterator(dir)) {
-            if (GlobalState::g_operationCancelled.load()) return;
-            if (entry.is_symlink()) continue;
+    DirWalkOptions options;
+    options.maxDepth = maxDepth;
+    options.skipSymlinks = true;
+    options.suffixes = {".iso"};
+    options.cancelled = [cancel = Cancellation::operation()] { return cancel.cancelled(); };
+
+    ParallelDirWalker walker(std::move(options));
+    std::vector<std::vector<std::string>> perWorker(walker.workerCount());
+    std::mutex errorMutex;
+
+    walker.walk({dir.string()},
+        [&](size_t worker, const std::string& parent, std::string_view name) {
+            std::error_code ec;
+            fs::path canonical = fs::canonical(joinDirEntry(parent, name), ec);
+            if (!ec) perWorker[worker].push_back(canonical.string());
+        },
+        [&](const std::string& path, const std::error_code& ec) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            warnMsg(silentMode,
+                    std::string("Error scanning directory: ") + ec.message(),
+                    path);
+            hasErrors = true;
+        });
 
-            if (entry.is_regular_file()) {
-                std::string ext = entry.path().extension().string();
-                std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
-                if (ext == ".iso")
-                    isoFiles.insert(fs::canonical(entry.path()).string());
-            } else if (entry.is_directory() &&
-                       (maxDepth == -1 || currentDepth < maxDepth)) {
-                scanDirectoryForISOs(entry.path(), maxDepth,
-                                     currentDepth + 1,
-                                     isoFiles, hasErrors, silentMode);
-            }
-        }
-    } catch (const fs::filesystem_error& e) {
-        warnMsg(silentMode,
-                std::string("Error scanning directory: ") + e.what(),
-                dir.string());
-        hasErrors = true;
+    for (auto& local : perWorker) {
+        for (auto& path : local) isoFiles.insert(std::move(path));
     }
 }
 
@@ -180,11 +188,13 @@ static int handleMount(const ParsedArgs& args) {
         return 1;
     }
 
+    const CancellationToken cancel = Cancellation::operation();
+
     std::unordered_set<std::string> isoFiles;
     bool hasErrors = false;
 
     for (const auto& rawPath : args.paths) {
-        if (GlobalState::g_operationCancelled.load()) {
+        if (cancel.cancelled()) {
             verboseWarn(args.silentMode, "Operation cancelled by user.");
             return 1;
         }
@@ -221,7 +231,7 @@ static int handleMount(const ParsedArgs& args) {
                             .append(path.string())
                             .append(" (").append(depthDesc).append(")..."));
 
-                scanDirectoryForISOs(path, args.maxDepth, 0,
+                scanDirectoryForISOs(path, args.maxDepth,
                                      isoFiles, hasErrors, args.silentMode);
             } else {
                 warnMsg(args.silentMode,
@@ -235,12 +245,12 @@ static int handleMount(const ParsedArgs& args) {
         }
     }
 
-    if (GlobalState::g_operationCancelled.load()) {
+    if (cancel.cancelled()) {
         verboseWarn(args.silentMode, "Mount operation cancelled by user.");
     }
 
     if (isoFiles.empty()) {
-        if (!GlobalState::g_operationCancelled.load())
+        if (!cancel.cancelled())
             verboseWarn(args.silentMode, "\nNo ISO files found to mount.");
         return hasErrors ? 1 : 0;
     }
@@ -254,8 +264,9 @@ static int handleMount(const ParsedArgs& args) {
 
     std::atomic<size_t> completedTasks{0}, failedTasks{0};
 
+    ResultChannel results;
     mountIsoFiles(std::vector<std::string>(isoFiles.begin(), isoFiles.end()),
-                  &completedTasks, &failedTasks, args.silentMode);
+                  &completedTasks, &failedTasks, args.silentMode, results);
 
     if (!args.silentMode) {
         for (const auto& msg : verboseSets.operationCompleted)    std::cout << msg << "\n";
@@ -278,6 +289,8 @@ static int handleUmount(const ParsedArgs& args) {
         return 1;
     }
 
+    const CancellationToken cancel = Cancellation::operation();
+
     std::unordered_set<std::string> mountPoints;
     bool hasErrors = false;
 
@@ -290,7 +303,7 @@ static int handleUmount(const ParsedArgs& args) {
                     .append(" for ISO mount points (surface scan)..."));
         try {
             for (const auto& entry : fs::directory_iterator(mntPath)) {
-                if (GlobalState::g_operationCancelled.load()) return;
+                if (cancel.cancelled()) return;
                 if (entry.is_directory()) {
                     const std::string name = entry.path().filename().string();
                     if (name.rfind("iso_", 0) == 0)
@@ -309,13 +322,13 @@ static int handleUmount(const ParsedArgs& args) {
 
     if (scanAllMnt) {
         collectFromMnt("/mnt");
-        if (GlobalState::g_operationCancelled.load()) {
+        if (cancel.cancelled()) {
             verboseWarn(args.silentMode, "Operation cancelled by user.");
             return 1;
         }
     } else {
         for (const auto& rawPath : args.paths) {
-            if (GlobalState::g_operationCancelled.load()) {
+            if (cancel.cancelled()) {
                 verboseWarn(args.silentMode, "Operation cancelled by user.");
                 return 1;
             }
@@ -359,12 +372,12 @@ static int handleUmount(const ParsedArgs& args) {
         }
     }
 
-    if (GlobalState::g_operationCancelled.load()) {
+    if (cancel.cancelled()) {
         verboseWarn(args.silentMode, "Umount operation cancelled by user.");
     }
 
     if (mountPoints.empty()) {
-        if (!GlobalState::g_operationCancelled.load())
+        if (!cancel.cancelled())
             verboseWarn(args.silentMode, "\nNo ISO mount points found to unmount.");
         return hasErrors ? 1 : 0;
     }
@@ -378,8 +391,9 @@ static int handleUmount(const ParsedArgs& args) {
 
     std::atomic<size_t> completedTasks{0}, failedTasks{0};
 
+    ResultChannel results;
     unmountISO(std::vector<std::string>(mountPoints.begin(), mountPoints.end()),
-               &completedTasks, &failedTasks, args.silentMode);
+               &completedTasks, &failedTasks, args.silentMode, results);
 
     if (!args.silentMode) {
         for (const auto& msg : verboseSets.operationCompleted)  std::cout << msg << "\n";
@@ -407,7 +421,7 @@ static int handleUmount(const ParsedArgs& args) {
  */
 int handleMountUmountCommands(int argc, char* argv[]) {
     setupSignalHandlerCancellations();
-    GlobalState::g_operationCancelled.store(false);
+    Cancellation::beginOperation();
 
     if (argc < 2) {
         errMsg("No arguments provided.");
@@ -8,7 +8,6 @@
 #include <cctype>
 #include <filesystem>
 #include <fstream>
-#include <mutex>
 #include <string>
 #include <string_view>
 #include <utility>
@@ -19,7 +18,7 @@
 #include <unistd.h>
 
 // Project Headers
-#include "../globalMutexes.h"
+#include "../cancellation.h"
 #include "../convert.h"
 #include "../display.h"
 #include "../state.h"
@@ -42,11 +41,12 @@ void getRealUserId(uid_t& real_uid, gid_t& real_gid, std::string& real_username,
  * @brief Batch converts disk image files (BIN, IMG, MDF, NRG, CHD, CCD, DAA, GBI) to ISO format.
  *
  * Handles per-file validation (existence and basic readability), skips existing outputs,
- * selects the appropriate conversion backend based on mode flags, and aggregates
- * success/failed/skipped messages in a thread-safe manner.
+ * selects the appropriate conversion backend based on mode flags, and pushes
+ * success/failed/skipped messages into @p results.
  *
  * Also updates file ownership for outputs, removes invalid cache entries, and
- * collects successful output paths for later database indexing by the caller.
+ * sends successful output paths through @p results for later database
+ * indexing by the caller.
  */
 void convertToISO(const std::vector<std::string>& imageFiles,
                   const bool& modeMdf,
@@ -56,11 +56,9 @@ void convertToISO(const std::vector<std::string>& imageFiles,
                   std::atomic<size_t>* completedBytes,
                   std::atomic<size_t>* completedTasks,
                   std::atomic<size_t>* failedTasks,
-                  std::vector<std::string>* successfulOutputPaths,
-                  std::mutex* outPathsMutex) {
+                  ResultChannel& results) {
 
     namespace fs = std::filesystem;
-    const size_t BATCH_SIZE = 50;
 
     ConversionThemeStrings themes = getConversionThemeStrings();
 
@@ -68,26 +66,10 @@ void convertToISO(const std::vector<std::string>& imageFiles,
     std::string real_username, real_groupname;
     getRealUserId(real_uid, real_gid, real_username, real_groupname);
 
-    std::vector<std::string> localSuccessMsgs, localFailedMsgs, localSkippedMsgs;
-
-    auto batchInsertMessages = [&]() {
-        std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
-        if (!localSuccessMsgs.empty()) {
-            verboseSets.operationCompleted.insert(localSuccessMsgs.begin(), localSuccessMsgs.end());
-            localSuccessMsgs.clear();
-        }
-        if (!localFailedMsgs.empty()) {
-            verboseSets.operationFailed.insert(localFailedMsgs.begin(), localFailedMsgs.end());
-            localFailedMsgs.clear();
-        }
-        if (!localSkippedMsgs.empty()) {
-            verboseSets.operationSkipped.insert(localSkippedMsgs.begin(), localSkippedMsgs.end());
-            localSkippedMsgs.clear();
-        }
-    };
+    const CancellationToken cancel = Cancellation::operation();
 
     for (const std::string& inputPath : imageFiles) {
-        if (GlobalState::g_operationCancelled.load(std::memory_order_relaxed)) break;
+        if (cancel.cancelled()) break;
 
         auto [directory, fileNameOnly] = extractDirectoryAndFilename(inputPath, "conversions");
 
@@ -107,19 +89,15 @@ void convertToISO(const std::vector<std::string>& imageFiles,
             msg.append(themes.missingLabel).append("Convert2ISO: ")
                .append(themes.errPath).append("'").append(displayPath).append("'")
                .append(themes.missingLabel).append(": Failed → MissingFile.");
-            localFailedMsgs.push_back(std::move(msg));
+            results.failed(std::move(msg));
 
-            {
-                std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
-                auto& cache = modeNrg ? GlobalState::nrgFilesCache :
-                              (modeMdf ? GlobalState::mdfMdsFilesCache :
-                               (modeChd ? GlobalState::chdFilesCache :
-                                (modeDaa ? GlobalState::daaGbiFilesCache : GlobalState::binImgFilesCache)));
-                cache.erase(std::remove(cache.begin(), cache.end(), inputPath), cache.end());
-            }
+            auto& cache = modeNrg ? GlobalState::nrgFilesCache :
+                          (modeMdf ? GlobalState::mdfMdsFilesCache :
+                           (modeChd ? GlobalState::chdFilesCache :
+                            (modeDaa ? GlobalState::daaGbiFilesCache : GlobalState::binImgFilesCache)));
+            cache.erase(inputPath);  // O(1); the display order is pruned lazily
 
             failedTasks->fetch_add(1, std::memory_order_acq_rel);
-            if (localFailedMsgs.size() >= BATCH_SIZE) batchInsertMessages();
             continue;
         }
 
@@ -130,10 +108,9 @@ void convertToISO(const std::vector<std::string>& imageFiles,
             msg.append(themes.errLabel).append("Convert2ISO: ")
                .append(themes.errPath).append("'").append(displayPath).append("'")
                .append(themes.errLabel).append(": Failed → NoAccess.");
-            localFailedMsgs.push_back(std::move(msg));
+            results.failed(std::move(msg));
 
             failedTasks->fetch_add(1, std::memory_order_acq_rel);
-            if (localFailedMsgs.size() >= BATCH_SIZE) batchInsertMessages();
             continue;
         }
 
@@ -154,29 +131,25 @@ void convertToISO(const std::vector<std::string>& imageFiles,
             msg.append(themes.skipLabel).append("Convert2ISO: ")
                .append(themes.skipPath).append("'").append(displayPath).append("'")
                .append(themes.skipLabel).append(": ISOalrExists → Skipped.");
-            localSkippedMsgs.push_back(std::move(msg));
+            results.skipped(std::move(msg));
 
             completedTasks->fetch_add(1, std::memory_order_acq_rel);
-            if (localSkippedMsgs.size() >= BATCH_SIZE) batchInsertMessages();
             continue;
         }
 
-        if (GlobalState::g_operationCancelled.load(std::memory_order_relaxed)) break;
+        if (cancel.cancelled()) break;
 
         bool conversionSuccess = false;
-        if (modeMdf)       conversionSuccess = convertMdfToIso(inputPath, outputPath, completedBytes);
-        else if (modeNrg)  conversionSuccess = convertNrgToIso(inputPath, outputPath, completedBytes);
-        else if (modeChd)  conversionSuccess = convertChdToIso(inputPath, outputPath, completedBytes);
-        else if (modeDaa)  conversionSuccess = convertDaaToIso(inputPath, outputPath, completedBytes);
-        else               conversionSuccess = convertCcdToIso(inputPath, outputPath, completedBytes);
+        if (modeMdf)       conversionSuccess = convertMdfToIso(inputPath, outputPath, completedBytes, cancel);
+        else if (modeNrg)  conversionSuccess = convertNrgToIso(inputPath, outputPath, completedBytes, cancel);
+        else if (modeChd)  conversionSuccess = convertChdToIso(inputPath, outputPath, completedBytes, cancel);
+        else if (modeDaa)  conversionSuccess = convertDaaToIso(inputPath, outputPath, completedBytes, cancel);
+        else               conversionSuccess = convertCcdToIso(inputPath, outputPath, completedBytes, cancel);
 
         if (conversionSuccess) {
             [[maybe_unused]] int ret = chown(outputPath.c_str(), real_uid, real_gid);
 
-            if (successfulOutputPaths && outPathsMutex) {
-                std::lock_guard<std::mutex> lock(*outPathsMutex);
-                successfulOutputPaths->push_back(outputPath); // can't move; needed below
-            }
+            results.outputPath(outputPath); // can't move; needed below
 
             // Determine file type from extension without copying the full filename
             std::string_view fileType = "Image";
@@ -207,26 +180,22 @@ void convertToISO(const std::vector<std::string>& imageFiles,
             msg.append(themes.okLabel).append("Convert2ISO: ")
                .append(themes.okPath).append("'").append(outputPath).append("'")
                .append(themes.okLabel).append(": ").append(fileType).append(" → ISO.");
-            localSuccessMsgs.push_back(std::move(msg));
+            results.completed(std::move(msg));
 
             completedTasks->fetch_add(1, std::memory_order_acq_rel);
-            if (localSuccessMsgs.size() >= BATCH_SIZE) batchInsertMessages();
         } else {
             if (fs::exists(outputPath)) fs::remove(outputPath);
 
-            bool isCancelled = GlobalState::g_operationCancelled.load(std::memory_order_relaxed);
+            bool isCancelled = cancel.cancelled();
             std::string msg;
             msg.reserve(themes.errLabel.size() * 2 + themes.errPath.size() +
                         displayPath.size() + 24);
             msg.append(themes.errLabel).append("Convert2ISO: ")
                .append(themes.errPath).append("'").append(displayPath).append("'")
                .append(themes.errLabel).append(": ").append(isCancelled ? "Cancelled." : "Failed.");
-            localFailedMsgs.push_back(std::move(msg));
+            results.failed(std::move(msg));
 
             failedTasks->fetch_add(1, std::memory_order_acq_rel);
-            if (localFailedMsgs.size() >= BATCH_SIZE) batchInsertMessages();
         }
     }
-
-    batchInsertMessages();
 }
@@ -4,9 +4,7 @@
 #include <atomic>
 #include <cstddef>
 #include <filesystem>
-#include <fstream>
 #include <functional>
-#include <mutex>
 #include <sstream>
 #include <string>
 #include <string_view>
@@ -18,6 +16,7 @@
 // C / System Headers
 #include <errno.h>
 #include <ctype.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -27,6 +26,7 @@
 #include <readline/readline.h>
 
 // Project Headers
+#include "../asyncIo.h"
 #include "../cpMvRm.h"
 #include "../display.h"
 #include "../globalMutexes.h"
@@ -37,6 +37,7 @@
 #include "../state.h"
 #include "../stringManipulation.h"
 #include "../themes.h"
+#include "../threadpool.h"
 #include "../verbose.h"
 
 /**
@@ -373,12 +374,12 @@ namespace fs = std::filesystem;
 void getRealUserId(uid_t& real_uid, gid_t& real_gid, std::string& real_username, std::string& real_groupname);
 
 /**
- * @brief Builds a color‑coded error message, adds it to the reporter,
+ * @brief Builds a color‑coded error message, pushes it to the result channel,
  *        increments failedTasks and sets operationSuccessful = false.
  *
  * Constructs a human-readable error string for the given @p errorType, using
- * the configured verbose theme for colour codes. The message is appended to
- * the batch reporter, the failed-task counter is incremented with acquire-release
+ * the configured verbose theme for colour codes. The message is pushed to
+ * the result channel, the failed-task counter is incremented with acquire-release
  * semantics, and the operation-successful flag is stored as false with release
  * semantics.
  *
@@ -398,7 +399,7 @@ void getRealUserId(uid_t& real_uid, gid_t& real_gid, std::string& real_username,
  *
  * All original colour codes and message templates are preserved exactly.
  *
- * @param ctx         Operation context providing reporter, counters, and success flag.
+ * @param ctx         Operation context providing result channel, counters, and success flag.
  * @param errorType   Category of failure (see detailed list above).
  * @param srcDir      Path view of the source directory.
  * @param srcFile     Filename view of the source file.
@@ -473,7 +474,7 @@ void reportErrorCpMvRm(OperationContext& ctx,
                 .append(vt.reset);
     }
 
-    ctx.reporter.addError(std::move(errorMsg));
+    ctx.results.failed(std::move(errorMsg));
     if (ctx.failedTasks)
         ctx.failedTasks->fetch_add(1, std::memory_order_acq_rel);
     ctx.operationSuccessful.store(false, std::memory_order_release);
@@ -483,68 +484,68 @@ void reportErrorCpMvRm(OperationContext& ctx,
  * @brief Performs a binary file copy with real-time progress tracking and
  *        cancellation support.
  *
- * Uses an 8 MiB buffered stream approach to transfer data between two paths.
- * An atomic counter is updated incrementally so the UI can display progress.
- * The operation can be aborted at any time via GlobalState::g_operationCancelled;
- * if cancelled, the partially‑written destination file is removed.
+ * Hands the transfer to @ref copyStream, which keeps reads of the source and
+ * writes of the destination in flight together (io_uring, or a reader thread
+ * where that is unavailable) instead of alternating between them.
+ * An atomic counter is updated as each chunk lands so the UI can display progress.
+ * The copy can be aborted at any time through @p cancel, which also wakes
+ * waits on in-flight I/O; if cancelled, the partially‑written destination
+ * file is removed.
  *
  * @param src            Source file path.
  * @param dst            Destination file path.
  * @param completedBytes Atomic counter for tracking bytes written (updated with
  *                       memory_order_relaxed).
+ * @param cancel         Token that aborts the copy.
  * @param ec             Error code object to capture system failures.
  *                       Set to operation_canceled on user abort,
  *                       no_such_file_or_directory if the source is missing,
  *                       permission_denied if the destination cannot be opened,
- *                       or io_error on write failures.
+ *                       or the failing read/write's error otherwise.
  * @return True if the copy completed successfully, false if cancelled or failed.
  */
 bool bufferedCopyWithProgress(const fs::path& src, const fs::path& dst,
                               std::atomic<size_t>* completedBytes,
+                              const CancellationToken& cancel,
                               std::error_code& ec) {
-    const size_t bufferSize = 8 * 1024 * 1024;
-    std::vector<char> buffer(bufferSize);
+    if (cancel.cancelled()) return false;
 
-    if (GlobalState::g_operationCancelled.load()) return false;
-
-    std::ifstream input(src, std::ios::binary);
-    if (!input) {
+    const int in = ::open(src.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
         ec = std::make_error_code(std::errc::no_such_file_or_directory);
         return false;
     }
-
-    std::ofstream output(dst, std::ios::binary);
-    if (!output) {
+    const int out = ::open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (out < 0) {
+        ::close(in);
         ec = std::make_error_code(std::errc::permission_denied);
         return false;
     }
+    posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
 
-    while (!GlobalState::g_operationCancelled.load()) {
-        input.read(buffer.data(), buffer.size());
-        std::streamsize bytesRead = input.gcount();
-        if (bytesRead == 0) break;
+    StreamCopy job;
+    job.completedBytes = completedBytes;
+    job.cancel = cancel;
+    const StreamCopyResult copied = copyStream(in, out, job);
 
-        output.write(buffer.data(), bytesRead);
-        if (!output) {
-            ec = std::make_error_code(std::errc::io_error);
-            return false;
-        }
+    ::close(in);
+    const bool closed = ::close(out) == 0;
 
-        completedBytes->fetch_add(bytesRead, std::memory_order_relaxed);
+    if (copied.error == std::errc::operation_canceled) {
+        ec = copied.error;
+        std::error_code removeEc;
+        fs::remove(dst, removeEc);
+        return false;
     }
-
-    if (GlobalState::g_operationCancelled.load()) {
-        ec = std::make_error_code(std::errc::operation_canceled);
-        output.close();
-        fs::remove(dst, ec);
+    if (!copied || !closed) {
+        ec = copied ? std::make_error_code(std::errc::io_error) : copied.error;
         return false;
     }
-
     return true;
 }
 
 /**
- * @brief Logs the final result of a Move or Copy operation to the batch reporter.
+ * @brief Logs the final result of a Move or Copy operation to the result channel.
  *
  * Formats and dispatches either a success message (to the "isos" set) or an
  * error message (to the "errors" set) based on the operation outcome. Updates
@@ -553,10 +554,9 @@ bool bufferedCopyWithProgress(const fs::path& src, const fs::path& dst,
  *   to false.
  * - On success: increments @c completedTasks.
  *
- * Batching is handled automatically by the reporter; no explicit flush call
- * is needed here.
+ * Messages are pushed without locking; the waiting thread collects them.
  *
- * @param ctx              Operation context providing reporter and counters.
+ * @param ctx              Operation context providing result channel and counters.
  * @param success          Whether the operation succeeded at the filesystem level.
  * @param cancelled        Whether the operation was aborted by the user.
  * @param ec               Error code (empty on success).
@@ -590,7 +590,7 @@ static void logOperationResult(OperationContext& ctx,
            .append(errorDetail).append(".")
            .append(UI::Palette::BoldReset);
 
-        ctx.reporter.addError(std::move(msg));
+        ctx.results.failed(std::move(msg));
         if (ctx.failedTasks)
             ctx.failedTasks->fetch_add(1, std::memory_order_acq_rel);
         ctx.operationSuccessful.store(false, std::memory_order_release);
@@ -607,18 +607,17 @@ static void logOperationResult(OperationContext& ctx,
            .append(destFile)
            .append(colors.success_label).append("'.");
 
-        ctx.reporter.addSuccess(std::move(msg));
+        ctx.results.completed(std::move(msg));
         if (ctx.completedTasks)
             ctx.completedTasks->fetch_add(1, std::memory_order_acq_rel);
     }
-    // Batching happens automatically inside reporter.addSuccess/addError
 }
 
 /**
  * @brief Removes a single file from disk and logs the outcome.
  *
- * Attempts to delete the file at @p srcPath. Respects the global cancellation
- * flag; if set, the operation is aborted before touching the filesystem.
+ * Attempts to delete the file at @p srcPath. Respects the batch's cancellation
+ * token; if set, the operation is aborted before touching the filesystem.
  * On success, the file's byte count is added to @p completedBytes and a
  * success message is emitted. On failure, the error is captured and reported.
  *
@@ -642,7 +641,7 @@ void performDeleteOperation(OperationContext& ctx,
     const CpMvRmColors colors = getCpMvRmColors();
     std::string displaySrc = buildDisplaySrc(srcDir, srcFile);
 
-    if (GlobalState::g_operationCancelled.load(std::memory_order_acquire)) {
+    if (ctx.cancel.cancelled()) {
         std::string msg;
         msg.reserve(128 + displaySrc.size());
         msg.append(colors.error_label).append("Error deleting: ")
@@ -651,7 +650,7 @@ void performDeleteOperation(OperationContext& ctx,
            .append(": Cancelled.")
            .append(UI::Palette::BoldReset);
 
-        ctx.reporter.addError(std::move(msg));
+        ctx.results.failed(std::move(msg));
         failedTasks->fetch_add(1, std::memory_order_acq_rel);
         ctx.operationSuccessful.store(false, std::memory_order_release);
         return;
@@ -668,7 +667,7 @@ void performDeleteOperation(OperationContext& ctx,
            .append(UI::Palette::BoldReset).append(colors.success_label).append(".")
            .append(UI::Palette::BoldReset);
 
-        ctx.reporter.addSuccess(std::move(msg));
+        ctx.results.completed(std::move(msg));
         completedTasks->fetch_add(1, std::memory_order_acq_rel);
     } else {
         std::string msg;
@@ -680,7 +679,7 @@ void performDeleteOperation(OperationContext& ctx,
            .append(".")
            .append(UI::Palette::BoldReset);
 
-        ctx.reporter.addError(std::move(msg));
+        ctx.results.failed(std::move(msg));
         failedTasks->fetch_add(1, std::memory_order_acq_rel);
         ctx.operationSuccessful.store(false, std::memory_order_release);
     }
@@ -717,7 +716,7 @@ bool performMoveOperation(OperationContext& ctx,
                           std::atomic<size_t>* completedBytes,
                           std::atomic<size_t>* completedTasks)
 {
-    if (GlobalState::g_operationCancelled.load(std::memory_order_acquire)) {
+    if (ctx.cancel.cancelled()) {
         logOperationResult(ctx, false, true, {}, "moving",
                            srcDir, srcFile, destDirProcessed, destFile);
         return false;
@@ -737,7 +736,7 @@ bool performMoveOperation(OperationContext& ctx,
 
     // Cross‑device fallback
     ec.clear();
-    bool success = bufferedCopyWithProgress(srcPath, destPath, completedBytes, ec);
+    bool success = bufferedCopyWithProgress(srcPath, destPath, completedBytes, ctx.cancel, ec);
     if (success) {
         std::error_code deleteEc;
         if (!fs::remove(srcPath, deleteEc)) {
@@ -754,7 +753,7 @@ bool performMoveOperation(OperationContext& ctx,
                .append(UI::Palette::BoldReset).append(errLabel).append(" - ")
                .append(deleteEc.message()).append(UI::Palette::BoldReset);
 
-            ctx.reporter.addError(std::move(msg));
+            ctx.results.failed(std::move(msg));
             if (completedTasks)
                 completedTasks->fetch_add(1, std::memory_order_acq_rel);
             return true;   // move itself succeeded
@@ -765,7 +764,7 @@ bool performMoveOperation(OperationContext& ctx,
                            srcDir, srcFile, destDirProcessed, destFile);
     } else {
         logOperationResult(ctx, false,
-                           GlobalState::g_operationCancelled.load(std::memory_order_acquire),
+                           ctx.cancel.cancelled(),
                            ec, "moving",
                            srcDir, srcFile, destDirProcessed, destFile);
     }
@@ -797,12 +796,12 @@ bool performMultiDestMoveOperation(OperationContext& ctx,
                                    std::atomic<size_t>* completedBytes)
 {
     std::error_code ec;
-    bool success = bufferedCopyWithProgress(srcPath, destPath, completedBytes, ec);
+    bool success = bufferedCopyWithProgress(srcPath, destPath, completedBytes, ctx.cancel, ec);
     if (success && ctx.changeOwnership)
         ctx.changeOwnership(destPath);
 
     logOperationResult(ctx, success,
-                       GlobalState::g_operationCancelled.load(), ec, "moving",
+                       ctx.cancel.cancelled(), ec, "moving",
                        srcDir, srcFile, destDirProcessed, destFile);
     return success;
 }
@@ -830,37 +829,172 @@ bool performCopyOperation(OperationContext& ctx,
                           std::atomic<size_t>* completedBytes)
 {
     std::error_code ec;
-    bool success = bufferedCopyWithProgress(srcPath, destPath, completedBytes, ec);
+    bool success = bufferedCopyWithProgress(srcPath, destPath, completedBytes, ctx.cancel, ec);
     if (success && ctx.changeOwnership)
         ctx.changeOwnership(destPath);
 
     logOperationResult(ctx, success,
-                       GlobalState::g_operationCancelled.load(), ec, "copying",
+                       ctx.cancel.cancelled(), ec, "copying",
                        srcDir, srcFile, destDirProcessed, destFile);
     return success;
 }
 
+namespace {
+
+/// @brief State shared by the per-file pipelines of one Cp/Mv batch.
+struct TransferBatch {
+    OperationContext& ctx;
+    const std::vector<std::string>& destDirs;
+    const std::unordered_set<std::string>& isoFilesCopySet;
+    bool isMove, isCopy, overwriteExisting;
+    std::atomic<size_t>* completedBytes;
+    std::atomic<size_t>* completedTasks;
+    TaskGroup& checks;      ///< Uncapped: stat and destination checks.
+    TaskGroup& transfers;   ///< Capped at CPMV_THREAD_CAP: the data movement.
+};
+
+} // namespace
+
 /**
- * @brief High-level handler that iterates through ISO files to perform CP, MV, or RM.
+ * @brief Copies or moves the files of one unit to every destination.
+ *
+ * Runs as a @ref PipelineTask: for each file, the existence, same-file and
+ * overwrite checks run as a task of @c batch.checks, the rename or copy as a
+ * task of @c batch.transfers. A file that fails its checks therefore never
+ * waits for a transfer slot, and a slow transfer holds one slot without
+ * delaying the checks of the files behind it. Ownership change and the result
+ * message are the transfer stage's tail; they cost less than another hop.
  *
- * Manages thread‑safe updates to reporting sets and handles ownership changes
- * for newly created files.
+ * The files of a unit share a filename, so they would land on the same
+ * destination path; they run one after another, in order, as they did when
+ * they shared a chunk.
+ *
+ * Display strings come from a per-thread cache (see @ref extractDirectoryAndFilename),
+ * so each stage resolves its own rather than carrying views across a hop.
+ */
+static PipelineTask transferUnit(TransferBatch& batch, std::vector<std::string> unit) {
+    OperationContext& ctx = batch.ctx;
+    const size_t destCount = batch.destDirs.size();
+
+    for (size_t i = 0; i < unit.size(); ++i) {
+        if (i > 0) co_await batch.checks.schedule();
+
+        const std::string& iso = unit[i];
+        if (!batch.isoFilesCopySet.count(iso)) continue;
+
+        const fs::path srcPath(iso);
+        size_t fileSize = 0;
+        std::vector<size_t> targets;   // indices into destDirs that passed the checks
+        {
+            auto [srcDir, srcFile] = extractDirectoryAndFilename(srcPath.native(), "cp_mv_rm");
+            struct stat st;
+            if (::stat(srcPath.c_str(), &st) != 0) {
+                reportErrorCpMvRm(ctx, "missing_file", srcDir, srcFile, "", "", "");
+                continue;
+            }
+            fileSize = st.st_size;
+
+            for (size_t d = 0; d < destCount; ++d) {
+                const std::string& destDirProcessed = batch.destDirs[d];
+                const fs::path destPath = fs::path(destDirProcessed) / srcPath.filename();
+
+                if (fs::absolute(srcPath) == fs::absolute(destPath)) {
+                    std::string op = batch.isMove ? "move" : "copy";
+                    reportErrorCpMvRm(ctx, "same_file", srcDir, srcFile, "", "", op);
+                    continue;
+                }
+
+                if (!fs::exists(srcPath)) {
+                    reportErrorCpMvRm(ctx, "source_missing", srcDir, srcFile, "", "", "");
+                    continue;
+                }
+
+                if (fs::exists(destPath)) {
+                    if (batch.overwriteExisting) {
+                        std::error_code ec;
+                        if (!fs::remove(destPath, ec)) {
+                            reportErrorCpMvRm(ctx, "overwrite_failed", "", "",
+                                              destDirProcessed, ec.message(), "");
+                            continue;
+                        }
+                    } else {
+                        std::string op = batch.isCopy ? "copying" : "moving";
+                        reportErrorCpMvRm(ctx, "file_exists", srcDir, srcFile,
+                                          destDirProcessed, "", op);
+                        continue;
+                    }
+                }
+                targets.push_back(d);
+            }
+        }
+        if (targets.empty()) continue;
+
+        co_await batch.transfers.schedule();
+
+        auto [srcDir, srcFile] = extractDirectoryAndFilename(srcPath.native(), "cp_mv_rm");
+        bool atLeastOneCopySucceeded = false;
+
+        for (size_t d : targets) {
+            const std::string& destDirProcessed = batch.destDirs[d];
+            const fs::path destPath = fs::path(destDirProcessed) / srcPath.filename();
+            auto [_, destFile] = extractDirectoryAndFilename(destPath.native(), "cp_mv_rm");
+
+            bool success = false;
+            if (batch.isMove && destCount > 1) {
+                success = performMultiDestMoveOperation(
+                    ctx, srcPath, destPath, srcDir, srcFile,
+                    destDirProcessed, destFile, batch.completedBytes);
+                if (success) atLeastOneCopySucceeded = true;
+            } else if (batch.isMove) {
+                success = performMoveOperation(
+                    ctx, srcPath, destPath, srcDir, srcFile,
+                    destDirProcessed, destFile, fileSize,
+                    batch.completedBytes, batch.completedTasks);
+            } else { // isCopy
+                success = performCopyOperation(
+                    ctx, srcPath, destPath, srcDir, srcFile,
+                    destDirProcessed, destFile, batch.completedBytes);
+            }
+            if (success) ctx.results.outputPath(destPath.string());
+        }
+
+        // Multi‑dest move cleanup
+        if (batch.isMove && destCount > 1 && atLeastOneCopySucceeded) {
+            std::error_code deleteEc;
+            if (!fs::remove(srcPath, deleteEc)) {
+                reportErrorCpMvRm(ctx, "remove_after_move", srcDir, srcFile, "",
+                                  deleteEc.message(), "");
+            }
+        }
+    }
+}
+
+/**
+ * @brief High-level handler that runs a CP, MV, or RM batch to completion.
+ *
+ * Reports results through @p results and handles ownership changes for newly
+ * created files. Results are collected into verboseSets (and destination
+ * paths into @p outputPaths) by this function while it waits, so it must be
+ * called on the thread that consumes @p results.
  *
  * Processing flow:
  * - Parses semicolon‑separated destination directories from @p userDestDir.
- * - Creates a thread‑local BatchReporter and OperationContext.
- * - For each file in @p isoFiles (that also exists in @p isoFilesCopy):
- *   - Validates the file still exists on disk.
- *   - For delete: calls performDeleteOperation.
- *   - For move/copy: iterates over all destinations, checking for same‑file,
- *     source‑missing, overwrite, and file‑exists conditions before dispatching
- *     to the appropriate operation function.
+ * - Creates one OperationContext around @p results, shared by every task.
+ * - For delete: every file is one task of an "rm" @ref TaskGroup capped at
+ *   `GlobalConcurrency::RM_THREAD_CAP`, which validates it still exists and
+ *   calls performDeleteOperation.
+ * - For move/copy: every unit is one pipeline (see @ref transferUnit) whose
+ *   checks run in an uncapped "<op>.check" group and whose transfers run in
+ *   a "<op>" group capped at `GlobalConcurrency::CPMV_THREAD_CAP`.
  *   - For multi‑destination moves: the source file is removed once at least
  *     one copy succeeds.
  * - Ownership of newly created files is restored to the real user (via chown).
- * - Batched messages are flushed on exit.
  *
- * @param isoFiles            Files to operate on in this chunk.
+ * Scheduling per file rather than per pre-split chunk means a large or slow
+ * file delays only itself; thousands of small files keep every slot busy.
+ *
+ * @param units               Files to operate on, grouped so that files sharing
+ *                            a filename are one unit (processed in order).
  * @param isoFilesCopy        Master file list (for existence validation).
  * @param userDestDir         Semicolon‑separated destination directories.
  * @param isMove              True for move operation.
@@ -870,14 +1004,14 @@ bool performCopyOperation(OperationContext& ctx,
  * @param completedTasks      Atomic counter for successful operations.
  * @param failedTasks         Atomic counter for failed operations.
  * @param overwriteExisting   If true, replace existing files at destination.
- * @param successfulDestPaths Vector to collect successful destination paths (optional).
- * @param destPathsMutex      Mutex protecting @p successfulDestPaths.
+ * @param results             Receives result messages and successful destination paths.
+ * @param outputPaths         Receives the collected destination paths (dropped if null).
  *
  * @note For multi-destination moves, the source file is removed once at least
  *       one copy succeeds — not necessarily all copies.
  * @note Ownership is restored using the real user ID from sudo/setuid context.
  */
-void handleIsoFileOperation(const std::vector<std::string>& isoFiles,
+void handleIsoFileOperation(const std::vector<std::vector<std::string>>& units,
                             const std::vector<std::string>& isoFilesCopy,
                             const std::string& userDestDir,
                             bool isMove, bool isCopy, bool isDelete,
@@ -885,15 +1019,9 @@ void handleIsoFileOperation(const std::vector<std::string>& isoFiles,
                             std::atomic<size_t>* completedTasks,
                             std::atomic<size_t>* failedTasks,
                             bool overwriteExisting,
-                            std::vector<std::string>* successfulDestPaths,
-                            std::mutex* destPathsMutex)
+                            ResultChannel& results,
+                            std::vector<std::string>* outputPaths)
 {
-    // ----- Thread‑local batched reporter -----
-    BatchReporter reporter(verboseSets.operationCompleted,
-                           verboseSets.operationFailed,
-                           GlobalMutexes::globalSetsMutex,
-                           50);  // batch size
-
     std::atomic<bool> operationSuccessful(true);
 
     // ----- Resolve real user for ownership changes -----
@@ -902,11 +1030,12 @@ void handleIsoFileOperation(const std::vector<std::string>& isoFiles,
     std::string real_username, real_groupname;
     getRealUserId(real_uid, real_gid, real_username, real_groupname);
 
-    OperationContext ctx{ reporter, completedTasks, failedTasks,
+    OperationContext ctx{ results, completedTasks, failedTasks,
                           operationSuccessful,
                           [&](const fs::path& path) {
                               chown(path.c_str(), real_uid, real_gid);
-                          } };
+                          },
+                          Cancellation::operation() };
 
     // ----- Parse destinations -----
     std::vector<std::string> destDirs;
@@ -920,105 +1049,41 @@ void handleIsoFileOperation(const std::vector<std::string>& isoFiles,
     const std::unordered_set<std::string> isoFilesCopySet(
         isoFilesCopy.begin(), isoFilesCopy.end());
 
-    // ----- Process each file -----
-    for (const auto& iso : isoFiles) {
-        if (!isoFilesCopySet.count(iso)) continue;
-
-        fs::path srcPath(iso);
-        if (!fs::exists(srcPath)) {
-            auto [isoDir, isoFile] = extractDirectoryAndFilename(srcPath.native(), "cp_mv_rm");
-            reportErrorCpMvRm(ctx, "missing_file", isoDir, isoFile, "", "", "");
-            continue;
-        }
-
-        auto [srcDir, srcFile] = extractDirectoryAndFilename(srcPath.native(), "cp_mv_rm");
-        struct stat st;
-        size_t fileSize = (stat(srcPath.c_str(), &st) == 0) ? st.st_size : 0;
-
-        if (isDelete) {
-            performDeleteOperation(ctx, srcPath, srcDir, srcFile, fileSize,
-                                   completedBytes, completedTasks, failedTasks);
-            continue;
-        }
-
-        bool atLeastOneCopySucceeded = false;
-        int validDestinations = 0;
-
-        for (const auto& dst : destDirs) {
-            fs::path destPath = fs::path(dst) / srcPath.filename();
-            const std::string& destDirProcessed = dst;
-            auto [_, destFile] = extractDirectoryAndFilename(destPath.native(), "cp_mv_rm");
-
-            if (fs::absolute(srcPath) == fs::absolute(destPath)) {
-                std::string op = isMove ? "move" : "copy";
-                reportErrorCpMvRm(ctx, "same_file", srcDir, srcFile, "", "", op);
-                continue;
-            }
-            ++validDestinations;
-
-            if (!fs::exists(srcPath)) {
-                reportErrorCpMvRm(ctx, "source_missing", srcDir, srcFile, "", "", "");
-                continue;
-            }
-
-            if (fs::exists(destPath)) {
-                if (overwriteExisting) {
-                    std::error_code ec;
-                    if (!fs::remove(destPath, ec)) {
-                        reportErrorCpMvRm(ctx, "overwrite_failed", "", "",
-                                          destDirProcessed, ec.message(), "");
-                        continue;
+    auto collect = [&results, outputPaths] { results.collect(outputPaths); };
+
+    // ----- Delete: one task per file -----
+    if (isDelete) {
+        TaskGroup deletes("rm", TaskPriority::Foreground, GlobalConcurrency::RM_THREAD_CAP);
+        for (const auto& unit : units) {
+            for (const auto& iso : unit) {
+                if (!isoFilesCopySet.count(iso)) continue;
+                deletes.submit([&ctx, &iso, completedBytes, completedTasks, failedTasks] {
+                    const fs::path srcPath(iso);
+                    auto [srcDir, srcFile] = extractDirectoryAndFilename(srcPath.native(), "cp_mv_rm");
+                    struct stat st;
+                    if (::stat(srcPath.c_str(), &st) != 0) {
+                        reportErrorCpMvRm(ctx, "missing_file", srcDir, srcFile, "", "", "");
+                        return;
                     }
-                } else {
-                    std::string op = isCopy ? "copying" : "moving";
-                    reportErrorCpMvRm(ctx, "file_exists", srcDir, srcFile,
-                                      destDirProcessed, "", op);
-                    continue;
-                }
-            }
-
-            bool success = false;
-            if (isMove && destDirs.size() > 1) {
-                success = performMultiDestMoveOperation(
-                    ctx, srcPath, destPath, srcDir, srcFile,
-                    destDirProcessed, destFile, completedBytes);
-                if (success) {
-                    atLeastOneCopySucceeded = true;
-                    if (successfulDestPaths && destPathsMutex) {
-                        std::lock_guard<std::mutex> lock(*destPathsMutex);
-                        successfulDestPaths->push_back(destPath.string());
-                    }
-                }
-            } else if (isMove) {
-                success = performMoveOperation(
-                    ctx, srcPath, destPath, srcDir, srcFile,
-                    destDirProcessed, destFile, fileSize,
-                    completedBytes, completedTasks);
-                if (success && successfulDestPaths && destPathsMutex) {
-                    std::lock_guard<std::mutex> lock(*destPathsMutex);
-                    successfulDestPaths->push_back(destPath.string());
-                }
-            } else { // isCopy
-                success = performCopyOperation(
-                    ctx, srcPath, destPath, srcDir, srcFile,
-                    destDirProcessed, destFile, completedBytes);
-                if (success && successfulDestPaths && destPathsMutex) {
-                    std::lock_guard<std::mutex> lock(*destPathsMutex);
-                    successfulDestPaths->push_back(destPath.string());
-                }
-            }
-        }
-
-        // Multi‑dest move cleanup
-        if (isMove && destDirs.size() > 1 && validDestinations > 0 && atLeastOneCopySucceeded) {
-            std::error_code deleteEc;
-            if (!fs::remove(srcPath, deleteEc)) {
-                reportErrorCpMvRm(ctx, "remove_after_move", srcDir, srcFile, "",
-                                  deleteEc.message(), "");
+                    performDeleteOperation(ctx, srcPath, srcDir, srcFile, st.st_size,
+                                           completedBytes, completedTasks, failedTasks);
+                });
             }
         }
+        deletes.wait(collect);
+        return;
     }
 
-    // ----- Flush any remaining batched messages -----
-    reporter.flush();
+    // ----- Copy / move: one pipeline per unit -----
+    const std::string opName = isMove ? "mv" : "cp";
+    TaskGroup checks(opName + ".check", TaskPriority::Foreground);
+    TaskGroup transfers(opName, TaskPriority::Foreground, GlobalConcurrency::CPMV_THREAD_CAP);
+    TransferBatch batch{ctx, destDirs, isoFilesCopySet, isMove, isCopy, overwriteExisting,
+                        completedBytes, completedTasks, checks, transfers};
+    PipelineScope pipelines;
+
+    for (const auto& unit : units)
+        pipelines.spawn(checks, transferUnit(batch, unit));
+
+    pipelines.wait(collect);
 }
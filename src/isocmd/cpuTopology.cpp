@@ -0,0 +1,227 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// C / System Headers
+#include <dirent.h>
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Project Headers
+#include "../cpuTopology.h"
+
+namespace {
+
+/// @brief First line of a sysfs attribute, or empty if it can't be read.
+std::string readSysfs(const std::string& path) {
+    std::FILE* f = std::fopen(path.c_str(), "r");
+    if (!f) return {};
+    char buf[4096];
+    std::string out;
+    if (std::fgets(buf, sizeof(buf), f)) out = buf;
+    std::fclose(f);
+    while (!out.empty() && std::isspace(static_cast<unsigned char>(out.back()))) out.pop_back();
+    return out;
+}
+
+/// @brief Expands a sysfs CPU list ("0-3,8,10-11") into CPU numbers.
+std::vector<int> parseCpuList(std::string_view list) {
+    std::vector<int> cpus;
+    while (!list.empty()) {
+        const std::size_t comma = list.find(',');
+        const std::string_view range = list.substr(0, comma);
+        list = (comma == std::string_view::npos) ? std::string_view{} : list.substr(comma + 1);
+
+        int first = -1, last = -1;
+        const std::string text(range);
+        const int parsed = std::sscanf(text.c_str(), "%d-%d", &first, &last);
+        if (parsed < 1 || first < 0) continue;
+        if (parsed == 1) last = first;
+        for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+/// @brief CPUs the process may run on, in ascending order.
+std::vector<int> allowedCpus() {
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+            if (CPU_ISSET(cpu, &set)) cpus.push_back(cpu);
+    }
+    if (cpus.empty()) {
+        for (int cpu = 0; cpu < static_cast<int>(std::max(1u, std::thread::hardware_concurrency())); ++cpu)
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+
+/// @brief Keeps the CPUs of @p cpus that are also in the sorted list @p allowed.
+std::vector<int> restrictTo(std::vector<int> cpus, const std::vector<int>& allowed) {
+    std::erase_if(cpus, [&allowed](int cpu) { return !std::binary_search(allowed.begin(), allowed.end(), cpu); });
+    return cpus;
+}
+
+/// @brief One domain per NUMA node that has allowed CPUs, by node id.
+std::vector<CpuDomain> readNodes(const std::vector<int>& allowed) {
+    std::vector<CpuDomain> nodes;
+    DIR* dir = ::opendir("/sys/devices/system/node");
+    if (!dir) return nodes;
+    while (const dirent* entry = ::readdir(dir)) {
+        const std::string_view name = entry->d_name;
+        if (name.size() <= 4 || name.substr(0, 4) != "node" ||
+            !std::all_of(name.begin() + 4, name.end(), [](char c) { return std::isdigit(static_cast<unsigned char>(c)); }))
+            continue;
+
+        CpuDomain d;
+        d.node = std::stoi(std::string(name.substr(4)));
+        d.numaNode = true;
+        d.cpuList = readSysfs("/sys/devices/system/node/" + std::string(name) + "/cpulist");
+        d.cpus = restrictTo(parseCpuList(d.cpuList), allowed);
+        if (!d.cpus.empty()) nodes.push_back(std::move(d));
+    }
+    ::closedir(dir);
+    std::sort(nodes.begin(), nodes.end(), [](const CpuDomain& a, const CpuDomain& b) { return a.node < b.node; });
+    return nodes;
+}
+
+/// @brief One domain per distinct last-level data cache among @p allowed.
+std::vector<CpuDomain> readLastLevelCaches(const std::vector<int>& allowed, int node) {
+    std::map<std::string, std::vector<int>> groups;   // shared_cpu_list -> allowed CPUs
+    for (int cpu : allowed) {
+        const std::string base = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache/index";
+        int bestLevel = -1;
+        std::string shared;
+        for (int index = 0;; ++index) {
+            const std::string level = readSysfs(base + std::to_string(index) + "/level");
+            if (level.empty()) break;
+            if (readSysfs(base + std::to_string(index) + "/type") == "Instruction") continue;
+            const int lvl = std::atoi(level.c_str());
+            if (lvl > bestLevel) {
+                bestLevel = lvl;
+                shared = readSysfs(base + std::to_string(index) + "/shared_cpu_list");
+            }
+        }
+        if (shared.empty()) shared = std::to_string(cpu);
+        groups[shared].push_back(cpu);
+    }
+
+    std::vector<CpuDomain> caches;
+    for (auto& [list, cpus] : groups) caches.push_back({node, false, list, std::move(cpus)});
+    std::sort(caches.begin(), caches.end(), [](const CpuDomain& a, const CpuDomain& b) { return a.cpus.front() < b.cpus.front(); });
+    return caches;
+}
+
+std::vector<CpuDomain> readDomains() {
+    const std::vector<int> allowed = allowedCpus();
+
+    std::vector<CpuDomain> nodes = readNodes(allowed);
+    if (nodes.size() >= 2) return nodes;
+
+    const int node = nodes.empty() ? 0 : nodes.front().node;
+    std::vector<CpuDomain> caches = readLastLevelCaches(allowed, node);
+    if (!caches.empty()) return caches;
+
+    std::string list;
+    for (int cpu : allowed) list += (list.empty() ? "" : ",") + std::to_string(cpu);
+    return {CpuDomain{node, false, list, allowed}};
+}
+
+thread_local int t_boundNode = -1;
+
+} // namespace
+
+const std::vector<CpuDomain>& cpuDomains() {
+    static const std::vector<CpuDomain> domains = readDomains();
+    return domains;
+}
+
+bool bindCurrentThreadToDomain(std::size_t domain) {
+    const std::vector<CpuDomain>& domains = cpuDomains();
+    if (domain >= domains.size()) return false;
+    const CpuDomain& d = domains[domain];
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : d.cpus)
+        if (cpu < CPU_SETSIZE) CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) return false;
+
+    t_boundNode = d.numaNode ? d.node : -1;
+    return true;
+}
+
+int currentThreadNode() noexcept {
+    return t_boundNode;
+}
+
+NodeBufferCounters& nodeBufferCounters() noexcept {
+    static NodeBufferCounters counters;
+    return counters;
+}
+
+NodeLocalBuffer::NodeLocalBuffer(std::size_t size) {
+    const std::size_t page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t mapped = (std::max<std::size_t>(size, 1) + page - 1) / page * page;
+    void* p = ::mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) return;
+
+    data_ = static_cast<char*>(p);
+    size_ = size;
+    mapped_ = mapped;
+
+    // Preferred rather than bound: a full node spills over instead of failing the fault.
+    constexpr int MAX_NODES = 1024;
+    const int node = currentThreadNode();
+    if (node >= 0 && node < MAX_NODES) {
+        unsigned long mask[MAX_NODES / (8 * sizeof(unsigned long))] = {};
+        mask[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+        if (::syscall(SYS_mbind, p, mapped, MPOL_PREFERRED, mask, MAX_NODES + 1, 0) == 0) node_ = node;
+    }
+    auto& counters = nodeBufferCounters();
+    (node_ >= 0 ? counters.bound : counters.firstTouch).fetch_add(1, std::memory_order_relaxed);
+}
+
+NodeLocalBuffer::~NodeLocalBuffer() {
+    release();
+}
+
+NodeLocalBuffer::NodeLocalBuffer(NodeLocalBuffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr)),
+      size_(std::exchange(other.size_, 0)),
+      mapped_(std::exchange(other.mapped_, 0)),
+      node_(std::exchange(other.node_, -1)) {}
+
+NodeLocalBuffer& NodeLocalBuffer::operator=(NodeLocalBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        mapped_ = std::exchange(other.mapped_, 0);
+        node_ = std::exchange(other.node_, -1);
+    }
+    return *this;
+}
+
+void NodeLocalBuffer::release() noexcept {
+    if (data_) ::munmap(data_, mapped_);
+    data_ = nullptr;
+    size_ = mapped_ = 0;
+    node_ = -1;
+}
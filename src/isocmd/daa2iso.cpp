@@ -44,21 +44,32 @@
 // ___________________________________________________________________________
 
 // C++ Standard Library Headers
+#include <algorithm>
 #include <atomic>
+#include <cassert>
 #include <cstddef>
 #include <filesystem>
+#include <mutex>
 #include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
 
 // C / System Headers
 #include <ctype.h>
+#include <fcntl.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Project Headers
+#include "../asyncIo.h"
+#include "../cancellation.h"
+#include "../concurrency.h"
 #include "../daa2iso.h"
-#include "../state.h"
 
 namespace fs = std::filesystem;
 
@@ -469,208 +480,306 @@ static size_t lzma_decode_full(CLzmaDec *p, const u8 *in, size_t insz, u8 *out,
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
-//  tinflate – Luigi Auriemma's modified tiny inflate (btype table swapped)
-//  NOTE: All previously static/global tinflate state is now per-instance,
-//        stored in DaaContext, and passed explicitly to every function.
+//  Inflate – table-driven, with DAA's permuted block types
+//  Plain RFC 1951 except that the 2-bit block type goes through
+//  swapped_btype[] (stored, fixed, dynamic). Huffman symbols come from a
+//  10-bit lookup table, falling back to a canonical-code search only for
+//  longer codes; bits arrive 56+ at a time through a 64-bit buffer; matches
+//  copy 8 bytes per step. The fixed-code tables are built once and shared,
+//  read-only, by every thread; dynamic tables live on the decoding stack.
 // ═══════════════════════════════════════════════════════════════════════════
 
-#define TINF_OK         0
-#define TINF_DATA_ERROR (-3)
+#define INFLATE_OK         0
+#define INFLATE_DATA_ERROR (-3)
 
-struct TINF_TREE {
-    unsigned short table[16];
-    unsigned short trans[288];
+#define INFLATE_FAST_BITS  10
+#define INFLATE_FAST_MASK  ((1u << INFLATE_FAST_BITS) - 1)
+
+struct InflateHuffman {
+    u16 fast[1 << INFLATE_FAST_BITS];   // (length << 9) | symbol; 0 = longer code
+    u16 firstcode[16];
+    u16 firstsymbol[16];
+    u32 maxcode[17];                    // Exclusive, left-aligned to 16 bits
+    u8  size[288];
+    u16 value[288];
 };
 
-struct TINF_DATA {
-    const u8      *source;
-    unsigned int   tag;
-    unsigned int   bitcount;
-    u8            *dest;
-    size_t        *destLen;     // Changed to size_t
-    size_t         sourceLen;   // Changed to size_t
-    size_t         sourceSize;  // Changed to size_t
-    size_t         destSize;    // Changed to size_t
-    TINF_TREE      ltree;
-    TINF_TREE      dtree;
+struct InflateTables {
+    InflateHuffman fixedLit, fixedDist;
 };
 
-// Per-context tinflate tables (replaces the old static globals)
-struct TinfTables {
-    TINF_TREE sltree, sdtree;
-    u8        length_bits[30];
-    u16       length_base[30];
-    u8        dist_bits[30];
-    u16       dist_base[30];
+// Bit reader. Bytes past the end read as zero, which the original decoder
+// also allowed; `overrun` counts them so a stream that really runs out is caught.
+struct InflateBits {
+    const u8 *pos, *end;
+    u64       buf;
+    unsigned  cnt;
+    size_t    overrun;
 };
 
+static const u16 inflate_len_base[29] = {
+    3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258
+};
+static const u8 inflate_len_extra[29] = {
+    0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0
+};
+static const u16 inflate_dist_base[30] = {
+    1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,
+    1025,1537,2049,3073,4097,6145,8193,12289,16385,24577
+};
+static const u8 inflate_dist_extra[30] = {
+    0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13
+};
 static const u8 clcidx[] = {
     16,17,18,0,8,7,9,6,10,5,11,4,12,3,13,2,14,1,15
 };
 
-static void tinf_build_bits_base(u8 *bits, u16 *base, int delta, int first) {
-    int i, sum;
-    for (i = 0; i < delta; ++i) bits[i] = 0;
-    for (i = 0; i < 30 - delta; ++i) bits[i+delta] = i/delta;
-    for (sum = first, i = 0; i < 30; ++i) { base[i] = sum; sum += 1 << bits[i]; }
-}
-
-static void tinf_build_fixed_trees(TINF_TREE *lt, TINF_TREE *dt) {
-    int i;
-    for (i = 0; i < 7; ++i) lt->table[i] = 0;
-    lt->table[7] = 24; lt->table[8] = 152; lt->table[9] = 112;
-    for (i = 0; i < 24; ++i)  lt->trans[i]           = 256+i;
-    for (i = 0; i < 144; ++i) lt->trans[24+i]         = i;
-    for (i = 0; i < 8; ++i)   lt->trans[24+144+i]     = 280+i;
-    for (i = 0; i < 112; ++i) lt->trans[24+144+8+i]   = 144+i;
-    for (i = 0; i < 5; ++i)  dt->table[i] = 0;
-    dt->table[5] = 32;
-    for (i = 0; i < 32; ++i) dt->trans[i] = i;
+static unsigned inflate_reverse(unsigned code, unsigned bits) {
+    unsigned r = 0;
+    for (unsigned i = 0; i < bits; ++i, code >>= 1) r = (r << 1) | (code & 1);
+    return r;
 }
 
-static void tinf_build_tree(TINF_TREE *t, const u8 *lengths, unsigned num) {
-    unsigned short offs[16];
-    unsigned i, sum;
-    for (i = 0; i < 16; ++i) t->table[i] = 0;
-    for (i = 0; i < num; ++i) t->table[lengths[i]]++;
-    t->table[0] = 0;
-    for (sum = 0, i = 0; i < 16; ++i) { offs[i] = sum; sum += t->table[i]; }
-    for (i = 0; i < num; ++i) if (lengths[i]) t->trans[offs[lengths[i]]++] = i;
+static bool inflate_build(InflateHuffman &h, const u8 *lengths, unsigned num) {
+    unsigned sizes[17] = {0}, next_code[16];
+    memset(h.fast, 0, sizeof(h.fast));
+    for (unsigned i = 0; i < num; ++i) ++sizes[lengths[i]];
+    sizes[0] = 0;
+
+    unsigned code = 0, k = 0;
+    for (unsigned i = 1; i < 16; ++i) {
+        next_code[i]      = code;
+        h.firstcode[i]    = (u16)code;
+        h.firstsymbol[i]  = (u16)k;
+        code += sizes[i];
+        if (sizes[i] && code - 1 >= (1u << i)) return false;   // Over-subscribed
+        h.maxcode[i] = code << (16 - i);
+        code <<= 1;
+        k += sizes[i];
+    }
+    h.maxcode[16] = 0x10000;
+
+    for (unsigned i = 0; i < num; ++i) {
+        const unsigned s = lengths[i];
+        if (!s) continue;
+        const unsigned c = next_code[s] - h.firstcode[s] + h.firstsymbol[s];
+        h.size[c]  = (u8)s;
+        h.value[c] = (u16)i;
+        if (s <= INFLATE_FAST_BITS) {
+            const u16 entry = (u16)((s << 9) | i);
+            for (unsigned j = inflate_reverse(next_code[s], s); j < (1u << INFLATE_FAST_BITS); j += 1u << s)
+                h.fast[j] = entry;
+        }
+        ++next_code[s];
+    }
+    return true;
 }
 
-static void tinf_init(TinfTables &tt) {
-    tinf_build_fixed_trees(&tt.sltree, &tt.sdtree);
-    tinf_build_bits_base(tt.length_bits, tt.length_base, 4, 3);
-    tinf_build_bits_base(tt.dist_bits,   tt.dist_base,   2, 1);
-    tt.length_bits[28] = 0; tt.length_base[28] = 258;
+static const InflateTables &inflate_tables() {
+    static const InflateTables tables = [] {
+        InflateTables t;
+        u8 lengths[288];
+        memset(lengths,       8, 144);
+        memset(lengths + 144, 9, 112);
+        memset(lengths + 256, 7, 24);
+        memset(lengths + 280, 8, 8);
+        inflate_build(t.fixedLit, lengths, 288);
+        memset(lengths, 5, 30);
+        inflate_build(t.fixedDist, lengths, 30);
+        return t;
+    }();
+    return tables;
 }
 
-static int tinf_getbit(TINF_DATA *d) {
-    if (!d->bitcount--) {
-        if ((d->sourceLen+1) > d->sourceSize) return 0;
-        d->tag = *d->source++; d->sourceLen++; d->bitcount = 7;
+static inline void inflate_refill(InflateBits &b) {
+    if (b.end - b.pos >= 8) {
+        // Branchless: top up to 56-63 bits. Bytes loaded beyond the count
+        // sit above it unchanged and are simply loaded again next time.
+        u64 w;
+        memcpy(&w, b.pos, 8);
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        w = __builtin_bswap64(w);
+#endif
+        b.buf |= w << b.cnt;
+        b.pos += (63 - b.cnt) >> 3;
+        b.cnt |= 56;
+        return;
+    }
+    while (b.cnt < 56) {
+        u64 byte = 0;
+        if (b.pos < b.end) byte = *b.pos++;
+        else               b.overrun++;
+        b.buf |= byte << b.cnt;
+        b.cnt += 8;
     }
-    int bit = d->tag & 1; d->tag >>= 1; return bit;
 }
 
-static unsigned int tinf_read_bits(TINF_DATA *d, int num, int base) {
-    unsigned val = 0;
-    if (num) {
-        unsigned limit = 1u << num, mask;
-        for (mask = 1; mask < limit; mask <<= 1) if (tinf_getbit(d)) val += mask;
-    }
-    return val + base;
+// Callers refill first; a refill guarantees 56 bits, not 64.
+static inline unsigned inflate_bits(InflateBits &b, unsigned n) {
+    assert(b.cnt >= n);
+    const unsigned v = (unsigned)(b.buf & ((1ull << n) - 1));
+    b.buf >>= n;
+    b.cnt  -= n;
+    return v;
 }
 
-static int tinf_decode_symbol(TINF_DATA *d, TINF_TREE *t) {
-    int sum = 0, cur = 0, len = 0;
-    do { cur = 2*cur + tinf_getbit(d); ++len; sum += t->table[len]; cur -= t->table[len]; }
-    while (cur >= 0);
-    return t->trans[sum+cur];
+// Needs at least 15 bits buffered.
+static inline int inflate_symbol(InflateBits &b, const InflateHuffman &h) {
+    unsigned e = h.fast[b.buf & INFLATE_FAST_MASK];
+    if (e) {
+        assert(b.cnt >= (e >> 9));
+        b.buf >>= e >> 9;
+        b.cnt  -= e >> 9;
+        return (int)(e & 511);
+    }
+    const unsigned k = inflate_reverse((unsigned)(b.buf & 0xffff), 16);
+    unsigned s = INFLATE_FAST_BITS + 1;
+    while (k >= h.maxcode[s]) ++s;
+    if (s >= 16) return -1;
+    const unsigned c = (k >> (16 - s)) - h.firstcode[s] + h.firstsymbol[s];
+    if (c >= 288 || h.size[c] != s) return -1;
+    assert(b.cnt >= s);
+    b.buf >>= s;
+    b.cnt  -= s;
+    return h.value[c];
 }
 
-static int tinf_decode_trees(TINF_DATA *d, TINF_TREE *lt, TINF_TREE *dt) {
-    TINF_TREE code_tree;
-    u8 lengths[288+32];
-    unsigned hlit = tinf_read_bits(d,5,257);
-    unsigned hdist= tinf_read_bits(d,5,1);
-    unsigned hclen= tinf_read_bits(d,4,4);
-    unsigned i, num, length;
-    for (i = 0; i < 19; ++i) lengths[i] = 0;
-    for (i = 0; i < hclen; ++i) { unsigned clen = tinf_read_bits(d,3,0); lengths[clcidx[i]] = clen; }
-    tinf_build_tree(&code_tree, lengths, 19);
-    for (num = 0; num < hlit+hdist; ) {
-        int sym = tinf_decode_symbol(d, &code_tree);
-        switch (sym) {
-        case 16: {
-            u8 prev = lengths[num-1];
-            length = tinf_read_bits(d,2,3);
-            if ((num+length)>(288+32)) return TINF_DATA_ERROR;
-            for (; length; --length) lengths[num++] = prev;
-            break;
-        }
-        case 17: {
-            length = tinf_read_bits(d,3,3);
-            if ((num+length)>(288+32)) return TINF_DATA_ERROR;
-            for (; length; --length) lengths[num++] = 0;
-            break;
-        }
-        case 18: {
-            length = tinf_read_bits(d,7,11);
-            if ((num+length)>(288+32)) return TINF_DATA_ERROR;
-            for (; length; --length) lengths[num++] = 0;
-            break;
-        }
-        default: if ((num+1)>(288+32)) return TINF_DATA_ERROR;
-                 lengths[num++] = sym; break;
+static int inflate_decode_trees(InflateBits &b, InflateHuffman &lit, InflateHuffman &dist) {
+    inflate_refill(b);
+    const unsigned hlit  = inflate_bits(b, 5) + 257;
+    const unsigned hdist = inflate_bits(b, 5) + 1;
+    const unsigned hclen = inflate_bits(b, 4) + 4;
+
+    u8 lengths[288 + 32] = {0};
+    // Up to 19 * 3 = 57 bits, one more than a refill guarantees
+    for (unsigned i = 0; i < hclen; ++i) {
+        if (i % 9 == 0) inflate_refill(b);
+        lengths[clcidx[i]] = (u8)inflate_bits(b, 3);
+    }
+    InflateHuffman codeTree;
+    if (!inflate_build(codeTree, lengths, 19)) return INFLATE_DATA_ERROR;
+
+    memset(lengths, 0, sizeof(lengths));
+    for (unsigned num = 0; num < hlit + hdist; ) {
+        inflate_refill(b);
+        const int sym = inflate_symbol(b, codeTree);
+        unsigned repeat;
+        u8 value = 0;
+        if (sym < 0) return INFLATE_DATA_ERROR;
+        if (sym < 16) {
+            lengths[num++] = (u8)sym;
+            continue;
+        } else if (sym == 16) {
+            if (num == 0) return INFLATE_DATA_ERROR;
+            value  = lengths[num - 1];
+            repeat = inflate_bits(b, 2) + 3;
+        } else if (sym == 17) {
+            repeat = inflate_bits(b, 3) + 3;
+        } else {
+            repeat = inflate_bits(b, 7) + 11;
         }
+        if (num + repeat > hlit + hdist) return INFLATE_DATA_ERROR;
+        memset(lengths + num, value, repeat);
+        num += repeat;
     }
-    tinf_build_tree(lt, lengths, hlit);
-    tinf_build_tree(dt, lengths+hlit, hdist);
-    return TINF_OK;
+    if (!inflate_build(lit, lengths, hlit) || !inflate_build(dist, lengths + hlit, hdist))
+        return INFLATE_DATA_ERROR;
+    return INFLATE_OK;
 }
 
-static int tinf_inflate_block_data(TINF_DATA *d, TINF_TREE *lt, TINF_TREE *dt,
-                                    const TinfTables &tt) {
-    while (1) {
-        int sym = tinf_decode_symbol(d, lt);
-        if (sym == 256) break;
+static int inflate_block(InflateBits &b, const InflateHuffman &lit, const InflateHuffman &dist,
+                         u8 *start, u8 *&out, u8 *end) {
+    for (;;) {
+        // 15 + 5 + 15 + 13 bits at most per iteration, always under 56
+        inflate_refill(b);
+        int sym = inflate_symbol(b, lit);
         if (sym < 256) {
-            if ((*d->destLen+1) > d->destSize) return TINF_DATA_ERROR;
-            *d->dest++ = sym; *d->destLen += 1;
+            if (sym < 0 || out == end) return INFLATE_DATA_ERROR;
+            *out++ = (u8)sym;
+            continue;
+        }
+        if (sym == 256) return INFLATE_OK;
+
+        sym -= 257;
+        if (sym >= 29) return INFLATE_DATA_ERROR;
+        const unsigned len = inflate_len_base[sym] + inflate_bits(b, inflate_len_extra[sym]);
+        const int dsym = inflate_symbol(b, dist);
+        if (dsym < 0 || dsym >= 30) return INFLATE_DATA_ERROR;
+        const size_t offs = inflate_dist_base[dsym] + inflate_bits(b, inflate_dist_extra[dsym]);
+
+        if (offs > (size_t)(out - start) || len > (size_t)(end - out)) return INFLATE_DATA_ERROR;
+        const u8 *src = out - offs;
+        if (offs >= 8 && (size_t)(end - out) >= len + 8) {
+            // 8 bytes per step; may run up to 7 past the match, inside the buffer
+            u8 *stop = out + len;
+            do { memcpy(out, src, 8); out += 8; src += 8; } while (out < stop);
+            out = stop;
+        } else if (offs == 1) {
+            memset(out, *src, len);
+            out += len;
         } else {
-            sym -= 257;
-            int length = tinf_read_bits(d, tt.length_bits[sym], tt.length_base[sym]);
-            int dist   = tinf_decode_symbol(d, dt);
-            int offs   = tinf_read_bits(d, tt.dist_bits[dist], tt.dist_base[dist]);
-            if ((*d->destLen+length) > d->destSize) return TINF_DATA_ERROR;
-            for (int i = 0; i < length; ++i) d->dest[i] = d->dest[i-offs];
-            d->dest += length; *d->destLen += length;
+            for (unsigned i = 0; i < len; ++i) out[i] = src[i];
+            out += len;
         }
     }
-    return TINF_OK;
 }
 
-static int tinf_inflate_uncompressed_block(TINF_DATA *d) {
-    if ((d->sourceLen+4) > d->sourceSize) return TINF_DATA_ERROR;
-    unsigned length    = (unsigned)d->source[1]<<8 | d->source[0];
-    unsigned invlength = (unsigned)d->source[3]<<8 | d->source[2];
-    if (length != (~invlength & 0xffff)) return TINF_DATA_ERROR;
-    d->source += 4; d->sourceLen += 4;
-    if ((d->sourceLen+length) > d->sourceSize) return TINF_DATA_ERROR;
-    if ((*d->destLen+length) > d->destSize)    return TINF_DATA_ERROR;
-    for (unsigned i = length; i; --i) *d->dest++ = *d->source++;
-    d->bitcount = 0; d->sourceLen += length; *d->destLen += length;
-    return TINF_OK;
+static int inflate_stored(InflateBits &b, u8 *&out, u8 *end) {
+    // Drop to the byte boundary and hand the buffered whole bytes back
+    inflate_bits(b, b.cnt & 7);
+    size_t unread = b.cnt >> 3;
+    const size_t virt = std::min(unread, b.overrun);
+    b.overrun -= virt;
+    unread    -= virt;
+    b.pos -= unread;
+    b.buf = 0;
+    b.cnt = 0;
+    if (b.overrun || b.end - b.pos < 4) return INFLATE_DATA_ERROR;
+
+    const unsigned length    = (unsigned)b.pos[1] << 8 | b.pos[0];
+    const unsigned invlength = (unsigned)b.pos[3] << 8 | b.pos[2];
+    if (length != (~invlength & 0xffff)) return INFLATE_DATA_ERROR;
+    b.pos += 4;
+    if ((size_t)(b.end - b.pos) < length || (size_t)(end - out) < length) return INFLATE_DATA_ERROR;
+    memcpy(out, b.pos, length);
+    b.pos += length;
+    out   += length;
+    return INFLATE_OK;
 }
 
-static int tinf_uncompress(TinfTables &tt,
-                            void *dest, size_t *destLen, // Changed to size_t
-                            const void *source, size_t sourceLen, // Changed to size_t
-                            const unsigned swapped_btype[3]) {
-    TINF_DATA d;
-    d.source     = (const u8 *)source;
-    d.bitcount   = 0;
-    d.dest       = (u8 *)dest;
-    d.destLen    = destLen;
-    d.sourceLen  = 0;
-    d.sourceSize = sourceLen;
-    d.destSize   = *destLen;
+/**
+ * @brief Inflates @p sourceLen bytes into @p dest.
+ * @param destLen In: capacity of @p dest. Out: bytes produced.
+ * @return INFLATE_OK or INFLATE_DATA_ERROR.
+ */
+static int daa_inflate(void *dest, size_t *destLen,
+                       const void *source, size_t sourceLen,
+                       const unsigned swapped_btype[3]) {
+    const InflateTables &tables = inflate_tables();
+    InflateBits b = {(const u8 *)source, (const u8 *)source + sourceLen, 0, 0, 0};
+    u8 *start = (u8 *)dest, *out = start, *end = start + *destLen;
     *destLen = 0;
+
     int bfinal;
     do {
-        bfinal = tinf_getbit(&d);
-        unsigned btype = tinf_read_bits(&d, 2, 0);
+        inflate_refill(b);
+        bfinal = (int)inflate_bits(b, 1);
+        const unsigned btype = inflate_bits(b, 2);
         int res;
-        if      (btype == swapped_btype[0]) res = tinf_inflate_uncompressed_block(&d);
-        else if (btype == swapped_btype[1]) res = tinf_inflate_block_data(&d, &tt.sltree, &tt.sdtree, tt);
+        if      (btype == swapped_btype[0]) res = inflate_stored(b, out, end);
+        else if (btype == swapped_btype[1]) res = inflate_block(b, tables.fixedLit, tables.fixedDist, start, out, end);
         else if (btype == swapped_btype[2]) {
-            if (tinf_decode_trees(&d, &d.ltree, &d.dtree) != TINF_OK) return TINF_DATA_ERROR;
-            res = tinf_inflate_block_data(&d, &d.ltree, &d.dtree, tt);
-        } else return TINF_DATA_ERROR;
-        if (res != TINF_OK) return TINF_DATA_ERROR;
+            InflateHuffman lit, dist;
+            res = inflate_decode_trees(b, lit, dist);
+            if (res == INFLATE_OK) res = inflate_block(b, lit, dist, start, out, end);
+        } else return INFLATE_DATA_ERROR;
+        if (res != INFLATE_OK) return INFLATE_DATA_ERROR;
+        // More zeros than the buffer can prefetch means the stream really ran out
+        if (b.overrun > sizeof(b.buf)) return INFLATE_DATA_ERROR;
     } while (!bfinal);
-    return TINF_OK;
+
+    *destLen = (size_t)(out - start);
+    return INFLATE_OK;
 }
 
 // ═══════════════════════════════════════════════════════════════════════════
@@ -771,17 +880,30 @@ static u8 *find_ext(u8 *fname, const char *ext) {
 
 // ═══════════════════════════════════════════════════════════════════════════
 //  Library context
-//  TinfTables and powerisuxn are per-instance — no shared mutable state.
+//  powerisuxn is per-instance — no shared mutable state.
 // ═══════════════════════════════════════════════════════════════════════════
 
+// One volume's share of the chunk stream: bytes [start, start + length) of
+// its file hold stream bytes [base, base + length).
+struct DaaVolume {
+    int         fd             = -1;
+    u64         start          = 0;
+    u64         length         = 0;
+    u64         base           = 0;
+};
+
 struct DaaContext {
     FILE       *fdi            = nullptr;
-    FILE       *fdo            = nullptr;
+    int         fdo            = -1;
     std::string outputPath;
 
+    // Volumes after the first, kept open for the decode workers
+    std::vector<FILE*> extraVolumes;
+
     int         multi          = 0;
     int         multinum       = 0;
     char       *multi_filename = nullptr;
+    size_t      multi_baselen  = 0;   // Volume suffixes are written from here
 
     int         endian         = 0;
     int         daagbi         = TYPE_DAA;
@@ -789,13 +911,6 @@ struct DaaContext {
 
     u8         *in             = nullptr;
     u32         insz           = 0;
-    u8         *out_buf        = nullptr;
-    u32         outsz          = 0;
-
-    CLzmaDec    lzma           = {};
-
-    // Per-instance tinflate tables (was static globals — race condition fix)
-    TinfTables  tinf           = {};
 
     // Per-instance bit-reader counter (was static global — race condition fix)
     int         powerisuxn     = 0;
@@ -804,16 +919,10 @@ struct DaaContext {
 
     ~DaaContext() {
 		if (fdi) { fclose(fdi); fdi = nullptr; }
-		if (fdo) { fclose(fdo); fdo = nullptr; }
+		if (fdo >= 0) { close(fdo); fdo = -1; }
+		for (FILE *f : extraVolumes) fclose(f);
 		if (in) { free(in); in = nullptr; }
-		if (out_buf) { free(out_buf); out_buf = nullptr; }
 		if (multi_filename) { free(multi_filename); multi_filename = nullptr; }
-
-		// Safety check for parallel threads
-		if (lzma.probs != nullptr) {
-			LzmaDec_Free(&lzma, &g_Alloc);
-			lzma.probs = nullptr; // Ensure this is NULL so the next thread doesn't try to free it
-		}
 	}
 };
 
@@ -827,7 +936,7 @@ static FILE *ctx_next_volume(DaaContext &ctx) {
     if (!ctx.multi_filename)
         throw DaaError("multi_filename not initialised");
 
-    char *toadd = ctx.multi_filename + strlen(ctx.multi_filename);
+    char *toadd = ctx.multi_filename + ctx.multi_baselen;
     int written = snprintf(toadd, 32, fmts[ctx.multi - 1], ctx.multinum);
 	if (written < 0 || written >= 32)
 		throw DaaError("volume filename overflow");
@@ -875,36 +984,198 @@ static void ctx_alloc(u8 **data, unsigned wantsize, unsigned *currsize) {
 }
 
 static bool daa_fail(DaaContext &ctx) {
-    if (ctx.fdo) { fclose(ctx.fdo); ctx.fdo = nullptr; }
+    if (ctx.fdo >= 0) { close(ctx.fdo); ctx.fdo = -1; }
     if (!ctx.outputPath.empty()) fs::remove(ctx.outputPath);
     return false;
 }
 
+// ═══════════════════════════════════════════════════════════════════════════
+//  Chunk-parallel decoder
+//  The index table gives every chunk's length up front and each chunk
+//  decodes on its own (LZMA restarts with LzmaDec_Init, inflate carries no
+//  history across chunks), so workers claim chunks from a shared counter and
+//  pwrite each one to its fixed place in the output: chunk i at i * chunksize.
+// ═══════════════════════════════════════════════════════════════════════════
+
+struct DaaChunk {
+    u64         pos;        // Offset in the chunk stream (all volumes, back to back)
+    u32         len;
+    int         ztype;
+};
+
+struct DaaDecodeJob {
+    const std::vector<DaaChunk>  *chunks         = nullptr;
+    const std::vector<DaaVolume> *volumes        = nullptr;
+    u32                           chunksize      = 0;
+    u64                           isosize        = 0;
+    const unsigned               *swapped_btype  = nullptr;
+    const u8                     *lzmaProps      = nullptr;   // null when the image has no LZMA chunks
+    int                           lzma_filter    = 0;
+    int                           fdo            = -1;
+    std::atomic<size_t>          *completedBytes = nullptr;
+    CancellationToken             cancel;
+};
+
+// Decoder state owned by one worker
+struct DaaWorker {
+    CLzmaDec    lzma           = {};
+    u8         *in             = nullptr;
+    u32         insz           = 0;
+    u8         *out_buf        = nullptr;
+    u32         outsz          = 0;
+
+    DaaWorker() { LzmaDec_Construct(&lzma); }
+    ~DaaWorker() {
+        if (lzma.probs) LzmaDec_Free(&lzma, &g_Alloc);
+        free(in);
+        free(out_buf);
+    }
+    DaaWorker(const DaaWorker&) = delete;
+    DaaWorker& operator=(const DaaWorker&) = delete;
+};
+
+static void volumes_read(const std::vector<DaaVolume> &volumes, u64 pos, u8 *data, u32 size) {
+    auto vol = std::upper_bound(volumes.begin(), volumes.end(), pos,
+                                [](u64 p, const DaaVolume &v) { return p < v.base; });
+    if (vol == volumes.begin()) throw DaaError("incomplete input file");
+    for (--vol; size > 0; ++vol) {
+        if (vol == volumes.end()) throw DaaError("incomplete input file");
+        const u64 skip = pos - vol->base;
+        if (skip >= vol->length) continue;
+        const u32 part = (u32)std::min<u64>(size, vol->length - skip);
+        std::error_code ec;
+        if (!readFully(vol->fd, (char*)data, part, vol->start + skip, ec))
+            throw DaaError("incomplete input file");
+        data += part; pos += part; size -= part;
+    }
+}
+
+static void daa_decode_chunk(DaaWorker &w, const DaaDecodeJob &job, u32 i) {
+    const DaaChunk &c = (*job.chunks)[i];
+    ctx_alloc(&w.in, c.len, &w.insz);
+    volumes_read(*job.volumes, c.pos, w.in, c.len);
+
+    u32 outlen;
+    switch (c.ztype) {
+        case -1:
+            outlen = (c.len < job.chunksize) ? c.len : job.chunksize;
+            memcpy(w.out_buf, w.in, outlen);
+            break;
+        case 0:
+            if (!w.lzma.probs) {
+                if (!job.lzmaProps || LzmaDec_Allocate(&w.lzma, job.lzmaProps, LZMA_PROPS_SIZE, &g_Alloc) != SZ_OK)
+                    throw DaaError("LZMA property allocation failed");
+            }
+            LzmaDec_Init(&w.lzma);
+            outlen = lzma_decode_full(&w.lzma, w.in, c.len, w.out_buf, w.outsz);
+            if (outlen == 0) throw DaaError("LZMA decompression failed");
+            if (job.lzma_filter) poweriso_is_shit(w.out_buf, (int)outlen);
+            break;
+        case 1: {
+            size_t destLen = w.outsz;
+            if (daa_inflate(w.out_buf, &destLen, w.in, c.len, job.swapped_btype) != INFLATE_OK)
+                throw DaaError("INFLATE decompression failed");
+            outlen = destLen;
+            break;
+        }
+        default:
+            throw DaaError("unknown compression type");
+    }
+
+    const u64 offset = (u64)i * job.chunksize;
+    if (i + 1 == job.chunks->size()) {
+        if (offset > job.isosize) throw DaaError("output size mismatch");
+        if ((offset + outlen) > job.isosize)
+            outlen = (u32)(job.isosize - offset);
+        if ((offset + outlen) != job.isosize) throw DaaError("output size mismatch");
+    } else {
+        if (outlen != job.chunksize)
+            throw DaaError("chunk size mismatch");
+    }
+
+    std::error_code ec;
+    if (!writeFully(job.fdo, (const char*)w.out_buf, outlen, offset, ec))
+        throw DaaError("write failed");
+
+    if (job.completedBytes)
+        job.completedBytes->fetch_add(outlen, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Decodes every chunk of @p job on up to thread_cap_for_daa_decode
+ *        threads, the calling thread included.
+ * @return nullptr on success, "cancelled" when the token fired, otherwise
+ *         the first worker's error.
+ */
+static const char *daa_decode_chunks(const DaaDecodeJob &job) {
+    const u32 total = (u32)job.chunks->size();
+    const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+    const size_t numThreads = std::max<size_t>(1, std::min<size_t>({
+        GlobalConcurrency::DAA_DECODE_THREAD_CAP, cores, total }));
+
+    std::atomic<u32>  next{0};
+    std::atomic<bool> stop{false};
+    std::mutex        errorMutex;
+    const char       *error = nullptr;
+
+    auto fail = [&](const char *msg) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!error) error = msg;
+        stop.store(true, std::memory_order_relaxed);
+    };
+
+    auto work = [&] {
+        DaaWorker w;
+        try {
+            ctx_alloc(&w.out_buf, job.chunksize, &w.outsz);
+            while (!stop.load(std::memory_order_relaxed)) {
+                if (job.cancel.cancelled()) { fail("cancelled"); return; }
+                const u32 i = next.fetch_add(1, std::memory_order_relaxed);
+                if (i >= total) return;
+                daa_decode_chunk(w, job, i);
+            }
+        } catch (const DaaError &e) {
+            fail(e.msg);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    try {
+        for (size_t t = 1; t < numThreads; ++t) threads.emplace_back(work);
+    } catch (const std::system_error &) {
+        // Fewer helpers than asked for still decode the whole image
+    }
+    work();
+    for (auto &th : threads) th.join();
+    return error;
+}
+
 // ═══════════════════════════════════════════════════════════════════════════
 //  Public API
 // ═══════════════════════════════════════════════════════════════════════════
 
 bool convertDaaToIso(const std::string &inputFile,
                      const std::string &outputFile,
-                     std::atomic<size_t> *completedBytes)
+                     std::atomic<size_t> *completedBytes,
+                     const CancellationToken &cancel)
 {
-    if (GlobalState::g_operationCancelled.load()) return false;
+    if (cancel.cancelled()) return false;
 
     DaaContext ctx;
     ctx.outputPath     = outputFile;
     ctx.completedBytes = completedBytes;
 
-    // Initialise per-instance state (replaces reset_bit_reader / tinf_init globals)
+    // Initialise per-instance state (replaces the reset_bit_reader global)
     ctx.powerisuxn = 0;
-    tinf_init(ctx.tinf);
 
     { int e = 1; ctx.endian = (*(char*)&e) ? 0 : 1; }
 
     ctx.fdi = fopen(inputFile.c_str(), "rb");
     if (!ctx.fdi) return false;
 
-    ctx.fdo = fopen(outputFile.c_str(), "wb");
-    if (!ctx.fdo) return daa_fail(ctx);
+    ctx.fdo = open(outputFile.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+    if (ctx.fdo < 0) return daa_fail(ctx);
 
     try {
         daa_t daa;
@@ -924,8 +1195,6 @@ bool convertDaaToIso(const std::string &inputFile,
         if ((daa.version != 0x100 && daa.version != 0x110) || daa.b1 != 1)
             throw DaaError("unsupported DAA version");
 
-        LzmaDec_Construct(&ctx.lzma);
-
         daa_data_t *daa_data = nullptr;
         u32 daas = 0, daas_mem = 0, daa_dataz = 0;
         int ztype=1, bitpos=0, bitsize=0, bittype=0;
@@ -972,11 +1241,7 @@ bool convertDaaToIso(const std::string &inputFile,
             ver110_btype = (ver110_y >> 0x17) & 3;
             if (ctx.daagbi == TYPE_GBI) ver110_btype ^= 1;
 
-            if (dolzma) {
-                lzma_filter = daa.hdata[6];
-                if (LzmaDec_Allocate(&ctx.lzma, daa.hdata + 7, LZMA_PROPS_SIZE, &g_Alloc) != SZ_OK)
-                    throw DaaError("LZMA property allocation failed");
-            }
+            if (dolzma) lzma_filter = daa.hdata[6];
         }
 
         switch (ver110_btype) {
@@ -1013,6 +1278,7 @@ bool convertDaaToIso(const std::string &inputFile,
 				ctx.multi_filename = (char*)malloc(plen + 32);
 				memcpy(ctx.multi_filename, fi, plen);
 				ctx.multi_filename[plen] = '\0';
+				ctx.multi_baselen = plen;
             }
         }
 
@@ -1022,7 +1288,7 @@ bool convertDaaToIso(const std::string &inputFile,
             ctx_alloc(&ctx.in, daa_dataz, &ctx.insz);
             ctx_read(ctx, ctx.in, daa_dataz);
             size_t destLen = daas_mem;
-            if (tinf_uncompress(ctx.tinf, (u8*)daa_data, &destLen, ctx.in, daa_dataz, ctx.swapped_btype) != TINF_OK)
+            if (daa_inflate((u8*)daa_data, &destLen, ctx.in, daa_dataz, ctx.swapped_btype) != INFLATE_OK)
                 throw DaaError("failed to decompress index table");
             u32 bits_per_entry = (u32)(bittype + bitsize);
             daas = (u32)(((u64)destLen << 3) / bits_per_entry);
@@ -1035,16 +1301,10 @@ bool convertDaaToIso(const std::string &inputFile,
 
         if (fseek(ctx.fdi, daa.data_offset, SEEK_SET)) throw DaaError("fseek to data_offset");
 
-        ctx_alloc(&ctx.out_buf, daa.chunksize, &ctx.outsz);
-        u64  tot        = 0;
-        u32  last_chunk = daas - 1;
-
+        // Walk the index once, up front: the v1.10 bit reader is sequential
+        std::vector<DaaChunk> chunks(daas);
+        u64 streamLen = 0;
         for (u32 i = 0; i < daas; i++) {
-            if (GlobalState::g_operationCancelled.load()) {
-                free(daa_data);
-                return daa_fail(ctx);
-            }
-
             u32 len;
             if (daa.version == 0x100) {
                 len   = ((u32)daa_data[i].n1<<16) | daa_data[i].n2 | ((u32)daa_data[i].n3<<8);
@@ -1060,52 +1320,52 @@ bool convertDaaToIso(const std::string &inputFile,
 
             if (len > 0x1000000) throw DaaError("excessive chunk length");
 
-            ctx_alloc(&ctx.in, len, &ctx.insz);
-            ctx_read(ctx, ctx.in, len);
-
-            u32 outlen;
-            switch (ztype) {
-                case -1:
-                    outlen = (len < daa.chunksize) ? len : daa.chunksize;
-                    memcpy(ctx.out_buf, ctx.in, outlen);
-                    break;
-                case 0:
-                    LzmaDec_Init(&ctx.lzma);
-                    outlen = lzma_decode_full(&ctx.lzma, ctx.in, len, ctx.out_buf, ctx.outsz);
-                    if (outlen == 0) throw DaaError("LZMA decompression failed");
-                    if (lzma_filter) poweriso_is_shit(ctx.out_buf, (int)outlen);
-                    break;
-                case 1: {
-                    size_t destLen = ctx.outsz;
-                    if (tinf_uncompress(ctx.tinf, ctx.out_buf, &destLen, ctx.in, len, ctx.swapped_btype) != TINF_OK)
-                        throw DaaError("INFLATE decompression failed");
-                    outlen = destLen;
-                    break;
-                }
-                default:
-                    throw DaaError("unknown compression type");
-            }
-
-            if (i == last_chunk) {
-                if ((tot + outlen) > daa.isosize)
-                    outlen = (u32)(daa.isosize - tot);
-            } else {
-                if (outlen != daa.chunksize)
-                    throw DaaError("chunk size mismatch");
-            }
-
-            if (fwrite(ctx.out_buf, 1, outlen, ctx.fdo) != outlen)
-                throw DaaError("write failed");
-
-            tot += outlen;
-            if (completedBytes)
-                completedBytes->fetch_add(outlen, std::memory_order_relaxed);
+            chunks[i] = {streamLen, len, ztype};
+            streamLen += len;
+        }
+        free(daa_data);
+        daa_data = nullptr;
+        if (daas == 0 && daa.isosize != 0) throw DaaError("output size mismatch");
+
+        // Map the chunk stream onto the volumes, opening as many as it spans
+        std::vector<DaaVolume> volumes;
+        auto addVolume = [&](FILE *f) {
+            struct stat st;
+            if (fstat(fileno(f), &st)) throw DaaError("cannot stat volume");
+            DaaVolume v;
+            v.fd     = fileno(f);
+            v.start  = (u64)ftell(f);
+            v.length = ((u64)st.st_size > v.start) ? (u64)st.st_size - v.start : 0;
+            v.base   = volumes.empty() ? 0 : volumes.back().base + volumes.back().length;
+            posix_fadvise(v.fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+            volumes.push_back(v);
+        };
+        addVolume(ctx.fdi);
+        while (ctx.multi && volumes.back().base + volumes.back().length < streamLen) {
+            ctx.extraVolumes.push_back(ctx_next_volume(ctx));
+            addVolume(ctx.extraVolumes.back());
         }
 
-        if (tot != daa.isosize) throw DaaError("output size mismatch");
+        DaaDecodeJob job;
+        job.chunks         = &chunks;
+        job.volumes        = &volumes;
+        job.chunksize      = daa.chunksize;
+        job.isosize        = daa.isosize;
+        job.swapped_btype  = ctx.swapped_btype;
+        job.lzmaProps      = dolzma ? daa.hdata + 7 : nullptr;
+        job.lzma_filter    = lzma_filter;
+        job.fdo            = ctx.fdo;
+        job.completedBytes = completedBytes;
+        job.cancel         = cancel;
+
+        if (const char *err = daa_decode_chunks(job)) {
+            if (cancel.cancelled()) return daa_fail(ctx);
+            throw DaaError(err);
+        }
 
-        free(daa_data);
-        fclose(ctx.fdo); ctx.fdo = nullptr;
+        const bool closed = close(ctx.fdo) == 0;
+        ctx.fdo = -1;
+        if (!closed) throw DaaError("write failed");
         fclose(ctx.fdi); ctx.fdi = nullptr;
         return true;
 
@@ -0,0 +1,483 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// C++ Standard Library Headers
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// C / System Headers
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Project Headers
+#include "../dirWalker.h"
+#include "../threadpool.h"
+
+namespace {
+
+    /// @brief One pending directory and the depth its entries will be reported at.
+    struct DirTask {
+        std::string path;
+        int depth;
+    };
+
+    /**
+     * @brief Per-worker task deque.
+     *
+     * The owner pushes and pops at the back; thieves take from the front, so
+     * the largest (shallowest) unexplored subtrees are the ones that migrate.
+     * Contention is limited to the rare moment a thief and the owner touch the
+     * same deque, so a plain mutex is cheaper here than anything cleverer.
+     */
+    struct alignas(64) WorkerDeque {
+        std::mutex mutex;
+        std::deque<DirTask> tasks;
+    };
+
+    /**
+     * @brief State shared by the caller and every helper of one walk.
+     *
+     * Held through a @c shared_ptr because a pool helper may only get scheduled
+     * after the walk has already finished; such a helper touches nothing but
+     * @c done and @c activeHelpers, never the callbacks.
+     */
+    struct WalkShared {
+        explicit WalkShared(std::size_t n) : deques(n), recorded(n) {}
+
+        std::vector<WorkerDeque> deques;
+        alignas(64) std::atomic<std::size_t> outstanding{0};
+        alignas(64) std::atomic<std::size_t> nextWorker{1};
+        std::atomic<std::size_t> activeHelpers{0};
+        std::atomic<bool> done{false};
+        std::atomic<bool> cancelled{false};
+
+        const DirWalkOptions* options = nullptr;
+        const ParallelDirWalker::FileCallback* onFile = nullptr;
+        const ParallelDirWalker::ErrorCallback* onError = nullptr;
+        const ParallelDirWalker::CountCallback* onCount = nullptr;
+
+        /// Directories stamped by each worker, merged into the output
+        /// snapshot once the walk is over so recording never takes a lock.
+        std::vector<std::vector<std::pair<std::string, DirStamp>>> recorded;
+    };
+
+    void pushTask(WalkShared& s, std::size_t worker, DirTask task) {
+        s.outstanding.fetch_add(1, std::memory_order_relaxed);
+        auto& dq = s.deques[worker];
+        std::lock_guard<std::mutex> lock(dq.mutex);
+        dq.tasks.push_back(std::move(task));
+    }
+
+    bool popLocal(WalkShared& s, std::size_t worker, DirTask& out) {
+        auto& dq = s.deques[worker];
+        std::lock_guard<std::mutex> lock(dq.mutex);
+        if (dq.tasks.empty()) return false;
+        out = std::move(dq.tasks.back());
+        dq.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(WalkShared& s, std::size_t thief, DirTask& out) {
+        const std::size_t n = s.deques.size();
+        for (std::size_t i = 1; i < n; ++i) {
+            auto& dq = s.deques[(thief + i) % n];
+            std::unique_lock<std::mutex> lock(dq.mutex, std::try_to_lock);
+            if (!lock.owns_lock() || dq.tasks.empty()) continue;
+            out = std::move(dq.tasks.front());
+            dq.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool pollCancelled(WalkShared& s) {
+        if (s.cancelled.load(std::memory_order_relaxed)) return true;
+        if (s.options->cancelled && s.options->cancelled()) {
+            s.cancelled.store(true, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /// @brief Record layout returned by getdents64(2); glibc only exposes it
+    /// under _GNU_SOURCE and with a different name, so it is spelled out here.
+    struct LinuxDirent64 {
+        std::uint64_t  d_ino;
+        std::int64_t   d_off;
+        unsigned short d_reclen;
+        unsigned char  d_type;
+        char           d_name[];
+    };
+
+    /// @brief Size of the per-thread getdents64 buffer. Large enough that a
+    /// directory of a few thousand entries is drained in one or two syscalls.
+    constexpr std::size_t DIRENT_BUFFER_SIZE = 256 * 1024;
+
+    char* direntBuffer() {
+        static thread_local std::unique_ptr<char[]> buffer(new char[DIRENT_BUFFER_SIZE]);
+        return buffer.get();
+    }
+
+    /// @brief Case-insensitive ASCII suffix test on raw entry bytes. A name
+    /// that is nothing but the suffix (e.g. ".iso") does not match, mirroring
+    /// `std::filesystem::path::extension()` on dot-files.
+    bool hasSuffix(std::string_view name, const std::vector<std::string>& suffixes) {
+        for (const auto& suffix : suffixes) {
+            if (name.size() <= suffix.size()) continue;
+            const char* tail = name.data() + (name.size() - suffix.size());
+            bool match = true;
+            for (std::size_t i = 0; i < suffix.size(); ++i) {
+                char c = tail[i];
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+                if (c != suffix[i]) { match = false; break; }
+            }
+            if (match) return true;
+        }
+        return false;
+    }
+
+    DirStamp stampFromStat(const struct stat& st) {
+        DirStamp stamp;
+        stamp.dev = static_cast<std::uint64_t>(st.st_dev);
+        stamp.ino = static_cast<std::uint64_t>(st.st_ino);
+        stamp.mtimeSec = st.st_mtim.tv_sec;
+        stamp.mtimeNsec = st.st_mtim.tv_nsec;
+        stamp.ctimeSec = st.st_ctim.tv_sec;
+        stamp.ctimeNsec = st.st_ctim.tv_nsec;
+        return stamp;
+    }
+
+    struct FdCloser {
+        int fd;
+        ~FdCloser() { if (fd != -1) ::close(fd); }
+    };
+
+    /**
+     * @brief Reads one directory, reporting files and queueing subdirectories.
+     *
+     * Entries are classified from `d_type`; `fstatat` is only issued for
+     * filesystems that report `DT_UNKNOWN`, and for symlinks whose target
+     * type matters. Names are handed out as views into the dirent buffer, so
+     * a non-matching file costs no allocation at all.
+     */
+    void scanDirectory(WalkShared& s, std::size_t worker, const DirTask& task) {
+        if (pollCancelled(s)) return;
+
+        const DirWalkOptions& opts = *s.options;
+        const bool descend = opts.maxDepth < 0 || task.depth + 1 <= opts.maxDepth;
+        const bool filtered = !opts.suffixes.empty();
+
+        FdCloser dir{::openat(AT_FDCWD, task.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)};
+        if (dir.fd == -1) {
+            const int err = errno;
+            // Still recorded, with an empty stamp, so its parent lists it and
+            // the next incremental walk retries it.
+            if (opts.snapshotOut) s.recorded[worker].emplace_back(task.path, DirStamp{});
+            if (*s.onError) (*s.onError)(task.path, std::error_code(err, std::generic_category()));
+            return;
+        }
+
+        DirStamp stamp;
+        const bool stamping = opts.previousSnapshot || opts.snapshotOut;
+        if (stamping) {
+            struct stat st;
+            if (::fstat(dir.fd, &st) == 0) {
+                stamp = stampFromStat(st);
+                const DirStamp* previous = opts.previousSnapshot ? opts.previousSnapshot->find(task.path) : nullptr;
+                if (previous && *previous == stamp) {
+                    // Listing unchanged since the last walk: reuse its subdirectories.
+                    for (const auto& child : opts.previousSnapshot->children(task.path)) {
+                        pushTask(s, worker, DirTask{child, task.depth + 1});
+                    }
+                    if (opts.snapshotOut) s.recorded[worker].emplace_back(task.path, stamp);
+                    return;
+                }
+            }
+        }
+
+        char* buffer = direntBuffer();
+        std::size_t filesSeen = 0;
+        bool complete = true;
+        std::size_t polled = 0;
+
+        while (true) {
+            const long nread = ::syscall(SYS_getdents64, dir.fd, buffer, DIRENT_BUFFER_SIZE);
+            if (nread == 0) break;
+            if (nread < 0) {
+                if (errno == EINTR) continue;
+                if (*s.onError) (*s.onError)(task.path, std::error_code(errno, std::generic_category()));
+                complete = false;
+                break;
+            }
+
+            for (long pos = 0; pos < nread;) {
+                const auto* d = reinterpret_cast<const LinuxDirent64*>(buffer + pos);
+                pos += d->d_reclen;
+
+                const char* raw = d->d_name;
+                if (raw[0] == '.' && (raw[1] == '\0' || (raw[1] == '.' && raw[2] == '\0'))) continue;
+                if ((++polled & 0xFF) == 0 && pollCancelled(s)) {
+                    if (s.onCount && *s.onCount) (*s.onCount)(filesSeen);
+                    return;
+                }
+
+                unsigned char type = d->d_type;
+                if (type == DT_UNKNOWN) {
+                    struct stat st;
+                    if (::fstatat(dir.fd, raw, &st, AT_SYMLINK_NOFOLLOW) != 0) continue;
+                    type = S_ISDIR(st.st_mode) ? DT_DIR :
+                           S_ISREG(st.st_mode) ? DT_REG :
+                           S_ISLNK(st.st_mode) ? DT_LNK : DT_UNKNOWN;
+                }
+
+                if (type == DT_LNK) {
+                    if (opts.skipSymlinks) continue;
+                    struct stat st;
+                    if (::fstatat(dir.fd, raw, &st, 0) != 0 || !S_ISREG(st.st_mode)) continue;
+                    type = DT_REG;
+                }
+
+                if (type == DT_DIR) {
+                    if (descend) pushTask(s, worker, DirTask{joinDirEntry(task.path, raw), task.depth + 1});
+                } else if (type == DT_REG) {
+                    ++filesSeen;
+                    std::string_view name(raw);
+                    if (!filtered || hasSuffix(name, opts.suffixes)) {
+                        (*s.onFile)(worker, task.path, name);
+                    }
+                }
+            }
+        }
+
+        if (filesSeen && s.onCount && *s.onCount) (*s.onCount)(filesSeen);
+        if (opts.snapshotOut) s.recorded[worker].emplace_back(task.path, complete ? stamp : DirStamp{});
+    }
+
+    /**
+     * @brief Main loop of one walker participant.
+     *
+     * Runs until no directory is queued or being read anywhere. Because a
+     * directory only spawns children while it is itself counted in
+     * @c outstanding, the counter reaching zero is final.
+     */
+    void runWorker(WalkShared& s, std::size_t worker) {
+        unsigned idleSpins = 0;
+        DirTask task;
+        while (true) {
+            if (popLocal(s, worker, task) || steal(s, worker, task)) {
+                idleSpins = 0;
+                scanDirectory(s, worker, task);
+                s.outstanding.fetch_sub(1, std::memory_order_acq_rel);
+                continue;
+            }
+            if (s.outstanding.load(std::memory_order_acquire) == 0) return;
+
+            if (++idleSpins < 64) {
+                #if defined(__x86_64__) || defined(_M_X64)
+                    __builtin_ia32_pause();
+                #else
+                    std::this_thread::yield();
+                #endif
+            } else if (idleSpins < 256) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+            }
+        }
+    }
+
+    void runHelper(const std::shared_ptr<WalkShared>& s) {
+        s->activeHelpers.fetch_add(1);
+        if (!s->done.load()) {
+            const std::size_t id = s->nextWorker.fetch_add(1, std::memory_order_relaxed);
+            if (id < s->deques.size()) runWorker(*s, id);
+        }
+        if (s->activeHelpers.fetch_sub(1) == 1) {
+            s->activeHelpers.notify_all();
+        }
+    }
+
+} // namespace
+
+ParallelDirWalker::ParallelDirWalker(DirWalkOptions options)
+    : options_(std::move(options)),
+      workers_(getStaticThreadPool().maxThreadCount() + 1) {}
+
+void ParallelDirWalker::walk(const std::vector<std::string>& roots,
+                             const FileCallback& onFile,
+                             const ErrorCallback& onError,
+                             const CountCallback& onCount) const {
+    if (roots.empty()) return;
+
+    auto shared = std::make_shared<WalkShared>(workers_);
+    shared->options = &options_;
+    shared->onFile = &onFile;
+    shared->onError = &onError;
+    shared->onCount = &onCount;
+
+    // Spread the roots so helpers have something to start on without stealing.
+    // Trailing slashes are dropped so paths match snapshot keys built by joinDirEntry.
+    for (std::size_t i = 0; i < roots.size(); ++i) {
+        std::string root = roots[i];
+        while (root.size() > 1 && root.back() == '/') root.pop_back();
+        pushTask(*shared, i % workers_, DirTask{std::move(root), 0});
+    }
+
+    auto& pool = getStaticThreadPool();
+    const std::size_t helpers = workers_ - 1;
+    for (std::size_t i = 0; i < helpers; ++i) {
+        pool.submit([shared] { runHelper(shared); });
+    }
+
+    runWorker(*shared, 0);
+
+    // No new helper may enter the loop past this point; wait for those inside.
+    shared->done.store(true);
+    std::size_t active = shared->activeHelpers.load();
+    while (active != 0) {
+        shared->activeHelpers.wait(active);
+        active = shared->activeHelpers.load();
+    }
+
+    if (options_.snapshotOut) {
+        for (auto& local : shared->recorded) {
+            for (auto& [path, stamp] : local) options_.snapshotOut->record(std::move(path), stamp);
+        }
+    }
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  DirSnapshot
+// ─────────────────────────────────────────────────────────────────────────────
+
+namespace {
+    constexpr const char* SNAPSHOT_MAGIC = "isocmd-dirsnapshot 1";
+
+    /// @brief Parent directory of an absolute path produced by the walker.
+    std::string parentOf(const std::string& path) {
+        const std::size_t pos = path.rfind('/');
+        if (pos == std::string::npos) return {};
+        return pos == 0 ? std::string("/") : path.substr(0, pos);
+    }
+}
+
+bool DirSnapshot::load(const std::string& filePath) {
+    stamps_.clear();
+    children_.clear();
+
+    FILE* file = std::fopen(filePath.c_str(), "r");
+    if (!file) return false;
+
+    char* linePtr = nullptr;
+    size_t len = 0;
+    bool ok = false;
+    long long savedAt = 0;
+
+    if (getline(&linePtr, &len, file) != -1) {
+        const std::size_t magicLen = std::strlen(SNAPSHOT_MAGIC);
+        if (std::strncmp(linePtr, SNAPSHOT_MAGIC, magicLen) == 0 &&
+            std::sscanf(linePtr + magicLen, "%lld", &savedAt) == 1) {
+            ok = true;
+        }
+    }
+
+    ssize_t n;
+    while (ok && (n = getline(&linePtr, &len, file)) != -1) {
+        if (n > 0 && linePtr[n - 1] == '\n') linePtr[--n] = '\0';
+
+        unsigned long long dev, ino;
+        long long ms, mns, cs, cns;
+        int consumed = 0;
+        if (std::sscanf(linePtr, "%llu %llu %lld %lld %lld %lld %n",
+                        &dev, &ino, &ms, &mns, &cs, &cns, &consumed) != 6 || consumed >= n) {
+            continue;
+        }
+        std::string path(linePtr + consumed, static_cast<std::size_t>(n - consumed));
+
+        std::string parent = parentOf(path);
+        if (!parent.empty() && parent != path) children_[parent].push_back(path);
+
+        // Unreadable when recorded, or changed in the same second the
+        // snapshot was taken: let the next walk read it again.
+        if (ino == 0 || ms >= savedAt - 1 || cs >= savedAt - 1) continue;
+
+        DirStamp stamp;
+        stamp.dev = dev; stamp.ino = ino;
+        stamp.mtimeSec = ms; stamp.mtimeNsec = mns;
+        stamp.ctimeSec = cs; stamp.ctimeNsec = cns;
+        stamps_.emplace(std::move(path), stamp);
+    }
+
+    free(linePtr);
+    std::fclose(file);
+    if (!ok) { stamps_.clear(); children_.clear(); }
+    return ok;
+}
+
+bool DirSnapshot::save(const std::string& filePath) const {
+    std::string output;
+    output.reserve(stamps_.size() * 96 + 64);
+    output.append(SNAPSHOT_MAGIC).append(" ")
+          .append(std::to_string(static_cast<long long>(std::time(nullptr)))).append("\n");
+
+    char numbers[160];
+    for (const auto& [path, st] : stamps_) {
+        int w = std::snprintf(numbers, sizeof(numbers), "%llu %llu %lld %lld %lld %lld ",
+                              static_cast<unsigned long long>(st.dev), static_cast<unsigned long long>(st.ino),
+                              static_cast<long long>(st.mtimeSec), static_cast<long long>(st.mtimeNsec),
+                              static_cast<long long>(st.ctimeSec), static_cast<long long>(st.ctimeNsec));
+        output.append(numbers, static_cast<std::size_t>(w)).append(path).append("\n");
+    }
+
+    const std::size_t slash = filePath.rfind('/');
+    std::string tmpPath = (slash == std::string::npos ? std::string() : filePath.substr(0, slash + 1))
+                        + "iso_commander_dir_snapshot_XXXXXX";
+    int tmpFd = mkstemp(tmpPath.data());
+    if (tmpFd == -1) return false;
+
+    auto cleanupTmp = [&]() {
+        ::close(tmpFd);
+        ::unlink(tmpPath.c_str());
+    };
+    if (fchmod(tmpFd, 0644) == -1) { cleanupTmp(); return false; }
+    if (::write(tmpFd, output.data(), output.size()) != static_cast<ssize_t>(output.size())) { cleanupTmp(); return false; }
+    if (fsync(tmpFd) == -1) { cleanupTmp(); return false; }
+    ::close(tmpFd);
+
+    if (::rename(tmpPath.c_str(), filePath.c_str()) == -1) {
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+void DirSnapshot::record(std::string dir, const DirStamp& stamp) {
+    stamps_.insert_or_assign(std::move(dir), stamp);
+}
+
+const DirStamp* DirSnapshot::find(const std::string& dir) const {
+    auto it = stamps_.find(dir);
+    return it == stamps_.end() ? nullptr : &it->second;
+}
+
+const std::vector<std::string>& DirSnapshot::children(const std::string& dir) const {
+    static const std::vector<std::string> none;
+    auto it = children_.find(dir);
+    return it == children_.end() ? none : it->second;
+}
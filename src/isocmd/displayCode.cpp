@@ -23,11 +23,15 @@
 #include "../filtering.h"
 #include "../inputHandling.h"
 #include "../globalMutexes.h"
+#include "../pathTable.h"
 #include "../pausePrompt.h"
 #include "../sort.h"
 #include "../state.h"
 #include "../themes.h"
 
+void printList(const PathList& items, const std::string& listType, const std::string& listSubType,
+               std::vector<std::string>& pendingIndices, bool& hasPendingProcess, bool& isFiltered,
+               size_t& currentPage, std::shared_ptr<RefreshState> state);
 void printList(const std::vector<std::string>& items, const std::string& listType, const std::string& listSubType,
                std::vector<std::string>& pendingIndices, bool& hasPendingProcess, bool& isFiltered,
                size_t& currentPage, std::shared_ptr<RefreshState> state);
@@ -59,7 +63,7 @@ size_t& currentPage, size_t& originalPage, std::shared_ptr<RefreshState> state)
     disable_ctrl_d();
 
     bool needToReload = GlobalState::isoListDirty.exchange(false);
-    std::vector<std::string> freshList;
+    PathList freshList;
 
     if (needToReload) {
         loadFromDatabase(freshList);
@@ -96,8 +100,13 @@ size_t& currentPage, size_t& originalPage, std::shared_ptr<RefreshState> state)
         clearScrollBuffer();
 
         // Use either the recently refreshed filteredFiles or the global master list
-        printList(isFiltered ? filteredFiles : GlobalState::globalIsoFileList, "ISO_FILES", listSubType,
-                  pendingIndices, hasPendingProcess, isFiltered, currentPage, state);
+        if (isFiltered) {
+            printList(filteredFiles, "ISO_FILES", listSubType,
+                      pendingIndices, hasPendingProcess, isFiltered, currentPage, state);
+        } else {
+            printList(GlobalState::globalIsoFileList, "ISO_FILES", listSubType,
+                      pendingIndices, hasPendingProcess, isFiltered, currentPage, state);
+        }
 
         isEmpty = GlobalState::globalIsoFileList.empty();
     }
@@ -249,42 +258,32 @@ void loadAndDisplayImageFiles(std::vector<std::string>& files, const std::string
     clearScrollBuffer();
 
     // Restore from the appropriate cache when not filtered and the cache is valid
-    files =
-    (!isFiltered && !GlobalState::binImgFilesCache.empty() && (fileType == "bin" || fileType == "img") &&
-     (GlobalState::binImgFilesCache.size() != files.size() || !std::equal(GlobalState::binImgFilesCache.begin(), GlobalState::binImgFilesCache.end(), files.begin())))
-        ? (need2Sort = true, GlobalState::binImgFilesCache)
-    : (!isFiltered && !GlobalState::mdfMdsFilesCache.empty() && fileType == "mdf" &&
-       (GlobalState::mdfMdsFilesCache.size() != files.size() || !std::equal(GlobalState::mdfMdsFilesCache.begin(), GlobalState::mdfMdsFilesCache.end(), files.begin())))
-        ? (need2Sort = true, GlobalState::mdfMdsFilesCache)
-    : (!isFiltered && !GlobalState::nrgFilesCache.empty() && fileType == "nrg" &&
-       (GlobalState::nrgFilesCache.size() != files.size() || !std::equal(GlobalState::nrgFilesCache.begin(), GlobalState::nrgFilesCache.end(), files.begin())))
-        ? (need2Sort = true, GlobalState::nrgFilesCache)
-    : (!isFiltered && !GlobalState::chdFilesCache.empty() && fileType == "chd" &&
-       (GlobalState::chdFilesCache.size() != files.size() || !std::equal(GlobalState::chdFilesCache.begin(), GlobalState::chdFilesCache.end(), files.begin())))
-        ? (need2Sort = true, GlobalState::chdFilesCache)
-    : (!isFiltered && !GlobalState::daaGbiFilesCache.empty() && fileType == "daa" &&               // <-- DAA branch
-       (GlobalState::daaGbiFilesCache.size() != files.size() || !std::equal(GlobalState::daaGbiFilesCache.begin(), GlobalState::daaGbiFilesCache.end(), files.begin())))
-        ? (need2Sort = true, GlobalState::daaGbiFilesCache)
-    : files;
+    ImageFileCache* cache =
+        (fileType == "bin" || fileType == "img") ? &GlobalState::binImgFilesCache :
+        (fileType == "mdf") ? &GlobalState::mdfMdsFilesCache :
+        (fileType == "nrg") ? &GlobalState::nrgFilesCache :
+        (fileType == "chd") ? &GlobalState::chdFilesCache :
+        (fileType == "daa") ? &GlobalState::daaGbiFilesCache : nullptr;
+
+    if (cache && !isFiltered) {
+        cache->withOrdered([&](const std::vector<const std::string*>& cached) {
+            const bool same = cached.size() == files.size() &&
+                std::equal(cached.begin(), cached.end(), files.begin(),
+                           [](const std::string* a, const std::string& b) { return *a == b; });
+            if (!cached.empty() && !same) {
+                files.clear();
+                files.reserve(cached.size());
+                for (const std::string* p : cached) files.push_back(*p);
+                need2Sort = true;
+            }
+        });
+    }
 
     if (!list || (list && GlobalState::needSortingAfterflno)) {
         if (need2Sort) {
             sortFilesCaseInsensitive(files);
-            if (fileType == "bin" || fileType == "img") {
-                std::lock_guard<std::mutex> lock(GlobalMutexes::binImgCacheMutex);
-                sortFilesCaseInsensitive(GlobalState::binImgFilesCache);
-            } else if (fileType == "mdf") {
-                std::lock_guard<std::mutex> lock(GlobalMutexes::mdfMdsCacheMutex);
-                sortFilesCaseInsensitive(GlobalState::mdfMdsFilesCache);
-            } else if (fileType == "nrg") {
-                std::lock_guard<std::mutex> lock(GlobalMutexes::nrgCacheMutex);
-                sortFilesCaseInsensitive(GlobalState::nrgFilesCache);
-            } else if (fileType == "chd") {
-                std::lock_guard<std::mutex> lock(GlobalMutexes::chdCacheMutex);
-                sortFilesCaseInsensitive(GlobalState::chdFilesCache);
-            } else if (fileType == "daa") {
-                std::lock_guard<std::mutex> lock(GlobalMutexes::daaGbiCacheMutex);
-                sortFilesCaseInsensitive(GlobalState::daaGbiFilesCache);
+            if (cache) {
+                cache->withOrdered([](std::vector<const std::string*>& cached) { sortFilesCaseInsensitive(cached); });
             }
         }
         GlobalState::needSortingAfterflno = false;
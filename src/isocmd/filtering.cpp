@@ -27,11 +27,15 @@
 
 // Project Headers
 #include "../concurrency.h"
+#include "../databaseOps.h"
 #include "../display.h"
 #include "../filtering.h"
 #include "../history.h"
+#include "../pathSearchIndex.h"
+#include "../pathTable.h"
 #include "../readline.h"
 #include "../stringManipulation.h"
+#include "../substringSearch.h"
 #include "../themes.h"
 #include "../state.h"
 #include "../threadpool.h"
@@ -43,91 +47,13 @@ namespace AnsiEscape {
     constexpr const char* CLEAR_TWO_LINES  = "\033[2A\033[K";
 }
 
-// ─── Boyer-Moore implementation ──────────────────────────────────────────────
-
-/**
- * @brief Precomputes Boyer-Moore bad character and good suffix tables for a pattern
- *
- * @param pattern The search pattern to precompute tables for
- * @param badCharTable Output table mapping characters to their last occurrence index
- * @param goodSuffixTable Output table with safe skip distances for suffix mismatches
- */
-void precomputeBoyerMooreTables(const std::string& pattern, std::vector<int>& badCharTable, std::vector<int>& goodSuffixTable)
-{
-    const size_t m             = pattern.size();
-    const int    ALPHABET_SIZE = 256;
-
-    badCharTable.assign(ALPHABET_SIZE, -1);
-    for (int i = 0; i < static_cast<int>(m); ++i)
-        badCharTable[static_cast<unsigned char>(pattern[i])] = i;
-
-    goodSuffixTable.resize(m, static_cast<int>(m));
-    std::vector<int> suffix(m, 0);
-
-    suffix[m - 1] = static_cast<int>(m);
-    int g = static_cast<int>(m) - 1;
-    int f = static_cast<int>(m) - 1;
-
-    for (int i = static_cast<int>(m) - 2; i >= 0; --i) {
-        if (i > g && suffix[i + m - 1 - f] < i - g) {
-            suffix[i] = suffix[i + m - 1 - f];
-        } else {
-            g = std::min(g, i);
-            f = i;
-            while (g >= 0 && pattern[g] == pattern[g + m - 1 - f])
-                --g;
-            suffix[i] = f - g;
-        }
-    }
-
-    for (int i = 0; i < static_cast<int>(m) - 1; ++i)
-        goodSuffixTable[i] = static_cast<int>(m) - 1 - suffix[0];
-
-    for (int i = 0; i <= static_cast<int>(m) - 2; ++i) {
-        const int j = static_cast<int>(m) - 1 - suffix[i];
-        if (goodSuffixTable[j] > static_cast<int>(m) - 1 - i)
-            goodSuffixTable[j] = static_cast<int>(m) - 1 - i;
-    }
-}
-
-/**
- * @brief Performs Boyer-Moore search to check if pattern exists in text
- *
- * @param text The text to search within
- * @param pattern The pattern to search for
- * @param badCharTable Precomputed bad character shift table
- * @param goodSuffixTable Precomputed good suffix shift table
- * @return true if pattern is found, false otherwise
- */
-bool boyerMooreSearchExists(const std::string& text, const std::string& pattern, const std::vector<int>& badCharTable, const std::vector<int>& goodSuffixTable)
-{
-    const size_t n = text.size();
-    const size_t m = pattern.size();
-    if (m == 0 || m > n) return false;
-
-    int s = 0;
-    while (s <= static_cast<int>(n - m)) {
-        int j = static_cast<int>(m) - 1;
-        while (j >= 0 && text[s + j] == pattern[j])
-            --j;
-
-        if (j < 0)
-            return true;
-
-        const int bcShift = j - badCharTable[static_cast<unsigned char>(text[s + j])];
-        const int gsShift = goodSuffixTable[j];
-        s += std::max(1, std::max(bcShift, gsShift));
-    }
-    return false;
-}
-
 // ─── Query tokenization ──────────────────────────────────────────────────────
 
 /**
  * @brief Builds query tokens from a semicolon-separated query string
  *
  * @param query The query string to tokenize
- * @return Vector of QueryToken objects ready for Boyer-Moore searching
+ * @return Vector of QueryToken objects ready for @ref containsSubstring
  */
 static std::vector<QueryToken> buildQueryTokens(const std::string& query) {
     std::vector<QueryToken> tokens;
@@ -142,12 +68,9 @@ static std::vector<QueryToken> buildQueryTokens(const std::string& query) {
         qt.isCaseSensitive = std::any_of(token.begin(), token.end(),
                                  [](unsigned char c) { return std::isupper(c); });
 
-        precomputeBoyerMooreTables(qt.original, qt.originalBadChar, qt.originalGoodSuffix);
-
         if (!qt.isCaseSensitive) {
             qt.lower = token;
             toLowerInPlace(qt.lower);
-            precomputeBoyerMooreTables(qt.lower, qt.lowerBadChar, qt.lowerGoodSuffix);
         }
 
         tokens.push_back(std::move(qt));
@@ -158,69 +81,60 @@ static std::vector<QueryToken> buildQueryTokens(const std::string& query) {
 // ─── Core filter engine ──────────────────────────────────────────────────────
 
 /**
- * @brief Filters file indices based on a search query using Boyer-Moore algorithm
+ * @brief Filters indices [0, count) based on a search query
  *
- * @param files Vector of file paths to filter
- * @param query Search query with semicolon-separated terms
+ * Each candidate is matched with the vectorised @ref containsSubstring, which
+ * folds case as it reads, so no lowered copy of the candidate is made.
+ *
+ * @param count  Number of candidates
+ * @param keyAt  Returns the text to search for candidate @c j as a view; it may
+ *               assemble the text in the per-thread buffer it is given
+ * @param query  Search query with semicolon-separated terms
  * @return Vector of indices matching the search criteria
  */
-std::vector<size_t> filterFilesIndices(const std::vector<std::string>& files, const std::string& query)
+template <typename KeyAt>
+static std::vector<size_t> filterIndices(const size_t count, const KeyAt& keyAt, const std::string& query)
 {
-    if (files.empty() || query.empty()) return {};
+    if (count == 0 || query.empty()) return {};
 
     const std::vector<QueryToken> queryTokens = buildQueryTokens(query);
     if (queryTokens.empty()) {
-        std::vector<size_t> allIndices(files.size());
+        std::vector<size_t> allIndices(count);
         std::iota(allIndices.begin(), allIndices.end(), 0);
         return allIndices;
     }
 
-    const bool needLower = std::any_of(queryTokens.begin(), queryTokens.end(),
-                               [](const QueryToken& qt) { return !qt.isCaseSensitive; });
-
     ThreadPool&  pool       = getStaticThreadPool();
     const size_t numThreads = std::min({
         pool.threadCount(),
-        files.size(),
+        count,
         static_cast<size_t>(GlobalConcurrency::FILTER_THREAD_CAP)
     });
 
-    const size_t chunkSize  = (files.size() + numThreads - 1) / numThreads;
+    const size_t chunkSize  = (count + numThreads - 1) / numThreads;
 
     std::vector<std::future<std::vector<size_t>>> futures;
         futures.reserve(numThreads);
 
     for (size_t i = 0; i < numThreads; ++i) {
         const size_t start = i * chunkSize;
-        const size_t end   = std::min(files.size(), start + chunkSize);
+        const size_t end   = std::min(count, start + chunkSize);
         if (start >= end) break;
 
-        futures.emplace_back(pool.enqueue(
-            [&files, start, end, needLower, &queryTokens]() -> std::vector<size_t> {
+        futures.emplace_back(pool.enqueueAt(TaskPriority::Interactive,
+            [&keyAt, start, end, &queryTokens]() -> std::vector<size_t> {
                 std::vector<size_t> localMatches;
                 localMatches.reserve((end - start) / 4);
 
-                std::string fileLower;
-                if (needLower)
-                    fileLower.reserve(256);
+                std::string fileBuffer;
 
                 for (size_t j = start; j < end; ++j) {
-                    const std::string& file = files[j];
-
-                    if (needLower) {
-                        fileLower = file;
-                        toLowerInPlace(fileLower);
-                    }
+                    const std::string_view file = keyAt(j, fileBuffer);
 
                     for (const auto& qt : queryTokens) {
-                        bool match;
-                        if (qt.isCaseSensitive) {
-                            match = boyerMooreSearchExists(file,      qt.original,
-                                                            qt.originalBadChar, qt.originalGoodSuffix);
-                        } else {
-                            match = boyerMooreSearchExists(fileLower, qt.lower,
-                                                            qt.lowerBadChar,    qt.lowerGoodSuffix);
-                        }
+                        const bool match = qt.isCaseSensitive
+                            ? containsSubstring(file, qt.original, false)
+                            : containsSubstring(file, qt.lower, true);
                         if (match) {
                             localMatches.push_back(j);
                             break;
@@ -233,7 +147,7 @@ std::vector<size_t> filterFilesIndices(const std::vector<std::string>& files, co
     }
 
     std::vector<size_t> filteredIndices;
-    filteredIndices.reserve(files.size());
+    filteredIndices.reserve(count);
 
     std::exception_ptr firstException;
 
@@ -255,6 +169,73 @@ std::vector<size_t> filterFilesIndices(const std::vector<std::string>& files, co
     return filteredIndices;
 }
 
+/**
+ * @brief Filters file indices based on a search query
+ *
+ * @param files Vector of file paths to filter
+ * @param query Search query with semicolon-separated terms
+ * @return Vector of indices matching the search criteria
+ */
+std::vector<size_t> filterFilesIndices(const std::vector<std::string>& files, const std::string& query)
+{
+    return filterIndices(files.size(),
+        [&files](size_t j, std::string&) -> std::string_view { return files[j]; }, query);
+}
+
+/**
+ * @brief Filters positions of @p files (restricted to @p subset when non-null).
+ *
+ * Searches names straight from the interned table; full paths are joined into
+ * a per-thread buffer, so no per-entry string is allocated. Once the list's
+ * trigram index is ready, only the entries it reports as candidates are
+ * checked; terms shorter than three characters fall back to a full scan.
+ *
+ * @return Indices into @p subset when given, otherwise into @p files.
+ */
+static std::vector<size_t> filterPathListIndices(const PathList& files, const std::vector<size_t>* subset,
+                                                 bool namesOnly, const std::string& query)
+{
+    const size_t count = subset ? subset->size() : files.size();
+
+    // Narrow to index candidates (positions into the subset/list), if possible.
+    std::vector<size_t> candidates;
+    bool narrowed = false;
+    if (auto index = isoSearchIndexFor(files)) {
+        const std::vector<QueryToken> tokens = buildQueryTokens(query);
+        std::vector<std::string> lowered;
+        lowered.reserve(tokens.size());
+        for (const auto& qt : tokens) {
+            lowered.push_back(qt.isCaseSensitive ? qt.original : qt.lower);
+            if (qt.isCaseSensitive) toLowerInPlace(lowered.back());
+        }
+        const std::vector<std::string_view> terms(lowered.begin(), lowered.end());
+
+        std::vector<unsigned char> marks;
+        if (!terms.empty() && index->markCandidates(terms, namesOnly, marks)) {
+            const std::vector<PathTable::Id>& order = files.order();
+            for (size_t j = 0; j < count; ++j) {
+                if (marks[order[subset ? (*subset)[j] : j]]) candidates.push_back(j);
+            }
+            narrowed = true;
+        }
+    }
+
+    auto keyAt = [&files, subset, namesOnly](size_t j, std::string& buffer) -> std::string_view {
+        const size_t i = subset ? (*subset)[j] : j;
+        if (namesOnly) return files.name(i);
+        buffer.clear();
+        files.appendPath(i, buffer);
+        return buffer;
+    };
+
+    if (!narrowed) return filterIndices(count, keyAt, query);
+
+    std::vector<size_t> matches = filterIndices(candidates.size(),
+        [&candidates, &keyAt](size_t k, std::string& buffer) { return keyAt(candidates[k], buffer); }, query);
+    for (size_t& m : matches) m = candidates[m];
+    return matches;
+}
+
 // ─── Shared filtering core ───────────────────────────────────────────────────
 
 /**
@@ -273,47 +254,46 @@ std::vector<size_t> filterFilesIndices(const std::vector<std::string>& files, co
 static bool applyFilterCore(const std::string& searchString, FilterContext& ctx) {
     if (searchString.empty()) return false;
 
-    const std::vector<std::string>& sourceList =
-        ctx.sourceOverride ? *ctx.sourceOverride : ctx.files;
-
-    auto extractUnmountKey = [](const std::string& path) -> std::string {
+    auto extractUnmountKey = [](std::string_view path) -> std::string_view {
         size_t lastSlash = path.find_last_of('/');
-        std::string name = (lastSlash != std::string::npos) ? path.substr(lastSlash + 1) : path;
+        std::string_view name = (lastSlash != std::string_view::npos) ? path.substr(lastSlash + 1) : path;
         size_t lastTilde = name.find_last_of('~');
-        return (lastTilde != std::string::npos) ? name.substr(0, lastTilde) : name;
+        return (lastTilde != std::string_view::npos) ? name.substr(0, lastTilde) : name;
     };
 
     std::vector<std::string> tempFiltered;
     std::vector<size_t>      tempIndices;
+    size_t                   sourceSize = 0;
 
     const bool useNameOnly   = displayConfig::toggleNamesOnly && !ctx.isUnmount;
     const bool useUnmountKey = ctx.isUnmount && !ctx.toggleFullListUmount;
 
-    if (useNameOnly || useUnmountKey) {
-        std::vector<std::string> derived;
-        derived.reserve(sourceList.size());
-        for (const auto& path : sourceList) {
-            if (useUnmountKey) {
-                derived.push_back(extractUnmountKey(path));
-            } else {
-                size_t lastSlash = path.find_last_of('/');
-                derived.push_back((lastSlash != std::string::npos)
-                                  ? path.substr(lastSlash + 1)
-                                  : path);
-            }
-        }
-
-        auto matchedIndices = filterFilesIndices(derived, searchString);
-        if (matchedIndices.empty()) return false;
+    if (ctx.pathSource) {
+        const PathList& sourceList = *ctx.pathSource;
+        sourceSize  = sourceList.size();
+        tempIndices = filterPathListIndices(sourceList, nullptr, useNameOnly, searchString);
+        if (tempIndices.empty()) return false;
 
-        tempFiltered.reserve(matchedIndices.size());
-        tempIndices.reserve(matchedIndices.size());
-        for (size_t idx : matchedIndices) {
-            tempFiltered.push_back(sourceList[idx]);
-            tempIndices.push_back(idx);
+        tempFiltered.reserve(tempIndices.size());
+        for (size_t idx : tempIndices) {
+            tempFiltered.push_back(sourceList.path(idx));
         }
     } else {
-        tempIndices = filterFilesIndices(sourceList, searchString);
+        const std::vector<std::string>& sourceList =
+            ctx.sourceOverride ? *ctx.sourceOverride : ctx.files;
+        sourceSize = sourceList.size();
+
+        if (useNameOnly || useUnmountKey) {
+            tempIndices = filterIndices(sourceList.size(),
+                [&](size_t j, std::string&) -> std::string_view {
+                    const std::string_view path = sourceList[j];
+                    if (useUnmountKey) return extractUnmountKey(path);
+                    const size_t lastSlash = path.find_last_of('/');
+                    return (lastSlash != std::string_view::npos) ? path.substr(lastSlash + 1) : path;
+                }, searchString);
+        } else {
+            tempIndices = filterFilesIndices(sourceList, searchString);
+        }
         if (tempIndices.empty()) return false;
 
         tempFiltered.reserve(tempIndices.size());
@@ -323,7 +303,7 @@ static bool applyFilterCore(const std::string& searchString, FilterContext& ctx)
     }
 
     if (tempFiltered.empty())                     return false;
-    if (tempFiltered.size() == sourceList.size()) {
+    if (tempFiltered.size() == sourceSize) {
         std::cout << AnsiEscape::CLEAR_LINE_ABOVE;
         return true;
     }
@@ -451,7 +431,8 @@ static void runFilterLoop(const std::string& promptText, FilterContext& ctx,
  * * @section filtering_logic Logic Flow:
  * 1.  **Initialization**: Starts with a full range of indices representing @ref globalIsoFileList.
  * 2.  **Iterative Filtering**: For each @ref FilteringState in the stack:
- * - Extracts filenames or full paths based on @ref displayConfig::toggleNamesOnly.
+ * - Searches filenames or full paths based on @ref displayConfig::toggleNamesOnly,
+ *   read in place from the interned list.
  * - Executes the @ref filterFilesIndices function with the current query.
  * - Maps the resulting local indices back to the original global file indices.
  * - Updates the active index set for the next stack iteration.
@@ -466,7 +447,7 @@ static void runFilterLoop(const std::string& promptText, FilterContext& ctx,
  * or will be cleared if no matches are found.
  */
 void syncFilteringStackForIso(
-    const std::vector<std::string>& globalIsoFileList,
+    const PathList& globalIsoFileList,
     std::vector<FilteringState>& filteringStack,
     std::vector<std::string>& filteredFiles,
     bool& isFiltered)
@@ -483,22 +464,9 @@ void syncFilteringStackForIso(
 
     // Iterate through each filter in the stack
     for (auto& state : filteringStack) {
-        std::vector<std::string> searchList;
-        searchList.reserve(currentIndices.size());
-
-        // Prepare the strings to search (Full Path vs File Name only)
-        for (size_t idx : currentIndices) {
-            const std::string& path = globalIsoFileList[idx];
-            if (displayConfig::toggleNamesOnly) {
-                size_t lastSlash = path.find_last_of('/');
-                searchList.push_back(lastSlash != std::string::npos ? path.substr(lastSlash + 1) : path);
-            } else {
-                searchList.push_back(path);
-            }
-        }
-
-        // Apply the filter query to the current subset
-        auto localMatches = filterFilesIndices(searchList, state.query);
+        // Search the current subset in place (Full Path vs File Name only)
+        auto localMatches = filterPathListIndices(globalIsoFileList, &currentIndices,
+                                                  displayConfig::toggleNamesOnly, state.query);
 
         if (localMatches.empty()) {
             broken = true;
@@ -526,7 +494,7 @@ void syncFilteringStackForIso(
         filteredFiles.clear();
         filteredFiles.reserve(currentIndices.size());
         for (size_t idx : currentIndices) {
-            filteredFiles.push_back(globalIsoFileList[idx]);
+            filteredFiles.push_back(globalIsoFileList.path(idx));
         }
     }
 }
@@ -592,8 +560,9 @@ bool runSharedFilterFlow(const std::string& inputString, const FilterCallConfig&
         *cfg.filterHistory,
         *cfg.currentPage
     };
-    if (cfg.sourceOverride) {
+    if (cfg.sourceOverride || cfg.pathSource) {
         ctx.sourceOverride       = cfg.sourceOverride;
+        ctx.pathSource           = cfg.pathSource;
         ctx.isUnmount            = cfg.isUnmount;
         ctx.toggleFullListUmount = cfg.toggleFullList;
     }
@@ -635,12 +604,13 @@ bool handleFilteringForISO(const std::string& inputString, std::vector<std::stri
     const std::string& operation, const std::string& operationColor,
     const std::vector<std::string>& isoDirs, bool isUnmount, size_t& currentPage)
 {
-    const std::vector<std::string>& baseSource =
-        isFiltered ? filteredFiles : (isUnmount ? isoDirs : GlobalState::globalIsoFileList);
+    const bool fromIsoList = !isFiltered && !isUnmount;
+    const std::vector<std::string>& baseSource = isFiltered ? filteredFiles : isoDirs;
 
     return runSharedFilterFlow(inputString, {
         .files          = &filteredFiles,
-        .sourceOverride = &baseSource,
+        .sourceOverride = fromIsoList ? nullptr : &baseSource,
+        .pathSource     = fromIsoList ? &GlobalState::globalIsoFileList : nullptr,
         .operation      = operation,
         .operationColor = operationColor,
         .isFiltered     = &isFiltered,
@@ -159,7 +159,11 @@ void helpSearches(bool isCpMv, bool import2ISO) {
         } else {
             displayCmds +=
                 "   " + std::string(UI::Palette::BoldReset) + "• " + std::string(UI::Palette::Blue) +
-                "'*stats'     " + std::string(UI::Palette::BoldReset) + " : Display stats";
+                "'*stats'     " + std::string(UI::Palette::BoldReset) + " : Display stats\n" +
+                "   " + std::string(UI::Palette::BoldReset) + "• " + std::string(UI::Palette::Blue) +
+                "'*export'    " + std::string(UI::Palette::BoldReset) + " : Export IsoDatabase as text\n" +
+                "   " + std::string(UI::Palette::BoldReset) + "• " + std::string(UI::Palette::Blue) +
+                "'*import'    " + std::string(UI::Palette::BoldReset) + " : Import IsoDatabase from text";
         }
         printSection(tc, "3. Cleanup/Display Commands (↵):", displayCmds);
         printSection(tc, "\n4. Tips:",
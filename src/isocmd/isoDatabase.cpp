@@ -9,7 +9,6 @@
 #include <cstddef>
 #include <cstdint>
 #include <filesystem>
-#include <future>
 #include <iomanip>
 #include <iostream>
 #include <fstream>
@@ -18,6 +17,7 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <system_error>
 #include <thread>
 #include <unordered_set>
 #include <utility>
@@ -33,156 +33,93 @@
 #include <unistd.h>
 
 // Project Headers
+#include "../asyncIo.h"
 #include "../caches.h"
+#include "../cancellation.h"
 #include "../concurrency.h"
 #include "../databaseOps.h"
+#include "../dirWalker.h"
 #include "../history.h"
 #include "../inputHandling.h"
+#include "../isoDatabaseStore.h"
 #include "../globalMutexes.h"
+#include "../pathSearchIndex.h"
+#include "../pathTable.h"
 #include "../pausePrompt.h"
 #include "../sharedRefreshState.h"
 #include "../state.h"
 #include "../themes.h"
 #include "../threadpool.h"
 
-// Local ISO Database mutex
-namespace {
-    std::mutex dbFileMutex;
-}
-
 /**
  * @brief Removes non-existent ISO paths from the database and in-memory cache.
  *
- * Reads the database file under a shared lock, then checks each path for
- * existence in parallel via a thread pool. If any paths are missing, writes
- * the surviving entries to a temporary file in the same directory as the
- * database and atomically renames it into place — ensuring readers always
- * see either the complete old file or the complete new one, never a partial
- * write. Updates the in-memory list only if at least one path was removed.
+ * Interns the stored paths into a @ref PathTable, checks each for existence
+ * in parallel via a thread pool, and removes only the missing ones from the
+ * store; surviving entries are never rewritten. Updates the in-memory list only if at least
+ * one path was removed, and then drops the directory snapshot too.
  *
  * @param globalIsoFileList  Reference to the in-memory list of ISO files to update.
  */
-void removeNonExistentPathsFromDatabase(std::vector<std::string>& globalIsoFileList)
+void removeNonExistentPathsFromDatabase(PathList& globalIsoFileList)
 {
-    std::vector<std::string> retained;
-    bool anyRemoved = false;
-    {
-        std::lock_guard<std::mutex> fileLock(dbFileMutex);
-        int fd = open(GlobalState::databaseFilePath.c_str(), O_RDONLY);
-        if (fd == -1) {
-            if (errno == ENOENT) {
-                std::lock_guard<std::mutex> lock(GlobalMutexes::updateListMutex);
-                globalIsoFileList.clear();
-            }
-            return;
-        }
-        struct FdGuard {
-            int fd;
-            ~FdGuard() { if (fd != -1) { flock(fd, LOCK_UN); close(fd); } }
-            void release() { fd = -1; }
-        } fdGuard{fd};
-
-        if (flock(fd, LOCK_SH) == -1) return;
-
-        int dupFd = dup(fd);
-        if (dupFd == -1) return;
-        FILE* file = fdopen(dupFd, "r");
-        if (!file) { close(dupFd); return; }
-
-        std::vector<std::string> cache;
-        char* linePtr = nullptr;
-        size_t len    = 0;
-        while (getline(&linePtr, &len, file) != -1) {
-            std::string line(linePtr);
-            if (!line.empty() && line.back() == '\n') line.pop_back();
-            if (!line.empty()) cache.push_back(std::move(line));
-        }
-        free(linePtr);
-        fclose(file);
-
-        // Release the read lock and close the original fd — we're done reading
-        fdGuard.release();
-        flock(fd, LOCK_UN);
-        close(fd);
+    IsoDatabaseStore& store = IsoDatabaseStore::instance();
 
-        if (cache.empty()) return;
-
-        ThreadPool& pool = getStaticThreadPool();
-        std::vector<int> pathExists(cache.size(), 0);
-        std::atomic<size_t> existingCount{0};
-
-        const size_t numThread = std::min({
-            pool.threadCount(),
-            static_cast<size_t>(GlobalConcurrency::CLEAN_THREAD_CAP),
-            cache.size()
-        });
-        const size_t chunkSize = (cache.size() + numThread - 1) / numThread;
-        std::vector<std::future<void>> futures;
-        futures.reserve(numThread);
-        for (size_t i = 0; i < numThread; ++i) {
-            const size_t start = i * chunkSize;
-            const size_t end   = std::min(cache.size(), start + chunkSize);
-            if (start >= end) break;
-            futures.emplace_back(
-                pool.enqueue([&cache, &pathExists, &existingCount, start, end] {
-                    for (size_t j = start; j < end; ++j) {
-                        if (access(cache[j].c_str(), F_OK) == 0) {
-                            pathExists[j] = 1;
-                            existingCount.fetch_add(1, std::memory_order_relaxed);
-                        }
-                    }
-                }));
-        }
-        for (auto& f : futures) f.get();
-
-        if (existingCount == cache.size()) return;
+    PathTable::Builder builder;
+    builder.reserve(store.liveCount());
+    store.forEach([&builder](std::string_view path) { builder.add(path); });
+    const std::shared_ptr<const PathTable> table = builder.finish();
+    if (table->empty()) {
+        std::lock_guard<std::mutex> lock(GlobalMutexes::updateListMutex);
+        globalIsoFileList.clear();
+        return;
+    }
 
-        const size_t surviving = existingCount.load();
-        retained.reserve(surviving);
-        size_t totalBufferSize = 0;
-        for (size_t i = 0; i < cache.size(); ++i) {
-            if (pathExists[i]) {
-                totalBufferSize += cache[i].size() + 1;
-                retained.push_back(std::move(cache[i]));
+    const size_t total = table->size();
+    std::vector<int> pathExists(total, 0);
+    std::atomic<size_t> existingCount{0};
+
+    // Small fixed blocks keep the workers evenly loaded when some directories
+    // sit on slow media; the group caps how many run at once.
+    constexpr size_t blockSize = 256;
+    TaskGroup checks("clean", TaskPriority::Foreground, GlobalConcurrency::CLEAN_THREAD_CAP);
+    for (size_t start = 0; start < total; start += blockSize) {
+        const size_t end = std::min(total, start + blockSize);
+        checks.submit([&table, &pathExists, &existingCount, start, end] {
+            std::string path;
+            for (size_t j = start; j < end; ++j) {
+                path.clear();
+                table->appendPath(static_cast<PathTable::Id>(j), path);
+                if (access(path.c_str(), F_OK) == 0) {
+                    pathExists[j] = 1;
+                    existingCount.fetch_add(1, std::memory_order_relaxed);
+                }
             }
-        }
-        anyRemoved = true;
-
-        // Build output before touching any file
-        std::string buf;
-        buf.reserve(totalBufferSize);
-        for (const auto& path : retained) {
-            buf += path;
-            buf += '\n';
-        }
-
-        // Write to a temp file in the same directory as the database,
-        // then atomically rename into place
-        std::string tmpPath = (std::filesystem::path(GlobalState::databaseFilePath).parent_path() / "iso_commander_database_saved_XXXXXX").string();
-        int tmpFd = mkstemp(tmpPath.data());
-        if (tmpFd == -1) return;
-
-        auto cleanupTmp = [&]() {
-            close(tmpFd);
-            ::unlink(tmpPath.c_str());
-        };
-
-        if (fchmod(tmpFd, 0644) == -1) { cleanupTmp(); return; }
-        if (::write(tmpFd, buf.data(), buf.size()) != static_cast<ssize_t>(buf.size())) { cleanupTmp(); return; }
-        if (fsync(tmpFd) == -1) { cleanupTmp(); return; }
-        close(tmpFd);
-
-        if (::rename(tmpPath.c_str(), GlobalState::databaseFilePath.c_str()) == -1) {
-            ::unlink(tmpPath.c_str());
-            return;
-        }
-
-        GlobalState::isoListDirty.store(true);
+        });
     }
-    if (anyRemoved) {
-        std::lock_guard<std::mutex> lock(GlobalMutexes::updateListMutex);
-        globalIsoFileList = std::move(retained);
+    checks.wait();
+
+    if (existingCount == total) return;
+
+    PathList retained(table);
+    std::vector<PathTable::Id>& order = retained.order();
+    std::vector<std::string> missing;
+    order.clear();
+    missing.reserve(total - existingCount.load());
+    for (size_t i = 0; i < total; ++i) {
+        const auto id = static_cast<PathTable::Id>(i);
+        if (pathExists[i]) order.push_back(id);
+        else missing.push_back(table->path(id));
     }
+
+    if (store.remove(missing) == 0) return;
+    // The drive may only be unmounted; when it returns with the same
+    // directory stamps an incremental rescan must still find these again.
+    ::unlink(GlobalState::dirSnapshotFilePath.c_str());
+    GlobalState::isoListDirty.store(true);
+
+    std::lock_guard<std::mutex> lock(GlobalMutexes::updateListMutex);
+    globalIsoFileList = std::move(retained);
 }
 
 /**
@@ -226,112 +163,67 @@ std::string getHomeDirectory() {
 /**
  * @brief Saves new ISO file paths to the database, merging with existing entries.
  *
- * Deduplicates incoming paths against the existing cache and against each other,
- * appends new entries, and trims to maxDatabaseSize if needed. Writes the new
- * database contents to a temporary file in the same directory as the database,
- * then atomically renames it into place — ensuring readers always see either the
- * complete old file or the complete new one, never a partial write.
+ * Appends every path not already stored (the store deduplicates against its
+ * hash index and within the batch). Capacity is enforced by the store per
+ * database_full_policy: least recently used entries are evicted, or paths
+ * that do not fit are refused. Only the new entries are written.
  *
  * @param discoveredISO  Const reference to vector of ISO file paths to add.
- * @param newISOFound    Set to true if at least one new entry was added,
+ * @param newISOFound    Set to true if at least one path was not yet in the
+ *                       database (even if it was refused for lack of room),
  *                       false if all paths already existed in the cache.
+ * @param allStored      If non-null, set to true only if every path is now in
+ *                       the database and nothing was evicted to make room.
  * @return true  if new entries were written successfully.
- * @return false if no new entries were found, or if an I/O error occurred.
+ * @return false if no new entries were added, or if an I/O error occurred.
  */
-bool saveToDatabase(const std::vector<std::string>& discoveredISO, bool* newISOFound) {
-    std::filesystem::path cachePath = GlobalState::databaseDirectory;
-    cachePath /= GlobalState::databaseFilename;
-    if (!std::filesystem::exists(GlobalState::databaseDirectory) && !std::filesystem::create_directories(GlobalState::databaseDirectory)) {
-        return false;
-    }
-    if (!std::filesystem::is_directory(GlobalState::databaseDirectory)) {
-        return false;
-    }
-    std::lock_guard<std::mutex> fileLock(dbFileMutex);
+bool saveToDatabase(const std::vector<std::string>& discoveredISO, bool* newISOFound, bool* allStored) {
     if (newISOFound) *newISOFound = false;
-    std::vector<std::string> existingCache;
-    int fd = open(cachePath.c_str(), O_RDONLY);
-    if (fd != -1) {
-        if (flock(fd, LOCK_SH) == 0) {
-            struct stat fileStat;
-            if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0) {
-                std::vector<char> buffer(fileStat.st_size);
-                ssize_t bytesRead = ::read(fd, buffer.data(), fileStat.st_size);
-                if (bytesRead > 0 && bytesRead <= fileStat.st_size) {
-                    char* start = buffer.data();
-                    char* end = buffer.data() + bytesRead;
-                    while (start < end) {
-                        char* lineEnd = std::find(start, end, '\n');
-                        std::string line(start, lineEnd);
-                        if (!line.empty() && line.back() == '\r') {
-                            line.pop_back();
-                        }
-                        if (!line.empty()) {
-                            existingCache.push_back(std::move(line));
-                        }
-                        start = (lineEnd < end) ? lineEnd + 1 : end;
-                    }
-                }
-            }
-            flock(fd, LOCK_UN);
-        }
-        close(fd);
-    }
-    std::vector<std::string> combinedCache = std::move(existingCache);
-    std::unordered_set<std::string> existingSet(combinedCache.begin(), combinedCache.end());
-    std::vector<std::string> newEntries;
-    bool localNewISOFound = false;
-    for (const auto& iso : discoveredISO) {
-        if (existingSet.insert(iso).second) {
-            newEntries.push_back(iso);
-            localNewISOFound = true;
-        }
-    }
-    if (newEntries.empty()) {
-        if (newISOFound)
-            *newISOFound = false;
-        return false;
-    }
-    combinedCache.insert(combinedCache.end(), newEntries.begin(), newEntries.end());
-    if (combinedCache.size() > GlobalState::maxDatabaseSize) {
-        combinedCache.erase(combinedCache.begin(), combinedCache.begin() + (combinedCache.size() - GlobalState::maxDatabaseSize));
-    }
-    std::string output;
-    output.reserve(combinedCache.size() * 64);
-    for (const auto& entry : combinedCache) {
-        output += entry;
-        output += '\n';
-    }
-    std::string tmpPath = (std::filesystem::path(GlobalState::databaseFilePath).parent_path() / "iso_commander_database_saved_XXXXXX").string();
-    int tmpFd = mkstemp(tmpPath.data());
-    if (tmpFd == -1) return false;
-    auto cleanupTmp = [&]() {
-        close(tmpFd);
-        ::unlink(tmpPath.c_str());
-    };
-    if (fchmod(tmpFd, 0644) == -1) {
-        cleanupTmp();
-        return false;
-    }
-    if (::write(tmpFd, output.data(), output.size()) != static_cast<ssize_t>(output.size())) {
-        cleanupTmp();
-        return false;
-    }
-    if (fsync(tmpFd) == -1) {
-        cleanupTmp();
+    if (allStored) *allStored = false;
+    std::error_code ec;
+    std::filesystem::create_directories(GlobalState::databaseDirectory, ec);
+    if (!std::filesystem::is_directory(GlobalState::databaseDirectory, ec)) {
+        ::unlink(GlobalState::dirSnapshotFilePath.c_str());
         return false;
     }
-    close(tmpFd);
-    if (::rename(tmpPath.c_str(), cachePath.c_str()) == -1) {
-        ::unlink(tmpPath.c_str());
-        return false;
+
+    IsoDatabaseStore::AppendStats stats;
+    const size_t added = IsoDatabaseStore::instance().append(discoveredISO, &stats);
+
+    const bool complete = !stats.failed && stats.refused == 0 && stats.evicted == 0;
+    if (!complete) {
+        // Evicted, refused or unwritten paths would never be rediscovered by
+        // an incremental rescan.
+        ::unlink(GlobalState::dirSnapshotFilePath.c_str());
     }
+    if (allStored) *allStored = complete;
     if (newISOFound)
-        *newISOFound = localNewISOFound;
+        *newISOFound = added > 0 || stats.refused > 0;
+    if (added == 0) return false;
+
     GlobalState::isoListDirty.store(true);
     return true;
 }
 
+/**
+ * @brief Marks ISO paths as just used, so LRU eviction keeps them longest.
+ *
+ * @param isoFiles Paths the user just operated on (e.g. mounted).
+ */
+void touchDatabaseEntries(const std::vector<std::string>& isoFiles) {
+    if (isoFiles.empty() || GlobalState::databaseRefuseWhenFull) return;
+    IsoDatabaseStore::instance().touch(isoFiles);
+}
+
+/**
+ * @brief Returns true if the ISO database has no room for another entry.
+ */
+bool isDatabaseFull() {
+    IsoDatabaseStore& store = IsoDatabaseStore::instance();
+    return store.liveCount() >= GlobalState::databaseMaxEntries ||
+           store.dataBytes() >= GlobalState::databaseMaxBytes;
+}
+
 /**
  * @brief Passes successfully operated ISO file paths to the database.
  *
@@ -428,30 +320,33 @@ bool isValidDirectory(const std::string& path);
  *
  * Reads semicolon-delimited paths from the history file, deduplicates them,
  * removes the root path "/" if other paths are present, then reduces them
- * hierarchically. Traverses the resulting directories in concurrent groups
- * sized to the global thread pool's thread count, collecting ISO files and
- * errors across all groups, then saves all results to the database in a
- * single call once every group has completed.
+ * hierarchically. All surviving directories are handed to a single
+ * @c traverse call, whose work-stealing walker spreads them over the global
+ * thread pool, and the results are saved to the database in one call.
  *
- * Checks stopImport after history parsing, after path reduction, between
- * groups, and after all traversal completes before saving. When stopImport
- * fires mid-group, the workerCV wait unblocks early but all spawned threads
- * are still joined before the function exits. localMaxDepth (-1) and
- * localPromptFlag (false) are hardcoded locals passed to each traversal.
+ * The walk is incremental: the per-directory stamps (dev, ino, mtime, ctime)
+ * saved by the previous completed import are loaded from
+ * GlobalState::dirSnapshotFilePath, and only directories whose stamp changed
+ * are re-read. A fresh snapshot is written only once every discovered path
+ * is stored; a cancelled import leaves the old one in place, and a failed or
+ * partial save (I/O error, refusals, evictions) removes it.
  *
- * activeWorkers is incremented after validation but before thread launch,
- * and decremented by each thread on exit; the last thread to decrement
- * (fetch_sub returning 1) signals workerCV to wake the waiting main thread.
- * If thread construction throws, activeWorkers is decremented to stay
- * consistent. Signals completion via RefreshState::importCV; if stopImport
- * was not set, waits 500ms before doing so. isImportRunning is stored false
- * under printMutex before importCV is notified, ensuring printList cannot
- * observe a stale sync indicator after the signal.
+ * Runs as a task of RefreshState::importGroup (background priority). Checks
+ * the group's cancellation after history parsing, after path reduction, and
+ * after traversal before saving; the walk itself stops on
+ * RefreshState::importCancel. Neither is tied to the interactive operation, so
+ * Ctrl+C in the foreground does not abort an import.
+ * localMaxDepth (-1) and localPromptFlag (false) are hardcoded locals passed
+ * to the traversal.
  *
- * @param state        Shared state holding isImportRunning, stopImport,
- *                     importCV/mutex for completion signaling, workerCV/mutex
- *                     and activeWorkers for per-group synchronization,
- *                     and printMutex for sync indicator consistency.
+ * Signals completion via RefreshState::importCV; if the group was not cancelled,
+ * waits 500ms before doing so. isImportRunning is stored false under
+ * printMutex before importCV is notified, ensuring printList cannot observe a
+ * stale sync indicator after the signal.
+ *
+ * @param state        Shared state holding isImportRunning, importGroup,
+ *                     importCV/mutex for completion signaling, and
+ *                     printMutex for sync indicator consistency.
  */
 void backgroundDatabaseImport(std::shared_ptr<RefreshState> state) {
 
@@ -460,7 +355,7 @@ void backgroundDatabaseImport(std::shared_ptr<RefreshState> state) {
     bool localPromptFlag = false;
     auto signalDone = [&] {
         if (state) {
-            if (!state->stopImport.load()) {
+            if (!state->importGroup.cancelled()) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(500));
             }
             {
@@ -475,7 +370,7 @@ void backgroundDatabaseImport(std::shared_ptr<RefreshState> state) {
         if (!file.is_open()) { signalDone(); return; }
         std::string line;
         while (std::getline(file, line)) {
-            if (state->stopImport.load()) { signalDone(); return; }
+            if (state->importGroup.cancelled()) { signalDone(); return; }
             std::istringstream iss(line);
             std::string path;
             while (std::getline(iss, path, ';')) {
@@ -487,135 +382,196 @@ void backgroundDatabaseImport(std::shared_ptr<RefreshState> state) {
             }
         }
     }
-    if (state->stopImport.load()) { signalDone(); return; }
+    if (state->importGroup.cancelled()) { signalDone(); return; }
     if (paths.size() > 1) {
         auto it = std::find(paths.begin(), paths.end(), "/");
         if (it != paths.end()) paths.erase(it);
     }
     std::vector<std::string> finalPaths = hierarchicalPathReduction(paths);
     if (finalPaths.empty()) { signalDone(); return; }
-    if (state->stopImport.load()) { signalDone(); return; }
+    if (state->importGroup.cancelled()) { signalDone(); return; }
+
+    std::vector<std::string> validPaths;
+    validPaths.reserve(finalPaths.size());
+    for (const auto& path : finalPaths) {
+        if (isValidDirectory(path)) validPaths.push_back(path);
+    }
 
     std::vector<std::string> allIsoFiles;
     std::atomic<size_t> totalFiles{0};
     std::unordered_set<std::string> uniqueErrorMessages;
-    std::mutex processMutex;
-    std::mutex traverseErrorMutex;
-
-    const size_t groupSize = std::max<size_t>(1, getStaticThreadPool().threadCount());
-
-    for (size_t i = 0; i < finalPaths.size(); i += groupSize) {
-        if (state->stopImport.load()) break;
-
-        const size_t end = std::min(i + groupSize, finalPaths.size());
-        std::vector<std::thread> threads;
-        threads.reserve(end - i);
 
-        state->activeWorkers.store(0, std::memory_order_relaxed);
+    // The snapshot only describes what is already in the database, so it is
+    // ignored once the database is gone or empty (e.g. after !clr).
+    DirSnapshot previousSnapshot;
+    if (IsoDatabaseStore::instance().liveCount() > 0) {
+        previousSnapshot.load(GlobalState::dirSnapshotFilePath);
+    }
+    DirSnapshot currentSnapshot;
 
-        for (size_t j = i; j < end; ++j) {
-            if (state->stopImport.load()) break;
-            if (!isValidDirectory(finalPaths[j])) continue;
+    const CancellationToken cancel = state->importCancel.token();
+    traverse(validPaths, allIsoFiles, uniqueErrorMessages, totalFiles,
+             localMaxDepth, localPromptFlag, &cancel,
+             &previousSnapshot, &currentSnapshot);
 
-            state->activeWorkers.fetch_add(1, std::memory_order_relaxed);
+    if (state->importGroup.cancelled() || cancel.cancelled()) { signalDone(); return; }
+    bool allStored = false;
+    saveToDatabase(allIsoFiles, nullptr, &allStored);
+    if (allStored) currentSnapshot.save(GlobalState::dirSnapshotFilePath);
+    signalDone();
+}
 
-            try {
-                threads.emplace_back([&, path = finalPaths[j]]() {
-                    traverse(path, allIsoFiles, uniqueErrorMessages,
-                             totalFiles, processMutex, traverseErrorMutex,
-                             localMaxDepth, localPromptFlag);
-                    if (state->activeWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
-                        std::lock_guard<std::mutex> lk(state->workerMutex);
-                        state->workerCV.notify_all();
-                    }
-                });
-            } catch (...) {
-                state->activeWorkers.fetch_sub(1, std::memory_order_relaxed);
-            }
-        }
+// Search index for the most recently loaded table. Has its own mutex so that
+// loading may run with or without updateListMutex held.
+static std::mutex searchIndexMutex;
+static std::weak_ptr<const PathTable> searchIndexTable;
+static std::shared_ptr<const PathSearchIndex> searchIndex;
 
-        if (!threads.empty()) {
-            std::unique_lock<std::mutex> lk(state->workerMutex);
-            state->workerCV.wait(lk, [&] {
-                return state->activeWorkers.load(std::memory_order_acquire) == 0
-                    || state->stopImport.load();
-            });
+/**
+ * @brief Builds the trigram index for @p table on the thread pool.
+ *
+ * The build is skipped or discarded when a newer table was loaded meanwhile;
+ * until it publishes, filtering falls back to scanning the list.
+ */
+static void scheduleSearchIndexBuild(const std::shared_ptr<const PathTable>& table) {
+    {
+        std::lock_guard<std::mutex> lock(searchIndexMutex);
+        searchIndexTable = table;
+    }
+    getStaticThreadPool().submit([weak = std::weak_ptr<const PathTable>(table)]() {
+        auto latest = [&weak] {
+            std::shared_ptr<const PathTable> t = weak.lock();
+            return t && searchIndexTable.lock() == t;
+        };
+        {
+            std::lock_guard<std::mutex> lock(searchIndexMutex);
+            if (!latest()) return;
         }
+        auto index = PathSearchIndex::build(weak.lock());
+        std::lock_guard<std::mutex> lock(searchIndexMutex);
+        if (latest()) searchIndex = std::move(index);
+    }, TaskPriority::Background);
+}
 
-        for (auto& t : threads)
-            if (t.joinable()) t.join();
-    }
-    if (state->stopImport.load()) { signalDone(); return; }
-    saveToDatabase(allIsoFiles, nullptr);
-    signalDone();
+/**
+ * @brief Returns the search index covering @p list, or null while it is being built.
+ */
+std::shared_ptr<const PathSearchIndex> isoSearchIndexFor(const PathList& list) {
+    std::lock_guard<std::mutex> lock(searchIndexMutex);
+    if (searchIndex && list.table() && searchIndex->table() == list.table()) return searchIndex;
+    return nullptr;
 }
 
 /**
  * @brief Loads ISO database from file into memory
  *
- * @param outList Reference to vector that will receive the loaded ISO paths
+ * Paths are interned straight from the store's mapping into a fresh
+ * @ref PathTable; no per-path string is allocated. A trigram index over the
+ * new table is then built in the background for @ref isoSearchIndexFor.
+ *
+ * @param outList Reference to the list that will receive the loaded ISO paths
  */
-void loadFromDatabase(std::vector<std::string>& outList) {
-    std::lock_guard<std::mutex> fileLock(dbFileMutex);
-
-    int fd = open(GlobalState::databaseFilePath.c_str(), O_RDONLY);
-    if (fd == -1) return;
+void loadFromDatabase(PathList& outList) {
+    IsoDatabaseStore& store = IsoDatabaseStore::instance();
+    if (::access(GlobalState::databaseFilePath.c_str(), F_OK) != 0) return;
+
+    PathTable::Builder builder;
+    builder.reserve(store.liveCount());
+    store.forEach([&builder](std::string_view path) { builder.add(path); });
+    std::shared_ptr<const PathTable> table = builder.finish();
+    scheduleSearchIndexBuild(table);
+    outList = PathList(std::move(table));
+}
 
-    if (flock(fd, LOCK_SH) == -1) {
-        close(fd);
-        return;
+/**
+ * @brief Prints the thread pool's size, last load sample, worker placement,
+ *        recent resize decisions and per-group task times.
+ */
+static void printThreadPoolStatistics(const SemanticUIColors& c) {
+    const ThreadPool::Telemetry t = getStaticThreadPool().telemetry();
+    auto seconds = [](uint64_t ns) { return static_cast<double>(ns) / 1e9; };
+
+    std::cout << "\n" << c.accent << "=== Thread Pool ===" << c.reset << "\n"
+              << "\n" << c.label << "Threads: " << c.data << t.target << " running, " << t.started
+              << " started (bounds " << t.minThreads << "-" << t.maxThreads
+              << (t.minThreads == t.maxThreads ? ", fixed" : "") << ")"
+              << "\n" << c.label << "Tasks: " << c.data << t.active << " active, " << t.pending << " queued"
+              << "\n" << c.label << "Last Sample: " << c.data << std::fixed << std::setprecision(0)
+              << t.blocked * 100 << "% blocked, " << t.utilisation * 100 << "% busy, "
+              << t.ioDelayMs << "ms block-I/O delay\n";
+
+    std::cout << c.label << "Affinity: " << c.data << (t.pinned ? "on" : "off") << ", I/O buffers "
+              << t.nodeBuffers << " node-local, " << t.firstTouchBuffers << " first-touch\n";
+    std::cout << c.label << "Stream I/O: " << c.data << asyncIoBackend() << "\n";
+    for (const auto& d : t.domains) {
+        std::cout << c.data << "  " << (d.numaNode ? "node " : "cache (node ") << d.node << (d.numaNode ? "" : ")")
+                  << " cpus " << d.cpus << ": " << d.workers << (d.workers == 1 ? " worker\n" : " workers\n");
     }
 
-    struct stat fileStat;
-    if (fstat(fd, &fileStat) == -1 || fileStat.st_size == 0) {
-        flock(fd, LOCK_UN);
-        close(fd);
-        outList.clear();
-        return;
+    if (!t.decisions.empty()) {
+        std::cout << c.label << "Recent Sizing:" << c.reset << "\n";
+        const auto now = std::chrono::steady_clock::now();
+        for (const auto& d : t.decisions) {
+            const double ago = std::chrono::duration<double>(now - d.when).count();
+            std::cout << c.data << "  -" << std::setprecision(1) << ago << "s " << d.from << " -> " << d.to
+                      << "  " << d.reason << std::setprecision(0) << " (blocked " << d.blocked * 100
+                      << "%, busy " << d.utilisation * 100 << "%, " << d.pending << " queued)\n";
+        }
     }
 
-    std::vector<char> buffer(fileStat.st_size);
-    ssize_t bytesRead = ::read(fd, buffer.data(), fileStat.st_size);
-
-    flock(fd, LOCK_UN);
-    close(fd);
-
-    if (bytesRead <= 0 || bytesRead > fileStat.st_size) return;
-
-    std::vector<std::string> loadedFiles;
-    char* start = buffer.data();
-    char* end = buffer.data() + bytesRead;
-
-    while (start < end) {
-        char* lineEnd = std::find(start, end, '\n');
-        std::string line(start, lineEnd);
-        if (!line.empty() && line.back() == '\r') line.pop_back();
-        if (!line.empty()) loadedFiles.push_back(std::move(line));
-        start = (lineEnd < end) ? lineEnd + 1 : end;
+    if (!t.groups.empty()) {
+        std::cout << c.label << "Task Groups:" << c.reset << "\n";
+        for (const auto& g : t.groups) {
+            const double blocked = g.wall_ns ? 100.0 * (1.0 - std::min(1.0, double(g.cpu_ns) / double(g.wall_ns))) : 0.0;
+            std::cout << c.data << "  " << std::left << std::setw(20) << g.name << std::right
+                      << g.tasks << " tasks, wall " << std::setprecision(2) << seconds(g.wall_ns)
+                      << "s, cpu " << seconds(g.cpu_ns) << "s, " << std::setprecision(0)
+                      << blocked << "% blocked\n";
+        }
     }
-    outList = std::move(loadedFiles);
+    std::cout << c.reset;
+}
+
+/**
+ * @brief Prints the hazard-pointer domain's reclamation counters, so memory
+ *        held by retired queue nodes can be checked after a burst of tasks.
+ */
+static void printReclamationStatistics(const SemanticUIColors& c) {
+    const HazardPointerDomain::Statistics s = HazardPointerDomain::instance().statistics();
+    const double avgUs = s.scans ? static_cast<double>(s.scanNsTotal) / static_cast<double>(s.scans) / 1e3 : 0.0;
+
+    std::cout << "\n" << c.accent << "=== Hazard Pointers ===" << c.reset << "\n"
+              << "\n" << c.label << "Nodes: " << c.data << s.retired << " retired, " << s.reclaimed << " reclaimed, "
+              << s.pending() << " pending (" << s.orphaned << " orphaned, " << s.adopted << " adopted)"
+              << "\n" << c.label << "Scans: " << c.data << s.scans << " at threshold " << s.threshold
+              << ", avg " << std::fixed << std::setprecision(1) << avgUs << "us, max "
+              << static_cast<double>(s.scanNsMax) / 1e3 << "us, largest " << s.largestScan << " nodes"
+              << "\n" << c.label << "Records: " << c.data << s.activeRecords << " active, " << s.records << " allocated"
+              << c.reset << "\n";
 }
 
 /**
  * @brief Displays database statistics including on-disk and RAM usage.
  *
- * Creates database and history files if absent, then prints capacity,
- * entry counts, and locations for the ISO and history databases, followed
+ * Creates history files if absent, then prints entry and byte usage against
+ * the configured limits, the full policy, real on-disk size, and locations
+ * for the ISO and history databases, the thread pool's sizing telemetry and
+ * hazard-pointer reclamation counters, followed
  * by RAM-buffered entry counts for ISO, STR, BIN/IMG, DAA/GBI, CHD, MDF,
  * and NRG caches sourced from GlobalCaches and GlobalState.
  *
  * @param databaseFilePath Path to the ISO database file.
- * @param maxDatabaseSize  Maximum allowed database size in bytes.
  */
-void displayDatabaseStatistics(const std::string& databaseFilePath, std::uintmax_t maxDatabaseSize) {
+void displayDatabaseStatistics(const std::string& databaseFilePath) {
     signal(SIGINT, SIG_IGN);
     disable_ctrl_d();
     clearScrollBuffer();
 
-    auto [label, accent, warning, error, reset, path, highlight, data, str] = resolveDatabaseTheme();
+    const SemanticUIColors theme = resolveDatabaseTheme();
+    auto [label, accent, warning, error, reset, path, highlight, data, str] = theme;
 
     try {
-        for (const auto& path : {GlobalState::databaseFilePath, GlobalState::historyFilePath, GlobalState::filterHistoryFilePath}) {
+        for (const auto& path : {GlobalState::historyFilePath, GlobalState::filterHistoryFilePath}) {
             if (!std::filesystem::exists(path)) {
                 std::ofstream createFile(path);
             }
@@ -623,14 +579,20 @@ void displayDatabaseStatistics(const std::string& databaseFilePath, std::uintmax
 
         std::cout << "\n" << accent << "=== ISO Database ===" << reset << "\n";
 
-        std::uintmax_t fileSizeInBytes = std::filesystem::file_size(databaseFilePath);
-        double fileSizeInKB = fileSizeInBytes / 1024.0;
-        double cachesizeInKb = maxDatabaseSize / 1024.0;
-        double usagePercentage = (fileSizeInBytes * 100.0) / maxDatabaseSize;
-
-        std::cout << "\n" << label << "Capacity: " << data << std::fixed << std::setprecision(0)
-                  << fileSizeInKB << "KB/" << cachesizeInKb << "KB (" << std::setprecision(1) << usagePercentage << "%)"
-                  << "\n" << label << "Entries: " << data << countNonEmptyLines(GlobalState::databaseFilePath)
+        IsoDatabaseStore& store = IsoDatabaseStore::instance();
+        const std::size_t entries = store.liveCount();
+        const double dataInKB = store.dataBytes() / 1024.0;
+        const double diskInKB = store.diskBytes() / 1024.0;
+        const double limitInKB = GlobalState::databaseMaxBytes / 1024.0;
+        const double entryPercentage = (entries * 100.0) / GlobalState::databaseMaxEntries;
+        const double bytePercentage = (dataInKB * 100.0) / limitInKB;
+
+        std::cout << "\n" << label << "Entries: " << data << entries << "/" << GlobalState::databaseMaxEntries
+                  << " (" << std::fixed << std::setprecision(1) << entryPercentage << "%)"
+                  << "\n" << label << "Capacity: " << data << std::setprecision(0) << dataInKB << "KB/" << limitInKB
+                  << "KB (" << std::setprecision(1) << bytePercentage << "%)"
+                  << "\n" << label << "On Disk: " << data << std::setprecision(0) << diskInKB << "KB"
+                  << "\n" << label << "When Full: " << data << (GlobalState::databaseRefuseWhenFull ? "refuse" : "lru")
                   << "\n" << label << "Location: " << data << "'" << databaseFilePath << "'" << reset << "\n";
 
         std::cout << "\n" << accent << "=== History Database ===" << reset << "\n"
@@ -639,6 +601,9 @@ void displayDatabaseStatistics(const std::string& databaseFilePath, std::uintmax
                   << "\n\n" << label << "FilterTerm Entries: " << data << countNonEmptyLines(GlobalState::filterHistoryFilePath) << "/" << GlobalState::MAX_HISTORY_PATTERN_LINES
                   << "\n" << label << "Location: " << data << "'" << GlobalState::filterHistoryFilePath << "'" << std::endl;
 
+        printThreadPoolStatistics(theme);
+        printReclamationStatistics(theme);
+
         std::cout << "\n" << accent << "=== Buffered Entries ===" << reset << "\n";
 
         std::cout << str << "\nSTR → RAM: " << data
@@ -666,8 +631,10 @@ void displayDatabaseStatistics(const std::string& databaseFilePath, std::uintmax
  *
  * Dispatches on inputSearch:
  *   *stats      — calls displayDatabaseStatistics()
- *   !clr        — truncates the ISO database file and clears
- *                 transformationCache and globalIsoFileList
+ *   !clr        — empties the ISO database, drops the directory snapshot,
+ *                 and clears transformationCache and globalIsoFileList
+ *   *export     — writes the ISO database as a plain text list
+ *   *import     — merges a plain text list into the ISO database
  *   !clr_paths / !clr_filter — delegates to clearHistory()
  *
  * @param inputSearch Command string to process.
@@ -679,23 +646,53 @@ void databaseSwitches(std::string& inputSearch) {
     auto db = resolveDatabaseTheme();
 
     if (inputSearch == "*stats") {
-        displayDatabaseStatistics(GlobalState::databaseFilePath, GlobalState::maxDatabaseSize);
+        displayDatabaseStatistics(GlobalState::databaseFilePath);
     } else if (inputSearch == "!clr") {
-        std::ofstream ofs(GlobalState::databaseFilePath, std::ofstream::out | std::ofstream::trunc);
-        if (!ofs) {
+        if (!IsoDatabaseStore::instance().clear()) {
             std::cerr << "\n" << db.error << "Error clearing ISO database: "
                       << db.path << "'" << GlobalState::databaseFilePath << "'"
                       << db.error << ". File missing or inaccessible.\033[J" << std::endl;
 
             pressEnterToContinue();
         } else {
-            ofs.close();
+            ::unlink(GlobalState::dirSnapshotFilePath.c_str());
 			GlobalCaches::transformationCache.clear();
 
             std::cout << "\n" << db.highlight << "ISO database cleared successfully." << "\033[J" << std::endl;
             pressEnterToContinue();
-            std::vector<std::string>().swap(GlobalState::globalIsoFileList);
+            GlobalState::globalIsoFileList.clear();
+        }
+    } else if (inputSearch == "*export") {
+        if (!IsoDatabaseStore::instance().exportText(GlobalState::legacyDatabaseFilePath)) {
+            std::cerr << "\n" << db.error << "Error exporting ISO database to: "
+                      << db.path << "'" << GlobalState::legacyDatabaseFilePath << "'"
+                      << db.error << ".\033[J" << std::endl;
+        } else {
+            std::cout << "\n" << db.highlight << "ISO database exported to: "
+                      << db.path << "'" << GlobalState::legacyDatabaseFilePath << "'" << "\033[J" << std::endl;
+        }
+        pressEnterToContinue();
+    } else if (inputSearch == "*import") {
+        IsoDatabaseStore::AppendStats stats;
+        const long added = IsoDatabaseStore::instance().importText(GlobalState::legacyDatabaseFilePath, &stats);
+        if (added < 0) {
+            std::cerr << "\n" << db.error << "Error importing ISO database from: "
+                      << db.path << "'" << GlobalState::legacyDatabaseFilePath << "'"
+                      << db.error << ". File missing or inaccessible.\033[J" << std::endl;
+        } else {
+            if (added > 0) GlobalState::isoListDirty.store(true);
+            // Evicted entries would never be rediscovered by an incremental rescan.
+            if (stats.evicted > 0) ::unlink(GlobalState::dirSnapshotFilePath.c_str());
+            std::cout << "\n" << db.highlight << "Imported " << added << " new ISO entries from: "
+                      << db.path << "'" << GlobalState::legacyDatabaseFilePath << "'" << "\033[J" << std::endl;
+            if (stats.evicted > 0)
+                std::cout << db.highlight << "Evicted " << stats.evicted
+                          << " least recently used entries to stay within the database limits.\033[J" << std::endl;
+            if (stats.refused > 0)
+                std::cerr << db.error << "Refused " << stats.refused
+                          << " entries: the database is full (database_full_policy=refuse).\033[J" << std::endl;
         }
+        pressEnterToContinue();
     } else if (inputSearch == "!clr_paths" || inputSearch == "!clr_filter") {
         clearHistory(inputSearch);
     }
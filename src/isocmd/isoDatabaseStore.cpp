@@ -0,0 +1,1121 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+// C / System Headers
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Project Headers
+#include "../isoDatabaseStore.h"
+#include "../state.h"
+#include "../threadpool.h"
+
+/**
+ * @file isoDatabaseStore.cpp
+ * @brief Binary, memory-mapped ISO database with an in-place hash index.
+ */
+
+struct IsoDatabaseStore::Header {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t headerBytes;
+    std::uint64_t tableOffset;
+    std::uint64_t tableCapacity;
+    std::uint64_t entryCount;     ///< Committed rows, live or removed.
+    std::uint64_t liveCount;
+    std::uint64_t hashOffset;
+    std::uint64_t hashCapacity;   ///< Power of two, at least twice tableCapacity.
+    std::uint64_t arenaOffset;
+    std::uint64_t arenaCapacity;
+    std::uint64_t arenaUsed;
+    std::uint64_t generation;     ///< Bumped on every commit.
+};
+
+struct IsoDatabaseStore::Entry {
+    std::uint64_t offset;         ///< Relative to arenaOffset.
+    std::uint32_t length;
+    std::uint32_t flags;
+};
+
+namespace {
+
+    constexpr char          DB_MAGIC[8]     = {'I', 'S', 'O', 'C', 'M', 'D', 'D', 'B'};
+    constexpr std::uint32_t DB_VERSION      = 1;
+    constexpr std::uint64_t HEADER_BYTES    = 4096;
+    constexpr std::uint64_t MIN_TABLE_CAP   = 4096;
+    constexpr std::uint64_t MIN_ARENA_CAP   = 256 * 1024;
+    constexpr std::uint32_t ENTRY_REMOVED   = 1u;
+    constexpr std::uint64_t SLOT_INDEX_MASK = 0xFFFFFFFFull;
+
+    /// @brief Above this many new entries the hash section is rewritten whole
+    /// instead of slot by slot.
+    constexpr std::size_t SLOT_BULK_THRESHOLD = 4096;
+
+    /// @brief Removed entries are compacted away once they exceed both this
+    /// and the number of live entries.
+    constexpr std::uint64_t COMPACT_MIN_DEAD = 1024;
+
+    constexpr char          JOURNAL_MAGIC[8]   = {'I', 'S', 'O', 'C', 'M', 'D', 'J', 'L'};
+    constexpr std::uint64_t JOURNAL_HEADER     = 16;  ///< magic + epoch
+    constexpr std::uint64_t JOURNAL_RECORD_HDR = 16;  ///< op, pad, length, checksum
+    constexpr char          JOURNAL_ADD        = 'A';
+    constexpr char          JOURNAL_REMOVE     = 'R';
+    constexpr char          JOURNAL_TOUCH      = 'T';
+
+    /// @brief Bytes each live entry costs beyond its path: one table row and
+    /// its two hash slots (the index is kept at most half full).
+    constexpr std::uint64_t ENTRY_COST = 16 + 2 * sizeof(std::uint64_t);
+
+    /// @brief Journal size / record count past which it is folded into the database.
+    constexpr std::uint64_t JOURNAL_COMPACT_BYTES   = 1024 * 1024;
+    constexpr std::uint64_t JOURNAL_COMPACT_RECORDS = 8192;
+
+    /// @brief Batches larger than this go straight to the database, whose
+    /// in-place update is already O(batch). Touches are still journaled first
+    /// (see touch()) and folded at once.
+    constexpr std::size_t JOURNAL_DIRECT_BATCH = 1024;
+
+    /// @brief 64-bit FNV-1a; cheap, and good enough for path keys.
+    std::uint64_t hashPath(std::string_view s) {
+        std::uint64_t h = 1469598103934665603ull;
+        for (unsigned char c : s) {
+            h ^= c;
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    std::uint32_t tagOf(std::uint64_t hash) { return static_cast<std::uint32_t>(hash >> 32); }
+
+    std::uint64_t makeSlot(std::uint64_t hash, std::uint64_t index) {
+        return (static_cast<std::uint64_t>(tagOf(hash)) << 32) | (index + 1);
+    }
+
+    std::uint64_t nextPow2(std::uint64_t v) {
+        std::uint64_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    std::uint64_t alignUp(std::uint64_t v, std::uint64_t a) { return (v + a - 1) / a * a; }
+
+    bool writeAll(int fd, const void* data, std::size_t len, std::uint64_t offset) {
+        const char* p = static_cast<const char*>(data);
+        while (len > 0) {
+            ssize_t n = ::pwrite(fd, p, len, static_cast<off_t>(offset));
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                return false;
+            }
+            p += n;
+            len -= static_cast<std::size_t>(n);
+            offset += static_cast<std::uint64_t>(n);
+        }
+        return true;
+    }
+
+    std::string directoryOf(const std::string& path) {
+        const std::size_t slash = path.rfind('/');
+        return slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+    }
+
+    bool sameFile(int fd, const std::string& path) {
+        struct stat a, b;
+        return ::fstat(fd, &a) == 0 && ::stat(path.c_str(), &b) == 0 &&
+               a.st_dev == b.st_dev && a.st_ino == b.st_ino;
+    }
+
+    /// @brief Checksum of one journal record, covering its op, length and payload.
+    std::uint64_t recordChecksum(char op, std::string_view payload) {
+        std::uint64_t h = hashPath(payload);
+        h ^= static_cast<unsigned char>(op);
+        h *= 1099511628211ull;
+        h ^= payload.size();
+        h *= 1099511628211ull;
+        return h;
+    }
+
+    /// @brief Releases the store's `flock` at scope exit, on whatever
+    /// descriptor is current by then (a rebuild swaps it).
+    struct FlockGuard {
+        const int& fd;
+        ~FlockGuard() { if (fd != -1) flock(fd, LOCK_UN); }
+    };
+
+} // namespace
+
+IsoDatabaseStore& IsoDatabaseStore::instance() {
+    static IsoDatabaseStore store(GlobalState::databaseFilePath);
+    static std::once_flag migrated;
+
+    // Settings can change at runtime, so they are re-read on every call.
+    store.setLimits({GlobalState::databaseMaxEntries,
+                     static_cast<std::uint64_t>(GlobalState::databaseMaxBytes),
+                     GlobalState::databaseRefuseWhenFull});
+
+    // First run after upgrading from the text database: import it once.
+    std::call_once(migrated, [] {
+        store.backgroundCompaction_ = true;
+        if (::access(GlobalState::databaseFilePath.c_str(), F_OK) != 0 &&
+            ::access(GlobalState::legacyDatabaseFilePath.c_str(), R_OK) == 0) {
+            store.importText(GlobalState::legacyDatabaseFilePath);
+        }
+    });
+    return store;
+}
+
+IsoDatabaseStore::IsoDatabaseStore(std::string filePath)
+    : filePath_(std::move(filePath)), journalPath_(filePath_ + ".journal") {}
+
+IsoDatabaseStore::~IsoDatabaseStore() {
+    unmapLocked();
+    if (journalFd_ != -1) ::close(journalFd_);
+}
+
+// ── Mapping ──────────────────────────────────────────────────────────────────
+
+const IsoDatabaseStore::Header* IsoDatabaseStore::header() const {
+    return static_cast<const Header*>(map_);
+}
+
+const IsoDatabaseStore::Entry* IsoDatabaseStore::entries() const {
+    return reinterpret_cast<const Entry*>(static_cast<const char*>(map_) + header()->tableOffset);
+}
+
+const std::uint64_t* IsoDatabaseStore::slots() const {
+    return reinterpret_cast<const std::uint64_t*>(static_cast<const char*>(map_) + header()->hashOffset);
+}
+
+std::string_view IsoDatabaseStore::pathAt(std::uint64_t index) const {
+    const Entry& e = entries()[index];
+    return std::string_view(static_cast<const char*>(map_) + header()->arenaOffset + e.offset, e.length);
+}
+
+void IsoDatabaseStore::unmapLocked() {
+    if (map_) ::munmap(map_, mapSize_);
+    map_ = nullptr;
+    mapSize_ = 0;
+    if (fd_ != -1) ::close(fd_);
+    fd_ = -1;
+}
+
+/**
+ * @brief Maps the open file and checks every header field against the file
+ *        size, so a truncated or foreign file is never dereferenced.
+ *
+ * Runs before the file lock is taken, so it only reads; the live counts are
+ * taken afterwards by recountLocked().
+ */
+bool IsoDatabaseStore::mapLocked() {
+    static_assert(sizeof(Header) <= HEADER_BYTES, "header must fit its page");
+    static_assert(sizeof(Entry) == 16, "entry layout is part of the file format");
+    static_assert(ENTRY_COST == sizeof(Entry) + 2 * sizeof(std::uint64_t), "ENTRY_COST tracks the layout");
+
+    struct stat st;
+    if (::fstat(fd_, &st) != 0 || static_cast<std::uint64_t>(st.st_size) < HEADER_BYTES) return false;
+
+    const std::uint64_t size = static_cast<std::uint64_t>(st.st_size);
+    void* m = ::mmap(nullptr, static_cast<std::size_t>(size), PROT_READ, MAP_SHARED, fd_, 0);
+    if (m == MAP_FAILED) return false;
+
+    const Header* h = static_cast<const Header*>(m);
+    const bool valid =
+        std::memcmp(h->magic, DB_MAGIC, sizeof(DB_MAGIC)) == 0 &&
+        h->version == DB_VERSION &&
+        h->tableOffset >= HEADER_BYTES &&
+        h->tableCapacity < SLOT_INDEX_MASK &&
+        h->tableOffset + h->tableCapacity * sizeof(Entry) <= h->hashOffset &&
+        h->hashCapacity >= h->tableCapacity * 2 && (h->hashCapacity & (h->hashCapacity - 1)) == 0 &&
+        h->hashOffset + h->hashCapacity * sizeof(std::uint64_t) <= h->arenaOffset &&
+        h->arenaOffset + h->arenaCapacity <= size &&
+        h->entryCount <= h->tableCapacity &&
+        h->arenaUsed <= h->arenaCapacity;
+
+    if (!valid) {
+        ::munmap(m, static_cast<std::size_t>(size));
+        return false;
+    }
+    map_ = m;
+    mapSize_ = static_cast<std::size_t>(size);
+
+    const Entry* e = entries();
+    for (std::uint64_t i = 0; i < h->entryCount; ++i) {
+        if (e[i].offset + e[i].length > h->arenaUsed) {
+            ::munmap(map_, mapSize_);
+            map_ = nullptr;
+            mapSize_ = 0;
+            return false;
+        }
+    }
+    countsStale_ = true;
+    return true;
+}
+
+/**
+ * @brief Counts live entries and their bytes after a fresh mapping, under
+ *        the file lock.
+ *
+ * Removal flags are written before the header, so after a crash the stored
+ * live count may lag behind; the flags are authoritative.
+ *
+ * @return false if the header needs repairing and @p exclusive is not set,
+ *         or if the repair could not be written.
+ */
+bool IsoDatabaseStore::recountLocked(bool exclusive) {
+    if (!countsStale_) return true;
+
+    const Header* h = header();
+    const Entry* e = entries();
+    std::uint64_t live = 0;
+    liveBytes_ = 0;
+    for (std::uint64_t i = 0; i < h->entryCount; ++i) {
+        if (!(e[i].flags & ENTRY_REMOVED)) {
+            ++live;
+            liveBytes_ += e[i].length;
+        }
+    }
+    if (live != h->liveCount) {
+        if (!exclusive) return false;
+        Header fixed = *h;
+        fixed.liveCount = live;
+        if (!commitHeaderLocked(fixed)) return false;
+    }
+    countsStale_ = false;
+    return true;
+}
+
+/**
+ * @brief Writes a complete database holding @p paths to a temporary file and
+ *        renames it over the store path. Used for creation, growth,
+ *        compaction and clearing alike; the previous file stays valid until
+ *        the rename.
+ *
+ * Without @p replace an existing store file is left alone (another process
+ * created it first), which still counts as success.
+ *
+ * With @p lockedFd the new file is locked `LOCK_EX` before the rename and
+ * left open there, so a caller holding the lock on the old file never lets
+ * go of the store: other processes lock whichever inode is at the path.
+ */
+bool IsoDatabaseStore::writeFileLocked(const std::vector<std::string_view>& paths,
+                                       std::uint64_t tableCap, std::uint64_t arenaCap,
+                                       bool replace, int* lockedFd) {
+    std::uint64_t arenaNeeded = 0;
+    for (auto p : paths) arenaNeeded += p.size();
+
+    tableCap = std::max<std::uint64_t>({MIN_TABLE_CAP, tableCap, paths.size()});
+    arenaCap = std::max<std::uint64_t>({MIN_ARENA_CAP, arenaCap, arenaNeeded});
+    const std::uint64_t hashCap = nextPow2(tableCap * 2);
+
+    Header h{};
+    std::memcpy(h.magic, DB_MAGIC, sizeof(DB_MAGIC));
+    h.version       = DB_VERSION;
+    h.headerBytes   = static_cast<std::uint32_t>(HEADER_BYTES);
+    h.tableOffset   = HEADER_BYTES;
+    h.tableCapacity = tableCap;
+    h.hashOffset    = alignUp(h.tableOffset + tableCap * sizeof(Entry), 4096);
+    h.hashCapacity  = hashCap;
+    h.arenaOffset   = alignUp(h.hashOffset + hashCap * sizeof(std::uint64_t), 4096);
+    h.arenaCapacity = arenaCap;
+
+    std::vector<Entry> table;
+    std::vector<std::uint64_t> hash(hashCap, 0);
+    std::string arena;
+    table.reserve(paths.size());
+    arena.reserve(arenaNeeded);
+
+    for (auto p : paths) {
+        const std::uint64_t hv = hashPath(p);
+        std::uint64_t slot = hv & (hashCap - 1);
+        while (hash[slot] & SLOT_INDEX_MASK) slot = (slot + 1) & (hashCap - 1);
+        hash[slot] = makeSlot(hv, table.size());
+        table.push_back(Entry{arena.size(), static_cast<std::uint32_t>(p.size()), 0});
+        arena.append(p);
+    }
+    h.entryCount = h.liveCount = table.size();
+    h.arenaUsed  = arena.size();
+
+    std::string tmpPath = directoryOf(filePath_) + "iso_commander_database_saved_XXXXXX";
+    int tmpFd = mkstemp(tmpPath.data());
+    if (tmpFd == -1) return false;
+
+    auto fail = [&]() {
+        ::close(tmpFd);
+        ::unlink(tmpPath.c_str());
+        return false;
+    };
+
+    // The file is sized up front but only the used parts are written, so the
+    // spare capacity stays sparse on disk.
+    if (fchmod(tmpFd, 0644) == -1) return fail();
+    if (ftruncate(tmpFd, static_cast<off_t>(h.arenaOffset + h.arenaCapacity)) == -1) return fail();
+    if (!table.empty() && !writeAll(tmpFd, table.data(), table.size() * sizeof(Entry), h.tableOffset)) return fail();
+    if (!writeAll(tmpFd, hash.data(), hash.size() * sizeof(std::uint64_t), h.hashOffset)) return fail();
+    if (!arena.empty() && !writeAll(tmpFd, arena.data(), arena.size(), h.arenaOffset)) return fail();
+    if (!writeAll(tmpFd, &h, sizeof(h), 0)) return fail();
+    if (fsync(tmpFd) == -1) return fail();
+    if (lockedFd && flock(tmpFd, LOCK_EX) == -1) return fail();
+
+    if (!replace) {
+        if (::renameat2(AT_FDCWD, tmpPath.c_str(), AT_FDCWD, filePath_.c_str(), RENAME_NOREPLACE) == -1) {
+            const bool lost = errno == EEXIST;
+            fail();
+            return lost;
+        }
+    } else if (::rename(tmpPath.c_str(), filePath_.c_str()) == -1) {
+        return fail();
+    }
+    if (lockedFd) *lockedFd = tmpFd;
+    else ::close(tmpFd);
+    return true;
+}
+
+/**
+ * @brief Replaces the mapped file with @p fd, a freshly written store file
+ *        that is already locked `LOCK_EX` (see writeFileLocked()).
+ */
+bool IsoDatabaseStore::adoptLocked(int fd) {
+    unmapLocked();
+    fd_ = fd;
+    if (mapLocked() && recountLocked(true)) return true;
+    unmapLocked();
+    return false;
+}
+
+/**
+ * @brief Makes sure @c fd_ / @c map_ refer to the file currently at the
+ *        store path, creating it (or replacing an unreadable one) if needed.
+ *
+ * Another process may have rebuilt the file since we mapped it; rebuilding
+ * always goes through a rename, so comparing inodes is enough to notice.
+ */
+bool IsoDatabaseStore::ensureOpenLocked() {
+    if (fd_ != -1 && sameFile(fd_, filePath_)) return true;
+    unmapLocked();
+
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        if (::access(filePath_.c_str(), F_OK) != 0 && !writeFileLocked({}, 0, 0, false)) return false;
+
+        fd_ = ::open(filePath_.c_str(), O_RDWR | O_CLOEXEC);
+        if (fd_ == -1) return false;
+        if (mapLocked()) return true;
+
+        // Foreign, truncated or other-version file: keep it for inspection
+        // and start over with an empty database.
+        ::close(fd_);
+        fd_ = -1;
+        if (::rename(filePath_.c_str(), (filePath_ + ".corrupt").c_str()) == -1) return false;
+    }
+    return false;
+}
+
+/**
+ * @brief Opens the store and takes @p lockOp (`LOCK_SH` / `LOCK_EX`) on it,
+ *        retrying if another process swapped the file in the meantime.
+ *
+ * A shared request is served with an exclusive lock when the header first
+ * needs the repair described at recountLocked().
+ */
+bool IsoDatabaseStore::openAndLockLocked(int lockOp) {
+    for (int attempt = 0; attempt < 4; ++attempt) {
+        if (!ensureOpenLocked()) return false;
+        if (flock(fd_, lockOp) != 0) return false;
+        if (!sameFile(fd_, filePath_)) {
+            flock(fd_, LOCK_UN);
+            continue;
+        }
+        if (recountLocked(lockOp == LOCK_EX)) return true;
+        flock(fd_, LOCK_UN);
+        if (lockOp == LOCK_EX) return false;
+        lockOp = LOCK_EX;
+    }
+    return false;
+}
+
+bool IsoDatabaseStore::commitHeaderLocked(const Header& h) {
+    return writeAll(fd_, &h, sizeof(h), 0) && fdatasync(fd_) == 0;
+}
+
+/**
+ * @brief Rewrites the database with only its live entries and room for at
+ *        least @p minEntries rows and @p minArena path bytes, doubled.
+ *
+ * The new file is locked before it replaces the old one, so the exclusive
+ * lock is held throughout the swap and no other process can slip in between.
+ */
+bool IsoDatabaseStore::rebuildLocked(std::uint64_t minEntries, std::uint64_t minArena) {
+    std::vector<std::string> keep;
+    keep.reserve(header()->liveCount);
+    std::uint64_t liveBytes = 0;
+    const Entry* e = entries();
+    for (std::uint64_t i = 0; i < header()->entryCount; ++i) {
+        if (e[i].flags & ENTRY_REMOVED) continue;
+        keep.emplace_back(pathAt(i));
+        liveBytes += e[i].length;
+    }
+    std::vector<std::string_view> views(keep.begin(), keep.end());
+
+    const std::uint64_t tableCap = std::max<std::uint64_t>(minEntries, keep.size()) * 2;
+    const std::uint64_t arenaCap = std::max<std::uint64_t>(minArena, liveBytes) * 2;
+
+    int fresh = -1;
+    return writeFileLocked(views, tableCap, arenaCap, true, &fresh) && adoptLocked(fresh);
+}
+
+/**
+ * @brief Looks up @p path among committed entries.
+ *
+ * Slots referring past the committed entry count belong to an append that
+ * never reached its header commit and are treated as empty.
+ *
+ * @return Index of the live entry, or -1 if absent.
+ */
+std::int64_t IsoDatabaseStore::findLocked(std::string_view path, std::uint64_t hash) const {
+    const Header* h = header();
+    const std::uint64_t mask = h->hashCapacity - 1;
+    const std::uint64_t* table = slots();
+    const Entry* e = entries();
+    const std::uint32_t tag = tagOf(hash);
+
+    for (std::uint64_t slot = hash & mask, probes = 0; probes <= mask; slot = (slot + 1) & mask, ++probes) {
+        const std::uint64_t v = table[slot];
+        const std::uint64_t idx1 = v & SLOT_INDEX_MASK;
+        if (idx1 == 0 || idx1 > h->entryCount) return -1;
+        const std::uint64_t idx = idx1 - 1;
+        if (static_cast<std::uint32_t>(v >> 32) == tag &&
+            !(e[idx].flags & ENTRY_REMOVED) && pathAt(idx) == path) {
+            return static_cast<std::int64_t>(idx);
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Appends the paths of @p paths that are not yet present.
+ *
+ * New rows, path bytes and hash slots all land beyond the committed counts
+ * and are synced before the header that publishes them. Slots are only ever
+ * taken from empty positions (never from removed entries), so an append
+ * interrupted before its header commit leaves every probe chain intact.
+ */
+bool IsoDatabaseStore::appendLocked(const std::vector<std::string_view>& paths, std::size_t& added) {
+    added = 0;
+
+    std::vector<std::string_view> fresh;
+    std::vector<std::uint64_t> hashes;
+    std::unordered_set<std::string_view> inBatch;
+    std::uint64_t freshBytes = 0;
+    fresh.reserve(paths.size());
+    hashes.reserve(paths.size());
+    inBatch.reserve(paths.size());
+
+    for (auto p : paths) {
+        if (p.empty() || p.size() > SLOT_INDEX_MASK) continue;
+        if (!inBatch.insert(p).second) continue;
+        const std::uint64_t hv = hashPath(p);
+        if (findLocked(p, hv) >= 0) continue;
+        fresh.push_back(p);
+        hashes.push_back(hv);
+        freshBytes += p.size();
+    }
+    if (fresh.empty()) return true;
+
+    {
+        const Header* h = header();
+        if (h->entryCount + fresh.size() > h->tableCapacity ||
+            h->arenaUsed + freshBytes > h->arenaCapacity) {
+            if (!rebuildLocked(h->liveCount + fresh.size(), h->arenaUsed + freshBytes)) return false;
+        }
+    }
+
+    Header h = *header();
+    const std::uint64_t mask = h.hashCapacity - 1;
+    const std::uint64_t* committed = slots();
+
+    std::vector<Entry> rows;
+    std::string bytes;
+    rows.reserve(fresh.size());
+    bytes.reserve(freshBytes);
+
+    // Small batches touch only the slots they claim; big ones rewrite the
+    // whole section in a single write.
+    const bool bulk = fresh.size() > SLOT_BULK_THRESHOLD;
+    std::vector<std::uint64_t> all;
+    std::unordered_map<std::uint64_t, std::uint64_t> overlay;
+    if (bulk) all.assign(committed, committed + h.hashCapacity);
+
+    auto occupied = [&](std::uint64_t slot) {
+        std::uint64_t v;
+        if (bulk) {
+            v = all[slot];
+        } else {
+            auto it = overlay.find(slot);
+            v = (it != overlay.end()) ? it->second : committed[slot];
+        }
+        const std::uint64_t idx1 = v & SLOT_INDEX_MASK;
+        return idx1 != 0 && idx1 <= h.entryCount + rows.size();
+    };
+
+    for (std::size_t i = 0; i < fresh.size(); ++i) {
+        std::uint64_t slot = hashes[i] & mask;
+        while (occupied(slot)) slot = (slot + 1) & mask;
+
+        const std::uint64_t value = makeSlot(hashes[i], h.entryCount + rows.size());
+        if (bulk) all[slot] = value;
+        else overlay[slot] = value;
+
+        rows.push_back(Entry{h.arenaUsed + bytes.size(), static_cast<std::uint32_t>(fresh[i].size()), 0});
+        bytes.append(fresh[i]);
+    }
+
+    if (!writeAll(fd_, bytes.data(), bytes.size(), h.arenaOffset + h.arenaUsed)) return false;
+    if (!writeAll(fd_, rows.data(), rows.size() * sizeof(Entry), h.tableOffset + h.entryCount * sizeof(Entry))) return false;
+    if (bulk) {
+        if (!writeAll(fd_, all.data(), all.size() * sizeof(std::uint64_t), h.hashOffset)) return false;
+    } else {
+        for (const auto& [slot, value] : overlay) {
+            if (!writeAll(fd_, &value, sizeof(value), h.hashOffset + slot * sizeof(std::uint64_t))) return false;
+        }
+    }
+    if (fdatasync(fd_) != 0) return false;
+
+    h.entryCount += rows.size();
+    h.liveCount  += rows.size();
+    h.arenaUsed  += bytes.size();
+    ++h.generation;
+    if (!commitHeaderLocked(h)) return false;
+    liveBytes_ += bytes.size();
+
+    added = rows.size();
+    return true;
+}
+
+/**
+ * @brief Flags @p indices as removed and commits the new live count,
+ *        compacting the file once removed entries dominate.
+ */
+bool IsoDatabaseStore::markRemovedLocked(const std::vector<std::uint64_t>& indices) {
+    if (indices.empty()) return true;
+
+    Header h = *header();
+    const std::uint32_t removed = ENTRY_REMOVED;
+    for (std::uint64_t idx : indices) {
+        const std::uint64_t at = h.tableOffset + idx * sizeof(Entry) + offsetof(Entry, flags);
+        if (!writeAll(fd_, &removed, sizeof(removed), at)) return false;
+    }
+    if (fdatasync(fd_) != 0) return false;
+
+    h.liveCount -= std::min<std::uint64_t>(h.liveCount, indices.size());
+    ++h.generation;
+    if (!commitHeaderLocked(h)) return false;
+    for (std::uint64_t idx : indices) liveBytes_ -= std::min<std::uint64_t>(liveBytes_, entries()[idx].length);
+
+    const std::uint64_t dead = h.entryCount - h.liveCount;
+    if (dead > COMPACT_MIN_DEAD && dead > h.liveCount && !rebuildLocked(h.liveCount, 0)) {
+        // Compacting is optional, but a swap that failed half-way lost the mapping.
+        return map_ != nullptr;
+    }
+    return true;
+}
+
+// ── Journal ──────────────────────────────────────────────────────────────────
+
+/// @brief Returns true if @p path is live in the database plus the overlay.
+bool IsoDatabaseStore::liveLocked(std::string_view path) const {
+    if (pendingAddSet_.count(std::string(path))) return true;
+    if (pendingRemoves_.count(std::string(path))) return false;
+    return findLocked(path, hashPath(path)) >= 0;
+}
+
+void IsoDatabaseStore::addPendingLocked(std::string path) {
+    if (pendingAddSet_.insert(path).second) pendingAdds_.push_back(std::move(path));
+}
+
+void IsoDatabaseStore::erasePendingLocked(const std::string& path) {
+    if (pendingAddSet_.erase(path)) {
+        pendingAdds_.erase(std::find(pendingAdds_.begin(), pendingAdds_.end(), path));
+    }
+}
+
+/**
+ * @brief Folds one journal record into the overlay.
+ *
+ * `pendingRemoves_` only ever holds live database entries, and a database
+ * entry is in `pendingAdds_` only if it is also in `pendingRemoves_` (a
+ * touch: drop the old row, re-add it at the end). Records are interpreted
+ * against the current database, which is what makes replaying an
+ * already-applied journal harmless.
+ *
+ * A touch is only journaled for a live path, so replaying one for a path
+ * that is no longer live means a fold was interrupted after it flagged the
+ * old row and before it appended the new one: the path is re-added.
+ */
+void IsoDatabaseStore::applyRecordLocked(char op, std::string_view path) {
+    std::string key(path);
+    const bool inDatabase    = findLocked(path, hashPath(path)) >= 0;
+    const bool pendingAdd    = pendingAddSet_.count(key) != 0;
+    const bool pendingRemove = pendingRemoves_.count(key) != 0;
+    const bool live          = pendingAdd || (inDatabase && !pendingRemove);
+
+    switch (op) {
+        case JOURNAL_ADD:
+            if (live) break;
+            if (inDatabase) pendingRemoves_.erase(key);
+            else addPendingLocked(std::move(key));
+            break;
+        case JOURNAL_REMOVE:
+            if (pendingAdd) erasePendingLocked(key);
+            if (inDatabase) pendingRemoves_.insert(std::move(key));
+            break;
+        case JOURNAL_TOUCH:
+            if (!live) {
+                addPendingLocked(std::move(key));
+                break;
+            }
+            if (inDatabase) pendingRemoves_.insert(key);
+            if (pendingAdd) erasePendingLocked(key);
+            addPendingLocked(std::move(key));
+            break;
+    }
+}
+
+/**
+ * @brief Brings the overlay in line with the journal on disk.
+ *
+ * Cheap when nothing changed (one `fstat` and one 16-byte read). Otherwise
+ * (first use, another process appended, or the journal was truncated under
+ * a new epoch) the overlay is rebuilt by replaying the whole journal, and a
+ * torn or corrupt tail left by a crash is cut off at the last good record.
+ *
+ * Only an @p exclusive holder repairs the file. Under a shared lock other
+ * readers may be replaying it too, so replay just stops at a bad tail and
+ * treats a mangled header as an empty journal; the next exclusive section
+ * sees the size mismatch and does the cut.
+ */
+bool IsoDatabaseStore::syncJournalLocked(bool exclusive) {
+    if (journalFd_ == -1) {
+        journalFd_ = ::open(journalPath_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+        if (journalFd_ == -1) return false;
+        journalSize_ = 0;
+    }
+
+    struct stat st;
+    if (::fstat(journalFd_, &st) != 0) return false;
+    const std::uint64_t size = static_cast<std::uint64_t>(st.st_size);
+
+    char head[JOURNAL_HEADER];
+    std::uint64_t epoch = 0;
+    const bool headerOk = size >= JOURNAL_HEADER &&
+                          ::pread(journalFd_, head, sizeof(head), 0) == static_cast<ssize_t>(sizeof(head)) &&
+                          std::memcmp(head, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC)) == 0;
+    if (headerOk) std::memcpy(&epoch, head + 8, sizeof(epoch));
+
+    if (!headerOk) {
+        // Missing or mangled header: nothing in the file can be trusted.
+        journalEpoch_ = 0;
+        if (exclusive) return resetJournalLocked();
+        journalSize_ = 0;
+        journalRecords_ = 0;
+        pendingAdds_.clear();
+        pendingAddSet_.clear();
+        pendingRemoves_.clear();
+        return true;
+    }
+    if (journalSize_ != 0 && epoch == journalEpoch_ && size == journalSize_) return true;
+
+    pendingAdds_.clear();
+    pendingAddSet_.clear();
+    pendingRemoves_.clear();
+    journalRecords_ = 0;
+    journalEpoch_ = epoch;
+
+    std::string buf(size, '\0');
+    if (::pread(journalFd_, buf.data(), buf.size(), 0) != static_cast<ssize_t>(buf.size())) return false;
+
+    std::uint64_t pos = JOURNAL_HEADER;
+    while (pos + JOURNAL_RECORD_HDR <= size) {
+        const char op = buf[pos];
+        std::uint32_t length;
+        std::uint64_t check;
+        std::memcpy(&length, buf.data() + pos + 4, sizeof(length));
+        std::memcpy(&check, buf.data() + pos + 8, sizeof(check));
+        if (pos + JOURNAL_RECORD_HDR + length > size) break;
+
+        const std::string_view path(buf.data() + pos + JOURNAL_RECORD_HDR, length);
+        const bool knownOp = op == JOURNAL_ADD || op == JOURNAL_REMOVE || op == JOURNAL_TOUCH;
+        if (!knownOp || recordChecksum(op, path) != check) break;
+
+        applyRecordLocked(op, path);
+        ++journalRecords_;
+        pos += JOURNAL_RECORD_HDR + length;
+    }
+
+    if (exclusive && pos != size && ::ftruncate(journalFd_, static_cast<off_t>(pos)) != 0) return false;
+    journalSize_ = pos;
+    return true;
+}
+
+/// @brief Truncates the journal to a bare header under a new epoch.
+bool IsoDatabaseStore::resetJournalLocked() {
+    char head[JOURNAL_HEADER];
+    const std::uint64_t epoch = journalEpoch_ + 1;
+    std::memcpy(head, JOURNAL_MAGIC, sizeof(JOURNAL_MAGIC));
+    std::memcpy(head + 8, &epoch, sizeof(epoch));
+
+    if (::ftruncate(journalFd_, 0) != 0) return false;
+    if (!writeAll(journalFd_, head, sizeof(head), 0) || fdatasync(journalFd_) != 0) return false;
+
+    journalEpoch_ = epoch;
+    journalSize_ = JOURNAL_HEADER;
+    journalRecords_ = 0;
+    pendingAdds_.clear();
+    pendingAddSet_.clear();
+    pendingRemoves_.clear();
+    return true;
+}
+
+/**
+ * @brief Appends one @p op record per path with a single write and a single
+ *        `fdatasync`, then mirrors them in the overlay.
+ */
+bool IsoDatabaseStore::writeJournalLocked(char op, const std::vector<std::string_view>& paths) {
+    if (paths.empty()) return true;
+
+    std::string buf;
+    std::size_t total = 0;
+    for (auto p : paths) total += JOURNAL_RECORD_HDR + p.size();
+    buf.reserve(total);
+
+    for (auto p : paths) {
+        char rec[JOURNAL_RECORD_HDR] = {};
+        const std::uint32_t length = static_cast<std::uint32_t>(p.size());
+        const std::uint64_t check = recordChecksum(op, p);
+        rec[0] = op;
+        std::memcpy(rec + 4, &length, sizeof(length));
+        std::memcpy(rec + 8, &check, sizeof(check));
+        buf.append(rec, sizeof(rec));
+        buf.append(p);
+    }
+
+    if (!writeAll(journalFd_, buf.data(), buf.size(), journalSize_) || fdatasync(journalFd_) != 0) {
+        // Whatever landed past journalSize_ is cut off on the next replay.
+        return false;
+    }
+    journalSize_ += buf.size();
+    journalRecords_ += paths.size();
+    for (auto p : paths) applyRecordLocked(op, p);
+
+    scheduleCompactionLocked();
+    return true;
+}
+
+/**
+ * @brief Applies the overlay to the database in place, then truncates the
+ *        journal. This is the checkpoint replay starts from.
+ */
+bool IsoDatabaseStore::compactLocked() {
+    if (pendingAdds_.empty() && pendingRemoves_.empty()) {
+        return journalSize_ == JOURNAL_HEADER || resetJournalLocked();
+    }
+
+    std::vector<std::uint64_t> indices;
+    indices.reserve(pendingRemoves_.size());
+    for (const auto& p : pendingRemoves_) {
+        const std::int64_t idx = findLocked(p, hashPath(p));
+        if (idx >= 0) indices.push_back(static_cast<std::uint64_t>(idx));
+    }
+    if (!markRemovedLocked(indices)) return false;
+
+    std::vector<std::string_view> adds(pendingAdds_.begin(), pendingAdds_.end());
+    std::size_t added = 0;
+    if (!appendLocked(adds, added)) return false;
+
+    return resetJournalLocked();
+}
+
+std::size_t IsoDatabaseStore::liveCountLocked() const {
+    return static_cast<std::size_t>(header()->liveCount) - pendingRemoves_.size() + pendingAdds_.size();
+}
+
+std::uint64_t IsoDatabaseStore::dataBytesLocked() const {
+    std::uint64_t bytes = liveBytes_;
+    for (const auto& p : pendingAdds_) bytes += p.size();
+    for (const auto& p : pendingRemoves_) bytes -= std::min<std::uint64_t>(bytes, p.size());
+    return HEADER_BYTES + liveCountLocked() * ENTRY_COST + bytes;
+}
+
+/**
+ * @brief Removes least recently used entries until at least @p count are
+ *        gone and at least @p bytes (as @ref dataBytes counts them) are freed.
+ */
+std::size_t IsoDatabaseStore::evictLocked(std::size_t count, std::uint64_t bytes) {
+    if (!compactLocked()) return 0;
+
+    std::vector<std::uint64_t> indices;
+    std::uint64_t freed = 0;
+    const Entry* e = entries();
+    for (std::uint64_t i = 0; i < header()->entryCount && (indices.size() < count || freed < bytes); ++i) {
+        if (e[i].flags & ENTRY_REMOVED) continue;
+        indices.push_back(i);
+        freed += e[i].length + ENTRY_COST;
+    }
+    return markRemovedLocked(indices) ? indices.size() : 0;
+}
+
+/// @brief Queues a background fold once the journal has grown past its threshold.
+void IsoDatabaseStore::scheduleCompactionLocked() {
+    if (journalSize_ < JOURNAL_COMPACT_BYTES && journalRecords_ < JOURNAL_COMPACT_RECORDS) return;
+    if (!backgroundCompaction_) {
+        compactLocked();
+        return;
+    }
+    if (compactionQueued_.exchange(true)) return;
+
+    // If the pool shuts down first the task is dropped and the journal is
+    // simply replayed on the next start.
+    getStaticThreadPool().submit([this] {
+        compactionQueued_.store(false);
+        compact();
+    }, TaskPriority::Background);
+}
+
+// ── Public interface ─────────────────────────────────────────────────────────
+
+void IsoDatabaseStore::setLimits(const Limits& limits) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    limits_ = limits;
+}
+
+std::size_t IsoDatabaseStore::append(const std::vector<std::string>& paths, AppendStats* stats) {
+    auto failed = [stats] {
+        if (stats) stats->failed = true;
+        return std::size_t{0};
+    };
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_EX)) return failed();
+    FlockGuard unlock{fd_};
+    if (!syncJournalLocked(true)) return failed();
+
+    std::vector<std::string_view> fresh;
+    std::unordered_set<std::string_view> inBatch;
+    for (const auto& p : paths) {
+        if (p.empty() || !inBatch.insert(p).second || liveLocked(p)) continue;
+        fresh.push_back(p);
+    }
+
+    if (limits_.refuseWhenFull) {
+        std::size_t live = liveCountLocked();
+        std::uint64_t bytes = dataBytesLocked();
+        std::size_t fits = 0;
+        for (; fits < fresh.size(); ++fits) {
+            const std::uint64_t cost = fresh[fits].size() + ENTRY_COST;
+            if (limits_.maxEntries && live + 1 > limits_.maxEntries) break;
+            if (limits_.maxBytes && bytes + cost > limits_.maxBytes) break;
+            ++live;
+            bytes += cost;
+        }
+        if (stats) stats->refused = fresh.size() - fits;
+        fresh.resize(fits);
+    }
+    if (fresh.empty()) return 0;
+
+    std::size_t added = 0;
+    if (fresh.size() > JOURNAL_DIRECT_BATCH) {
+        if (!compactLocked() || !appendLocked(fresh, added)) return failed();
+    } else {
+        if (!writeJournalLocked(JOURNAL_ADD, fresh)) return failed();
+        added = fresh.size();
+    }
+
+    if (!limits_.refuseWhenFull) {
+        const std::size_t live = liveCountLocked();
+        const std::uint64_t bytes = dataBytesLocked();
+        const std::size_t overEntries = (limits_.maxEntries && live > limits_.maxEntries) ? live - limits_.maxEntries : 0;
+        const std::uint64_t overBytes = (limits_.maxBytes && bytes > limits_.maxBytes) ? bytes - limits_.maxBytes : 0;
+        if (overEntries || overBytes) {
+            const std::size_t evicted = evictLocked(overEntries, overBytes);
+            if (stats) stats->evicted = evicted;
+        }
+    }
+    return added;
+}
+
+std::size_t IsoDatabaseStore::touch(const std::vector<std::string>& paths) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_EX)) return 0;
+    FlockGuard unlock{fd_};
+    if (!syncJournalLocked(true)) return 0;
+
+    std::vector<std::string_view> used;
+    std::unordered_set<std::string_view> inBatch;
+    for (const auto& p : paths) {
+        if (!inBatch.insert(p).second || !liveLocked(p)) continue;
+        used.push_back(p);
+    }
+    if (used.empty()) return 0;
+
+    if (!writeJournalLocked(JOURNAL_TOUCH, used)) return 0;
+    // Moving a row drops it and re-adds the path, two separate commits; big
+    // batches are still journaled first so a crash between them is replayed.
+    if (used.size() > JOURNAL_DIRECT_BATCH && !compactLocked()) return 0;
+    return used.size();
+}
+
+std::size_t IsoDatabaseStore::remove(const std::vector<std::string>& paths) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_EX)) return 0;
+    FlockGuard unlock{fd_};
+    if (!syncJournalLocked(true)) return 0;
+
+    std::vector<std::string_view> doomed;
+    std::unordered_set<std::string_view> inBatch;
+    for (const auto& p : paths) {
+        if (!inBatch.insert(p).second || !liveLocked(p)) continue;
+        doomed.push_back(p);
+    }
+    if (doomed.empty()) return 0;
+
+    if (doomed.size() > JOURNAL_DIRECT_BATCH) {
+        if (!compactLocked()) return 0;
+        std::vector<std::uint64_t> indices;
+        indices.reserve(doomed.size());
+        for (auto p : doomed) {
+            const std::int64_t idx = findLocked(p, hashPath(p));
+            if (idx >= 0) indices.push_back(static_cast<std::uint64_t>(idx));
+        }
+        return markRemovedLocked(indices) ? indices.size() : 0;
+    }
+    return writeJournalLocked(JOURNAL_REMOVE, doomed) ? doomed.size() : 0;
+}
+
+std::size_t IsoDatabaseStore::evictOldest(std::size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_EX)) return 0;
+    FlockGuard unlock{fd_};
+    if (!syncJournalLocked(true)) return 0;
+    return evictLocked(count, 0);
+}
+
+bool IsoDatabaseStore::contains(std::string_view path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_SH)) return false;
+    FlockGuard unlock{fd_};
+    if (!syncJournalLocked(false)) return false;
+    return liveLocked(path);
+}
+
+void IsoDatabaseStore::forEach(const std::function<void(std::string_view)>& fn) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_SH)) return;
+    FlockGuard unlock{fd_};
+    if (!syncJournalLocked(false)) return;
+
+    const Entry* e = entries();
+    const std::uint64_t n = header()->entryCount;
+    for (std::uint64_t i = 0; i < n; ++i) {
+        if (e[i].flags & ENTRY_REMOVED) continue;
+        const std::string_view p = pathAt(i);
+        if (!pendingRemoves_.empty() && pendingRemoves_.count(std::string(p))) continue;
+        fn(p);
+    }
+    for (const auto& p : pendingAdds_) fn(p);
+}
+
+bool IsoDatabaseStore::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_EX)) return false;
+    FlockGuard unlock{fd_};
+
+    // Journal first: a crash in between must not resurrect journalled adds.
+    if (!syncJournalLocked(true) || !resetJournalLocked()) return false;
+    int fresh = -1;
+    return writeFileLocked({}, 0, 0, true, &fresh) && adoptLocked(fresh);
+}
+
+long IsoDatabaseStore::importText(const std::string& textPath, AppendStats* stats) {
+    std::ifstream in(textPath);
+    if (!in) return -1;
+
+    std::vector<std::string> paths;
+    std::string line;
+    while (std::getline(in, line)) {
+        if (!line.empty()) paths.push_back(std::move(line));
+    }
+    return static_cast<long>(append(paths, stats));
+}
+
+bool IsoDatabaseStore::exportText(const std::string& textPath) {
+    std::string tmpPath = directoryOf(textPath) + "iso_commander_database_export_XXXXXX";
+    int tmpFd = mkstemp(tmpPath.data());
+    if (tmpFd == -1) return false;
+
+    std::string out;
+    forEach([&out](std::string_view p) {
+        out.append(p);
+        out.push_back('\n');
+    });
+
+    const bool ok = fchmod(tmpFd, 0644) == 0 &&
+                    writeAll(tmpFd, out.data(), out.size(), 0) &&
+                    fsync(tmpFd) == 0;
+    ::close(tmpFd);
+
+    if (!ok || ::rename(tmpPath.c_str(), textPath.c_str()) == -1) {
+        ::unlink(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::size_t IsoDatabaseStore::liveCount() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_SH)) return 0;
+    FlockGuard unlock{fd_};
+    if (!syncJournalLocked(false)) return 0;
+    return liveCountLocked();
+}
+
+std::uint64_t IsoDatabaseStore::dataBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_SH)) return 0;
+    FlockGuard unlock{fd_};
+    if (!syncJournalLocked(false)) return 0;
+    return dataBytesLocked();
+}
+
+std::uint64_t IsoDatabaseStore::diskBytes() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_SH)) return 0;
+    FlockGuard unlock{fd_};
+
+    std::uint64_t total = 0;
+    struct stat st;
+    if (::fstat(fd_, &st) == 0) total += static_cast<std::uint64_t>(st.st_blocks) * 512;
+    if (journalFd_ != -1 && ::fstat(journalFd_, &st) == 0) total += static_cast<std::uint64_t>(st.st_blocks) * 512;
+    return total;
+}
+
+bool IsoDatabaseStore::compact() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!openAndLockLocked(LOCK_EX)) return false;
+    FlockGuard unlock{fd_};
+    return syncJournalLocked(true) && compactLocked();
+}
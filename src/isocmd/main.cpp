@@ -23,6 +23,7 @@
 
 // Project Headers
 #include "../threadpool.h"
+#include "../cancellation.h"
 #include "../databaseOps.h"
 #include "../inputHandling.h"
 #include "../main.h"
@@ -69,7 +70,6 @@ int main(int argc, char *argv[]) {
     /// @}
 
     // Generous reserve for future lists
-    GlobalState::globalIsoFileList.reserve(1000);
     GlobalState::binImgFilesCache.reserve(1000);
     GlobalState::mdfMdsFilesCache.reserve(1000);
     GlobalState::nrgFilesCache.reserve(1000);
@@ -131,14 +131,14 @@ int main(int argc, char *argv[]) {
     std::map<std::string, std::string> config = readUserConfigLists(GlobalState::configPath);
     std::vector<std::thread> backgroundThreads;
 
-    // Shared state for background import coordination (isImportRunning, stopImport, worker sync)
+    // Shared state for background import coordination (isImportRunning, importGroup)
     std::shared_ptr<RefreshState> importState;
     importState = std::make_shared<RefreshState>();
 
     /// Start background database import if auto-update is enabled and FolderPaths exist in history file
     if (search.load() && (!(isHistoryFileEmpty(GlobalState::historyFilePath) || !fs::is_regular_file(GlobalState::historyFilePath)))) {
         importState->isImportRunning.store(true);
-        backgroundThreads.emplace_back([importState, &search] {
+        importState->importGroup.enqueue([importState, &search] {
             backgroundDatabaseImport(importState);
             search.store(false);
         });
@@ -158,7 +158,7 @@ int main(int argc, char *argv[]) {
         rl_bind_key('\f', prevent_readline_keybindings);
         rl_bind_key('\t', prevent_readline_keybindings);
 
-        GlobalState::g_operationCancelled.store(false);
+        Cancellation::beginOperation();
         isAtMain.store(true);
         isAtISOList.store(false);
 
@@ -213,7 +213,7 @@ int main(int argc, char *argv[]) {
         if (choice == "1") {
             isAtMain.store(false);
             isAtISOList.store(false);
-            submenu1(isAtISOList, importState, backgroundThreads);
+            submenu1(isAtISOList, importState);
         } else if (choice.length() == 1) {
             switch (choice[0]) {
                 case '2':
@@ -245,20 +245,17 @@ int main(int argc, char *argv[]) {
     }
 
     //// @name Cleanup and Resource Release
-    /// Shut down the thread pool, signal background tasks to stop, and release system locks.
+    /// Signal background tasks to stop, shut down the thread pool, and release system locks.
+    /// Cancellation goes first so pool workers running or helping an import can leave it.
     /// @{
-    getStaticThreadPool().shutdown();
+    importState->importGroup.cancel();
+    stopMessage = true;
+    Cancellation::shutdown();
 
-    importState->stopImport = stopMessage = true;
-    GlobalState::g_operationCancelled.store(true, std::memory_order_release);
+    getStaticThreadPool().shutdown();
 
     if (importState) {
         importState->isImportRunning.store(false, std::memory_order_release);
-        {
-            std::lock_guard<std::mutex> lk(importState->workerMutex);
-            // Use notify_all() to wake up all background database threads safely
-            importState->workerCV.notify_all();
-        }
     }
 
     for (auto& t : backgroundThreads) {
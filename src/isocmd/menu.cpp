@@ -62,7 +62,6 @@ void print_ascii() {
 
 void selectForIsoFiles(const std::string& operation,
     std::atomic<bool>& isAtISOList,
-    std::vector<std::thread>& backgroundThreads,
     std::shared_ptr<RefreshState> refreshState);
 
 /**
@@ -86,12 +85,9 @@ void selectForIsoFiles(const std::string& operation,
  *                          ISO list is currently active.
  * @param refreshState      Shared @c RefreshState passed through to each
  *                          @c selectForIsoFiles call for import coordination.
- * @param backgroundThreads Passed through to each @c selectForIsoFiles call for
- *                          background worker lifetime management.
  */
 void submenu1(std::atomic<bool>& isAtISOList,
-    std::shared_ptr<RefreshState> refreshState,
-    std::vector<std::thread>& backgroundThreads) {
+    std::shared_ptr<RefreshState> refreshState) {
     while (true) {
         rl_bind_key('\f', prevent_readline_keybindings);
         rl_bind_key('\t', prevent_readline_keybindings);
@@ -131,32 +127,32 @@ void submenu1(std::atomic<bool>& isAtISOList,
             switch (choice[0]) {
                 case '1':
                     clearScrollBuffer();
-                    selectForIsoFiles("mount", isAtISOList, backgroundThreads, refreshState);
+                    selectForIsoFiles("mount", isAtISOList, refreshState);
                     clearScrollBuffer();
                     break;
                 case '2':
                     clearScrollBuffer();
-                    selectForIsoFiles("umount", isAtISOList, backgroundThreads, refreshState);
+                    selectForIsoFiles("umount", isAtISOList, refreshState);
                     clearScrollBuffer();
                     break;
                 case '3':
                     clearScrollBuffer();
-                    selectForIsoFiles("rm", isAtISOList, backgroundThreads, refreshState);
+                    selectForIsoFiles("rm", isAtISOList, refreshState);
                     clearScrollBuffer();
                     break;
                 case '4':
                     clearScrollBuffer();
-                    selectForIsoFiles("mv", isAtISOList, backgroundThreads, refreshState);
+                    selectForIsoFiles("mv", isAtISOList, refreshState);
                     clearScrollBuffer();
                     break;
                 case '5':
                     clearScrollBuffer();
-                    selectForIsoFiles("cp", isAtISOList, backgroundThreads, refreshState);
+                    selectForIsoFiles("cp", isAtISOList, refreshState);
                     clearScrollBuffer();
                     break;
                 case '6':
                     clearScrollBuffer();
-                    selectForIsoFiles("write2usb", isAtISOList, backgroundThreads, refreshState);
+                    selectForIsoFiles("write2usb", isAtISOList, refreshState);
                     clearScrollBuffer();
                     break;
             }
@@ -24,10 +24,11 @@
 #include <libmount/libmount.h>
 
 // Project Headers
-#include "../globalMutexes.h"
+#include "../cancellation.h"
 #include "../mount.h"
 #include "../state.h"
 #include "../stringManipulation.h"
+#include "../threadpool.h"
 #include "../verbose.h"
 
 struct libmnt_context;
@@ -190,6 +191,261 @@ static std::string mountPointSuffix(const std::string& isoPath) {
     return out;
 }
 
+/// @brief Packs (st_dev, st_ino) into one key; inodes are only unique per device.
+static uint64_t makeInodeKey(const struct stat& st) {
+    return (static_cast<uint64_t>(st.st_dev) << 32) | st.st_ino;
+}
+
+/**
+ * @brief Collects the inodes of every file currently mounted, so that a
+ *        renamed ISO (same inode, different path) is recognised as mounted.
+ *
+ * mnt_fs_get_source() returns the loop device (e.g. /dev/loop0) for ISO
+ * mounts, not the backing file path, so it is resolved through sysfs.
+ */
+static std::unordered_set<uint64_t> buildMountedInodeCache() {
+    std::unordered_set<uint64_t> inodes;
+    libmnt_table* tbl = mnt_new_table_from_file("/proc/self/mountinfo");
+    if (!tbl) return inodes;
+
+    // RAII wrapper for libmount table
+    struct TableGuard {
+        libmnt_table* t;
+        ~TableGuard() { if (t) mnt_free_table(t); }
+    } tableGuard{tbl};
+
+    libmnt_iter* itr = mnt_new_iter(MNT_ITER_FORWARD);
+    if (!itr) return inodes;
+
+    // RAII wrapper for libmount iterator
+    struct IterGuard {
+        libmnt_iter* i;
+        ~IterGuard() { if (i) mnt_free_iter(i); }
+    } iterGuard{itr};
+
+    libmnt_fs* fs = nullptr;
+    while (mnt_table_next_fs(tbl, itr, &fs) == 0) {
+        const char* src = mnt_fs_get_source(fs);
+        if (!src) continue;
+
+        struct stat st{};
+        if (::stat(src, &st) != 0) continue;
+
+        if (S_ISBLK(st.st_mode)) {
+            // Block device — check if it is a loop device backed by a file.
+            // /sys/block/loopN/loop/backing_file contains the real path,
+            // and stat() on that path gives the stable inode regardless of
+            // any renames that have happened since the mount.
+            unsigned int loopNum = 0;
+            if (std::sscanf(src, "/dev/loop%u", &loopNum) == 1) {
+                // Use pre-sized string buffer to avoid multiple allocations
+                char backingPath[256];
+                int written = snprintf(backingPath, sizeof(backingPath),
+                                      "/sys/block/loop%u/loop/backing_file", loopNum);
+                if (written <= 0 || static_cast<size_t>(written) >= sizeof(backingPath)) {
+                    continue; // Path too long, skip this entry
+                }
+
+                // Use RAII for file stream
+                std::ifstream f(backingPath);
+                if (!f.is_open()) continue;
+
+                std::string realPath;
+                if (std::getline(f, realPath) && !realPath.empty()) {
+                    // Trim trailing whitespace
+                    while (!realPath.empty() &&
+                           (realPath.back() == '\n' || realPath.back() == '\r'))
+                        realPath.pop_back();
+
+                    struct stat backingSt{};
+                    if (::stat(realPath.c_str(), &backingSt) == 0)
+                        inodes.insert(makeInodeKey(backingSt));
+                }
+                // f is automatically closed when it goes out of scope
+            }
+        } else {
+            // Direct file mount (no loop device) — stat it normally.
+            inodes.insert(makeInodeKey(st));
+        }
+    }
+    // IterGuard and TableGuard automatically clean up
+    return inodes;
+}
+
+/**
+ * @brief The calling thread's libmount context, allocated on first use and
+ *        reset by the caller before each mount.
+ * @return nullptr if it could not be allocated.
+ */
+static libmnt_context* threadMountContext() {
+    struct CtxHolder {
+        libmnt_context* c = mnt_new_context();
+        ~CtxHolder() { if (c) mnt_free_context(c); }
+    };
+    thread_local CtxHolder holder;
+    return holder.c;
+}
+
+namespace {
+
+/// @brief State shared by the per-file pipelines of one @ref mountIsoFiles call.
+struct MountBatch {
+    std::atomic<size_t>* completedTasks;
+    std::atomic<size_t>* failedTasks;
+    bool silentMode;
+    ResultChannel& results;
+    CancellationToken cancel;                       ///< The operation the batch belongs to.
+
+    std::mutex cacheMutex;                          ///< Guards both caches.
+    std::unordered_set<std::string> mountPointCache;
+    std::unordered_set<uint64_t> mountedInodes;
+};
+
+} // namespace
+
+/**
+ * @brief Mounts one ISO file: probed as a task of the group it was spawned
+ *        into, mounted as a task of @p mounts.
+ *
+ * The probe stage (stat, format check, mount point, duplicate check) only
+ * reads, so any number of files may be probed at once; the mount stage
+ * holds one of @p mounts' slots only for the mkdir and the mount itself.
+ *
+ * A file passing the duplicate check claims its mount point and inode in
+ * @p batch's caches before it is mounted, so a second path to the same
+ * inode later in the batch is skipped rather than mounted twice even when
+ * both are in flight. The claim is released if the mount fails.
+ */
+static PipelineTask mountIsoFile(MountBatch& batch, TaskGroup& mounts, std::string isoFile) {
+    VerbosityFormatter formatter;
+
+    auto recordFail = [&](const char* reason) {
+        if (!batch.silentMode) {
+            auto [dir, file] = extractDirectoryAndFilename(isoFile, "mount");
+            batch.results.failed(formatter.formatError(std::string(dir), std::string(file), reason));
+        }
+        batch.failedTasks->fetch_add(1, std::memory_order_relaxed);
+    };
+
+    if (batch.cancel.cancelled()) {
+        recordFail("cxl");
+        co_return;
+    }
+
+    // Single stat() call for existence check, validation, and inode cache
+    struct stat isoStat{};
+    if (::stat(isoFile.c_str(), &isoStat) != 0) {
+        recordFail("missingISO");
+        co_return;
+    }
+
+    // Check if it's a regular file
+    if (!S_ISREG(isoStat.st_mode)) {
+        recordFail("badFS");
+        co_return;
+    }
+
+    // Validate ISO format using pre-existing stat result (avoids redundant stat)
+    if (!isValidIsoFile(isoFile, isoStat)) {
+        recordFail("badFS");
+        co_return;
+    }
+
+    const fs::path isoPath(isoFile);
+    std::string mountPoint;
+    mountPoint.reserve(256); // Typical path length
+    mountPoint = "/mnt/iso_";
+    mountPoint += isoPath.stem().string();
+    mountPoint += "~";
+    mountPoint += mountPointSuffix(isoFile);
+
+    // Path-based skip (file was not renamed), then inode-based skip (file was
+    // renamed after being mounted): the kernel tracks loop-device backing files
+    // by inode, so a rename leaves the original mount intact but under a stale
+    // path in our name-derived mountPointCache.
+    const uint64_t inodeKey = makeInodeKey(isoStat);
+    bool alreadyMounted;
+    {
+        std::lock_guard<std::mutex> lock(batch.cacheMutex);
+        alreadyMounted = batch.mountPointCache.count(mountPoint) ||
+                         !batch.mountedInodes.insert(inodeKey).second;
+        if (!alreadyMounted) batch.mountPointCache.insert(mountPoint);
+    }
+    if (alreadyMounted) {
+        auto [mntDir, mntName] = extractDirectoryAndFilename(mountPoint, "mount");
+        auto [isoDir, isoName] = extractDirectoryAndFilename(isoFile, "mount");
+        if (!batch.silentMode)
+            batch.results.skipped(
+                formatter.formatSkipped(std::string(isoDir), std::string(isoName),
+                                        std::string(mntDir), std::string(mntName))
+            );
+        batch.completedTasks->fetch_add(1, std::memory_order_relaxed);
+        co_return;
+    }
+
+    auto releaseClaim = [&] {
+        std::lock_guard<std::mutex> lock(batch.cacheMutex);
+        batch.mountPointCache.erase(mountPoint);
+        batch.mountedInodes.erase(inodeKey);
+    };
+
+    co_await mounts.schedule();
+
+    if (batch.cancel.cancelled()) {
+        releaseClaim();
+        recordFail("cxl");
+        co_return;
+    }
+
+    libmnt_context* ctx = threadMountContext();
+    if (!ctx) {
+        releaseClaim();
+        recordFail("no mount context");
+        co_return;
+    }
+
+    std::error_code ec;
+    fs::create_directory(mountPoint, ec);
+
+    if ((ec && ec != std::errc::file_exists) ||
+        (fs::exists(mountPoint) && !fs::is_directory(mountPoint))) {
+        releaseClaim();
+        recordFail("mkdir failed");
+        co_return;
+    }
+
+    mnt_reset_context(ctx);
+    mnt_context_set_source(ctx, isoFile.c_str());
+    mnt_context_set_target(ctx, mountPoint.c_str());
+    mnt_context_set_options(ctx, "loop,ro");
+    mnt_context_set_fstype_pattern(ctx, "udf,iso9660");
+
+    const int ret = mnt_context_mount(ctx);
+
+    if (ret == 0) {
+        if (!batch.silentMode) {
+            // The display parts view this thread's path cache, so they are
+            // resolved here rather than carried over from the probe stage.
+            auto [mntDir, mntName] = extractDirectoryAndFilename(mountPoint, "mount");
+            auto [isoDir, isoName] = extractDirectoryAndFilename(isoFile, "mount");
+            const char* rawFsType = mnt_context_get_fstype(ctx);
+            const std::string fsType = rawFsType ? rawFsType : "unknown";
+            batch.results.completed(
+                formatter.formatMountSuccess(std::string(isoDir), std::string(isoName),
+                                             std::string(mntDir), std::string(mntName), fsType)
+            );
+        }
+        batch.completedTasks->fetch_add(1, std::memory_order_relaxed);
+    } else {
+        releaseClaim();
+        recordFail("badFS");
+        // Only remove the directory we just created if it is empty;
+        // a concurrent mount may have legitimately used it.
+        if (fs::is_directory(mountPoint) && fs::is_empty(mountPoint))
+            fs::remove(mountPoint, ec);
+    }
+}
+
 /**
  * @brief Mounts a batch of ISO files to unique directories under /mnt using loop devices.
  *
@@ -197,14 +453,18 @@ static std::string mountPointSuffix(const std::string& isoPath) {
  * cancellation state, file existence, and filesystem format) to minimize unnecessary I/O.
  *
  * ### Integrity & Performance Features:
- * - **Resource Efficiency:** Uses a single `libmnt_context` per batch, reset via `mnt_reset_context`
- * to avoid repeated allocation overhead.
+ * - **Per-file pipelines:** Every file is its own @ref PipelineTask (see @ref mountIsoFile):
+ * probed in a "mount.probe" group, then mounted in a "mount" group capped at
+ * `GlobalConcurrency::MOUNT_THREAD_CAP`. A file on a slow disk delays only itself.
+ * - **Resource Efficiency:** Each worker keeps one `libmnt_context`, reset via
+ * `mnt_reset_context` before every mount.
  * - **Intelligent Deduplication:**
- * 1. **Path-based:** Filters via `mountPointCache` for quick lookups.
+ * 1. **Path-based:** Filters via a mount point cache built once per batch.
  * 2. **Inode-based:** Inspects `/sys/block/loopN/loop/backing_file` to detect files that have
  * been renamed or hard-linked but are already active, ensuring idempotency.
- * - **Concurrency Strategy:** Results are buffered in thread-local vectors and flushed to
- * `globalSets` periodically to minimize lock contention on `GlobalMutexes::globalSetsMutex`.
+ * - **Concurrency Strategy:** Results are pushed into @p results without taking a lock
+ * and collected into `verboseSets` by this function while it waits (see @ref ResultChannel),
+ * so it must be called on the thread that consumes @p results.
  *
  * ### Mount Path Schema:
  * `/mnt/iso_<stem>~<5-char base-36 FNV-1a suffix>`
@@ -213,287 +473,46 @@ static std::string mountPointSuffix(const std::string& isoPath) {
  * @param completedTasks Atomic counter for successful mounts and skipped duplicates.
  * @param failedTasks   Atomic counter for any failures (e.g., missing root, I/O errors).
  * @param silentMode    If true, suppresses all log generation; only updates atomics.
+ * @param results       Receives one completed, skipped or failed message per file.
  *
  * @warning Requires root privileges (geteuid() == 0). If invoked without root, all
  * operations will immediately fail with a "needsRoot" error.
- * @note The inode cache is updated dynamically during the loop, allowing the function to
- * properly handle batches containing duplicate files.
+ * @note The caches are shared by the whole batch and updated as files are claimed,
+ * so batches containing duplicate files are handled correctly.
  */
 void mountIsoFiles(
     const std::vector<std::string>& isoFiles,
     std::atomic<size_t>* completedTasks,
     std::atomic<size_t>* failedTasks,
-    bool silentMode)
+    bool silentMode,
+    ResultChannel& results)
 {
     const bool hasRoot = (geteuid() == 0);
 
     if (!hasRoot) {
         if (!silentMode) {
+            // Pushed on the consuming thread itself: drained as it goes so
+            // a bounded channel can't fill up and block it.
             VerbosityFormatter formatter;
-            std::vector<std::string> fails;
-            fails.reserve(isoFiles.size());
             for (const auto& isoFile : isoFiles) {
                 auto [dir, file] = extractDirectoryAndFilename(isoFile, "mount");
-                fails.push_back(formatter.formatError(std::string(dir), std::string(file), "needsRoot"));
+                results.failed(formatter.formatError(std::string(dir), std::string(file), "needsRoot"));
+                results.collect();
             }
-            std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
-            verboseSets.operationFailed.insert(fails.begin(), fails.end());
         }
         failedTasks->fetch_add(isoFiles.size(), std::memory_order_relaxed);
         return;
     }
 
-    libmnt_context* ctx = mnt_new_context();
-    if (!ctx) {
-        if (!silentMode) {
-            std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
-            verboseSets.operationFailed.insert("\033[1;91mFailed to create mount context.\033[0m");
-        }
-        return;
-    }
-    struct CtxGuard {
-        libmnt_context* c;
-        ~CtxGuard() { mnt_free_context(c); }
-    } ctxGuard{ctx};
-
-    // Pack (st_dev, st_ino) into a single uint64_t key so the cache is
-    // correct across multiple filesystems (inodes are only unique per device).
-    auto makeInodeKey = [](const struct stat& st) -> uint64_t {
-        return (static_cast<uint64_t>(st.st_dev) << 32) | st.st_ino;
-    };
-
-    // Build cache of already-mounted source inodes so that a renamed ISO
-    // (same inode, different path) is correctly recognised as already mounted.
-    // mnt_fs_get_source() returns the loop device (e.g. /dev/loop0) for ISO
-    // mounts, not the backing file path, so we resolve it through sysfs.
-    auto buildMountedInodeCache = [&makeInodeKey]() -> std::unordered_set<uint64_t> {
-        std::unordered_set<uint64_t> inodes;
-        libmnt_table* tbl = mnt_new_table_from_file("/proc/self/mountinfo");
-        if (!tbl) return inodes;
-
-        // RAII wrapper for libmount table
-        struct TableGuard {
-            libmnt_table* t;
-            ~TableGuard() { if (t) mnt_free_table(t); }
-        } tableGuard{tbl};
-
-        libmnt_iter* itr = mnt_new_iter(MNT_ITER_FORWARD);
-        if (!itr) return inodes;
-
-        // RAII wrapper for libmount iterator
-        struct IterGuard {
-            libmnt_iter* i;
-            ~IterGuard() { if (i) mnt_free_iter(i); }
-        } iterGuard{itr};
-
-        libmnt_fs* fs = nullptr;
-        while (mnt_table_next_fs(tbl, itr, &fs) == 0) {
-            const char* src = mnt_fs_get_source(fs);
-            if (!src) continue;
-
-            struct stat st{};
-            if (::stat(src, &st) != 0) continue;
-
-            if (S_ISBLK(st.st_mode)) {
-                // Block device — check if it is a loop device backed by a file.
-                // /sys/block/loopN/loop/backing_file contains the real path,
-                // and stat() on that path gives the stable inode regardless of
-                // any renames that have happened since the mount.
-                unsigned int loopNum = 0;
-                if (std::sscanf(src, "/dev/loop%u", &loopNum) == 1) {
-                    // Use pre-sized string buffer to avoid multiple allocations
-                    char backingPath[256];
-                    int written = snprintf(backingPath, sizeof(backingPath),
-                                          "/sys/block/loop%u/loop/backing_file", loopNum);
-                    if (written <= 0 || static_cast<size_t>(written) >= sizeof(backingPath)) {
-                        continue; // Path too long, skip this entry
-                    }
-
-                    // Use RAII for file stream
-                    std::ifstream f(backingPath);
-                    if (!f.is_open()) continue;
-
-                    std::string realPath;
-                    if (std::getline(f, realPath) && !realPath.empty()) {
-                        // Trim trailing whitespace
-                        while (!realPath.empty() &&
-                               (realPath.back() == '\n' || realPath.back() == '\r'))
-                            realPath.pop_back();
-
-                        struct stat backingSt{};
-                        if (::stat(realPath.c_str(), &backingSt) == 0)
-                            inodes.insert(makeInodeKey(backingSt));
-                    }
-                    // f is automatically closed when it goes out of scope
-                }
-            } else {
-                // Direct file mount (no loop device) — stat it normally.
-                inodes.insert(makeInodeKey(st));
-            }
-        }
-        // IterGuard and TableGuard automatically clean up
-        return inodes;
-    };
-
-    auto mountPointCache = buildMountPointCache();
-    auto mountedInodes   = buildMountedInodeCache();
-
-    std::vector<std::string> tempCompleted;
-    std::vector<std::string> tempSkipped;
-    std::vector<std::string> tempFailed;
-    VerbosityFormatter formatter;
-
-    constexpr size_t kBatchSize = 50;
-    if (!silentMode) {
-        tempCompleted.reserve(kBatchSize);
-        tempSkipped.reserve(kBatchSize);
-        tempFailed.reserve(kBatchSize);
-    }
-
-    auto flushBuffers = [&]() {
-        if (silentMode) return;
-        std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
-        verboseSets.operationCompleted.insert(tempCompleted.begin(), tempCompleted.end());
-        verboseSets.operationSkipped.insert(tempSkipped.begin(), tempSkipped.end());
-        verboseSets.operationFailed.insert(tempFailed.begin(), tempFailed.end());
-        tempCompleted.clear();
-        tempSkipped.clear();
-        tempFailed.clear();
-    };
-
-    auto maybeFlush = [&]() {
-        if (!silentMode &&
-            (tempCompleted.size() >= kBatchSize ||
-             tempSkipped.size()   >= kBatchSize ||
-             tempFailed.size()    >= kBatchSize)) {
-            flushBuffers();
-        }
-    };
-
-    auto recordFail = [&](const std::string& isoFile, const char* reason) {
-        if (!silentMode) {
-            auto [dir, file] = extractDirectoryAndFilename(isoFile, "mount");
-            tempFailed.push_back(formatter.formatError(std::string(dir), std::string(file), reason));
-        }
-        failedTasks->fetch_add(1, std::memory_order_relaxed);
-    };
-
-    // Pre-allocate string buffer for mount point construction
-    std::string mountPointBuffer;
-    mountPointBuffer.reserve(256); // Typical path length
-
-    for (const auto& isoFile : isoFiles) {
-        if (GlobalState::g_operationCancelled.load(std::memory_order_relaxed)) {
-            recordFail(isoFile, "cxl");
-            maybeFlush();
-            continue;
-        }
-
-        // Single stat() call for existence check, validation, and inode cache
-        struct stat isoStat{};
-        if (::stat(isoFile.c_str(), &isoStat) != 0) {
-            recordFail(isoFile, "missingISO");
-            maybeFlush();
-            continue;
-        }
-
-        // Check if it's a regular file
-        if (!S_ISREG(isoStat.st_mode)) {
-            recordFail(isoFile, "badFS");
-            maybeFlush();
-            continue;
-        }
-
-        // Validate ISO format using pre-existing stat result (avoids redundant stat)
-        if (!isValidIsoFile(isoFile, isoStat)) {
-            recordFail(isoFile, "badFS");
-            maybeFlush();
-            continue;
-        }
-
-        // Construct mount point with minimal allocations
-        const fs::path isoPath(isoFile);
-        mountPointBuffer.clear();
-        mountPointBuffer = "/mnt/iso_";
-        mountPointBuffer += isoPath.stem().string();
-        mountPointBuffer += "~";
-        mountPointBuffer += mountPointSuffix(isoFile);
-        const std::string& mountPoint = mountPointBuffer;
+    MountBatch batch{completedTasks, failedTasks, silentMode, results, Cancellation::operation(), {},
+                     buildMountPointCache(), buildMountedInodeCache()};
 
-        auto [mntDir, mntName] = extractDirectoryAndFilename(mountPoint, "mount");
-        auto [isoDir, isoName] = extractDirectoryAndFilename(isoFile, "mount");
-
-        // --- path-based skip (file was not renamed) ---
-        if (mountPointCache.count(mountPoint)) {
-            if (!silentMode)
-                tempSkipped.push_back(
-                    formatter.formatSkipped(std::string(isoDir), std::string(isoName),
-                                            std::string(mntDir), std::string(mntName))
-                );
-            completedTasks->fetch_add(1, std::memory_order_relaxed);
-            maybeFlush();
-            continue;
-        }
-
-        // --- inode-based skip (file was renamed after being mounted) ---
-        // The kernel tracks loop-device backing files by inode, so a rename
-        // leaves the original mount intact but under a stale path in our
-        // name-derived mountPointCache.  Detect this by checking whether the
-        // file's (dev, inode) pair is already present in the live mount table.
-        // Reuse the isoStat we already have
-        if (mountedInodes.count(makeInodeKey(isoStat))) {
-            if (!silentMode)
-                tempSkipped.push_back(
-                    formatter.formatSkipped(std::string(isoDir), std::string(isoName),
-                                            std::string(mntDir), std::string(mntName))
-                );
-            completedTasks->fetch_add(1, std::memory_order_relaxed);
-            maybeFlush();
-            continue;
-        }
-
-        std::error_code ec;
-        fs::create_directory(mountPoint, ec);
+    TaskGroup probes("mount.probe", TaskPriority::Foreground);
+    TaskGroup mounts("mount", TaskPriority::Foreground, GlobalConcurrency::MOUNT_THREAD_CAP);
+    PipelineScope pipelines;
 
-        if ((ec && ec != std::errc::file_exists) ||
-            (fs::exists(mountPoint) && !fs::is_directory(mountPoint))) {
-            recordFail(isoFile, "mkdir failed");
-            maybeFlush();
-            continue;
-        }
-
-        mnt_reset_context(ctx);
-        mnt_context_set_source(ctx, isoFile.c_str());
-        mnt_context_set_target(ctx, mountPoint.c_str());
-        mnt_context_set_options(ctx, "loop,ro");
-        mnt_context_set_fstype_pattern(ctx, "udf,iso9660");
-
-        const int ret = mnt_context_mount(ctx);
-
-        if (ret == 0) {
-            if (!silentMode) {
-                const char* rawFsType = mnt_context_get_fstype(ctx);
-                const std::string fsType = rawFsType ? rawFsType : "unknown";
-                tempCompleted.push_back(
-                    formatter.formatMountSuccess(std::string(isoDir), std::string(isoName),
-                                                 std::string(mntDir), std::string(mntName), fsType)
-                );
-            }
-            mountPointCache.emplace(mountPoint);
-            // Keep the inode cache consistent so subsequent entries in the
-            // same batch that share the same file are also skipped correctly.
-            mountedInodes.insert(makeInodeKey(isoStat));
-            completedTasks->fetch_add(1, std::memory_order_relaxed);
-        } else {
-            recordFail(isoFile, "badFS");
-            // Only remove the directory we just created if it is empty;
-            // a concurrent mount may have legitimately used it.
-            if (fs::is_directory(mountPoint) && fs::is_empty(mountPoint))
-                fs::remove(mountPoint, ec);
-        }
-
-        maybeFlush();
-    }
+    for (const auto& isoFile : isoFiles)
+        pipelines.spawn(probes, mountIsoFile(batch, mounts, isoFile));
 
-    flushBuffers();
+    pipelines.wait([&results] { results.collect(); });
 }
@@ -17,6 +17,8 @@
 #include "../concurrency.h"
 #include "../display.h"
 #include "../globalMutexes.h"
+#include "../pathTable.h"
+#include "../sort.h"
 #include "../state.h"
 #include "../threadpool.h"
 
@@ -38,7 +40,8 @@
  * @param b The second string_view to compare.
  * @return int Returns -1 if a < b, 1 if a > b, and 0 if a == b.
  */
-int naturalCompare(std::string_view a, std::string_view b) {
+template <typename Text>
+static int naturalCompareImpl(const Text& a, const Text& b) {
     size_t i = 0, j = 0;
     const size_t size_a = a.size();
     const size_t size_b = b.size();
@@ -90,41 +93,45 @@ int naturalCompare(std::string_view a, std::string_view b) {
     return 0;
 }
 
+int naturalCompare(std::string_view a, std::string_view b) {
+    return naturalCompareImpl(a, b);
+}
+
 /**
- * @brief Sorts a vector of file paths in natural order using a parallel merge sort approach.
+ * @brief A path stored as two pieces (interned directory + name), read as one string.
+ *
+ * Lets @ref naturalCompareImpl order @ref PathTable entries exactly as their
+ * joined paths would sort, without building the joined string.
+ */
+struct JoinedPath {
+    std::string_view head;
+    std::string_view tail;
+
+    size_t size() const noexcept { return head.size() + tail.size(); }
+    char operator[](size_t i) const noexcept {
+        return i < head.size() ? head[i] : tail[i - head.size()];
+    }
+};
+
+/**
+ * @brief Sorts @p items with @p comparator using a parallel merge sort.
  *
- * The function divides the file list into chunks, sorts them in parallel via a ThreadPool,
- * and performs a multi-pass merge of the sorted results. It utilizes zero-copy
- * string_views to handle the `displayConfig::toggleNamesOnly` logic, ensuring
- * high performance without redundant memory allocations.
+ * The list is divided into chunks that are sorted in parallel on the ThreadPool,
+ * then merged pairwise in further parallel passes.
  *
  * @note Parallelism is capped by `GlobalConcurrency::SORT_THREAD_CAP` to prevent
  *       resource exhaustion.
- * @param files A reference to the vector of strings (file paths) to be sorted.
  */
-void sortFilesCaseInsensitive(std::vector<std::string>& files) {
-    if (files.empty())
+template <typename T, typename Less>
+static void parallelSort(std::vector<T>& items, Less comparator) {
+    if (items.empty())
         return;
-    bool namesOnly = displayConfig::toggleNamesOnly;
     ThreadPool& pool = getStaticThreadPool();
     const size_t numThreads = std::min(pool.threadCount(), GlobalConcurrency::SORT_THREAD_CAP);
-    const size_t n = files.size();
+    const size_t n = items.size();
     size_t numChunks = std::min<size_t>(numThreads * 2, n / 1000 + 1);
     size_t chunkSize = (n + numChunks - 1) / numChunks;
 
-    auto comparator = [namesOnly](const std::string& a, const std::string& b) {
-        if (namesOnly) {
-            size_t a_slash = a.find_last_of('/');
-            size_t b_slash = b.find_last_of('/');
-            std::string_view a_view = a;
-            if (a_slash != std::string::npos) a_view.remove_prefix(a_slash + 1);
-            std::string_view b_view = b;
-            if (b_slash != std::string::npos) b_view.remove_prefix(b_slash + 1);
-            return naturalCompare(a_view, b_view) < 0;
-        }
-        return naturalCompare(a, b) < 0;
-    };
-
     std::vector<std::pair<size_t, size_t>> chunks;
     std::vector<std::future<void>> futures;
     for (size_t i = 0; i < numChunks; ++i) {
@@ -132,8 +139,8 @@ void sortFilesCaseInsensitive(std::vector<std::string>& files) {
         size_t end = std::min(n, (i + 1) * chunkSize);
         if (start >= end) break;
         chunks.emplace_back(start, end);
-        futures.emplace_back(pool.enqueue([comparator, start, end, &files]() {
-            std::sort(files.begin() + start, files.begin() + end, comparator);
+        futures.emplace_back(pool.enqueueAt(TaskPriority::Interactive, [comparator, start, end, &items]() {
+            std::sort(items.begin() + start, items.begin() + end, comparator);
         }));
     }
     for (auto& f : futures) f.get();
@@ -149,8 +156,8 @@ void sortFilesCaseInsensitive(std::vector<std::string>& files) {
             size_t start = chunks[i].first;
             size_t mid   = chunks[i].second;
             size_t end   = chunks[i + 1].second;
-            mergeFutures.emplace_back(pool.enqueue([comparator, start, mid, end, &files]() {
-                std::inplace_merge(files.begin() + start, files.begin() + mid, files.begin() + end, comparator);
+            mergeFutures.emplace_back(pool.enqueueAt(TaskPriority::Interactive, [comparator, start, mid, end, &items]() {
+                std::inplace_merge(items.begin() + start, items.begin() + mid, items.begin() + end, comparator);
             }));
             newChunks.emplace_back(start, end);
         }
@@ -159,6 +166,60 @@ void sortFilesCaseInsensitive(std::vector<std::string>& files) {
     }
 }
 
+/**
+ * @brief Returns the file-name part of @p path (after the last '/').
+ */
+static std::string_view fileNamePart(std::string_view path) {
+    const size_t slash = path.find_last_of('/');
+    if (slash != std::string_view::npos) path.remove_prefix(slash + 1);
+    return path;
+}
+
+/**
+ * @brief Sorts a vector of file paths in natural order using a parallel merge sort approach.
+ *
+ * Utilizes zero-copy string_views to handle the `displayConfig::toggleNamesOnly`
+ * logic, ensuring high performance without redundant memory allocations.
+ *
+ * @param files A reference to the vector of strings (file paths) to be sorted.
+ */
+void sortFilesCaseInsensitive(std::vector<std::string>& files) {
+    const bool namesOnly = displayConfig::toggleNamesOnly;
+    parallelSort(files, [namesOnly](const std::string& a, const std::string& b) {
+        if (namesOnly) return naturalCompare(fileNamePart(a), fileNamePart(b)) < 0;
+        return naturalCompare(a, b) < 0;
+    });
+}
+
+/**
+ * @brief Sorts paths referenced by pointer, as held by an @ref ImageFileCache.
+ */
+void sortFilesCaseInsensitive(std::vector<const std::string*>& files) {
+    const bool namesOnly = displayConfig::toggleNamesOnly;
+    parallelSort(files, [namesOnly](const std::string* a, const std::string* b) {
+        if (namesOnly) return naturalCompare(fileNamePart(*a), fileNamePart(*b)) < 0;
+        return naturalCompare(*a, *b) < 0;
+    });
+}
+
+/**
+ * @brief Sorts a @ref PathList in place by reordering its ids; no path is copied.
+ *
+ * Entries in the same interned directory are ordered by name alone, which is
+ * equivalent to comparing the full paths since the shared prefix ends in '/'.
+ */
+void sortFilesCaseInsensitive(PathList& files) {
+    if (files.empty()) return;
+    const bool namesOnly = displayConfig::toggleNamesOnly;
+    const PathTable& table = *files.table();
+    parallelSort(files.order(), [namesOnly, &table](PathTable::Id a, PathTable::Id b) {
+        if (namesOnly || table.directoryId(a) == table.directoryId(b))
+            return naturalCompare(table.name(a), table.name(b)) < 0;
+        return naturalCompareImpl(JoinedPath{table.directory(a), table.name(a)},
+                                  JoinedPath{table.directory(b), table.name(b)}) < 0;
+    });
+}
+
 /**
  * @brief Triggered when the 'filenamesOnly' flag is toggled.
  *
@@ -167,21 +228,24 @@ void sortFilesCaseInsensitive(std::vector<std::string>& files) {
  * data consistency before the UI refreshes.
  */
 void sortAfterFilenamesOnlyFlag() {
-    auto sortJob = [](std::vector<std::string>& list, std::mutex& mtx) {
+    auto sortListJob = [](PathList& list, std::mutex& mtx) {
         std::lock_guard<std::mutex> lock(mtx);
         sortFilesCaseInsensitive(list);
     };
+    auto sortCacheJob = [](ImageFileCache& cache) {
+        cache.withOrdered([](std::vector<const std::string*>& list) { sortFilesCaseInsensitive(list); });
+    };
 
     std::vector<std::thread> workers;
     workers.reserve(6);
 
     // Launch all 6 sorts at the same time
-    workers.emplace_back(sortJob, std::ref(GlobalState::globalIsoFileList), std::ref(GlobalMutexes::updateListMutex));
-    workers.emplace_back(sortJob, std::ref(GlobalState::binImgFilesCache),  std::ref(GlobalMutexes::binImgCacheMutex));
-    workers.emplace_back(sortJob, std::ref(GlobalState::mdfMdsFilesCache),  std::ref(GlobalMutexes::mdfMdsCacheMutex));
-    workers.emplace_back(sortJob, std::ref(GlobalState::nrgFilesCache),     std::ref(GlobalMutexes::nrgCacheMutex));
-    workers.emplace_back(sortJob, std::ref(GlobalState::chdFilesCache),     std::ref(GlobalMutexes::chdCacheMutex));
-    workers.emplace_back(sortJob, std::ref(GlobalState::daaGbiFilesCache),  std::ref(GlobalMutexes::daaGbiCacheMutex));
+    workers.emplace_back(sortListJob, std::ref(GlobalState::globalIsoFileList), std::ref(GlobalMutexes::updateListMutex));
+    workers.emplace_back(sortCacheJob, std::ref(GlobalState::binImgFilesCache));
+    workers.emplace_back(sortCacheJob, std::ref(GlobalState::mdfMdsFilesCache));
+    workers.emplace_back(sortCacheJob, std::ref(GlobalState::nrgFilesCache));
+    workers.emplace_back(sortCacheJob, std::ref(GlobalState::chdFilesCache));
+    workers.emplace_back(sortCacheJob, std::ref(GlobalState::daaGbiFilesCache));
 
     // Block here until every single thread is finished to ensure sorting correctness for large lists
     for (auto& t : workers) {
@@ -0,0 +1,212 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Project Headers
+#include "../pathSearchIndex.h"
+
+namespace {
+
+inline std::uint32_t lowerByte(char c) {
+    return static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(c)));
+}
+
+/**
+ * @brief Collects the distinct lowercased trigrams of @p text, sorted.
+ */
+void collectTrigrams(std::string_view text, std::vector<std::uint32_t>& out) {
+    out.clear();
+    if (text.size() < 3) return;
+
+    std::uint32_t key = (lowerByte(text[0]) << 8) | lowerByte(text[1]);
+    for (std::size_t i = 2; i < text.size(); ++i) {
+        key = ((key << 8) | lowerByte(text[i])) & 0xFFFFFFu;
+        out.push_back(key);
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+} // namespace
+
+std::span<const std::uint32_t> PathSearchIndex::Postings::find(std::uint32_t key) const noexcept {
+    auto it = std::lower_bound(keys.begin(), keys.end(), key);
+    if (it == keys.end() || *it != key) return {};
+    const std::size_t slot = static_cast<std::size_t>(it - keys.begin());
+    return {ids.data() + offsets[slot], offsets[slot + 1] - offsets[slot]};
+}
+
+/**
+ * @brief Builds trigram postings for texts [0, @p count) in two passes.
+ *
+ * The first pass counts postings per trigram so the second can write every id
+ * straight into one flat array; ids are visited in ascending order, so each
+ * list comes out sorted.
+ */
+template <typename TextAt>
+PathSearchIndex::Postings PathSearchIndex::buildPostings(std::size_t count, const TextAt& textAt) {
+    Postings p;
+    std::unordered_map<std::uint32_t, std::uint32_t> slots;
+    std::vector<std::uint32_t> trigrams;
+
+    std::size_t total = 0;
+    for (std::size_t id = 0; id < count; ++id) {
+        collectTrigrams(textAt(id), trigrams);
+        for (std::uint32_t key : trigrams) ++slots[key];
+        total += trigrams.size();
+    }
+
+    p.keys.reserve(slots.size());
+    for (const auto& kv : slots) p.keys.push_back(kv.first);
+    std::sort(p.keys.begin(), p.keys.end());
+
+    // Turn counts into write cursors while laying out the offsets.
+    p.offsets.resize(p.keys.size() + 1);
+    std::uint32_t running = 0;
+    for (std::size_t i = 0; i < p.keys.size(); ++i) {
+        std::uint32_t& slot = slots[p.keys[i]];
+        p.offsets[i] = running;
+        running += slot;
+        slot = p.offsets[i];
+    }
+    p.offsets.back() = running;
+
+    p.ids.resize(total);
+    for (std::size_t id = 0; id < count; ++id) {
+        collectTrigrams(textAt(id), trigrams);
+        for (std::uint32_t key : trigrams) p.ids[slots[key]++] = static_cast<std::uint32_t>(id);
+    }
+    return p;
+}
+
+/**
+ * @brief Indexes file names, directory prefixes and the directory → entries map.
+ */
+std::shared_ptr<const PathSearchIndex> PathSearchIndex::build(std::shared_ptr<const PathTable> table) {
+    auto index = std::make_shared<PathSearchIndex>();
+    if (!table) return index;
+    const PathTable& t = *table;
+
+    index->names_ = buildPostings(t.size(), [&t](std::size_t id) {
+        return t.name(static_cast<PathTable::Id>(id));
+    });
+    index->dirs_ = buildPostings(t.directoryCount(), [&t](std::size_t dir) {
+        return t.directoryText(static_cast<std::uint32_t>(dir));
+    });
+
+    index->dirEntryOffsets_.assign(t.directoryCount() + 1, 0);
+    for (std::size_t id = 0; id < t.size(); ++id)
+        ++index->dirEntryOffsets_[t.directoryId(static_cast<PathTable::Id>(id)) + 1];
+    for (std::size_t d = 1; d < index->dirEntryOffsets_.size(); ++d)
+        index->dirEntryOffsets_[d] += index->dirEntryOffsets_[d - 1];
+
+    std::vector<std::uint32_t> cursor(index->dirEntryOffsets_.begin(), index->dirEntryOffsets_.end() - 1);
+    index->dirEntries_.resize(t.size());
+    for (std::size_t id = 0; id < t.size(); ++id)
+        index->dirEntries_[cursor[t.directoryId(static_cast<PathTable::Id>(id))]++] = static_cast<std::uint32_t>(id);
+
+    index->table_ = std::move(table);
+    return index;
+}
+
+/**
+ * @brief Ids whose text contains every trigram of @p term (length >= 3).
+ */
+std::vector<std::uint32_t> PathSearchIndex::lookup(const Postings& postings, std::string_view term) const {
+    std::vector<std::uint32_t> trigrams;
+    collectTrigrams(term, trigrams);
+
+    std::vector<std::span<const std::uint32_t>> lists;
+    lists.reserve(trigrams.size());
+    for (std::uint32_t key : trigrams) {
+        auto list = postings.find(key);
+        if (list.empty()) return {};
+        lists.push_back(list);
+    }
+    // Intersect shortest first so the working set only shrinks.
+    std::sort(lists.begin(), lists.end(), [](const auto& a, const auto& b) { return a.size() < b.size(); });
+
+    std::vector<std::uint32_t> result(lists.front().begin(), lists.front().end());
+    std::vector<std::uint32_t> next;
+    for (std::size_t i = 1; i < lists.size() && !result.empty(); ++i) {
+        next.clear();
+        std::set_intersection(result.begin(), result.end(), lists[i].begin(), lists[i].end(),
+                              std::back_inserter(next));
+        result.swap(next);
+    }
+    return result;
+}
+
+void PathSearchIndex::markDirectories(const std::vector<std::uint32_t>& dirs, std::vector<unsigned char>& marks) const {
+    for (std::uint32_t d : dirs)
+        for (std::uint32_t i = dirEntryOffsets_[d]; i < dirEntryOffsets_[d + 1]; ++i)
+            marks[dirEntries_[i]] = 1;
+}
+
+/**
+ * @details A term without '/' lies wholly in the directory prefix or wholly in
+ * the name, since every prefix ends at the separator. A term with '/' lies
+ * wholly in the prefix, or straddles its final '/': then the part up to the
+ * term's last '/' ends the prefix and the rest starts the name. Each case is
+ * narrowed by whichever parts are long enough to carry a trigram.
+ */
+bool PathSearchIndex::markCandidates(const std::vector<std::string_view>& terms, bool namesOnly,
+                                     std::vector<unsigned char>& marks) const {
+    const std::size_t n = table_ ? table_->size() : 0;
+    marks.assign(n, 0);
+    if (n == 0) return true;
+
+    for (std::string_view term : terms) {
+        const std::size_t slash = term.rfind('/');
+
+        if (namesOnly) {
+            if (slash != std::string_view::npos) continue;  // names never contain '/'
+            if (term.size() < 3) return false;
+            for (std::uint32_t id : lookup(names_, term)) marks[id] = 1;
+            continue;
+        }
+
+        if (term.size() < 3) return false;
+        markDirectories(lookup(dirs_, term), marks);
+
+        if (slash == std::string_view::npos) {
+            for (std::uint32_t id : lookup(names_, term)) marks[id] = 1;
+            continue;
+        }
+
+        const std::string_view head = term.substr(0, slash + 1);
+        const std::string_view tail = term.substr(slash + 1);
+        if (tail.empty()) continue;  // ends at a separator: wholly in the prefix
+
+        if (head.size() >= 3 && tail.size() >= 3) {
+            const std::vector<std::uint32_t> dirs = lookup(dirs_, head);
+            for (std::uint32_t id : lookup(names_, tail))
+                if (std::binary_search(dirs.begin(), dirs.end(), table_->directoryId(id))) marks[id] = 1;
+        } else if (head.size() >= 3) {
+            markDirectories(lookup(dirs_, head), marks);
+        } else if (tail.size() >= 3) {
+            for (std::uint32_t id : lookup(names_, tail)) marks[id] = 1;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::size_t PathSearchIndex::memoryBytes() const noexcept {
+    auto bytes = [](const std::vector<std::uint32_t>& v) { return v.capacity() * sizeof(std::uint32_t); };
+    return bytes(names_.keys) + bytes(names_.offsets) + bytes(names_.ids) +
+           bytes(dirs_.keys) + bytes(dirs_.offsets) + bytes(dirs_.ids) +
+           bytes(dirEntryOffsets_) + bytes(dirEntries_);
+}
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// C++ Standard Library Headers
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Project Headers
+#include "../pathTable.h"
+
+PathTable::Builder::Builder() : table_(std::make_unique<PathTable>()) {}
+
+/**
+ * @brief Preallocates room for @p paths entries and @p nameBytes of names.
+ */
+void PathTable::Builder::reserve(std::size_t paths, std::size_t nameBytes) {
+    table_->entries_.reserve(paths);
+    if (nameBytes) table_->nameArena_.reserve(nameBytes);
+}
+
+/**
+ * @brief Splits @p path at its last '/' and records it, interning the directory.
+ *
+ * @throws std::length_error if the table would exceed 2^32 entries.
+ */
+PathTable::Id PathTable::Builder::add(std::string_view path) {
+    PathTable& t = *table_;
+    if (t.entries_.size() >= std::numeric_limits<Id>::max())
+        throw std::length_error("PathTable: too many entries");
+
+    const std::size_t slash = path.rfind('/');
+    const std::string_view dir  = (slash == std::string_view::npos) ? std::string_view{} : path.substr(0, slash + 1);
+    const std::string_view name = (slash == std::string_view::npos) ? path : path.substr(slash + 1);
+
+    Id dirId;
+    auto it = dirIds_.find(dir);
+    if (it != dirIds_.end()) {
+        dirId = it->second;
+    } else {
+        dirId = static_cast<Id>(t.dirs_.size());
+        t.dirs_.push_back({t.dirArena_.size(), static_cast<std::uint32_t>(dir.size())});
+        t.dirArena_.append(dir);
+        dirIds_.emplace(std::string(dir), dirId);
+    }
+
+    const Id id = static_cast<Id>(t.entries_.size());
+    t.entries_.push_back({dirId, static_cast<std::uint32_t>(name.size()), t.nameArena_.size()});
+    t.nameArena_.append(name);
+    return id;
+}
+
+/**
+ * @brief Trims spare capacity and hands the table out read-only.
+ */
+std::shared_ptr<const PathTable> PathTable::Builder::finish() {
+    PathTable& t = *table_;
+    t.entries_.shrink_to_fit();
+    t.dirs_.shrink_to_fit();
+    t.dirArena_.shrink_to_fit();
+    t.nameArena_.shrink_to_fit();
+
+    std::shared_ptr<const PathTable> out(std::move(table_));
+    table_ = std::make_unique<PathTable>();
+    decltype(dirIds_)().swap(dirIds_);
+    return out;
+}
+
+PathList::PathList(std::shared_ptr<const PathTable> table) : table_(std::move(table)) {
+    if (!table_) return;
+    order_.resize(table_->size());
+    std::iota(order_.begin(), order_.end(), PathTable::Id{0});
+}
+
+std::vector<std::string> PathList::toVector() const {
+    std::vector<std::string> out;
+    out.reserve(order_.size());
+    for (PathTable::Id id : order_) out.push_back(table_->path(id));
+    return out;
+}
@@ -18,6 +18,7 @@
 #include "../filtering.h"
 #include "../databaseOps.h"
 #include "../main.h"
+#include "../pathTable.h"
 #include "../sharedRefreshState.h"
 #include "../state.h"
 #include "../stringManipulation.h"
@@ -53,7 +54,9 @@ struct IntBuf {
  * atomically under printMutex, preventing stale indicator display during
  * concurrent background ISO imports.
  *
- * @param items              The list of strings to display.
+ * @param totalItems         Number of entries in the list.
+ * @param itemAt             Returns entry @c i as a view, using the given buffer if it
+ *                           has to assemble the string.
  * @param listType           Category of the list (e.g., "ISO_FILES").
  * @param listSubType        Extension or sub-format details.
  * @param pendingIndices     Current user selection indices awaiting processing.
@@ -64,16 +67,16 @@ struct IntBuf {
  *                           flag; guards the "[↻ Syncing: NewISO → Restructure]"
  *                           indicator against races with background import completion.
  */
-void printList(const std::vector<std::string>& items, const std::string& listType, const std::string& listSubType,
-               std::vector<std::string>& pendingIndices, bool& hasPendingProcess, bool& isFiltered,
-               size_t& currentPage, std::shared_ptr<RefreshState> state) {
+template <typename ItemAt>
+static void renderList(const size_t totalItems, const ItemAt& itemAt, const std::string& listType, const std::string& listSubType,
+                       std::vector<std::string>& pendingIndices, bool& hasPendingProcess, bool& isFiltered,
+                       size_t& currentPage, const std::shared_ptr<RefreshState>& state) {
 
-    if (items.empty()) return;
+    if (totalItems == 0) return;
 
     const PrintListTheme c = getListColors();
 
     // --- Pagination Logic ---
-    const size_t totalItems = items.size();
     const bool disablePagination = (GlobalState::ITEMS_PER_PAGE == 0 || totalItems <= GlobalState::ITEMS_PER_PAGE);
     const size_t totalPages = disablePagination ? 1 : (totalItems + GlobalState::ITEMS_PER_PAGE - 1) / GlobalState::ITEMS_PER_PAGE;
 
@@ -115,6 +118,7 @@ void printList(const std::vector<std::string>& items, const std::string& listTyp
     }
 
     // --- Main Item Loop ---
+    std::string itemBuffer;
     for (size_t i = startIndex; i < endIndex; ++i) {
         const std::string_view seqColor = (i % 2 == 0) ? c.indexA : c.indexB;
         std::string_view idxStr = ib1.format(i + 1);
@@ -132,7 +136,7 @@ void printList(const std::vector<std::string>& items, const std::string& listTyp
             output.append(". ").append(UI::Palette::BoldReset);
         }
 
-        const std::string& item = items[i];
+        const std::string_view item = itemAt(i, itemBuffer);
 
         if (isFileMode) {
             auto [dir, fname] = extractDirectoryAndFilename(item, listSubType);
@@ -206,3 +210,25 @@ void printList(const std::vector<std::string>& items, const std::string& listTyp
         std::cout.write(output.data(), output.size());
     }
 }
+
+void printList(const std::vector<std::string>& items, const std::string& listType, const std::string& listSubType,
+               std::vector<std::string>& pendingIndices, bool& hasPendingProcess, bool& isFiltered,
+               size_t& currentPage, std::shared_ptr<RefreshState> state) {
+    renderList(items.size(), [&items](size_t i, std::string&) -> std::string_view { return items[i]; },
+               listType, listSubType, pendingIndices, hasPendingProcess, isFiltered, currentPage, state);
+}
+
+/**
+ * @brief Renders a @ref PathList; only the paths on the visible page are joined.
+ */
+void printList(const PathList& items, const std::string& listType, const std::string& listSubType,
+               std::vector<std::string>& pendingIndices, bool& hasPendingProcess, bool& isFiltered,
+               size_t& currentPage, std::shared_ptr<RefreshState> state) {
+    renderList(items.size(),
+               [&items](size_t i, std::string& buffer) -> std::string_view {
+                   buffer.clear();
+                   items.appendPath(i, buffer);
+                   return buffer;
+               },
+               listType, listSubType, pendingIndices, hasPendingProcess, isFiltered, currentPage, state);
+}
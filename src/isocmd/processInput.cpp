@@ -6,9 +6,7 @@
 #include <csignal>
 #include <cstddef>
 #include <filesystem>
-#include <future>
 #include <iostream>
-#include <mutex>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -21,7 +19,9 @@
 #include <sys/stat.h>
 
 // Project Headers
+#include "../cancellation.h"
 #include "../concurrency.h"
+#include "../databaseOps.h"
 #include "../inputHandling.h"
 #include "../mount.h"
 #include "../pausePrompt.h"
@@ -38,7 +38,10 @@
  */
 
 /**
- * @brief Orchestrates the mounting or unmounting of ISO files using a static thread pool and progress tracking.
+ * @brief Orchestrates the mounting or unmounting of ISO files with progress tracking.
+ *
+ * The whole selection goes to @ref mountIsoFiles / @ref unmountISO in one
+ * call; they schedule each file on the static thread pool on its own.
  *
  * @param input Raw user input string (comma/space separated indices or "00" for all).
  * @param files The master list of available ISO file paths.
@@ -48,7 +51,7 @@
  */
 void processInputForMountOrUmount(const std::string& input, const std::vector<std::string>& files, bool& umountMvRmBreak, bool& verbose, bool isUnmount) {
     setupSignalHandlerCancellations();
-    GlobalState::g_operationCancelled.store(false);
+    Cancellation::beginOperation();
 
     std::unordered_set<int> indicesToProcess;
     std::vector<int> selectedIndices;
@@ -84,22 +87,15 @@ void processInputForMountOrUmount(const std::string& input, const std::vector<st
 
     std::string coloredProcess = std::string(operationColor) + operationName + std::string(UI::Palette::BoldReset);
 
-    ThreadPool& pool = getStaticThreadPool();
-    const size_t poolSize = pool.threadCount();
-    const size_t cap = isUnmount ? GlobalConcurrency::UMOUNT_THREAD_CAP : GlobalConcurrency::MOUNT_THREAD_CAP;
-    size_t numThreads = std::max(size_t(2), std::min({selectedIndices.size(), cap, poolSize}));
-
-    if ((selectedIndices.size() + numThreads - 1) / numThreads > 100)
-        numThreads = (selectedIndices.size() + 99) / 100;
+    std::vector<std::string> selectedFiles;
+    selectedFiles.reserve(selectedIndices.size());
+    for (int idx : selectedIndices)
+        selectedFiles.push_back(files[idx - 1]);
 
-    std::vector<std::vector<int>> indexChunks(numThreads);
-    for (size_t i = 0; i < selectedIndices.size(); ++i)
-        indexChunks[i % numThreads].push_back(selectedIndices[i]);
-
-    std::vector<std::future<void>> futures;
     std::atomic<size_t> completedTasks(0);
     std::atomic<size_t> failedTasks(0);
     std::atomic<bool> isProcessingComplete(false);
+    ResultChannel results;
 
     std::thread progressThread(
         displayProgressBarWithSize,
@@ -113,38 +109,30 @@ void processInputForMountOrUmount(const std::string& input, const std::vector<st
         std::string(coloredProcess)
     );
 
-    for (const auto& idxChunk : indexChunks) {
-		futures.emplace_back(pool.enqueue([&]() {
-			std::vector<std::string> chunkStr;
-			chunkStr.reserve(idxChunk.size());
-			for (int idx : idxChunk)
-				chunkStr.push_back(files[idx - 1]);
-			if (isUnmount)
-				unmountISO(chunkStr, &completedTasks, &failedTasks, false);
-			else
-				mountIsoFiles(chunkStr, &completedTasks, &failedTasks, false);
-		}));
-	}
-
-    for (auto& future : futures)
-        future.wait();
+    if (isUnmount)
+        unmountISO(selectedFiles, &completedTasks, &failedTasks, false, results);
+    else
+        mountIsoFiles(selectedFiles, &completedTasks, &failedTasks, false, results);
 
     if (completedTasks == 0 && isUnmount) umountMvRmBreak = false;
 
+    if (!isUnmount) touchDatabaseEntries(selectedFiles);
+
     isProcessingComplete.store(true);
     signal(SIGINT, SIG_IGN);
     progressThread.join();
 }
 
 /**
- * @brief Groups file indices into chunks for parallel processing, preventing race conditions by grouping identical filenames.
- * * @param processedIndices Set of indices selected by the user.
+ * @brief Groups file indices into units that may be processed concurrently, preventing race conditions by grouping identical filenames.
+ * * Files sharing a filename would land on the same destination path, so they form one unit
+ * and are processed in order; every other file is a unit of its own.
+ * @param processedIndices Set of indices selected by the user.
  * @param isoFiles Master list of file paths.
- * @param numThreads Desired concurrency level.
  * @param isDelete Flag indicating if the operation is a deletion (avoids name-collision logic).
- * @return A vector of chunks, where each chunk is a vector of indices.
+ * @return A vector of units, where each unit is a vector of indices.
  */
-std::vector<std::vector<int>> groupFilesIntoChunksForCpMvRm(const std::unordered_set<int>& processedIndices, const std::vector<std::string>& isoFiles, unsigned int numThreads, bool isDelete)
+std::vector<std::vector<int>> groupFilesIntoChunksForCpMvRm(const std::unordered_set<int>& processedIndices, const std::vector<std::string>& isoFiles, bool isDelete)
 {
     std::vector<int> processedIndicesVector(processedIndices.begin(), processedIndices.end());
     std::vector<std::vector<int>> indexChunks;
@@ -158,33 +146,13 @@ std::vector<std::vector<int>> groupFilesIntoChunksForCpMvRm(const std::unordered
             groups[baseName].push_back(idx);
         }
 
-        std::vector<int> uniqueNameFiles;
-        for (auto& [baseName, indices] : groups) {
-            if (indices.size() > 1) {
-                indexChunks.push_back(std::move(indices));
-            } else {
-                uniqueNameFiles.push_back(indices[0]);
-            }
-        }
-
-        if (!uniqueNameFiles.empty()) {
-            size_t usedChunks = indexChunks.size();
-            size_t remainingThreads = (numThreads > usedChunks) ? numThreads - usedChunks : 1;
-
-            std::vector<std::vector<int>> uniqueChunks(remainingThreads);
-            for (size_t i = 0; i < uniqueNameFiles.size(); ++i)
-                uniqueChunks[i % remainingThreads].push_back(uniqueNameFiles[i]);
-
-            for (auto& c : uniqueChunks)
-                if (!c.empty()) indexChunks.push_back(std::move(c));
-        }
+        indexChunks.reserve(groups.size());
+        for (auto& [baseName, indices] : groups)
+            indexChunks.push_back(std::move(indices));
     } else {
-        std::vector<std::vector<int>> deleteChunks(numThreads);
-        for (size_t i = 0; i < processedIndicesVector.size(); ++i)
-            deleteChunks[i % numThreads].push_back(processedIndicesVector[i]);
-
-        for (auto& c : deleteChunks)
-            if (!c.empty()) indexChunks.push_back(std::move(c));
+        indexChunks.reserve(processedIndicesVector.size());
+        for (int idx : processedIndicesVector)
+            indexChunks.push_back({idx});
     }
 
     return indexChunks;
@@ -200,7 +168,6 @@ std::vector<std::vector<int>> groupFilesIntoChunksForCpMvRm(const std::unordered
  * @section Workflow Lifecycle
  * 1. **Input Parsing**: Tokenizes the user string to map selections to the master ISO list.
  * 2. **Pre-Processing & Validation**:
- * - Determines thread caps based on operation type (e.g., `RM_THREAD_CAP` vs `CPMV_THREAD_CAP`).
  * - Invokes `userDestDirCpMv` to handle UI interactions, such as selecting destination
  * folders or confirming permanent deletion.
  * 3. **Progress Estimation**: Calculates total byte size and task count. For copies/moves to
@@ -208,7 +175,8 @@ std::vector<std::vector<int>> groupFilesIntoChunksForCpMvRm(const std::unordered
  * reflects the true workload.
  * 4. **Execution**:
  * - Spawns a dedicated thread for the live progress bar.
- * - Distributes file chunks into a static thread pool for parallel execution via `handleIsoFileOperation`.
+ * - Hands the selection, grouped into same-filename units, to `handleIsoFileOperation`,
+ * which schedules every unit on the static thread pool as its own pipeline.
  * 5. **Post-Processing & Cleanup**:
  * - Disables signal handlers and joins the progress thread.
  * - **Database Sync**: If files were moved or copied, a **synchronous** update is triggered
@@ -230,7 +198,6 @@ void processInputForCpMvRm(const std::string& input,
     setupSignalHandlerCancellations();
 
     std::vector<std::string> successfulDestPaths;
-    std::mutex destPathsMutex;
 
     bool overwriteExisting = false;
     std::string userDestDir;
@@ -250,19 +217,14 @@ void processInputForCpMvRm(const std::string& input,
         return;
     }
 
-    ThreadPool& pool = getStaticThreadPool();
-    const size_t poolSize = pool.threadCount();
-    const size_t cap = isDelete ? GlobalConcurrency::RM_THREAD_CAP : GlobalConcurrency::CPMV_THREAD_CAP;
-    const size_t numThreads = std::max(size_t(2), std::min({processedIndices.size(), cap, poolSize}));
-
-    std::vector<std::vector<int>> indexChunks = groupFilesIntoChunksForCpMvRm(processedIndices, isoFiles, numThreads, isDelete);
+    std::vector<std::vector<int>> indexChunks = groupFilesIntoChunksForCpMvRm(processedIndices, isoFiles, isDelete);
 
     bool abortDel = false;
     std::string processedUserDestDir = userDestDirCpMv(isoFiles, indexChunks, userDestDir,
                                                        operationColor, operationDescription, umountMvRmBreak,
                                                        filterHistory, isDelete, isCopy, abortDel, overwriteExisting);
 
-    GlobalState::g_operationCancelled.store(false);
+    Cancellation::beginOperation();
 
     if ((processedUserDestDir == "" && (isCopy || isMove)) || abortDel) {
         verboseSets.uniqueErrorTokenMessages.clear();
@@ -314,27 +276,20 @@ void processInputForCpMvRm(const std::string& input,
                                totalBytes, &completedTasks, &failedTasks,
                                totalTasks, &isProcessingComplete, &verbose, std::string(coloredProcess));
 
-    std::vector<std::future<void>> futures;
-    futures.reserve(indexChunks.size());
-
-   for (const auto& chunk : indexChunks) {
-		futures.emplace_back(pool.enqueue([chunk = std::move(chunk), &isoFiles,
-										   &userDestDir, isMove, isCopy, isDelete,
-										   &completedBytes, &completedTasks, &failedTasks,
-										   &overwriteExisting, &successfulDestPaths, &destPathsMutex]() {
-			std::vector<std::string> isoFilesInChunk;
-			isoFilesInChunk.reserve(chunk.size());
-			for (int idx : chunk)
-				isoFilesInChunk.push_back(isoFiles[idx - 1]);
-			handleIsoFileOperation(isoFilesInChunk, isoFiles,
-								   userDestDir, isMove, isCopy, isDelete,
-								   &completedBytes, &completedTasks, &failedTasks,
-								   overwriteExisting, &successfulDestPaths, &destPathsMutex);
-		}));
-	}
+    std::vector<std::vector<std::string>> units;
+    units.reserve(indexChunks.size());
+    for (const auto& chunk : indexChunks) {
+        std::vector<std::string>& unit = units.emplace_back();
+        unit.reserve(chunk.size());
+        for (int idx : chunk)
+            unit.push_back(isoFiles[idx - 1]);
+    }
 
-    for (auto& future : futures)
-        future.wait();
+    ResultChannel results;
+    handleIsoFileOperation(units, isoFiles,
+                           userDestDir, isMove, isCopy, isDelete,
+                           &completedBytes, &completedTasks, &failedTasks,
+                           overwriteExisting, results, &successfulDestPaths);
 
     if (completedTasks == 0) umountMvRmBreak = false;
     isProcessingComplete.store(true);
@@ -355,10 +310,12 @@ void processInputForCpMvRm(const std::string& input,
 /**
  * @brief Handles bulk image-to-ISO conversions with threading and progress visualization.
  *
- * Each selected file is enqueued as an independent task directly into the static
- * thread pool rather than being pre-chunked. This keeps all available threads busy
- * regardless of whether the file count divides evenly across threads — the pool's
- * internal queue naturally balances load as threads free up.
+ * Each selected file is enqueued as an independent task rather than being
+ * pre-chunked, through a @ref TaskGroup limited to
+ * @c GlobalConcurrency::CONV_THREAD_CAP. Up to that many conversions run at
+ * once and the next one starts as soon as one finishes, so load balances
+ * regardless of file sizes while leaving the remaining workers free for
+ * mounts or filtering.
  *
  * @param input           Raw user input string (indices, ranges, or keywords).
  * @param fileList        Master list of image files used for index mapping.
@@ -377,14 +334,13 @@ void processInputForConversions(const std::string& input,
                                  )
 {
     std::vector<std::string> successfulOutputPaths;
-    std::mutex outPathsMutex;
 
     setupSignalHandlerCancellations();
 
     const MainTheme* theme = getActiveTheme();
     const bool isOrig = (globalTheme == "original");
 
-    GlobalState::g_operationCancelled.store(false);
+    Cancellation::beginOperation();
     std::unordered_set<int> processedIndices;
 
     if (!(input.empty() || std::all_of(input.begin(), input.end(), isspace))) {
@@ -399,8 +355,6 @@ void processInputForConversions(const std::string& input,
         return;
     }
 
-    ThreadPool& pool = getStaticThreadPool();
-
     // Calculate total bytes across all selected files.
     size_t totalBytes = 0;
     {
@@ -441,24 +395,23 @@ void processInputForConversions(const std::string& input,
         &completedTasks, &failedTasks, totalTasks,
         &isProcessingComplete, &verbose, operation);
 
-    // Enqueue one task per file — the pool queue balances load naturally.
-    std::vector<std::future<void>> futures;
-    futures.reserve(processedIndices.size());
+    // Enqueue one task per file — the group starts each as a slot frees up.
+    ResultChannel results;
+    TaskGroup conversions("convert2iso", TaskPriority::Foreground, GlobalConcurrency::CONV_THREAD_CAP);
 
     for (int idx : processedIndices) {
-        futures.emplace_back(pool.enqueue(
+        conversions.submit(
             [&fileList, idx, modeMdf, modeNrg, modeChd, modeDaa,
              &completedBytes, &completedTasks, &failedTasks,
-             &successfulOutputPaths, &outPathsMutex]() {
+             &results]() {
                 convertToISO({fileList[idx - 1]},
                              modeMdf, modeNrg, modeChd, modeDaa,
                              &completedBytes, &completedTasks, &failedTasks,
-                             &successfulOutputPaths, &outPathsMutex);
-            }));
+                             results);
+            });
     }
 
-    for (auto& future : futures)
-        future.wait();
+    conversions.wait([&] { results.collect(&successfulOutputPaths); });
 
     isProcessingComplete.store(true);
     signal(SIGINT, SIG_IGN);
@@ -23,6 +23,7 @@
 #include <readline/readline.h>
 
 // Project Headers
+#include "../cancellation.h"
 #include "../inputHandling.h"
 #include "../readline.h"
 #include "../state.h"
@@ -206,7 +207,7 @@ void displayProgressBarWithSize(std::atomic<size_t>* completedBytes, size_t tota
 
             const size_t completedTasksValue = completedTasks->load(std::memory_order_acquire);
             const size_t failedTasksValue    = failedTasks->load(std::memory_order_acquire);
-            const bool wasCancelled          = GlobalState::g_operationCancelled.load(std::memory_order_acquire);
+            const bool wasCancelled          = Cancellation::operation().cancelled();
             bool snapTo100 = (!wasCancelled && failedTasksValue == 0);
 
             // --- Status Summary ---
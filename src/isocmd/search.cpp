@@ -10,13 +10,13 @@
 #include <exception>
 #include <filesystem>
 #include <functional>
-#include <future>
 #include <iostream>
 #include <memory>
 #include <mutex>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <system_error>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -30,10 +30,13 @@
 #include <readline/readline.h>
 
 // Project Headers
+#include "../cancellation.h"
 #include "../concurrency.h"
 #include "../databaseOps.h"
+#include "../dirWalker.h"
 #include "../globalMutexes.h"
 #include "../history.h"
+#include "../imageFileCache.h"
 #include "../inputHandling.h"
 #include "../pausePrompt.h"
 #include "../readline.h"
@@ -41,7 +44,6 @@
 #include "../state.h"
 #include "../stringManipulation.h"
 #include "../themes.h"
-#include "../threadpool.h"
 #include "../verbose.h"
 
 namespace fs = std::filesystem;
@@ -67,6 +69,21 @@ bool isValidDirectory(const std::string& path) {
     return std::filesystem::is_directory(path);
 }
 
+/**
+ * @brief Adds a directory's file count to a scan total and refreshes the
+ *        progress line whenever a multiple of 100 is crossed.
+ * @param totalFiles Running total shared by every walker thread
+ * @param count Regular files found in the directory just read
+ */
+static void reportFilesProcessed(std::atomic<size_t>& totalFiles, size_t count) {
+    const size_t prev = totalFiles.fetch_add(count, std::memory_order_relaxed);
+    const size_t val = prev + count;
+    if (val / 100 != prev / 100) {
+        std::lock_guard<std::mutex> lock(GlobalMutexes::couNtMutex);
+        std::cout << "\r" << color << "Total files processed: " << val << std::flush;
+    }
+}
+
 //=============================================================================
 // ISO Section
 //=============================================================================
@@ -78,9 +95,10 @@ bool isValidDirectory(const std::string& path) {
  * Reads a semicolon-delimited list of directory paths from the user, validates
  * and trims each path, deduplicates by normalized form, sorts, then eliminates
  * subdirectories of already-included paths (prefix check requires prior sort).
- * Remaining paths are scanned in parallel via a static thread pool up to
- * @p maxDepth. Results are forwarded to @c saveAndReportResultsForDatabase,
- * which calls @c saveToDatabase and may mutate @p newISOFound.
+ * Remaining paths are scanned together by @c traverse, which spreads their
+ * subdirectories across the static thread pool, up to @p maxDepth. Results
+ * are forwarded to @c saveAndReportResultsForDatabase, which calls
+ * @c saveToDatabase and may mutate @p newISOFound.
  *
  * @details **Control flow:**
  * - **Exit conditions:** ESC input (@c "\\x1b", typically bound to the @c '<' key
@@ -91,9 +109,9 @@ bool isValidDirectory(const std::string& path) {
  *   empty/whitespace-only input, empty @p validPaths with no invalid paths, and
  *   exceptions (prints error, waits for Enter, re-arms and retries).
  * - **Early save path:** If all paths are invalid (validPaths empty, invalidPaths
- *   non-empty), resets @c g_operationCancelled and calls
+ *   non-empty), begins a fresh operation and calls
  *   @c saveAndReportResultsForDatabase without scanning.
- * - **Cancellation guarding:** @c g_operationCancelled is reset to @c false in
+ * - **Cancellation guarding:** @c Cancellation::beginOperation() is called in
  *   three places: inside @c rearmSetup (top of every iteration), before the
  *   early-save path, and before the parallel scan block. This prevents spurious
  *   cancellation from a premature Ctrl+C before input is processed.
@@ -129,7 +147,7 @@ void refreshForDatabase(bool promptFlag, int maxDepth, bool filterHistory, bool&
         setupSignalHandlerCancellations();
         setup_custom_keybindingsForSearches();
         rl_attempted_completion_function = my_special_completion_entry;
-        GlobalState::g_operationCancelled.store(false);
+        Cancellation::beginOperation();
         RetainAndRestoreReadlineBuffer::g_rl_complete_mode = 1;
     };
 
@@ -168,7 +186,8 @@ void refreshForDatabase(bool promptFlag, int maxDepth, bool filterHistory, bool&
                 continue;
             }
 
-            if (input == "*stats" || input == "!clr" || input == "!clr_paths" || input == "!clr_filter") {
+            if (input == "*stats" || input == "*export" || input == "*import" ||
+                input == "!clr" || input == "!clr_paths" || input == "!clr_filter") {
                 databaseSwitches(input);
                 continue;
             }
@@ -233,35 +252,15 @@ void refreshForDatabase(bool promptFlag, int maxDepth, bool filterHistory, bool&
                 resetReadlinePagination();
                 if (!invalidPaths.empty()) {
                     // To prevent unintended cancellation with premature ctrl+c
-                    GlobalState::g_operationCancelled.store(false);
+                    Cancellation::beginOperation();
                     saveAndReportResultsForDatabase(allIsoFiles, totalFiles, validPaths, invalidPaths, uniqueErrorMessages, newISOFound, start_time);
                 }
                 continue;
             }
 
-            {
-                auto& pool = getStaticThreadPool();
-                std::vector<std::future<void>> futures;
-                std::mutex processMutex;
-                std::mutex traverseErrorMutex;
-                // To prevent unintended cancellation with premature ctrl+c
-                GlobalState::g_operationCancelled.store(false);
-
-                for (const auto& validPath : validPaths) {
-                    futures.emplace_back(
-                        pool.enqueue([path = validPath, &allIsoFiles, &uniqueErrorMessages, &totalFiles,
-                                      &processMutex, &traverseErrorMutex, &maxDepth, &promptFlag]() {
-                            traverse(path, allIsoFiles, uniqueErrorMessages, totalFiles,
-                                     processMutex, traverseErrorMutex, maxDepth, promptFlag);
-                        })
-                    );
-                }
-
-                for (auto& future : futures) {
-                    future.wait();
-                    if (GlobalState::g_operationCancelled.load()) break;
-                }
-            }
+            // To prevent unintended cancellation with premature ctrl+c
+            Cancellation::beginOperation();
+            traverse(validPaths, allIsoFiles, uniqueErrorMessages, totalFiles, maxDepth, promptFlag);
 
             flushStdin();
             restoreInput();
@@ -287,97 +286,67 @@ void refreshForDatabase(bool promptFlag, int maxDepth, bool filterHistory, bool&
 }
 
 /**
- * @brief Recursively traverses a directory to find ISO files
+ * @brief Recursively traverses one or more directories to find ISO files
  *
- * This function performs a depth-first traversal of the filesystem starting at
- * the specified path, collecting all .iso files and handling errors appropriately.
+ * All roots are scanned together by a @c ParallelDirWalker, so subdirectories
+ * of even a single large root are spread across every pool thread. Matches are
+ * gathered into per-worker vectors and appended to @p isoFiles once the walk
+ * finishes, so no lock is taken per file.
  *
- * @param path The starting directory path for traversal
+ * @param roots The starting directory paths for traversal
  * @param isoFiles Output vector to store discovered ISO file paths
  * @param uniqueErrorMessages Set to store unique error messages encountered
  * @param totalFiles Atomic counter for total files processed (for progress reporting)
- * @param traverseFilesMutex Mutex for protecting isoFiles vector access
- * @param traverseErrorsMutex Mutex for protecting error messages set access
  * @param maxDepth Maximum recursion depth (-1 for unlimited)
- * @param promptFlag If true, displays progress updates
+ * @param promptFlag If true, displays progress updates and records errors
+ * @param cancel Token that stops the walk; null means the current interactive operation
+ * @param previousSnapshot Optional stamps from an earlier walk of the same roots;
+ *                         unchanged directories are skipped (requires maxDepth -1)
+ * @param snapshotOut Optional snapshot receiving this walk's directory stamps
  */
-void traverse(const std::filesystem::path& path, std::vector<std::string>& isoFiles,
+void traverse(const std::vector<std::string>& roots, std::vector<std::string>& isoFiles,
               std::unordered_set<std::string>& uniqueErrorMessages,
-              std::atomic<size_t>& totalFiles, std::mutex& traverseFilesMutex,
-              std::mutex& traverseErrorsMutex, int maxDepth, bool promptFlag) {
-
-    const size_t BATCH_SIZE = 100;
-    std::vector<std::string> localIsoFiles;
-    std::atomic<bool> g_CancelledMessageAdded{false};
+              std::atomic<size_t>& totalFiles, int maxDepth, bool promptFlag,
+              const CancellationToken* cancel,
+              const DirSnapshot* previousSnapshot, DirSnapshot* snapshotOut) {
 
     const VerboseAndDatabaseTheme dt = getDatabaseTheme();
-
-    auto iequals = [](const std::string_view& a, const std::string_view& b) {
-        return std::equal(a.begin(), a.end(), b.begin(), b.end(),
-                         [](unsigned char a, unsigned char b) {
-                             return std::tolower(a) == std::tolower(b);
-                         });
-    };
-
-    try {
-        auto options = std::filesystem::directory_options::none;
-        for (auto it = std::filesystem::recursive_directory_iterator(path, options);
-             it != std::filesystem::recursive_directory_iterator(); ++it) {
-
-            if (GlobalState::g_operationCancelled.load()) {
-                if (!g_CancelledMessageAdded.exchange(true)) {
-                    std::lock_guard<std::mutex> lock(traverseErrorsMutex);
-                    uniqueErrorMessages.clear();
-
-                    std::string msg = "\n" + dt.yellow + "ISO search interrupted by user" + dt.reset;
-                    uniqueErrorMessages.insert(msg);
-                }
-                break;
-            }
-
-            if (maxDepth >= 0 && it.depth() > maxDepth) {
-                it.disable_recursion_pending();
-                continue;
-            }
-
-            const auto& entry = *it;
-
-            if (promptFlag && entry.is_regular_file()) {
-                uint64_t val = totalFiles.fetch_add(1, std::memory_order_relaxed) + 1;
-                if (val % 100 == 0) {
-                    std::lock_guard<std::mutex> lock(GlobalMutexes::couNtMutex);
-                    std::cout << "\r" << color << "Total files processed: " << val << std::flush;
-                }
-            }
-
-            if (!entry.is_regular_file()) continue;
-
-            const auto& filePath = entry.path();
-
-            if (!iequals(filePath.extension().string(), ".iso")) continue;
-
-            localIsoFiles.push_back(filePath.string());
-
-            if (localIsoFiles.size() >= BATCH_SIZE) {
-                std::lock_guard<std::mutex> lock(traverseFilesMutex);
-                isoFiles.insert(isoFiles.end(), localIsoFiles.begin(), localIsoFiles.end());
-                localIsoFiles.clear();
-            }
-        }
-
-        if (!localIsoFiles.empty()) {
-            std::lock_guard<std::mutex> lock(traverseFilesMutex);
-            isoFiles.insert(isoFiles.end(), localIsoFiles.begin(), localIsoFiles.end());
-        }
-
-    } catch (const std::filesystem::filesystem_error& e) {
-        std::string formattedError = "\n" + dt.red + "Error: " + path.string() + " - " +
-                                     e.what() + dt.reset;
-
-        if (promptFlag) {
+    const CancellationToken token = cancel ? *cancel : Cancellation::operation();
+
+    DirWalkOptions options;
+    options.maxDepth = maxDepth;
+    options.suffixes = {".iso"};
+    options.previousSnapshot = (maxDepth < 0) ? previousSnapshot : nullptr;
+    options.snapshotOut = snapshotOut;
+    options.cancelled = [token] { return token.cancelled(); };
+
+    ParallelDirWalker walker(std::move(options));
+    std::vector<std::vector<std::string>> perWorker(walker.workerCount());
+    std::mutex traverseErrorsMutex;
+
+    walker.walk(roots,
+        [&](size_t worker, const std::string& dir, std::string_view name) {
+            perWorker[worker].push_back(joinDirEntry(dir, name));
+        },
+        [&](const std::string& dir, const std::error_code& ec) {
+            if (!promptFlag) return;
             std::lock_guard<std::mutex> errorLock(traverseErrorsMutex);
-            uniqueErrorMessages.insert(formattedError);
-        }
+            uniqueErrorMessages.insert("\n" + dt.red + "Error: " + dir + " - " + ec.message() + dt.reset);
+        },
+        [&](size_t count) {
+            if (!promptFlag) return;
+            reportFilesProcessed(totalFiles, count);
+        });
+
+    if (token.cancelled()) {
+        uniqueErrorMessages.clear();
+        uniqueErrorMessages.insert("\n" + dt.yellow + "ISO search interrupted by user" + dt.reset);
+    }
+
+    for (auto& local : perWorker) {
+        isoFiles.insert(isoFiles.end(),
+                        std::make_move_iterator(local.begin()),
+                        std::make_move_iterator(local.end()));
     }
 }
 
@@ -398,22 +367,12 @@ void traverse(const std::filesystem::path& path, std::vector<std::string>& isoFi
  * @param files Output vector populated with cached file paths when available
  * @param list Enables display/listing mode and user interaction behavior
  * @param fileExtension Display-only string used in status messages
- * @param binImgFilesCache Snapshot of BIN/IMG cache
- * @param mdfMdsFilesCache Snapshot of MDF cache
- * @param nrgFilesCache Snapshot of NRG cache
- * @param chdFilesCache Snapshot of CHD cache
- * @param daaGbiFilesCache Snapshot of DAA/GBI cache
  * @param modeMdf Select MDF cache mode
  * @param modeNrg Select NRG cache mode
  * @param modeChd Select CHD cache mode
  * @param modeDaa Select DAA/GBI cache mode
  */
 void ramCacheList(std::vector<std::string>& files, bool& list, const std::string& fileExtension,
-                  const std::vector<std::string>& binImgFilesCache,
-                  const std::vector<std::string>& mdfMdsFilesCache,
-                  const std::vector<std::string>& nrgFilesCache,
-                  const std::vector<std::string>& chdFilesCache,
-                  const std::vector<std::string>& daaGbiFilesCache,
                   bool modeMdf, bool modeNrg, bool modeChd, bool modeDaa) {
 
     signal(SIGINT, SIG_IGN);
@@ -421,20 +380,14 @@ void ramCacheList(std::vector<std::string>& files, bool& list, const std::string
 
     const VerboseAndDatabaseTheme dt = getDatabaseTheme();
 
-    bool isEmpty = false;
-    if (modeDaa) {
-        isEmpty = daaGbiFilesCache.empty();
-    } else if (modeChd) {
-        isEmpty = chdFilesCache.empty();
-    } else if (modeMdf) {
-        isEmpty = mdfMdsFilesCache.empty();
-    } else if (modeNrg) {
-        isEmpty = nrgFilesCache.empty();
-    } else {
-        isEmpty = binImgFilesCache.empty();
-    }
+    const ImageFileCache& cache = modeDaa ? GlobalState::daaGbiFilesCache :
+                                  modeChd ? GlobalState::chdFilesCache :
+                                  modeMdf ? GlobalState::mdfMdsFilesCache :
+                                  modeNrg ? GlobalState::nrgFilesCache : GlobalState::binImgFilesCache;
 
-    if (isEmpty && list) {
+    std::vector<std::string> cached = cache.snapshot();
+
+    if (cached.empty() && list) {
         std::cout << "\n" << dt.yellow << "No cached " << fileExtension << " entries to display.\033[J"
                   << dt.reset << "\n";
 
@@ -446,17 +399,7 @@ void ramCacheList(std::vector<std::string>& files, bool& list, const std::string
         return;
 
     } else if (list) {
-        if (modeDaa) {
-            files = daaGbiFilesCache;
-        } else if (modeChd) {
-            files = chdFilesCache;
-        } else if (modeMdf) {
-            files = mdfMdsFilesCache;
-        } else if (modeNrg) {
-            files = nrgFilesCache;
-        } else {
-            files = binImgFilesCache;
-        }
+        files = std::move(cached);
     }
 }
 
@@ -492,28 +435,23 @@ void clearRamCache(bool& modeMdf, bool& modeNrg, bool& modeChd, bool& modeDaa) {
     if (modeDaa) {
         extensions = {".daa", ".gbi"};
         cacheType = "DAA/GBI";
-        cacheIsEmpty = GlobalState::daaGbiFilesCache.empty();
-        if (!cacheIsEmpty) std::vector<std::string>().swap(GlobalState::daaGbiFilesCache);
+        cacheIsEmpty = !GlobalState::daaGbiFilesCache.clear();
     } else if (modeChd) {
         extensions = {".chd"};
         cacheType = "CHD";
-        cacheIsEmpty = GlobalState::chdFilesCache.empty();
-        if (!cacheIsEmpty) std::vector<std::string>().swap(GlobalState::chdFilesCache);
+        cacheIsEmpty = !GlobalState::chdFilesCache.clear();
     } else if (modeMdf) {
         extensions = {".mdf"};
         cacheType = "MDF";
-        cacheIsEmpty = GlobalState::mdfMdsFilesCache.empty();
-        if (!cacheIsEmpty) std::vector<std::string>().swap(GlobalState::mdfMdsFilesCache);
+        cacheIsEmpty = !GlobalState::mdfMdsFilesCache.clear();
     } else if (modeNrg) {
         extensions = {".nrg"};
         cacheType = "NRG";
-        cacheIsEmpty = GlobalState::nrgFilesCache.empty();
-        if (!cacheIsEmpty) std::vector<std::string>().swap(GlobalState::nrgFilesCache);
+        cacheIsEmpty = !GlobalState::nrgFilesCache.clear();
     } else {
         extensions = {".bin", ".img"};
         cacheType = "BIN/IMG";
-        cacheIsEmpty = GlobalState::binImgFilesCache.empty();
-        if (!cacheIsEmpty) std::vector<std::string>().swap(GlobalState::binImgFilesCache);
+        cacheIsEmpty = !GlobalState::binImgFilesCache.clear();
     }
 
     if (cacheIsEmpty) {
@@ -528,10 +466,8 @@ void clearRamCache(bool& modeMdf, bool& modeNrg, bool& modeChd, bool& modeDaa) {
     clearScrollBuffer();
 }
 
-void toLowerInPlace(std::string& str);
-
 /**
- * @brief Filters filesystem entries based on disc image mode.
+ * @brief Returns the lower-case file suffixes scanned for in a disc image mode.
  *
  * Acts as a mode-based extension filter that allows only one category of disc image
  * files at a time:
@@ -541,51 +477,31 @@ void toLowerInPlace(std::string& str);
  * - CHD
  * - DAA/GBI
  *
- * Optionally supports keyword-based exclusion (currently unused).
- *
- * @return true if the file matches the active mode filter, false otherwise.
+ * The suffixes are matched by the directory walker on raw entry names, so no
+ * path object is built for files of other types.
  */
-bool blacklist(const std::filesystem::path& entry, const bool& blacklistMdf, const bool& blacklistNrg, const bool& blacklistChd, const bool& blacklistDaa) {
-    const std::string filenameLower = entry.filename().string();
-    const std::string ext = entry.extension().string();
-    std::string extLower = ext;
-    toLowerInPlace(extLower);
-
-    // Determine which extension(s) are allowed
-    if (blacklistDaa) {
-        if (!(extLower == ".daa" || extLower == ".gbi")) {
-            return false;
-        }
-    }
-    else if (blacklistChd) {
-        if (extLower != ".chd") {
-            return false;
-        }
-    }
-    else if (blacklistMdf) {
-        if (extLower != ".mdf") {
-            return false;
-        }
-    }
-    else if (blacklistNrg) {
-        if (extLower != ".nrg") {
-            return false;
-        }
-    }
-    else { // default BIN/IMG mode
-        if (!(extLower == ".bin" || extLower == ".img")) {
-            return false;
-        }
-    }
+std::vector<std::string> imageSuffixesForMode(const std::string& mode) {
+    if (mode == "daa") return {".daa", ".gbi"};
+    if (mode == "chd") return {".chd"};
+    if (mode == "mdf") return {".mdf"};
+    if (mode == "nrg") return {".nrg"};
+    return {".bin", ".img"};
+}
 
-    // Optional keyword blacklisting (currently empty)
-    std::unordered_set<std::string> blacklistKeywords = {};
+/**
+ * @brief Optional keyword-based exclusion of image file names (currently unused).
+ *
+ * @return true if the file should be kept, false if a keyword excludes it.
+ */
+bool blacklist(std::string_view fileName) {
+    static const std::vector<std::string_view> blacklistKeywords = {};
+    if (blacklistKeywords.empty()) return true;
 
-    std::string filenameLowerNoExt = filenameLower;
-    filenameLowerNoExt.erase(filenameLowerNoExt.size() - ext.size());
+    const size_t dot = fileName.rfind('.');
+    const std::string_view stem = fileName.substr(0, dot);
 
     for (const auto& keyword : blacklistKeywords) {
-        if (filenameLowerNoExt.find(keyword) != std::string::npos) {
+        if (stem.find(keyword) != std::string_view::npos) {
             return false;
         }
     }
@@ -594,93 +510,72 @@ bool blacklist(const std::filesystem::path& entry, const bool& blacklistMdf, con
 }
 
 /**
- * @brief Recursively scans a single directory for disc image files as part of a parallel search system.
+ * @brief Recursively scans directories for disc image files as part of a parallel search system.
  *
- * Traverses the directory tree and filters files based on the specified mode
- * (BIN/IMG, MDF, NRG, CHD, or DAA/GBI). Applies cache checks and blacklist filtering
- * before invoking a callback for newly discovered files.
+ * Walks every path with a shared @c ParallelDirWalker and filters files based on
+ * the specified mode (BIN/IMG, MDF, NRG, CHD, or DAA/GBI). Applies cache checks
+ * and blacklist filtering before invoking a callback for newly discovered files.
  *
  * Supports cancellation handling, progress reporting, and error aggregation
  * for the parent search system.
  *
- * @return Set of newly discovered file paths from this directory.
+ * @return Set of newly discovered file paths across all directories.
  */
-std::unordered_set<std::string> processPaths(const std::string& path, const std::string& mode,
+std::unordered_set<std::string> processPaths(const std::vector<std::string>& paths, const std::string& mode,
                                             const std::function<void(const std::string&, const std::string&)>& callback,
                                             std::unordered_set<std::string>& processedErrorsFind) {
     const VerboseAndDatabaseTheme dt = getDatabaseTheme();
 
     std::atomic<size_t> totalFiles{0};
-    std::unordered_set<std::string> localFileNames;
-    std::atomic<bool> g_CancelledMessageAdded{false};
+    ShardedStringSet localFileNames;
+
+    const ImageFileCache& cache = (mode == "nrg") ? GlobalState::nrgFilesCache :
+                                  (mode == "mdf") ? GlobalState::mdfMdsFilesCache :
+                                  (mode == "chd") ? GlobalState::chdFilesCache :
+                                  (mode == "daa") ? GlobalState::daaGbiFilesCache : GlobalState::binImgFilesCache;
 
-    GlobalState::g_operationCancelled.store(false);
+    const CancellationToken cancel = Cancellation::operation();
     disableInput();
 
-    try {
-        bool blacklistMdf = (mode == "mdf");
-        bool blacklistNrg = (mode == "nrg");
-        bool blacklistChd = (mode == "chd");
-        bool blacklistDaa = (mode == "daa");
-
-        for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
-            if (GlobalState::g_operationCancelled.load()) {
-                if (GlobalState::g_operationCancelled.load()) {
-					std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
-
-					// Re-check under the lock to prevent races between threads
-					if (!g_CancelledMessageAdded.exchange(true)) {
-						processedErrorsFind.clear();
-
-						std::string type = (blacklistMdf) ? "MDF" :
-										   (blacklistNrg) ? "NRG" :
-										   (blacklistChd) ? "CHD" :
-										   (blacklistDaa) ? "DAA/GBI" : "BIN/IMG";
-
-						processedErrorsFind.insert(dt.yellow + type +
-							" search interrupted by user\n\n" + dt.reset);
-					}
-					break;
-				}
-			}
-
-                if (entry.is_regular_file()) {
-                    uint64_t val = totalFiles.fetch_add(1, std::memory_order_relaxed) + 1;
-                    if (val % 100 == 0) {
-                        std::lock_guard<std::mutex> lock(GlobalMutexes::couNtMutex);
-                        std::cout << "\r" << color << "Total files processed: " << val << std::flush;
-                }
+    bool blacklistMdf = (mode == "mdf");
+    bool blacklistNrg = (mode == "nrg");
+    bool blacklistChd = (mode == "chd");
+    bool blacklistDaa = (mode == "daa");
 
-                if (blacklist(entry, blacklistMdf, blacklistNrg, blacklistChd, blacklistDaa)) {
-                    std::string fileName = entry.path().string();
-                    {
-                        std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
-
-                        bool isInCache = false;
-                        if (mode == "nrg") {
-                            isInCache = (std::find(GlobalState::nrgFilesCache.begin(), GlobalState::nrgFilesCache.end(), fileName) != GlobalState::nrgFilesCache.end());
-                        } else if (mode == "mdf") {
-                            isInCache = (std::find(GlobalState::mdfMdsFilesCache.begin(), GlobalState::mdfMdsFilesCache.end(), fileName) != GlobalState::mdfMdsFilesCache.end());
-                        } else if (mode == "bin") {
-                            isInCache = (std::find(GlobalState::binImgFilesCache.begin(), GlobalState::binImgFilesCache.end(), fileName) != GlobalState::binImgFilesCache.end());
-                        } else if (mode == "chd") {
-                            isInCache = (std::find(GlobalState::chdFilesCache.begin(), GlobalState::chdFilesCache.end(), fileName) != GlobalState::chdFilesCache.end());
-                        } else if (mode == "daa") {
-                            isInCache = (std::find(GlobalState::daaGbiFilesCache.begin(), GlobalState::daaGbiFilesCache.end(), fileName) != GlobalState::daaGbiFilesCache.end());
-                        }
-
-                        if (!isInCache && localFileNames.insert(fileName).second) {
-                            callback(fileName, entry.path().parent_path().string());
-                        }
-                    }
-                }
+    DirWalkOptions options;
+    options.suffixes = imageSuffixesForMode(mode);
+    options.cancelled = [cancel] { return cancel.cancelled(); };
+
+    ParallelDirWalker walker(std::move(options));
+
+    walker.walk(paths,
+        [&](size_t, const std::string& dir, std::string_view name) {
+            if (!blacklist(name)) return;
+            std::string fileName = joinDirEntry(dir, name);
+
+            // Both sets are sharded, so scanner threads only contend on equal hashes.
+            if (!cache.contains(fileName) && localFileNames.insert(fileName)) {
+                callback(fileName, dir);
             }
-        }
-    } catch (const std::filesystem::filesystem_error& e) {
+        },
+        [&](const std::string& dir, const std::error_code& ec) {
+            std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
+            processedErrorsFind.insert(dt.red + "Error traversing path: " + dir + " - " +
+                                       ec.message() + dt.reset);
+        },
+        [&](size_t count) { reportFilesProcessed(totalFiles, count); });
+
+    if (cancel.cancelled()) {
         std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
+        processedErrorsFind.clear();
+
+        std::string type = (blacklistMdf) ? "MDF" :
+                           (blacklistNrg) ? "NRG" :
+                           (blacklistChd) ? "CHD" :
+                           (blacklistDaa) ? "DAA/GBI" : "BIN/IMG";
 
-        processedErrorsFind.insert(dt.red + "Error traversing path: " + path + " - " +
-                                 e.what() + dt.reset);
+        processedErrorsFind.insert(dt.yellow + type +
+            " search interrupted by user\n\n" + dt.reset);
     }
 
     {
@@ -688,7 +583,7 @@ std::unordered_set<std::string> processPaths(const std::string& path, const std:
         std::cout << "\r" << color << "Total files processed: " << totalFiles << dt.reset;
     }
 
-    return localFileNames;
+    return localFileNames.extract();
 }
 
 /**
@@ -699,13 +594,13 @@ std::unordered_set<std::string> processPaths(const std::string& path, const std:
  * are already covered by a parent path. This ensures each directory tree is
  * scanned exactly once.
  *
- * Submits the filtered directory scan tasks to a shared static thread pool, where
- * each task processes a directory recursively and returns discovered
+ * Hands the filtered directories to @c processPaths, which walks them together
+ * on the shared static thread pool and returns discovered
  * BIN/IMG/MDF/NRG/CHD/DAA/GBI files.
  *
  * Results are aggregated, deduplicated against the existing cache, and merged
- * into the appropriate RAM cache. Supports cancellation via the global operation
- * flag and signal handling.
+ * into the appropriate RAM cache. Each call begins a new interactive operation,
+ * which Ctrl+C cancels.
  *
  * @param inputPaths          Vector of raw user-provided directory paths.
  * @param fileNames           Output set to populate with discovered file paths.
@@ -716,7 +611,7 @@ std::unordered_set<std::string> processPaths(const std::string& path, const std:
  * @param invalidDirectoryPaths Set of paths that failed validation (for verbose output).
  * @param processedErrorsFind Set of error messages encountered during traversal.
  *
- * @return Reference to the updated cache vector containing all known files of the given mode.
+ * @return Snapshot of the updated cache, in display order, holding all known files of the given mode.
  */
 std::vector<std::string> findFiles(const std::vector<std::string>& inputPaths,
                                    std::unordered_set<std::string>& fileNames,
@@ -726,30 +621,26 @@ std::vector<std::string> findFiles(const std::vector<std::string>& inputPaths,
                                    std::unordered_set<std::string>& invalidDirectoryPaths,
                                    std::unordered_set<std::string>& processedErrorsFind) {
     setupSignalHandlerCancellations();
-    GlobalState::g_operationCancelled.store(false);
+    Cancellation::beginOperation();
 
     disableInput();
 
-    std::vector<std::string>* currentCache = nullptr;
+    ImageFileCache* currentCache = nullptr;
     if (mode == "bin") {
-        currentCacheOld = GlobalState::binImgFilesCache.size();
         currentCache = &GlobalState::binImgFilesCache;
     } else if (mode == "mdf") {
-        currentCacheOld = GlobalState::mdfMdsFilesCache.size();
         currentCache = &GlobalState::mdfMdsFilesCache;
     } else if (mode == "nrg") {
-        currentCacheOld = GlobalState::nrgFilesCache.size();
         currentCache = &GlobalState::nrgFilesCache;
     } else if (mode == "chd") {
-        currentCacheOld = GlobalState::chdFilesCache.size();
         currentCache = &GlobalState::chdFilesCache;
     } else if (mode == "daa") {
-        currentCacheOld = GlobalState::daaGbiFilesCache.size();
         currentCache = &GlobalState::daaGbiFilesCache;
     } else {
         restoreInput();
         return {};
     }
+    currentCacheOld = currentCache->size();
 
     // ----- Normalization and deduplication -----
     auto normalizePath = [](const std::string& p) {
@@ -782,53 +673,22 @@ std::vector<std::string> findFiles(const std::vector<std::string>& inputPaths,
     if (filteredPaths.empty()) {
         flushStdin();
         restoreInput();
-        return *currentCache;
+        return currentCache->snapshot();
     }
 
-    // ----- Submit filtered paths to thread pool -----
-    std::vector<std::future<std::unordered_set<std::string>>> threadFutures;
-
-    {
-        auto& pool = getStaticThreadPool();
-
-        for (const auto& path : filteredPaths) {
-            // Explicitly isolate a string copy for this thread task
-            std::string pathCopy = path;
-
-            // Move that copy into the lambda's storage block
-            threadFutures.push_back(pool.enqueue([path = std::move(pathCopy), &mode, &callback, &processedErrorsFind]() -> std::unordered_set<std::string> {
-                return processPaths(path, mode, callback, std::ref(processedErrorsFind));
-            }));
-        }
-
-        for (auto& future : threadFutures) {
-            if (future.valid()) {
-                std::unordered_set<std::string> threadResult = future.get();
-                fileNames.insert(threadResult.begin(), threadResult.end());
-            }
-            if (GlobalState::g_operationCancelled.load()) break;
-        }
-    }
+    // ----- Walk all filtered paths with one shared walker -----
+    fileNames = processPaths(filteredPaths, mode, callback, processedErrorsFind);
 
     verboseFind(invalidDirectoryPaths, directoryPaths, processedErrorsFind);
 
-    std::unordered_set<std::string> currentCacheSet(currentCache->begin(), currentCache->end());
-    std::vector<std::string> newFiles;
-
     for (const auto& fileName : fileNames) {
-        if (currentCacheSet.insert(fileName).second) {
-            newFiles.push_back(fileName);
-        }
-    }
-
-    if (!newFiles.empty()) {
-        currentCache->insert(currentCache->end(), newFiles.begin(), newFiles.end());
+        currentCache->insert(fileName);
     }
 
     flushStdin();
     restoreInput();
 
-    return *currentCache;
+    return currentCache->snapshot();
 }
 
 void selectForImageFiles(const std::string& fileType, std::vector<std::string>& files, bool& list, std::shared_ptr<RefreshState> state);
@@ -850,7 +710,7 @@ bool dispatchSpecialCommandForBinImgMdfNrgSearch(const std::string& input,
                                                   std::shared_ptr<RefreshState> state) {
 
     if (input == "*stats") {
-        displayDatabaseStatistics(GlobalState::databaseFilePath, GlobalState::maxDatabaseSize);
+        displayDatabaseStatistics(GlobalState::databaseFilePath);
         return true;
     }
     if (input == "!clr_paths" || input == "!clr_filter") {
@@ -868,9 +728,7 @@ bool dispatchSpecialCommandForBinImgMdfNrgSearch(const std::string& input,
     }
     if (input == "ls") {
         list = true;
-        ramCacheList(files, list, fileExtension,
-                     GlobalState::binImgFilesCache, GlobalState::mdfMdsFilesCache, GlobalState::nrgFilesCache, GlobalState::chdFilesCache, GlobalState::daaGbiFilesCache,
-                     modeMdf, modeNrg, modeChd, modeDaa);
+        ramCacheList(files, list, fileExtension, modeMdf, modeNrg, modeChd, modeDaa);
         if (!files.empty())
             selectForImageFiles(fileType, files, list, state);
         return true;
@@ -957,7 +815,7 @@ void promptSearchBinImgChdDaaMdfNrg(const std::string& fileTypeChoice, std::shar
         setupSignalHandlerCancellations();
         rl_attempted_completion_function = my_special_completion_entry;
         setup_custom_keybindingsForSearches();
-        GlobalState::g_operationCancelled.store(false);
+        Cancellation::beginOperation();
         clearScrollBuffer();
         bool filterHistory = false;
         loadHistory(filterHistory);
@@ -1044,7 +902,7 @@ void promptSearchBinImgChdDaaMdfNrg(const std::string& fileTypeChoice, std::shar
 
         if (!newFilesFound) continue;
 
-        if (!files.empty() && !GlobalState::g_operationCancelled.load())
+        if (!files.empty() && !Cancellation::operation().cancelled())
             selectForImageFiles(fileType, files, list, state);
     }
 }
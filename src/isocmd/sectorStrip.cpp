@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// C++ Standard Library Headers
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+// C / System Headers
+#include <sys/stat.h>
+
+// Project Headers
+#include "../asyncIo.h"
+#include "../cpuTopology.h"
+#include "../sectorStrip.h"
+
+namespace {
+
+constexpr size_t MODE_BYTE_OFFSET = 15;
+
+/// @brief Per-sector copy with the length fixed at compile time, so each
+///        iteration is a run of unrolled vector moves rather than a call.
+template <size_t Len>
+void gatherFixed(const char* src, size_t stride, size_t count, char* dst) noexcept {
+    for (size_t i = 0; i < count; ++i, src += stride, dst += Len)
+        std::memcpy(dst, src, Len);
+}
+
+void gatherAny(const char* src, size_t stride, size_t len, size_t count, char* dst) noexcept {
+    for (size_t i = 0; i < count; ++i, src += stride, dst += len)
+        std::memcpy(dst, src, len);
+}
+
+/// @brief Sectors at the front of @p src whose mode byte equals @p mode.
+size_t leadingRun(const char* src, size_t stride, size_t count, unsigned char mode) noexcept {
+    for (size_t i = 0; i < count; ++i)
+        if (static_cast<unsigned char>(src[i * stride + MODE_BYTE_OFFSET]) != mode) return i;
+    return count;
+}
+
+} // namespace
+
+size_t stripSectors(const SectorLayout& layout, const char* src, size_t count, char* dst) noexcept {
+    const size_t len = layout.dataLen;
+    src += layout.dataOffset;
+
+    if (layout.sectorSize == len) {
+        std::memcpy(dst, src, count * len);
+    } else if (len == 2048) {
+        gatherFixed<2048>(src, layout.sectorSize, count, dst);
+    } else if (len == 2352) {
+        gatherFixed<2352>(src, layout.sectorSize, count, dst);
+    } else {
+        gatherAny(src, layout.sectorSize, len, count, dst);
+    }
+    return count * len;
+}
+
+SectorStripResult stripSectorStream(int inFd, int outFd, const SectorStrip& job) {
+    SectorStripResult result;
+    const SectorLayout& layout = job.layout;
+    if (layout.sectorSize == 0 || layout.dataLen == 0 ||
+        layout.dataOffset + layout.dataLen > layout.sectorSize ||
+        (job.modeByte >= 0 && layout.sectorSize <= MODE_BYTE_OFFSET)) {
+        result.error = std::make_error_code(std::errc::invalid_argument);
+        return result;
+    }
+
+    struct stat st{};
+    if (::fstat(inFd, &st) != 0) {
+        result.error = std::error_code(errno, std::system_category());
+        return result;
+    }
+    const uint64_t size = static_cast<uint64_t>(st.st_size);
+    const uint64_t available = size > job.srcOffset ? size - job.srcOffset : 0;
+    uint64_t remaining = available / layout.sectorSize;
+
+    const size_t perBlock = std::max<size_t>(1, job.blockSize / layout.sectorSize);
+    const size_t firstBlock = static_cast<size_t>(std::min<uint64_t>(perBlock, remaining));
+    if (firstBlock == 0) return result;
+
+    NodeLocalBuffer raw(firstBlock * layout.sectorSize);
+    NodeLocalBuffer cooked(firstBlock * layout.dataLen);
+    if (!raw || !cooked) {
+        result.error = std::make_error_code(std::errc::not_enough_memory);
+        return result;
+    }
+
+    const CancellationToken cancel = job.cancel ? job.cancel : Cancellation::operation();
+    uint64_t srcPos = job.srcOffset;
+    uint64_t dstPos = job.dstOffset;
+
+    while (remaining > 0) {
+        if (cancel.cancelled()) {
+            result.error = std::make_error_code(std::errc::operation_canceled);
+            return result;
+        }
+
+        size_t count = static_cast<size_t>(std::min<uint64_t>(firstBlock, remaining));
+        if (!readFully(inFd, raw.data(), count * layout.sectorSize, srcPos, result.error))
+            return result;
+
+        bool stop = false;
+        if (job.modeByte >= 0) {
+            const size_t run = leadingRun(raw.data(), layout.sectorSize, count,
+                                          static_cast<unsigned char>(job.modeByte));
+            stop = run < count;
+            count = run;
+        }
+
+        const size_t out = stripSectors(layout, raw.data(), count, cooked.data());
+        if (!writeFully(outFd, cooked.data(), out, dstPos, result.error)) return result;
+        if (job.completedBytes) job.completedBytes->fetch_add(out, std::memory_order_relaxed);
+
+        result.sectors += count;
+        result.bytes += out;
+        remaining -= count;
+        srcPos += static_cast<uint64_t>(count) * layout.sectorSize;
+        dstPos += out;
+        if (stop) break;
+    }
+    return result;
+}
@@ -21,6 +21,7 @@
 #include <readline/readline.h>
 
 // Project Headers
+#include "../cancellation.h"
 #include "../databaseOps.h"
 #include "../filtering.h"
 #include "../inputHandling.h"
@@ -66,10 +67,17 @@ void processOperationForSelectedIsoFiles(const std::string& inputString,
     bool verbose = false;
     bool isUnmount = false;
 
+    // Operations index plain strings; materialise the interned list only for their duration.
+    std::vector<std::string> isoListPaths;
+    if (!isFiltered && operation != "umount") {
+        std::lock_guard<std::mutex> lock(GlobalMutexes::updateListMutex);
+        isoListPaths = GlobalState::globalIsoFileList.toVector();
+    }
+
     if (operation == "mount" || operation == "umount") {
         if (operation == "umount") isUnmount = true;
         const std::vector<std::string>& activeList = isFiltered ? filteredFiles :
-                                                    (isUnmount ? isoDirs : GlobalState::globalIsoFileList);
+                                                    (isUnmount ? isoDirs : isoListPaths);
 
         if (operation == "umount") {
             umountMvRmBreak = true;
@@ -77,10 +85,10 @@ void processOperationForSelectedIsoFiles(const std::string& inputString,
 
         processInputForMountOrUmount(inputString, activeList, umountMvRmBreak, verbose, isUnmount);
     } else if (operation == "write2usb") {
-        const std::vector<std::string>& activeList = isFiltered ? filteredFiles : GlobalState::globalIsoFileList;
+        const std::vector<std::string>& activeList = isFiltered ? filteredFiles : isoListPaths;
         writeToUsb(inputString, activeList);
     } else {
-        const std::vector<std::string>& activeList = isFiltered ? filteredFiles : GlobalState::globalIsoFileList;
+        const std::vector<std::string>& activeList = isFiltered ? filteredFiles : isoListPaths;
         processInputForCpMvRm(inputString, activeList, operation, umountMvRmBreak, filterHistory, verbose);
     }
 
@@ -288,9 +296,8 @@ void refreshListAfterAutoUpdate(std::atomic<bool>& isAtISOList,
  *   and batch-executed via the @c "P" command; @c "clr" discards the pending set.
  *   The @c "P" command with an empty pending set displays a warning and continues.
  * - **Manual Refresh:** Pressing @c "R" (when not unmount, the ISO list is
- *   non-empty, and no import is running) spawns a background database import
- *   thread. Stale completed threads in @p backgroundThreads are joined and
- *   erased before each new import is launched.
+ *   non-empty, and no import is running) submits a database import to
+ *   @c RefreshState::importGroup, which runs it at background priority.
  * - **Persistent Directory State:** @c isoDirs is @c static, so its contents
  *   survive re-entry into this function across the lifetime of the process.
  * - **Terminal Integrity:** Binds @c \\f and @c \\t to no-ops via Readline to
@@ -305,10 +312,6 @@ void refreshListAfterAutoUpdate(std::atomic<bool>& isAtISOList,
  *                           for non-unmount operations); automatically managed
  *                           by RAII guards during operation execution. Also
  *                           gates watcher-thread repaints.
- * @param backgroundThreads  Joinable worker threads (spawned by manual R-press
- *                           imports) retained for lifetime management; stale
- *                           completed threads are joined and erased before each
- *                           new import.
  * @param refreshState       Shared UI state and condition variable used to
  *                           synchronize the watcher with the active import session.
  *                           If @c nullptr, a new @c RefreshState is constructed
@@ -316,7 +319,6 @@ void refreshListAfterAutoUpdate(std::atomic<bool>& isAtISOList,
  */
 void selectForIsoFiles(const std::string& operation,
                        std::atomic<bool>& isAtISOList,
-                       std::vector<std::thread>& backgroundThreads,
                        std::shared_ptr<RefreshState> refreshState) {
 
     // --- RAII: Keybindings are automatically reset on any exit path ---
@@ -368,7 +370,7 @@ void selectForIsoFiles(const std::string& operation,
         clearGlobalVerboseSets();
         enable_ctrl_d();
         setupSignalHandlerCancellations();
-        GlobalState::g_operationCancelled.store(false);
+        Cancellation::beginOperation();
         filterHistory = false;
         clear_history();
 
@@ -446,17 +448,9 @@ void selectForIsoFiles(const std::string& operation,
         }
 
         if (inputString == "R" && !isUnmount && !GlobalState::globalIsoFileList.empty() && !refreshState->isImportRunning.load()) {
-            backgroundThreads.erase(
-                std::remove_if(backgroundThreads.begin(), backgroundThreads.end(),
-                    [](std::thread& t) {
-                        if (t.joinable()) { t.join(); return true; }
-                        return false;
-                    }),
-                backgroundThreads.end()
-            );
             needsClrScrn = true;
             refreshState->isImportRunning.store(true);
-            backgroundThreads.emplace_back([refreshState] {
+            refreshState->importGroup.enqueue([refreshState] {
                 backgroundDatabaseImport(refreshState);
                 refreshState->isWatcherRunning.store(false);
             });
@@ -494,8 +488,9 @@ void selectForIsoFiles(const std::string& operation,
         size_t totalPages = 0;
         {
             std::lock_guard<std::mutex> lock(GlobalMutexes::updateListMutex);
-            const std::vector<std::string>& currentList = isFiltered ? filteredFiles : (isUnmount ? isoDirs : GlobalState::globalIsoFileList);
-            totalPages = (GlobalState::ITEMS_PER_PAGE != 0) ? ((currentList.size() + GlobalState::ITEMS_PER_PAGE - 1) / GlobalState::ITEMS_PER_PAGE) : 0;
+            const size_t listSize = isFiltered ? filteredFiles.size() :
+                                    (isUnmount ? isoDirs.size() : GlobalState::globalIsoFileList.size());
+            totalPages = (GlobalState::ITEMS_PER_PAGE != 0) ? ((listSize + GlobalState::ITEMS_PER_PAGE - 1) / GlobalState::ITEMS_PER_PAGE) : 0;
         }
         bool need2Sort = false;
 
@@ -651,7 +646,7 @@ void selectForImageFiles(const std::string& fileType, std::vector<std::string>&
 
         // Reset manual-update key for image lists
         rl_bind_keyseq("R", rl_insert);
-        GlobalState::g_operationCancelled.store(false);
+        Cancellation::beginOperation();
         bool verbose = false;
 
         if (!isFiltered) originalPage = currentPage;
@@ -697,15 +692,15 @@ void selectForImageFiles(const std::string& fileType, std::vector<std::string>&
             if (isFiltered) {
                 // Restore original unfiltered file list
                 if (fileType == "bin" || fileType == "img") {
-                    files = GlobalState::binImgFilesCache;
+                    files = GlobalState::binImgFilesCache.snapshot();
                 } else if (fileType == "mdf") {
-                    files = GlobalState::mdfMdsFilesCache;
+                    files = GlobalState::mdfMdsFilesCache.snapshot();
                 } else if (fileType == "nrg") {
-                    files = GlobalState::nrgFilesCache;
+                    files = GlobalState::nrgFilesCache.snapshot();
                 } else if (fileType == "chd") {
-                    files = GlobalState::chdFilesCache;
+                    files = GlobalState::chdFilesCache.snapshot();
                 } else if (fileType == "daa") {
-                    files = GlobalState::daaGbiFilesCache;
+                    files = GlobalState::daaGbiFilesCache.snapshot();
                 }
                 needsClrScrn = true;
                 isFiltered = false;
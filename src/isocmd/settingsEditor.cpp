@@ -277,14 +277,25 @@ bool editSetting(const std::string& configPath, const std::string& key) {
 		} else if (key == "theme") {
 			std::cout << "original, classic, high_contrast, neon, ocean, sunset, forest,\n"
 					  << "               midnight, mono, retro, crimson, dracula, tokyo, paper, sakura\n";
-		} else if (key == "auto_update" || key == "filenames_only") {
+		} else if (key == "auto_update" || key == "filenames_only" || key == "numa_affinity") {
 			std::cout << "on, off\n";
-		} else if (key == "pagination" || key.find("thread_cap") != std::string::npos || key.find("_lines") != std::string::npos) {
+		} else if (key == "database_full_policy") {
+			std::cout << "lru, refuse\n";
+		} else if (key == "chd_parent_search_path") {
+			std::cout << "none, or absolute folders separated by ':'\n";
+		} else if (key == "pagination" || key.find("thread_cap") != std::string::npos || key.find("_lines") != std::string::npos ||
+		           key == "database_max_entries" || key == "database_max_mb" || key == "combined_thread_floor" ||
+		           key == "hazard_scan_threshold" || key == "chd_hunk_cache_mb") {
 			int min = 1, max = 256;
 			if (key == "pagination")                          { min = 0;  max = 1000; }
 			else if (key == "folder_path_history_lines")      { min = 0;  max = 5000; }
 			else if (key == "filter_history_lines")           { min = 0;  max = 1000; }
+			else if (key == "database_max_entries")           { min = 1;  max = 100000000; }
+			else if (key == "database_max_mb")                { min = 1;  max = 1048576; }
+			else if (key == "chd_hunk_cache_mb")              { min = 0;  max = 4096; }
 			else if (key == "combined_thread_cap")            { min = 1;  max = 256;  }
+			else if (key == "combined_thread_floor")          { min = 0;  max = 256;  }
+			else if (key == "hazard_scan_threshold")          { min = 16; max = 65536; }
 			else if (key == "thread_cap_for_mount")           { min = 1;  max = 128;  }
 			else if (key == "thread_cap_for_umount")          { min = 1;  max = 128;  }
 			else if (key == "thread_cap_for_cp_mv")           { min = 1;  max = 128;  }
@@ -293,6 +304,7 @@ bool editSetting(const std::string& configPath, const std::string& key) {
 			else if (key == "thread_cap_for_database_cleanup"){ min = 1;  max = 128;  }
 			else if (key == "thread_cap_for_list_sorting")    { min = 1;  max = 64;   }
 			else if (key == "thread_cap_for_list_filtering")  { min = 1;  max = 64;   }
+			else if (key == "thread_cap_for_daa_decode")      { min = 1;  max = 64;   }
 
 			std::cout << "numeric value (min - max: " << min << " - " << max << ")\n";
 		} else if (key.find("_list") != std::string::npos) {
@@ -6,6 +6,7 @@
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -18,6 +19,7 @@
 #include "../state.h"
 #include "../themes.h"
 #include "../settings.h"
+#include "../threadpool.h"
 
 namespace fs = std::filesystem;
 
@@ -136,7 +138,26 @@ void applyThreadCapsAndHistoryLimits(const std::map<std::string, std::string>& c
     GlobalState::MAX_HISTORY_LINES         		 = getVal("folder_path_history_lines",    30);
     GlobalState::MAX_HISTORY_PATTERN_LINES 		 = getVal("filter_history_lines",         15);
 
+    GlobalState::databaseMaxEntries              = getVal("database_max_entries",         1048576);
+    GlobalState::databaseMaxBytes                = getVal("database_max_mb",              256) * 1024 * 1024;
+    auto policy = configMap.find("database_full_policy");
+    GlobalState::databaseRefuseWhenFull          = (policy != configMap.end() && policy->second == "refuse");
+
+    GlobalState::chdParentSearchDirs.clear();
+    auto chdParents = configMap.find("chd_parent_search_path");
+    if (chdParents != configMap.end() && chdParents->second != "none") {
+        std::stringstream dirs(chdParents->second);
+        for (std::string dir; std::getline(dirs, dir, ':');)
+            if (!dir.empty()) GlobalState::chdParentSearchDirs.push_back(dir);
+    }
+    GlobalState::chdHunkCacheBytes               = getVal("chd_hunk_cache_mb",            64) * 1024 * 1024;
+
     GlobalConcurrency::MAX_USEFUL_THREADS        = getVal("combined_thread_cap",               16);
+    GlobalConcurrency::MIN_POOL_THREADS          = getVal("combined_thread_floor",             0);
+    auto affinity = configMap.find("numa_affinity");
+    GlobalConcurrency::PIN_POOL_WORKERS          = (affinity != configMap.end() && affinity->second == "on");
+    HazardPointerDomain::instance().setRetireThreshold(
+        getVal("hazard_scan_threshold", HazardPointerDomain::DEFAULT_RETIRE_THRESHOLD));
     GlobalConcurrency::MOUNT_THREAD_CAP          = getVal("thread_cap_for_mount",             8);
     GlobalConcurrency::UMOUNT_THREAD_CAP         = getVal("thread_cap_for_umount",            8);
     GlobalConcurrency::CPMV_THREAD_CAP           = getVal("thread_cap_for_cp_mv",             4);
@@ -145,6 +166,7 @@ void applyThreadCapsAndHistoryLimits(const std::map<std::string, std::string>& c
     GlobalConcurrency::CLEAN_THREAD_CAP          = getVal("thread_cap_for_database_cleanup",  4);
     GlobalConcurrency::SORT_THREAD_CAP           = getVal("thread_cap_for_list_sorting",      2);
     GlobalConcurrency::FILTER_THREAD_CAP         = getVal("thread_cap_for_list_filtering",    2);
+    GlobalConcurrency::DAA_DECODE_THREAD_CAP     = getVal("thread_cap_for_daa_decode",        4);
 }
 
 // ---------------------------------------------------------------------------
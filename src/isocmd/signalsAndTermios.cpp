@@ -14,6 +14,7 @@
 #include <readline/readline.h>
 
 // Project Headers
+#include "../cancellation.h"
 #include "../inputHandling.h"
 #include "../state.h"
 
@@ -96,17 +97,21 @@ void setupReadlineToIgnoreCtrlC() {
  */
 void signalHandlerCancellations(int signal) {
     if (signal == SIGINT) {
-        // Atomic flag used by worker threads to stop processing
-        GlobalState::g_operationCancelled = true;
+        // Relayed to Cancellation::cancelOperation(), which can't run in a handler
+        Cancellation::requestFromSignal();
     }
 }
 
 /**
  * @brief Sets up a handler to catch Ctrl+C for graceful cancellation.
- * @details Instead of terminating, the program sets a global flag
- * allowing current tasks to finish or clean up before returning.
+ * @details Instead of terminating, the program cancels the current
+ * interactive operation's token (see Cancellation::beginOperation),
+ * allowing its tasks to finish or clean up before returning. Background
+ * jobs are not affected.
  */
 void setupSignalHandlerCancellations() {
+    Cancellation::installSignalRelay();
+
     struct sigaction sa;
     sa.sa_handler = signalHandlerCancellations;
     sigemptyset(&sa.sa_mask);
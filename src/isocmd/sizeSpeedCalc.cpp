@@ -14,11 +14,9 @@
 #include <string.h>
 #include <sys/stat.h>
 
-// Third-Party Library Headers
-#include "chd.h"
-
 // Project Headers
 #include "../ccd.h"
+#include "../convert.h"
 #include "../daa2iso.h"
 #include "../mdf.h"
 #include "../write2usb.h"
@@ -169,8 +167,8 @@ void toLowerInPlace(std::string& str);
  * Iterates over the provided file list and estimates the size of the resulting ISO for each file
  * based on the active conversion mode. Each format is handled according to its sector geometry:
  *
- * - **CHD**: Opens the CHD header via libchdr, detects sector size (2448/2352/2048 bytes),
- *   and computes total sectors × 2048 bytes user data, mirroring convertChdToIso().
+ * - **CHD**: Delegates to chdIsoSize(), which opens the CHD (and any parents) the way
+ *   convertChdToIso() does and computes total sectors × 2048 bytes user data.
  * - **NRG**: Raw file size minus a fixed 300 KB header/footer offset.
  * - **MDF**: Detects sector geometry via MdfTypeInfo, computes sectors × sector_data,
  *   mirroring convertMdfToIso().
@@ -199,25 +197,7 @@ size_t calculateTotalBytesForConversions(
         toLowerInPlace(ext);
 
         if (modeChd && ext == "chd") {
-            chd_file* rawChd = nullptr;
-            chd_error err = chd_open(file.c_str(), CHD_OPEN_READ, nullptr, &rawChd);
-            if (err == CHDERR_NONE && rawChd) {
-                const chd_header* header = chd_get_header(rawChd);
-                if (header) {
-                    uint32_t hunkSize = header->hunkbytes;
-                    uint32_t rawSectorSize = 0;
-                    if      (hunkSize % 2448 == 0) rawSectorSize = 2448;
-                    else if (hunkSize % 2352 == 0) rawSectorSize = 2352;
-                    else if (hunkSize % 2048 == 0) rawSectorSize = 2048;
-                    if (rawSectorSize != 0) {
-                        constexpr uint32_t userDataSize = 2048;
-                        uint32_t sectorsPerHunk = hunkSize / rawSectorSize;
-                        uint64_t totalSectors = static_cast<uint64_t>(header->totalhunks) * sectorsPerHunk;
-                        totalBytes += totalSectors * userDataSize;
-                    }
-                }
-                chd_close(rawChd);
-            }
+            totalBytes += chdIsoSize(file);
         }
         else if (modeNrg && ext == "nrg") {
             std::ifstream nrg(file, std::ios::binary | std::ios::ate);
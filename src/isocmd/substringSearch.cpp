@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <string_view>
+
+// C / System Headers
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SUBSTRING_SEARCH_X86 1
+#endif
+
+// Project Headers
+#include "../substringSearch.h"
+
+// Helpers are force-inlined so that inside the AVX2 clone they are compiled
+// VEX-encoded too; calling legacy-SSE code with dirty upper YMM state would
+// stall on the SSE/AVX transition.
+#define SUBSTRING_INLINE inline __attribute__((always_inline))
+
+// ─── Scalar helpers ──────────────────────────────────────────────────────────
+
+template <bool Fold>
+static SUBSTRING_INLINE unsigned char loadByte(const char* p) {
+    const unsigned char c = static_cast<unsigned char>(*p);
+    if constexpr (Fold) return (static_cast<unsigned>(c - 'A') < 26u) ? static_cast<unsigned char>(c | 0x20) : c;
+    else return c;
+}
+
+/// @brief Compares @p n bytes of haystack @p h against needle @p nd.
+template <bool Fold>
+static SUBSTRING_INLINE bool equalBytes(const char* h, const char* nd, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k)
+        if (loadByte<Fold>(h + k) != static_cast<unsigned char>(nd[k])) return false;
+    return true;
+}
+
+/// @brief Checks start positions [from, n - m] one at a time.
+template <bool Fold>
+static SUBSTRING_INLINE bool scalarFrom(const char* h, std::size_t n, const char* nd, std::size_t m, std::size_t from) {
+    const unsigned char first = static_cast<unsigned char>(nd[0]);
+    for (std::size_t i = from; i + m <= n; ++i)
+        if (loadByte<Fold>(h + i) == first && equalBytes<Fold>(h + i + 1, nd + 1, m - 1)) return true;
+    return false;
+}
+
+// ─── Vector kernels ──────────────────────────────────────────────────────────
+
+#ifdef SUBSTRING_SEARCH_X86
+
+/// @brief Adds 0x20 to bytes in 'A'..'Z' (signed compare on bytes biased by -'A'-128).
+template <bool Fold>
+static SUBSTRING_INLINE __m128i fold16(__m128i v) {
+    if constexpr (!Fold) return v;
+    const __m128i biased = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - 'A')));
+    const __m128i upper  = _mm_cmplt_epi8(biased, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+template <bool Fold>
+static SUBSTRING_INLINE bool sse2Contains(const char* h, std::size_t n, const char* nd, std::size_t m) {
+    const __m128i first = _mm_set1_epi8(nd[0]);
+    const __m128i last  = _mm_set1_epi8(nd[m - 1]);
+
+    std::size_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        const __m128i a = fold16<Fold>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i)));
+        const __m128i b = fold16<Fold>(_mm_loadu_si128(reinterpret_cast<const __m128i*>(h + i + m - 1)));
+        unsigned mask = static_cast<unsigned>(
+            _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(a, first), _mm_cmpeq_epi8(b, last))));
+        while (mask) {
+            const unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if (m <= 2 || equalBytes<Fold>(h + i + bit + 1, nd + 1, m - 2)) return true;
+            mask &= mask - 1;
+        }
+    }
+    return scalarFrom<Fold>(h, n, nd, m, i);
+}
+
+template <bool Fold>
+__attribute__((target("avx2")))
+static inline __m256i fold32(__m256i v) {
+    if constexpr (!Fold) return v;
+    const __m256i biased = _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(0x80 - 'A')));
+    const __m256i upper  = _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(0x80 + 26)), biased);
+    return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+template <bool Fold>
+__attribute__((target("avx2")))
+static bool avx2Contains(const char* h, std::size_t n, const char* nd, std::size_t m) {
+    const __m256i first = _mm256_set1_epi8(nd[0]);
+    const __m256i last  = _mm256_set1_epi8(nd[m - 1]);
+
+    std::size_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32) {
+        const __m256i a = fold32<Fold>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i)));
+        const __m256i b = fold32<Fold>(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(h + i + m - 1)));
+        unsigned mask = static_cast<unsigned>(
+            _mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(a, first), _mm256_cmpeq_epi8(b, last))));
+        while (mask) {
+            const unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if (m <= 2 || equalBytes<Fold>(h + i + bit + 1, nd + 1, m - 2)) return true;
+            mask &= mask - 1;
+        }
+    }
+    // Fewer than 32 positions left: finish with 16-byte blocks.
+    return i + m <= n && sse2Contains<Fold>(h + i, n - i, nd, m);
+}
+
+// Function multiversioning: the loader resolves containsKernel once, to the
+// AVX2 build where the CPU has it and to the SSE2 (x86-64 baseline) one otherwise.
+__attribute__((target("default")))
+bool containsKernel(const char* h, std::size_t n, const char* nd, std::size_t m, bool fold) {
+    return fold ? sse2Contains<true>(h, n, nd, m) : sse2Contains<false>(h, n, nd, m);
+}
+
+__attribute__((target("avx2")))
+bool containsKernel(const char* h, std::size_t n, const char* nd, std::size_t m, bool fold) {
+    return fold ? avx2Contains<true>(h, n, nd, m) : avx2Contains<false>(h, n, nd, m);
+}
+
+#else
+
+static bool containsKernel(const char* h, std::size_t n, const char* nd, std::size_t m, bool fold) {
+    return fold ? scalarFrom<true>(h, n, nd, m, 0) : scalarFrom<false>(h, n, nd, m, 0);
+}
+
+#endif // SUBSTRING_SEARCH_X86
+
+bool containsSubstring(std::string_view haystack, std::string_view needle, bool ignoreCase) {
+    if (needle.empty()) return true;
+    if (needle.size() > haystack.size()) return false;
+    return containsKernel(haystack.data(), haystack.size(), needle.data(), needle.size(), ignoreCase);
+}
@@ -4,7 +4,6 @@
 #include <atomic>
 #include <cstddef>
 #include <filesystem>
-#include <mutex>
 #include <string>
 #include <string_view>
 #include <tuple>
@@ -18,11 +17,13 @@
 #include <libmount/libmount.h>
 
 // Project Headers
+#include "../cancellation.h"
 #include "../display.h"
 #include "../globalMutexes.h"
 #include "../state.h"
 #include "../stringManipulation.h"
 #include "../themes.h"
+#include "../threadpool.h"
 #include "../umount.h"
 #include "../verbose.h"
 
@@ -71,119 +72,116 @@ static std::string formatDirForDisplay(const std::string& isoDir, VerboseMessage
 }
 
 /**
- * @brief Performs unmount operations on a list of ISO mount points.
+ * @brief Unmounts one ISO mount point and reports the outcome.
  *
- * Allocates a single libmount context (@c mnt_new_context) and reuses it
- * across all entries via @c mnt_reset_context, avoiding per-iteration
- * allocation overhead.  The context is managed by a RAII CtxGuard that
- * guarantees @c mnt_free_context on any exit path.
+ * The mount point is unmounted with lazy detach (@c MNT_DETACH) and
+ * automatic loop device cleanup (@c /dev/loopX) through its own libmount
+ * context; the directory is removed afterwards if it is empty. Reported as
+ * cancelled without being touched once @p cancel is set.
+ */
+static void unmountOne(const std::string& isoDir,
+                       std::atomic<size_t>* completedTasks,
+                       std::atomic<size_t>* failedTasks,
+                       bool silentMode,
+                       ResultChannel& results,
+                       const CancellationToken& cancel)
+{
+    VerboseMessageFormatter messageFormatter;
+
+    if (cancel.cancelled()) {
+        if (!silentMode)
+            results.failed(
+                formatDirForDisplay(isoDir, messageFormatter, "cancel"));
+        failedTasks->fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    // Allocate isolated libmount context
+    libmnt_context* ctx = mnt_new_context();
+    if (!ctx) {
+        failedTasks->fetch_add(1, std::memory_order_relaxed);
+        if (!silentMode)
+            results.failed(
+                formatDirForDisplay(isoDir, messageFormatter, "error"));
+        return;
+    }
+
+    // Configure target, lazy unmount (MNT_DETACH), and loop cleanup
+    mnt_context_set_target(ctx, isoDir.c_str());
+    mnt_context_enable_lazy(ctx, 1);    // Matches MNT_DETACH
+    mnt_context_enable_loopdel(ctx, 1); // Cleans up /dev/loopX
+
+    // Execute the unmount operation
+    const int result = mnt_context_umount(ctx);
+    mnt_free_context(ctx);
+
+    // Handle results and directory removal verbose output
+    if (result == 0 || isDirectoryEmpty(isoDir)) {
+        rmdir(isoDir.c_str());
+        completedTasks->fetch_add(1, std::memory_order_relaxed);
+        if (!silentMode)
+            results.completed(
+                formatDirForDisplay(isoDir, messageFormatter, "success"));
+    } else {
+        failedTasks->fetch_add(1, std::memory_order_relaxed);
+        if (!silentMode)
+            results.failed(
+                formatDirForDisplay(isoDir, messageFormatter, "error"));
+    }
+}
+
+/**
+ * @brief Performs unmount operations on a list of ISO mount points.
  *
- * Each mount point is unmounted with lazy detach (@c MNT_DETACH) and
- * automatic loop device cleanup (@c /dev/loopX).  Empty mount point
- * directories are removed after a successful unmount.
+ * Every mount point is its own task (see @ref unmountOne) in an "umount"
+ * @ref TaskGroup capped at `GlobalConcurrency::UMOUNT_THREAD_CAP`, so a
+ * mount point whose unmount blocks (a busy or stale loop device) holds up
+ * one slot instead of every entry queued behind it in a chunk.
  *
- * Results are written directly to the global verboseSets:
- *   - verboseSets.operationCompleted  Success messages.
- *   - verboseSets.operationFailed     Failure messages (root_error, cancel, error).
+ * Results are pushed into @p results, one per mount point, without taking a
+ * lock, and collected into verboseSets by this function while it waits, so
+ * it must be called on the thread that consumes @p results:
+ *   - completed  Success messages.
+ *   - failed     Failure messages (root_error, cancel, error).
  *
  * @param isoDirs        Vector of mount point directories to unmount.
  * @param completedTasks Atomic counter incremented for each successful unmount.
  * @param failedTasks    Atomic counter incremented for each failure
  *                       (including cancellation and context allocation failure).
  * @param silentMode     Suppresses all message generation; only counters are updated.
+ * @param results        Receives the messages (see @ref ResultChannel).
  *
  * @warning Requires root (geteuid() == 0). Without it every entry gets "root_error".
- *          If the initial context allocation fails, all entries are marked failed
- *          immediately.
  */
 void unmountISO(
     const std::vector<std::string>& isoDirs,
     std::atomic<size_t>* completedTasks,
     std::atomic<size_t>* failedTasks,
-    bool silentMode)
+    bool silentMode,
+    ResultChannel& results)
 {
     const bool hasRoot = (geteuid() == 0);
-    VerboseMessageFormatter messageFormatter;
-    std::vector<std::string> errorMessages, successMessages;
-    constexpr size_t kBatchSize = 50;
-    if (!silentMode) {
-        errorMessages.reserve(kBatchSize);
-        successMessages.reserve(kBatchSize);
-    }
-    auto flushTemporaryBuffers = [&]() {
-        if (silentMode) return;
-        std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
-        if (!successMessages.empty()) {
-            verboseSets.operationCompleted.insert(successMessages.begin(), successMessages.end());
-            successMessages.clear();
-        }
-        if (!errorMessages.empty()) {
-            verboseSets.operationFailed.insert(errorMessages.begin(), errorMessages.end());
-            errorMessages.clear();
-        }
-    };
-    auto maybeFlush = [&]() {
-        if (!silentMode &&
-            (successMessages.size() >= kBatchSize ||
-             errorMessages.size()   >= kBatchSize)) {
-            flushTemporaryBuffers();
-        }
-    };
 
     if (!hasRoot) {
         if (!silentMode) {
-            for (const auto& isoDir : isoDirs)
-                errorMessages.push_back(
-                    formatDirForDisplay(isoDir, messageFormatter, "root_error"));
-            flushTemporaryBuffers();
+            // Pushed on the consuming thread itself: drained as it goes so
+            // a bounded channel can't fill up and block it.
+            VerboseMessageFormatter messageFormatter;
+            for (const auto& isoDir : isoDirs) {
+                results.failed(formatDirForDisplay(isoDir, messageFormatter, "root_error"));
+                results.collect();
+            }
         }
         failedTasks->fetch_add(isoDirs.size(), std::memory_order_relaxed);
         return;
     }
-    for (const auto& isoDir : isoDirs) {
-        if (GlobalState::g_operationCancelled.load(std::memory_order_relaxed)) {
-            if (!silentMode)
-                errorMessages.push_back(
-                    formatDirForDisplay(isoDir, messageFormatter, "cancel"));
-            failedTasks->fetch_add(1, std::memory_order_relaxed);
-            maybeFlush();
-            continue;
-        }
-
-        // Allocate isolated libmount context
-        libmnt_context* ctx = mnt_new_context();
-        if (!ctx) {
-            failedTasks->fetch_add(1, std::memory_order_relaxed);
-            if (!silentMode)
-                errorMessages.push_back(
-                    formatDirForDisplay(isoDir, messageFormatter, "error"));
-            maybeFlush();
-            continue;
-        }
 
-        // Configure target, lazy unmount (MNT_DETACH), and loop cleanup
-        mnt_context_set_target(ctx, isoDir.c_str());
-        mnt_context_enable_lazy(ctx, 1);    // Matches MNT_DETACH
-        mnt_context_enable_loopdel(ctx, 1); // Cleans up /dev/loopX
-
-        // Execute the unmount operation
-        const int result = mnt_context_umount(ctx);
-        mnt_free_context(ctx);
-
-        // Handle results and directory removal verbose output
-        if (result == 0 || isDirectoryEmpty(isoDir)) {
-            rmdir(isoDir.c_str());
-            completedTasks->fetch_add(1, std::memory_order_relaxed);
-            if (!silentMode)
-                successMessages.push_back(
-                    formatDirForDisplay(isoDir, messageFormatter, "success"));
-        } else {
-            failedTasks->fetch_add(1, std::memory_order_relaxed);
-            if (!silentMode)
-                errorMessages.push_back(
-                    formatDirForDisplay(isoDir, messageFormatter, "error"));
-        }
-        maybeFlush();
+    const CancellationToken cancel = Cancellation::operation();
+    TaskGroup unmounts("umount", TaskPriority::Foreground, GlobalConcurrency::UMOUNT_THREAD_CAP);
+    for (const auto& isoDir : isoDirs) {
+        unmounts.submit([&isoDir, completedTasks, failedTasks, silentMode, &results, &cancel] {
+            unmountOne(isoDir, completedTasks, failedTasks, silentMode, results, cancel);
+        });
     }
-    flushTemporaryBuffers();
+    unmounts.wait([&results] { results.collect(); });
 }
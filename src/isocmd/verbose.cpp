@@ -10,6 +10,7 @@
 #include <iomanip>
 #include <iostream>
 #include <iterator>
+#include <mutex>
 #include <string>
 #include <string_view>
 #include <unordered_set>
@@ -25,9 +26,12 @@
 #include <readline/history.h>
 
 // Project Headers
+#include "../cancellation.h"
 #include "../databaseOps.h"
 #include "../display.h"
+#include "../globalMutexes.h"
 #include "../inputHandling.h"
+#include "../pathTable.h"
 #include "../readline.h"
 #include "../state.h"
 #include "../themes.h"
@@ -111,6 +115,22 @@ void pressEnterToContinue() {
     tcsetattr(STDIN_FILENO, TCSAFLUSH, &saved);
 }
 
+/**
+ * @details The lock is taken once for the whole batch; producers never wait
+ * on it, since they only ever touch the channel.
+ */
+void ResultChannel::collect(std::vector<std::string>* outputPaths) {
+    std::lock_guard<std::mutex> lock(GlobalMutexes::globalSetsMutex);
+    channel_.drain([&](Result&& r) {
+        switch (r.kind) {
+            case Kind::Completed:  verboseSets.operationCompleted.insert(std::move(r.text)); break;
+            case Kind::Failed:     verboseSets.operationFailed.insert(std::move(r.text)); break;
+            case Kind::Skipped:    verboseSets.operationSkipped.insert(std::move(r.text)); break;
+            case Kind::OutputPath: if (outputPaths) outputPaths->push_back(std::move(r.text)); break;
+        }
+    });
+}
+
 /**
  * @brief Performs a high-visibility print of operation results categorized by sets.
  *
@@ -284,22 +304,17 @@ void handleSelectIsoFilesResults(const std::string& operation, bool& verbose,
  * @brief Identifies items present in the current search that do not exist in the cached list.
  * @return Integer count of new/different entries found.
  */
-int countDifferentEntries(const std::vector<std::string>& allIsoFiles, const std::vector<std::string>& globalIsoFileList) {
-    std::unordered_set<std::string_view> globalSet;
-    globalSet.reserve(globalIsoFileList.size());
-
-    for (const auto& file : globalIsoFileList) {
-        globalSet.insert(file);
-    }
-
-    int count = 0;
-    for (const auto& file : allIsoFiles) {
-        if (globalSet.find(file) == globalSet.end()) {
-            count++;
-        }
+int countDifferentEntries(const std::vector<std::string>& allIsoFiles, const PathList& globalIsoFileList) {
+    std::unordered_set<std::string_view> newSet(allIsoFiles.begin(), allIsoFiles.end());
+
+    std::string path;
+    for (size_t i = 0; i < globalIsoFileList.size() && !newSet.empty(); ++i) {
+        path.clear();
+        globalIsoFileList.appendPath(i, path);
+        newSet.erase(path);
     }
 
-    return count;
+    return static_cast<int>(newSet.size());
 }
 
 /**
@@ -315,7 +330,7 @@ int countDifferentEntries(const std::vector<std::string>& allIsoFiles, const std
  *   reconcile the in-memory @c globalIsoFileList with the saved disk state before
  *   any output is produced.
  * - **Persistence:** Calls @c saveToDatabase (passing @c &newISOFound, which it may
- *   mutate) unless @c GlobalState::g_operationCancelled is set.
+ *   mutate) unless the current operation was cancelled.
  * - **User Feedback:** Prints elapsed time, then a color-coded outcome from one of
  *   five branches: Cancelled; save failed with files and delta; no valid paths;
  *   files present but no delta (save not attempted or failed); no ISOs found;
@@ -371,15 +386,18 @@ void saveAndReportResultsForDatabase(std::vector<std::string>& allIsoFiles, std:
         printErrorMessages();
     }
 
-    const bool saveSuccess = GlobalState::g_operationCancelled ? false : saveToDatabase(allIsoFiles, &newISOFound);
+    const bool cancelled = Cancellation::operation().cancelled();
+    const bool saveSuccess = cancelled ? false : saveToDatabase(allIsoFiles, &newISOFound);
     const auto end_time = std::chrono::high_resolution_clock::now();
 
     const double total_elapsed = std::chrono::duration<double>(end_time - start_time).count();
     std::cout << color << "\nTime Elapsed: " << std::fixed << std::setprecision(1)
               << total_elapsed << "s\n";
 
-    if (GlobalState::g_operationCancelled) {
+    if (cancelled) {
         std::cout << "\n" << vt.green << "Database Refresh: [" << vt.yellow << "Cancelled" << vt.green << "]" << vt.bold << "\n";
+    } else if (!allIsoFiles.empty() && newISOFound && !saveSuccess && isDatabaseFull()) {
+        std::cout << "\n" << vt.red << "Database Refresh failed: [" << vt.yellow << "Database full, raise database_max_entries/database_max_mb" << vt.red << "]" << vt.bold << "\n";
     } else if (!allIsoFiles.empty() && newISOFound && !saveSuccess) {
         std::cout << "\n" << vt.red << "Database Refresh failed: [" << vt.yellow << "Unable to access the database file" << vt.red << "]" << vt.bold << "\n";
     } else if (validPaths.empty()) {
@@ -464,7 +482,7 @@ void verboseFind(std::unordered_set<std::string>& invalidDirectoryPaths, const s
  * whether the operation was cancelled.
  *
  * @details **Display branches** (all gated on
- * @c !GlobalState::g_operationCancelled.load()):
+ * the current operation not being cancelled):
  * - **Files found** (@c !fileNames.empty()): prints found count vs @p currentCacheOld.
  *   Does NOT call @c verboseFind. Not gated on @p list.
  * - **No new files, cache non-empty** (@c !newFilesFound && !files.empty() && !list):
@@ -473,7 +491,7 @@ void verboseFind(std::unordered_set<std::string>& invalidDirectoryPaths, const s
  * - **Cache empty** (@c files.empty() && !list): calls @c verboseFind, then prints
  *   0 found and 0 cached.
  *
- * If @c g_operationCancelled is set, all three branches are skipped; only elapsed
+ * If the operation was cancelled, all three branches are skipped; only elapsed
  * time and the Enter prompt are shown.
  *
  * After @c pressEnterToContinue, @c clearScrollBuffer() is called.
@@ -512,9 +530,10 @@ void verboseImageSearchResults(const std::string& fileExtension,
     const VerboseAndDatabaseTheme vt = getVerboseTheme();
 
     auto end_time = std::chrono::high_resolution_clock::now();
+    const bool cancelled = Cancellation::operation().cancelled();
 
     // Case: Files were found
-    if (!fileNames.empty() && !GlobalState::g_operationCancelled.load()) {
+    if (!fileNames.empty() && !cancelled) {
         std::cout << "\n\n"
                   << vt.green << fileNames.size() << " "
                   << vt.orange << "{" << fileExtension << "} "
@@ -525,7 +544,7 @@ void verboseImageSearchResults(const std::string& fileExtension,
     }
 
     // Case: No new files were found, but files exist in cache
-    if (!newFilesFound && !files.empty() && !list && !GlobalState::g_operationCancelled.load()) {
+    if (!newFilesFound && !files.empty() && !list && !cancelled) {
         verboseFind(invalidDirectoryPaths, directoryPaths, processedErrorsFind);
         std::cout << "\n\n"
                   << vt.red << "0 "
@@ -539,7 +558,7 @@ void verboseImageSearchResults(const std::string& fileExtension,
     }
 
     // Case: No files were found
-    if (files.empty() && !list && !GlobalState::g_operationCancelled.load()) {
+    if (files.empty() && !list && !cancelled) {
         verboseFind(invalidDirectoryPaths, directoryPaths, processedErrorsFind);
         std::cout << "\n\n"
                   << vt.red << "0" << vt.orange << " {" << fileExtension << "} "
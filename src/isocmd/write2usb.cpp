@@ -35,7 +35,8 @@
 #include <blkid/blkid.h>
 
 // Project Headers
-#include "../state.h"
+#include "../asyncIo.h"
+#include "../cancellation.h"
 #include "../write2usbUI.h"
 #include "../write2usb.h"
 
@@ -243,7 +244,7 @@ void safeUmount(const char* path) {
     // PRIORITY 1: Cancellation Path
     // If the operation is cancelled, bypass standard unmounts and
     // go straight to lazy detachment for immediate release.
-    if (GlobalState::g_operationCancelled.load()) {
+    if (Cancellation::operation().cancelled()) {
         mnt_context_enable_lazy(ctx, true);
     }
 
@@ -376,8 +377,9 @@ bool waitForDevice(const std::string& path, int timeout_seconds = 30) {
  * I/O strategy per file:
  * - **FAT32 destination files** use unbuffered Direct I/O (@c O_DIRECT) to bypass the
  *   Linux page cache.
- * - **NTFS destination files** use buffered I/O with @c posix_fallocate pre-allocation,
- *   copied via a manual read/write loop.
+ * - **NTFS destination files** use buffered I/O with @c posix_fallocate pre-allocation.
+ * - Either way the data moves through @ref copyStream, which keeps reads of the
+ *   next chunks in flight while earlier ones are written.
  *
  * Sector alignment:
  * - Both logical (@c BLKSSZGET) and physical (@c BLKPBSZGET) sector sizes are
@@ -389,7 +391,7 @@ bool waitForDevice(const std::string& path, int timeout_seconds = 30) {
  * Cancellation:
  * - Setup steps (ISO mount, wipe, partition, format, FAT/NTFS mount) treat a
  *   concurrent user cancellation as a clean abort rather than a failure: a
- *   step that errors out while @c g_operationCancelled is already set returns
+ *   step that errors out once the operation is already cancelled returns
  *   @c false without marking the operation as failed. Only genuine errors
  *   (cancellation not in effect) flip the failed flag.
  *
@@ -410,8 +412,8 @@ bool waitForDevice(const std::string& path, int timeout_seconds = 30) {
  * only lands after the data it references is already on disk.
  *
  * Cleanup strategy:
- * - All mount points and the I/O buffer are managed by RAII objects (ScopedMount,
- *   AlignedBuffer). The progress thread is managed by ThreadGuard. Every early
+ * - All mount points are managed by RAII objects (ScopedMount); @ref copyStream
+ *   owns its I/O buffers. The progress thread is managed by ThreadGuard. Every early
  *   return path is therefore cleanup-free: destructors fire in reverse declaration
  *   order automatically.
  *
@@ -425,13 +427,15 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
                              const std::string& device,
                              size_t             progressIndex)
 {
+    const CancellationToken cancel = Cancellation::operation();
+
     auto fail = [&]() -> bool {
         progressData[progressIndex].failed.store(true);
         return false;
     };
 
     auto failUnlessCancelled = [&]() -> bool {
-        if (GlobalState::g_operationCancelled.load()) return false;
+        if (cancel.cancelled()) return false;
         return fail();
     };
 
@@ -518,7 +522,7 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
                                    ? getBestSectorSize(ntfsPart)
                                    : 512;
 
-    if (GlobalState::g_operationCancelled.load()) return false;
+    if (cancel.cancelled()) return false;
 
     // ------------------------------------------------------------------ //
     // 2. Mount FAT32 partition (and NTFS for Windows installs)            //
@@ -560,7 +564,7 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
         ntfsScope.setMounted();
     }
 
-    if (GlobalState::g_operationCancelled.load()) return false;
+    if (cancel.cancelled()) return false;
 
     // ------------------------------------------------------------------ //
     // 3. Collect and classify ISO entries                                 //
@@ -607,12 +611,12 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
             else       ntfsEntries.push_back(std::move(e));
         }
     } catch (...) {
-        if (!GlobalState::g_operationCancelled.load()) return fail();
+        if (!cancel.cancelled()) return fail();
         return false;
     }
 
     if (totalBytes == 0 ) {
-        if (!GlobalState::g_operationCancelled.load()) {
+        if (!cancel.cancelled()) {
             return fail();
         } else {
             return false;
@@ -621,7 +625,7 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
     // ------------------------------------------------------------------ //
     // 4. Async progress monitoring thread                                 //
     // ------------------------------------------------------------------ //
-    std::atomic<uint64_t> totalBytesWrittenAccumulator{0};
+    std::atomic<size_t> totalBytesWrittenAccumulator{0};
     std::atomic<bool>     monitoringActive{true};
     const auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -715,21 +719,15 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
     ThreadGuard threadGuard(progressMonitorThread, monitoringActive);
 
     // ------------------------------------------------------------------ //
-    // 5. Aligned I/O buffer                                              //
+    // 5./6. Per-file copy with hybrid I/O                                //
     // ------------------------------------------------------------------ //
+    // copyStream overlaps reading the next chunks of a file with writing
+    // the previous ones; O_DIRECT destinations get sector-aligned buffers
+    // and a zero-padded last write, trimmed back below.
     constexpr size_t DESIRED_BUFFER  = 4 * 1024 * 1024;
     const int        maxSectorSize   = std::max(fatSectorSize, ntfsSectorSize);
     const size_t     bufferSize      = (DESIRED_BUFFER / maxSectorSize) * maxSectorSize;
 
-    AlignedBuffer ioBuf(bufferSize, maxSectorSize);
-    if (!ioBuf) {
-        if (!GlobalState::g_operationCancelled.load()) return fail();
-        return false;
-    }
-
-    // ------------------------------------------------------------------ //
-    // 6. Per-file copy with hybrid I/O                                   //
-    // ------------------------------------------------------------------ //
     auto copyWithProgress = [&](const fs::path& src, const fs::path& dst,
                                 uint64_t fileSize, int sectorSize) -> bool {
         const bool isNtfsDest = (isoType == IsoType::WindowsInstall) &&
@@ -749,77 +747,29 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
         if (useBufferedIO && fileSize > 0)
             posix_fallocate(fd_out, 0, static_cast<off_t>(fileSize));
 
-        const size_t mask = static_cast<size_t>(sectorSize) - 1;
+        StreamCopy job;
+        job.chunkSize      = bufferSize;
+        job.writeAlignment = useBufferedIO ? 0 : static_cast<size_t>(sectorSize);
+        job.completedBytes = &totalBytesWrittenAccumulator;
+        job.cancel         = cancel;
+        bool success = static_cast<bool>(copyStream(fd_in, fd_out, job));
 
-        bool success = true;
-        while (!GlobalState::g_operationCancelled.load()) {
-            const ssize_t bytes_read = read(fd_in, ioBuf.data, bufferSize);
-            if (bytes_read < 0) {
-                if (errno == EINTR) continue;
-                success = false;
-                break;
-            }
-            if (bytes_read == 0) break;
-
-            ssize_t writeLen = bytes_read;
-            if (!useBufferedIO) {
-                const ssize_t aligned = (bytes_read + mask) & ~static_cast<ssize_t>(mask);
-                if (aligned > bytes_read)
-                    memset(ioBuf.data + bytes_read, 0, aligned - bytes_read);
-                writeLen = aligned;
-            }
-
-            ssize_t  bytes_written    = 0;
-            uint64_t reportedThisChunk = 0; // real (non-padding) bytes already credited
-            while (bytes_written < writeLen) {
-                if (GlobalState::g_operationCancelled.load()) {
-                    success = false;
-                    goto done;
-                }
-                const ssize_t written = write(fd_out,
-                                              ioBuf.data + bytes_written,
-                                              writeLen  - bytes_written);
-                if (written < 0) {
-                    if (errno == EINTR) continue;
-                    success = false;
-                    goto done;
-                }
-                bytes_written += written;
-
-                // Report progress incrementally as each write() actually
-                // lands, rather than waiting for the whole (up to 4MiB)
-                // chunk to finish. This is what lets the monitor thread see
-                // real progress on slow devices instead of one big jump
-                // every several seconds. Cap at bytes_read so O_DIRECT
-                // alignment padding (writeLen > bytes_read) is never
-                // counted as real progress.
-                const uint64_t realBytesSoFar = static_cast<uint64_t>(
-                    std::min<ssize_t>(bytes_written, bytes_read));
-                if (realBytesSoFar > reportedThisChunk) {
-                    totalBytesWrittenAccumulator.fetch_add(
-                        realBytesSoFar - reportedThisChunk);
-                    reportedThisChunk = realBytesSoFar;
-                }
-            }
-        }
-
-    done:
         if (!useBufferedIO) {
-            if (GlobalState::g_operationCancelled.load()) {
+            if (cancel.cancelled()) {
                 [[maybe_unused]] const int r = ftruncate(fd_out, 0);
             } else if (ftruncate(fd_out, static_cast<off_t>(fileSize)) != 0) {
                 success = false;
             }
         }
 
-        if (GlobalState::g_operationCancelled.load())
+        if (cancel.cancelled())
             posix_fadvise(fd_out, 0, 0, POSIX_FADV_DONTNEED);
 
         posix_fadvise(fd_in, 0, 0, POSIX_FADV_DONTNEED);
 
         close(fd_in);
         close(fd_out);
-        return success && !GlobalState::g_operationCancelled.load();
+        return success && !cancel.cancelled();
     };
 
     // ------------------------------------------------------------------ //
@@ -829,7 +779,7 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
     // Returns false on failure or cancellation; RAII handles all cleanup.
     auto processEntries = [&](const std::vector<IsoEntry>& entries) -> bool {
         for (const auto& e : entries) {
-            if (GlobalState::g_operationCancelled.load()) return false;
+            if (cancel.cancelled()) return false;
 
             if (e.isDir) {
                 fs::create_directories(e.dst);
@@ -841,7 +791,7 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
                 const int sectorSize = toNtfs ? ntfsSectorSize : fatSectorSize;
 
                 if (!copyWithProgress(e.src, e.dst, e.size, sectorSize)) {
-                    if (!GlobalState::g_operationCancelled.load()) {
+                    if (!cancel.cancelled()) {
                         return fail();
                     } else {
                         return false;
@@ -864,7 +814,7 @@ bool writeWindowsIsoToDevice(const std::string& isoPath,
     // syncfs pushes all dirty pages at the filesystem level. safeUmount
     // (called by ScopedMount destructors) then blocks until the kernel
     // confirms all I/O has reached the device.
-    if (!GlobalState::g_operationCancelled.load()) {
+    if (!cancel.cancelled()) {
         if (isoType == IsoType::WindowsInstall) {
             const int ntfsFd = open(ntfsMnt.c_str(), O_RDONLY);
             if (ntfsFd >= 0) { syncfs(ntfsFd); close(ntfsFd); }
@@ -1121,9 +1071,9 @@ bool isWindowsIsoInitialCheck(int fd, off_t fileSize) {
  * - **Windows Path Routing:** If @ref isWindowsIsoInitialCheck passes, execution is
  * delegated to @ref writeWindowsIsoToDevice, which automatically handles multi-partitioning,
  * hybrid FAT32+NTFS tables, and cluster tuning.
- * - **Raw O_DIRECT Pipeline:** Non-Windows targets are imaged via raw unbuffered disk I/O.
- * Data transfers utilize a dedicated page-aligned memory buffer (@c posix_memalign) sized
- * to the device's effective sector boundary, derived by querying both logical sector size
+ * - **Raw O_DIRECT Pipeline:** Non-Windows targets are imaged via raw unbuffered disk I/O
+ * through @ref copyStream, which keeps ISO reads in flight while earlier chunks are written
+ * to the device. Its buffers are aligned to the device's effective sector boundary, derived by querying both logical sector size
  * (@c ioctl(BLKSSZGET)) and physical sector size (@c ioctl(BLKPBSZGET)) and taking the
  * larger of the two. This ensures correct @c O_DIRECT alignment on 512n, 512e, and 4Kn
  * drives. @c BLKPBSZGET is treated as best-effort and falls back to the logical size if
@@ -1131,12 +1081,12 @@ bool isWindowsIsoInitialCheck(int fd, off_t fileSize) {
  * @c POSIX_FADV_SEQUENTIAL is applied to the source descriptor before the write loop to
  * enable aggressive kernel read-ahead; @c POSIX_FADV_DONTNEED is applied after to release
  * the ISO from page cache once writing completes.
- * - **Tail-Block Padding:** Detects partial blocks at EOF or short reads, automatically
- * zero-padding the remaining buffer slice up to the strict sector layout boundary to prevent
- * kernel rejection errors (@c EINVAL).
- * - **Asynchronous Cancellation Safety:** Evaluates @c GlobalState::g_operationCancelled
- * at every inner loop pass. On user abort, it short-circuits execution and leaves the disk
- * safely without triggering a cascading @c fsync block.
+ * - **Tail-Block Padding:** The final chunk is zero-padded up to the sector boundary to
+ * prevent kernel rejection errors (@c EINVAL); padding is never counted as progress.
+ * - **Asynchronous Cancellation Safety:** the operation's cancellation token wakes the
+ * copy loop immediately and cancels the requests still in flight. On user abort, it
+ * short-circuits execution and leaves the disk safely without triggering a cascading
+ * @c fsync block.
  *
  * @param isoPath Absolute path to the source ISO image file on the host.
  * @param device Target destination block node path (e.g., @c /dev/sdb). WARNING: All existing
@@ -1150,6 +1100,7 @@ bool isWindowsIsoInitialCheck(int fd, off_t fileSize) {
  * @see writeWindowsIsoToDevice
  */
 bool writeIsoToDevice(const std::string& isoPath, const std::string& device, size_t progressIndex) {
+    const CancellationToken cancel = Cancellation::operation();
 
     // Open ISO once — shared by all validation and write paths
     int iso_fd = open(isoPath.c_str(), O_RDONLY);
@@ -1224,25 +1175,15 @@ bool writeIsoToDevice(const std::string& isoPath, const std::string& device, siz
         return false;
     }
 
-    // Pad file size up to sector boundary for O_DIRECT
-    const uint64_t paddedSize = ((fileSize + sectorSize - 1) / sectorSize) * sectorSize;
-
-    // Allocate aligned buffer (4 MiB, rounded down to sector boundary)
+    // Transfer size: 4 MiB, rounded down to the sector boundary
     constexpr size_t DESIRED_BUFFER = 4 * 1024 * 1024;
     size_t bufferSize = (DESIRED_BUFFER / sectorSize) * sectorSize;
     if (bufferSize == 0) bufferSize = sectorSize;
 
-    char* alignedBuffer = nullptr;
-    if (posix_memalign(reinterpret_cast<void**>(&alignedBuffer), sectorSize, bufferSize) != 0) {
-        progressData[progressIndex].failed.store(true);
-        return false;
-    }
-    std::unique_ptr<char, decltype(&free)> bufferGuard(alignedBuffer, &free);
-
     // ------------------------------------------------------------------ //
     // Asynchronous UI Status Thread Initialization                        //
     // ------------------------------------------------------------------ //
-    std::atomic<uint64_t> directBytesWrittenAccumulator{0};
+    std::atomic<size_t> directBytesWrittenAccumulator{0};
     std::atomic<bool> monitoringActive{true};
 
     auto startTime = std::chrono::high_resolution_clock::now();
@@ -1327,62 +1268,20 @@ bool writeIsoToDevice(const std::string& isoPath, const std::string& device, siz
         }
     });
 
-    uint64_t localBytesWritten = 0;
-
-    try {
-        while (localBytesWritten < paddedSize && !GlobalState::g_operationCancelled.load()) {
-            uint64_t remaining   = paddedSize - localBytesWritten;
-            size_t   bytesToRead = static_cast<size_t>(std::min<uint64_t>(bufferSize, remaining));
-
-            ssize_t bytesRead = 0;
-            while (true) {
-                bytesRead = read(iso_fd, alignedBuffer, bytesToRead);
-                if (bytesRead >= 0) break;
-                if (errno == EINTR) continue;
-                throw std::runtime_error("Read error: " + std::string(strerror(errno)));
-            }
-
-            if (bytesRead == 0) {
-                std::memset(alignedBuffer, 0, bytesToRead);
-            } else if (static_cast<size_t>(bytesRead) < bytesToRead) {
-                std::memset(alignedBuffer + bytesRead, 0, bytesToRead - bytesRead);
-            }
-
-            // Write loop — handles partial writes and EINTR
-            size_t remainingToWrite = bytesToRead;
-            char* writePtr         = alignedBuffer;
-            while (remainingToWrite > 0) {
-                ssize_t written = write(dev_fd, writePtr, remainingToWrite);
-                if (written < 0) {
-                    if (errno == EINTR) continue;
-                    throw std::runtime_error("Write error: " + std::string(strerror(errno)));
-                }
-
-                if (GlobalState::g_operationCancelled.load()) {
-                    goto user_cancelled;
-                }
-
-                remainingToWrite -= static_cast<size_t>(written);
-                writePtr         += written;
-
-                // Safely cap reported progress at the true file size bounds to hide padding modifications
-                uint64_t reportable = std::min<uint64_t>(
-                    static_cast<uint64_t>(written),
-                    fileSize - std::min(localBytesWritten, fileSize));
-
-                localBytesWritten += static_cast<size_t>(written);
-
-                directBytesWrittenAccumulator.fetch_add(reportable);
-            }
-        }
-    user_cancelled:;
-    } catch (...) {
+    // Reads of the ISO stay in flight while earlier chunks are written; the
+    // last chunk is zero-padded to the sector size, which O_DIRECT requires.
+    StreamCopy job;
+    job.length         = fileSize;
+    job.chunkSize      = bufferSize;
+    job.writeAlignment = static_cast<size_t>(sectorSize);
+    job.completedBytes = &directBytesWrittenAccumulator;
+    job.cancel         = cancel;
+    const StreamCopyResult copied = copyStream(iso_fd, dev_fd, job);
+
+    if (!copied && !cancel.cancelled()) {
         monitoringActive.store(false);
         if (progressMonitorThread.joinable()) progressMonitorThread.join();
-
-        if (!GlobalState::g_operationCancelled.load()) {
-            progressData[progressIndex].failed.store(true);
-        }
+        progressData[progressIndex].failed.store(true);
         return false;
     }
 
@@ -1393,14 +1292,14 @@ bool writeIsoToDevice(const std::string& isoPath, const std::string& device, siz
     // Drop ISO from page cache — no point keeping it after writing.
     posix_fadvise(iso_fd, 0, 0, POSIX_FADV_DONTNEED);
 
-    if (!GlobalState::g_operationCancelled.load()) {
+    if (!cancel.cancelled()) {
         if (fsync(dev_fd) != 0) {
             progressData[progressIndex].failed.store(true);
             return false;
         }
     }
 
-    if (!GlobalState::g_operationCancelled.load() && localBytesWritten >= paddedSize) {
+    if (!cancel.cancelled() && copied) {
         auto totalElapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
             std::chrono::high_resolution_clock::now() - startTime);
         double seconds  = totalElapsed.count() / 1000.0;
@@ -34,6 +34,7 @@
 #include <readline/readline.h>
 
 // Project Headers
+#include "../cancellation.h"
 #include "../display.h"
 #include "../inputHandling.h"
 #include "../pausePrompt.h"
@@ -497,7 +498,7 @@ void displayErrors();
  * @param selectedIsos ISOs chosen by the user for writing.
  * @return Validated (IsoInfo, device) pairs ready for @ref performWriteOperation,
  *         or an empty vector if the user aborted, or if the number of selected
- *         ISOs exceeds the thread pool size.
+ *         ISOs exceeds the thread pool limit.
  */
 std::vector<std::pair<IsoInfo, std::string>> collectDeviceMappings(const std::vector<IsoInfo>& selectedIsos) {
     const WriteTheme wt = getWriteTheme();
@@ -506,11 +507,11 @@ std::vector<std::pair<IsoInfo, std::string>> collectDeviceMappings(const std::ve
         TerminalStateGuard termGuard;
 
         ThreadPool& pool = getStaticThreadPool();
-        if (selectedIsos.size() > pool.threadCount()) {
+        if (selectedIsos.size() > pool.maxThreadCount()) {
             std::cout << "\n" << wt.colorFailure << "ISO selections for "
                       << UI::Palette::Yellow << "write2usb"
-                      << wt.colorFailure << " cannot exceed the current global thread pool size of "
-                      << wt.colorWarning << pool.threadCount()
+                      << wt.colorFailure << " cannot exceed the global thread pool limit of "
+                      << wt.colorWarning << pool.maxThreadCount()
                       << wt.colorFailure << "!"
                       << wt.speedCol << "\n";
 
@@ -690,7 +691,7 @@ std::vector<std::pair<IsoInfo, std::string>> collectDeviceMappings(const std::ve
 
         if (confirmation && (confirmation.get()[0] == 'y' || confirmation.get()[0] == 'Y')) {
             setupSignalHandlerCancellations();
-            GlobalState::g_operationCancelled.store(false);
+            Cancellation::beginOperation();
             return validPairs;  // termGuard destructor restores readline state
         }
 
@@ -725,10 +726,9 @@ std::vector<std::pair<IsoInfo, std::string>> collectDeviceMappings(const std::ve
  * - @b %    — Live percentage value representing active transfer progress.
  *
  * @par Cancellation (Ctrl+C / SIGINT)
- * When @ref GlobalState::g_operationCancelled is tripped:
- * -# The main thread's condition-variable wait (shared with the display thread)
- *    re-checks @ref GlobalState::g_operationCancelled at least every 500 ms and
- *    breaks as soon as it observes the flag set.
+ * When the operation's cancellation token is tripped:
+ * -# A callback on the token notifies the condition variable the main thread
+ *    and the display thread wait on, so both break at once.
  * -# The live UI render thread is flagged, notified via condition variable to wake
  *    from any in-progress wait, and joined immediately.
  * -# Terminal properties, standard input buffers, and layout configurations are restored @b instantly.
@@ -759,7 +759,7 @@ void performWriteOperation(const std::vector<std::pair<IsoInfo, std::string>>& v
     progressData.clear();
     progressData.reserve(validPairs.size());
 
-    GlobalState::g_operationCancelled.store(false);
+    const CancellationToken cancel = Cancellation::beginOperation();
 
     for (const auto& [iso, device] : validPairs) {
         progressData.push_back(ProgressInfo{
@@ -782,6 +782,13 @@ void performWriteOperation(const std::vector<std::pair<IsoInfo, std::string>>& v
     std::mutex progressCvMutex;
     std::condition_variable progressCv;
 
+    // Ctrl+C reaches the token from the signal relay thread, which can
+    // notify the waits below directly; they need no cancellation polling.
+    CancellationCallback wakeOnCancel(cancel, [&] {
+        std::lock_guard<std::mutex> lock(progressCvMutex);
+        progressCv.notify_all();
+    });
+
     ThreadPool& pool = getStaticThreadPool();
 
     disableInput();
@@ -842,7 +849,7 @@ void performWriteOperation(const std::vector<std::pair<IsoInfo, std::string>>& v
 
             if (isCompleted)                                    std::cout << wt.colorSuccess << "DONE ";
             else if (prog.failed.load())                        std::cout << wt.colorFailure << "FAIL ";
-            else if (GlobalState::g_operationCancelled.load())  std::cout << wt.colorWarning << "CXL  ";
+            else if (cancel.cancelled())                        std::cout << wt.colorWarning << "CXL  ";
             else {
                 std::string pctStr = std::to_string(pct) + "%";
                 std::cout << color << std::setw(2) << pctStr << " ";
@@ -865,7 +872,7 @@ void performWriteOperation(const std::vector<std::pair<IsoInfo, std::string>>& v
     bool isFirstUpdate = true;
     auto displayProgress = [&]() {
         while (!isProcessingComplete.load(std::memory_order_acquire) &&
-               !GlobalState::g_operationCancelled.load(std::memory_order_acquire)) {
+               !cancel.cancelled()) {
 
             // Check if all tasks are finished (succeeded or failed)
             if (finishedTasks.load() == totalTasks) {
@@ -880,14 +887,14 @@ void performWriteOperation(const std::vector<std::pair<IsoInfo, std::string>>& v
                 std::unique_lock<std::mutex> lock(progressCvMutex);
                 progressCv.wait_for(lock, std::chrono::milliseconds(500), [&] {
                     return isProcessingComplete.load(std::memory_order_acquire) ||
-                           GlobalState::g_operationCancelled.load(std::memory_order_acquire) ||
+                           cancel.cancelled() ||
                            finishedTasks.load() == totalTasks;
                 });
                 lock.unlock();
 
                 // Double check flags right after waking to prevent stale prints on quick exit
                 if (isProcessingComplete.load(std::memory_order_acquire) ||
-                    GlobalState::g_operationCancelled.load(std::memory_order_acquire)) {
+                    cancel.cancelled()) {
                     break;
                 }
             }
@@ -900,14 +907,14 @@ void performWriteOperation(const std::vector<std::pair<IsoInfo, std::string>>& v
 
     std::vector<std::future<void>> futures;
     for (size_t i = 0; i < totalTasks; ++i) {
-        futures.push_back(pool.enqueue([validPairs, i, &completedTasks, &finishedTasks, &progressCv, &progressCvMutex]() {
+        futures.push_back(pool.enqueue([validPairs, i, cancel, &completedTasks, &finishedTasks, &progressCv, &progressCvMutex]() {
             const auto& [iso, device] = validPairs[i];
             bool success = writeIsoToDevice(iso.path, device, i);
 
             if (success) {
                 progressData[i].completed.store(true);
                 completedTasks.fetch_add(1);
-            } else if (!GlobalState::g_operationCancelled.load()) {
+            } else if (!cancel.cancelled()) {
                 progressData[i].failed.store(true);
             }
             finishedTasks.fetch_add(1);
@@ -927,20 +934,13 @@ void performWriteOperation(const std::vector<std::pair<IsoInfo, std::string>>& v
     std::thread progressThread(displayProgress);
 
     // Wait for all tasks to finish, woken instantly by each task's
-    // notify_one() rather than polling each future individually. Still
-    // time-boxed to a 500ms cycle (not an unbounded wait) because
-    // g_operationCancelled is set from a SIGINT handler, which cannot
-    // safely call notify_one() — so cancellation must also be picked up
-    // by periodic re-check, not solely by notification.
+    // notify_one() rather than polling each future individually, and by
+    // wakeOnCancel on Ctrl+C.
     {
         std::unique_lock<std::mutex> lock(progressCvMutex);
-        while (finishedTasks.load() != totalTasks &&
-               !GlobalState::g_operationCancelled.load()) {
-            progressCv.wait_for(lock, std::chrono::milliseconds(500), [&] {
-                return finishedTasks.load() == totalTasks ||
-                       GlobalState::g_operationCancelled.load();
-            });
-        }
+        progressCv.wait(lock, [&] {
+            return finishedTasks.load() == totalTasks || cancel.cancelled();
+        });
     }
 
     // 1. Instantly trip the display thread break condition flags
@@ -970,7 +970,7 @@ void performWriteOperation(const std::vector<std::pair<IsoInfo, std::string>>& v
 
     // 3. Print operational results summaries directly
     std::cout << "\r" << color << "Status: " << operation << color <<" → "
-              << (!GlobalState::g_operationCancelled.load()
+              << (!cancel.cancelled()
                   ? (failedTasksValue > 0
                      ? (completedTasksValue > 0
                         ? wt.colorWarning + "PARTIAL"
@@ -1004,7 +1004,7 @@ void performWriteOperation(const std::vector<std::pair<IsoInfo, std::string>>& v
     // without copying or moving the non-copyable 'progressData' structure.
     // Each device is erased from the dirty-device set as its own future completes,
     // allowing the [FLUSHING] indicator to clear per-device as soon as draining finishes.
-    if (GlobalState::g_operationCancelled.load()) {
+    if (cancel.cancelled()) {
         std::vector<std::string> deviceNames;
         deviceNames.reserve(validPairs.size());
 
@@ -1071,7 +1071,7 @@ void writeToUsb(const std::string& input, const std::vector<std::string>& isoFil
     std::unordered_set<int> indicesToProcess;
 
     setupSignalHandlerCancellations();
-    GlobalState::g_operationCancelled.store(false);
+    Cancellation::beginOperation();
 
     tokenizeInput(input, isoFiles, indicesToProcess);
     if (indicesToProcess.empty()) {
@@ -41,8 +41,7 @@ void printMenu();
 // Primary navigation logic for the ISO list and scanning
 void submenu1(
     std::atomic<bool>& isAtISOList,
-    std::shared_ptr<RefreshState> state,
-    std::vector<std::thread>& backgroundThreads
+    std::shared_ptr<RefreshState> state
 );
 
 // Secondary navigation logic for settings and global status
@@ -14,6 +14,8 @@
 #include "display.h"
 #include "themes.h"
 
+class ResultChannel;
+
 /**
  * @brief High-performance formatter for mount-related terminal output.
  * @details Utilizes a persistent internal buffer to minimize heap allocations
@@ -113,6 +115,6 @@ private:
     }
 };
 
-void mountIsoFiles(const std::vector<std::string>& isoFiles, std::atomic<size_t>* completedTasks, std::atomic<size_t>* failedTasks, bool silentMode);
+void mountIsoFiles(const std::vector<std::string>& isoFiles, std::atomic<size_t>* completedTasks, std::atomic<size_t>* failedTasks, bool silentMode, ResultChannel& results);
 
 #endif // MOUNT_H
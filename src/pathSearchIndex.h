@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PATHSEARCHINDEX_H
+#define PATHSEARCHINDEX_H
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Project Headers
+#include "./pathTable.h"
+
+/**
+ * @class PathSearchIndex
+ * @brief Trigram posting lists over a @ref PathTable for substring filtering.
+ *
+ * Every lowercased file name and every interned directory prefix is broken
+ * into 3-byte trigrams, and each trigram keeps a sorted list of the names (or
+ * directories) containing it. A query term then narrows the table to the
+ * entries whose postings contain all of its trigrams; only those candidates
+ * are checked with the exact matcher. Directory postings are kept per
+ * interned directory, so a folder with thousands of images is indexed once.
+ *
+ * The index is immutable and refers to its table by id, so it stays valid for
+ * any @ref PathList over that table, however sorted or trimmed.
+ */
+class PathSearchIndex {
+public:
+    /// @brief Indexes every entry and directory of @p table.
+    static std::shared_ptr<const PathSearchIndex> build(std::shared_ptr<const PathTable> table);
+
+    const std::shared_ptr<const PathTable>& table() const noexcept { return table_; }
+
+    /**
+     * @brief Flags every entry that may contain one of @p terms.
+     *
+     * @param terms      Lowercased query terms (any one may match).
+     * @param namesOnly  Match file names only instead of full paths.
+     * @param marks      Resized to the table size; candidate entries are set to 1.
+     * @return false if some term is too short to answer from the index; the
+     *         caller must then scan every entry.
+     */
+    bool markCandidates(const std::vector<std::string_view>& terms, bool namesOnly,
+                        std::vector<unsigned char>& marks) const;
+
+    /// @brief Heap bytes held by the index (the table is not counted).
+    std::size_t memoryBytes() const noexcept;
+
+private:
+    /// Trigram → sorted ids, stored as one flat array with per-key offsets.
+    struct Postings {
+        std::vector<std::uint32_t> keys;
+        std::vector<std::uint32_t> offsets;
+        std::vector<std::uint32_t> ids;
+
+        std::span<const std::uint32_t> find(std::uint32_t key) const noexcept;
+    };
+
+    template <typename TextAt>
+    static Postings buildPostings(std::size_t count, const TextAt& textAt);
+
+    std::vector<std::uint32_t> lookup(const Postings& postings, std::string_view term) const;
+    void markDirectories(const std::vector<std::uint32_t>& dirs, std::vector<unsigned char>& marks) const;
+
+    std::shared_ptr<const PathTable> table_;
+    Postings names_;
+    Postings dirs_;
+    std::vector<std::uint32_t> dirEntryOffsets_;  ///< Entries of directory d: dirEntries_[off[d], off[d+1]).
+    std::vector<std::uint32_t> dirEntries_;
+};
+
+#endif // PATHSEARCHINDEX_H
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PATHTABLE_H
+#define PATHTABLE_H
+
+// C++ Standard Library Headers
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Project Headers
+#include "./caches.h"
+
+/**
+ * @class PathTable
+ * @brief Immutable, arena-backed table of file paths with interned directories.
+ *
+ * Every path is split at its last '/' into a directory prefix (trailing slash
+ * included) and a file name. Each distinct directory is stored once in one
+ * arena and every name back to back in another, so an entry costs 16 bytes
+ * plus its name instead of a separately allocated `std::string` holding the
+ * full path. With thousands of images per folder the directory prefix — most
+ * of a path — is paid once per folder.
+ *
+ * Tables are built once through @ref Builder and shared read-only through
+ * `std::shared_ptr<const PathTable>`, so any number of threads and lists can
+ * read the same table without locking or copying paths.
+ */
+class PathTable {
+public:
+    using Id = std::uint32_t;
+
+    /// @brief Collects paths and freezes them into a shared table.
+    class Builder {
+    public:
+        Builder();
+
+        void reserve(std::size_t paths, std::size_t nameBytes = 0);
+
+        /// @brief Adds @p path and returns its id (ids are consecutive from 0).
+        Id add(std::string_view path);
+
+        /// @brief Returns the finished table; the builder is left empty.
+        std::shared_ptr<const PathTable> finish();
+
+    private:
+        std::unique_ptr<PathTable> table_;
+        std::unordered_map<std::string, Id, StringViewHash, std::equal_to<>> dirIds_;
+    };
+
+    std::size_t size() const noexcept { return entries_.size(); }
+    bool empty() const noexcept { return entries_.empty(); }
+
+    /// @brief Directory prefix of @p id, including the trailing '/' (empty if none).
+    std::string_view directory(Id id) const noexcept { return directoryText(entries_[id].dir); }
+
+    /// @brief File name of @p id (everything after the last '/').
+    std::string_view name(Id id) const noexcept {
+        const Entry& e = entries_[id];
+        return {nameArena_.data() + e.nameOffset, e.nameLength};
+    }
+
+    /// @brief Interned directory index of @p id; equal ids mean equal prefixes.
+    std::uint32_t directoryId(Id id) const noexcept { return entries_[id].dir; }
+
+    std::size_t pathLength(Id id) const noexcept {
+        return dirs_[entries_[id].dir].length + entries_[id].nameLength;
+    }
+
+    /// @brief Appends the full path of @p id to @p out.
+    void appendPath(Id id, std::string& out) const {
+        out.append(directory(id)).append(name(id));
+    }
+
+    std::string path(Id id) const {
+        std::string out;
+        out.reserve(pathLength(id));
+        appendPath(id, out);
+        return out;
+    }
+
+    std::size_t directoryCount() const noexcept { return dirs_.size(); }
+
+    /// @brief Text of interned directory @p dir (see @ref directoryId).
+    std::string_view directoryText(std::uint32_t dir) const noexcept {
+        const Span& d = dirs_[dir];
+        return {dirArena_.data() + d.offset, d.length};
+    }
+
+    /// @brief Heap bytes held by the table.
+    std::size_t memoryBytes() const noexcept {
+        return entries_.capacity() * sizeof(Entry) + dirs_.capacity() * sizeof(Span) +
+               dirArena_.capacity() + nameArena_.capacity();
+    }
+
+private:
+    struct Span {
+        std::uint64_t offset;
+        std::uint32_t length;
+    };
+
+    struct Entry {
+        std::uint32_t dir;
+        std::uint32_t nameLength;
+        std::uint64_t nameOffset;
+    };
+
+    std::vector<Entry> entries_;
+    std::vector<Span>  dirs_;
+    std::string        dirArena_;
+    std::string        nameArena_;
+};
+
+/**
+ * @class PathList
+ * @brief Ordered view over a shared @ref PathTable.
+ *
+ * Holds the table by `shared_ptr` plus a vector of 32-bit ids, so copying,
+ * reordering or filtering a list never copies a path. Lists built from the
+ * same table share its storage.
+ */
+class PathList {
+public:
+    PathList() = default;
+
+    /// @brief Lists every entry of @p table in table order.
+    explicit PathList(std::shared_ptr<const PathTable> table);
+
+    std::size_t size() const noexcept { return order_.size(); }
+    bool empty() const noexcept { return order_.empty(); }
+
+    std::string_view directory(std::size_t i) const noexcept { return table_->directory(order_[i]); }
+    std::string_view name(std::size_t i) const noexcept { return table_->name(order_[i]); }
+    std::string path(std::size_t i) const { return table_->path(order_[i]); }
+    void appendPath(std::size_t i, std::string& out) const { table_->appendPath(order_[i], out); }
+
+    /// @brief Materialises the list as plain strings, for APIs that need them.
+    std::vector<std::string> toVector() const;
+
+    void clear() noexcept {
+        table_.reset();
+        std::vector<PathTable::Id>().swap(order_);
+    }
+
+    const std::shared_ptr<const PathTable>& table() const noexcept { return table_; }
+
+    /// @brief Entry ids in list order; may be reordered but must stay within the table.
+    std::vector<PathTable::Id>& order() noexcept { return order_; }
+    const std::vector<PathTable::Id>& order() const noexcept { return order_; }
+
+private:
+    std::shared_ptr<const PathTable> table_;
+    std::vector<PathTable::Id> order_;
+};
+
+#endif // PATHTABLE_H
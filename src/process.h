@@ -6,18 +6,21 @@
 // C++ Standard Library Headers
 #include <atomic>
 #include <cstddef>
-#include <mutex>
 #include <string>
 #include <vector>
 
+class ResultChannel;
+
 // --- Core File Operations (Cp, Mv, Rm, Convert) ---
 
 /**
- * Orchestrates high-level ISO file operations (Copy, Move, or Delete).
- * Tracks progress via atomic counters and ensures thread-safe path recording.
+ * Runs a batch of high-level ISO file operations (Copy, Move, or Delete), one
+ * pipeline per unit of files sharing a filename.
+ * Tracks progress via atomic counters; results go to @p results and are
+ * collected, with destination paths into @p outputPaths, before it returns.
  */
 void handleIsoFileOperation(
-    const std::vector<std::string>& isoFiles,
+    const std::vector<std::vector<std::string>>& units,
     const std::vector<std::string>& isoFilesCopy,
     const std::string& userDestDir,
     bool isMove,
@@ -27,8 +30,8 @@ void handleIsoFileOperation(
     std::atomic<size_t>* completedTasks,
     std::atomic<size_t>* failedTasks,
     bool overwriteExisting,
-    std::vector<std::string>* successfulDestPaths,
-    std::mutex* destPathsMutex
+    ResultChannel& results,
+    std::vector<std::string>* outputPaths
 );
 
 /**
@@ -43,8 +46,7 @@ void convertToISO(
     std::atomic<size_t>* completedBytes,
     std::atomic<size_t>* completedTasks,
     std::atomic<size_t>* failedTasks,
-    std::vector<std::string>* successfulOutputPaths,
-    std::mutex* outPathsMutex
+    ResultChannel& results
 );
 
 /**
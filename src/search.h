@@ -69,13 +69,11 @@ void helpSearches(bool isCpMv, bool import2ISO);
  */
 
 /**
- * @brief Retrieves and prints statistics about the SQLite database.
+ * @brief Retrieves and prints statistics about the ISO database.
  * @param databaseFilePath Path to the .db file.
- * @param maxDatabaseSize Size limit for warning thresholds.
  */
 void displayDatabaseStatistics(
-    const std::string& databaseFilePath,
-    std::uintmax_t maxDatabaseSize
+    const std::string& databaseFilePath
 );
 
 /**
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SECTORSTRIP_H
+#define SECTORSTRIP_H
+
+// C++ Standard Library Headers
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <system_error>
+
+// Project Headers
+#include "./cancellation.h"
+
+/**
+ * @brief Where the user data sits in each raw sector of a disc image.
+ *
+ * One descriptor covers every layout the converters meet: cooked 2048-byte
+ * sectors {2048, 0, 2048}, raw Mode 1 {2352, 16, 2048}, Mode 2 Form 1
+ * {2352, 24, 2048}, and the 2448-byte variants that carry 96 bytes of
+ * subchannel after each sector.
+ */
+struct SectorLayout {
+    uint32_t sectorSize = 2048;   ///< Bytes per raw sector in the image.
+    uint32_t dataOffset = 0;      ///< Offset of the user data within a sector.
+    uint32_t dataLen    = 2048;   ///< User data bytes kept per sector.
+};
+
+/**
+ * @brief Gathers the user data of @p count consecutive raw sectors at @p src
+ *        into @p dst, back to back.
+ *
+ * The common data lengths (2048, 2352) are copied with a compile-time size,
+ * which the compiler turns into straight vector loads and stores; a layout
+ * without headers or trailers is one memcpy.
+ *
+ * @return Bytes written to @p dst: @p count × dataLen.
+ */
+size_t stripSectors(const SectorLayout& layout, const char* src, size_t count, char* dst) noexcept;
+
+/// @brief One pass of @ref stripSectorStream over a range of raw sectors.
+struct SectorStrip {
+    SectorLayout layout;
+
+    uint64_t srcOffset = 0;            ///< Byte offset of the first raw sector.
+    uint64_t dstOffset = 0;            ///< Where its user data is written.
+
+    /// Raw bytes read per block, rounded down to whole sectors.
+    size_t   blockSize = 4 * 1024 * 1024;
+
+    /// When 0-255, the pass stops before the first sector whose mode byte
+    /// (offset 15 of a raw sector header) differs, for images that switch
+    /// layout mid-way.
+    int      modeByte = -1;
+
+    /// Credited with user-data bytes as each block is written.
+    std::atomic<size_t>* completedBytes = nullptr;
+
+    /// Checked between blocks; an empty token means Cancellation::operation().
+    CancellationToken cancel;
+};
+
+/// @brief Outcome of @ref stripSectorStream.
+struct SectorStripResult {
+    uint64_t sectors = 0;     ///< Raw sectors consumed.
+    uint64_t bytes = 0;       ///< User-data bytes written.
+    std::error_code error;    ///< `operation_canceled` when stopped by the cancel token.
+
+    explicit operator bool() const noexcept { return !error; }
+};
+
+/**
+ * @brief Copies the user data of every whole raw sector from @p job.srcOffset
+ *        to the end of @p inFd into @p outFd, stripping headers, ECC and
+ *        subchannel bytes on the way.
+ *
+ * Reads multi-megabyte blocks with pread(2), gathers them with
+ * @ref stripSectors into a contiguous buffer and writes that with one
+ * pwrite(2), so a DVD image costs a few hundred system calls rather than
+ * millions of stream operations. Neither descriptor's offset is used or
+ * moved. A trailing partial sector is ignored.
+ */
+SectorStripResult stripSectorStream(int inFd, int outFd, const SectorStrip& job);
+
+#endif // SECTORSTRIP_H
@@ -172,6 +172,53 @@ inline const std::vector<ConfigEntry> CONFIG_ORDERED_DEFAULTS = {
         [](const std::string& v) { return isNum(v, 0, 1000); }
     },
 
+    // --- Database Settings ---
+    {
+        "database_max_entries",
+        "1048576",
+        "Max ISO entries kept in the database",
+        "Database Settings",
+        [](const std::string& v) { return isNum(v, 1, 100000000); }
+    },
+    {
+        "database_max_mb",
+        "256",
+        "Max ISO database size in MiB (paths plus index overhead)",
+        "",
+        [](const std::string& v) { return isNum(v, 1, 1048576); }
+    },
+    {
+        "database_full_policy",
+        "lru",
+        "When full: evict least recently used entries or refuse new ones (lru/refuse)",
+        "",
+        [](const std::string& v) { return v == "lru" || v == "refuse"; }
+    },
+
+    // --- Conversion Settings ---
+    {
+        "chd_parent_search_path",
+        "none",
+        "Folders searched for the parent of a child CHD after its own folder, ':'-separated absolute paths (none to search only there)",
+        "Conversion Settings",
+        [](const std::string& v) {
+            if (v == "none") return true;
+            for (size_t start = 0;;) {
+                if (start >= v.size() || v[start] != '/') return false;
+                const size_t end = v.find(':', start);
+                if (end == std::string::npos) return true;
+                start = end + 1;
+            }
+        }
+    },
+    {
+        "chd_hunk_cache_mb",
+        "64",
+        "MiB of decoded CHD hunks shared by a conversion's workers for duplicate and parent hunks (0 to disable)",
+        "",
+        [](const std::string& v) { return isNum(v, 0, 4096); }
+    },
+
     // --- Display Modes ---
     {
         "mount_list",
@@ -213,10 +260,31 @@ inline const std::vector<ConfigEntry> CONFIG_ORDERED_DEFAULTS = {
     {
         "combined_thread_cap",
         "16",
-        "Global thread pool size limit (requires restart to apply)",
+        "Max threads the global pool grows to for I/O-bound work (requires restart to apply)",
         "Thread Configuration",
         [](const std::string& v) { return isNum(v, 1, 256); }
     },
+    {
+        "combined_thread_floor",
+        "0",
+        "Threads the global pool keeps when idle, 0 = one per core (requires restart to apply)",
+        "",
+        [](const std::string& v) { return isNum(v, 0, 256); }
+    },
+    {
+        "numa_affinity",
+        "off",
+        "Bind pool threads to NUMA nodes or shared caches and keep their I/O buffers node-local (on/off, requires restart to apply)",
+        "",
+        isOnOff
+    },
+    {
+        "hazard_scan_threshold",
+        "512",
+        "Retired queue nodes a thread holds before scanning to free them; lower bounds memory, higher scans less",
+        "",
+        [](const std::string& v) { return isNum(v, 16, 65536); }
+    },
     {
         "thread_cap_for_mount",
         "8",
@@ -273,6 +341,13 @@ inline const std::vector<ConfigEntry> CONFIG_ORDERED_DEFAULTS = {
         "",
         [](const std::string& v) { return isNum(v, 1, 64); }
     },
+    {
+        "thread_cap_for_daa_decode",
+        "4",
+        "Max threads decoding the chunks of a single DAA/GBI image",
+        "",
+        [](const std::string& v) { return isNum(v, 1, 64); }
+    },
 };
 
 #endif // SETTINGS_H
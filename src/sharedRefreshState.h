@@ -10,6 +10,9 @@
 #include <string>
 #include <vector>
 
+#include "./cancellation.h"
+#include "./threadpool.h"
+
 struct RefreshState {
     std::vector<std::string> filteredFiles;
     std::vector<std::string> pendingIndices;
@@ -23,11 +26,12 @@ struct RefreshState {
     std::condition_variable importCV;
     std::atomic<bool> isImportRunning{false};
     std::atomic<bool> isWatcherRunning{false};
-    std::atomic<bool> stopImport{false};
+    /// Runs imports one at a time at background priority; cancelled on exit.
+    TaskGroup importGroup{"auto_update import", TaskPriority::Background, 1};
+    /// Stops the import's walk. A child of the process root rather than of the
+    /// interactive operation, so Ctrl+C leaves the import running.
+    CancellationSource importCancel{Cancellation::process()};
     std::mutex printMutex;
-    std::condition_variable workerCV;
-    std::mutex workerMutex;
-    std::atomic<size_t> activeWorkers{0};
 };
 
 #endif // SHAREDREFRESHSTATE_H
@@ -7,12 +7,24 @@
 #include <string>
 #include <vector>
 
+class PathList;
+
 /**
  * Performs an in-place, case-insensitive lexicographical sort on a vector of strings.
  * Useful for ensuring file lists appear in alphabetical order regardless of casing.
  */
 void sortFilesCaseInsensitive(std::vector<std::string>& files);
 
+/**
+ * Same ordering for paths held by pointer (the display order of an image cache).
+ */
+void sortFilesCaseInsensitive(std::vector<const std::string*>& files);
+
+/**
+ * Same ordering for a PathList; only its ids are reordered.
+ */
+void sortFilesCaseInsensitive(PathList& files);
+
 /**
  * Adjusts the global or local sorting state specifically for "filename-only" display modes.
  * This typically ensures that path prefixes do not interfere with the alphabetical 
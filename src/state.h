@@ -12,6 +12,8 @@
 #include <vector>
 
 // Project Headers
+#include "./imageFileCache.h"
+#include "./pathTable.h"
 #include "./sharedRefreshState.h"
 
 /**
@@ -40,10 +42,13 @@ namespace GlobalState {
 
     // File Paths
     inline const std::string databaseDirectory = std::string(std::getenv("HOME") ? std::getenv("HOME") : "") + "/.local/share/isocmd/database/";
-    inline const std::string databaseFilename  = "iso_commander_database.txt";
+    inline const std::string databaseFilename  = "iso_commander_database.db";
     inline const std::string databaseFilePath  = databaseDirectory + databaseFilename;
+    inline const std::string legacyDatabaseFilename = "iso_commander_database.txt";
+    inline const std::string legacyDatabaseFilePath = databaseDirectory + legacyDatabaseFilename;
     inline const std::string historyFilePath   = databaseDirectory + "iso_commander_path_database.txt";
     inline const std::string filterHistoryFilePath = databaseDirectory + "iso_commander_filter_database.txt";
+    inline const std::string dirSnapshotFilePath = databaseDirectory + "iso_commander_dir_snapshot.txt";
 
     inline const std::string configDirectory = std::string(std::getenv("HOME") ? std::getenv("HOME") : "") + "/.config/isocmd/";
     inline const std::string configPath = configDirectory + "config";
@@ -52,11 +57,17 @@ namespace GlobalState {
     inline int MAX_HISTORY_LINES         = 100;
     inline int MAX_HISTORY_PATTERN_LINES = 50;
 
-    inline constexpr uintmax_t maxDatabaseSize = 1024 * 1024 * 1; // 1MB
+    // ISO database capacity (database_max_entries / database_max_mb / database_full_policy)
+    inline size_t    databaseMaxEntries     = 1048576;
+    inline uintmax_t databaseMaxBytes       = 256ull * 1024 * 1024;
+    inline bool      databaseRefuseWhenFull = false;
+
+    // CHD conversion (chd_parent_search_path / chd_hunk_cache_mb)
+    inline std::vector<std::string> chdParentSearchDirs;
+    inline size_t    chdHunkCacheBytes      = 64ull * 1024 * 1024;
 
     // State Management
     inline std::atomic<bool> isoListDirty{true};
-    inline std::atomic<bool> g_operationCancelled{false};
     inline std::atomic<bool> g_pendingMenuRefresh{false};
     inline std::atomic<PendingRefreshKind> g_pendingRefreshKind{PendingRefreshKind::None};
     inline std::shared_ptr<RefreshState> g_pendingRefreshState{nullptr};
@@ -66,13 +77,15 @@ namespace GlobalState {
     inline int lockFileDescriptor         = -1;
 
 
-    // Global vector state
-    inline std::vector<std::string> globalIsoFileList;
-    inline std::vector<std::string> binImgFilesCache;
-    inline std::vector<std::string> mdfMdsFilesCache;
-    inline std::vector<std::string> nrgFilesCache;
-    inline std::vector<std::string> chdFilesCache;
-    inline std::vector<std::string> daaGbiFilesCache;
+    // ISO database contents, interned (guarded by GlobalMutexes::updateListMutex)
+    inline PathList globalIsoFileList;
+
+    // Disc image RAM caches (internally synchronised)
+    inline ImageFileCache binImgFilesCache;
+    inline ImageFileCache mdfMdsFilesCache;
+    inline ImageFileCache nrgFilesCache;
+    inline ImageFileCache chdFilesCache;
+    inline ImageFileCache daaGbiFilesCache;
 
 } // namespace GlobalState
 
@@ -0,0 +1,23 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SUBSTRINGSEARCH_H
+#define SUBSTRINGSEARCH_H
+
+// C++ Standard Library Headers
+#include <string_view>
+
+/**
+ * @brief Reports whether @p needle occurs in @p haystack.
+ *
+ * Vectorised (AVX2 or SSE2, picked at load time through function
+ * multiversioning, with a scalar build for other targets): 16 or 32 candidate
+ * positions are tested at once against the needle's first and last bytes, and
+ * only the positions where both match have their middle compared.
+ *
+ * With @p ignoreCase, ASCII letters in @p haystack are folded to lower case as
+ * they are read, so no lowered copy is made; @p needle must already be lower
+ * case. Allocates nothing.
+ */
+bool containsSubstring(std::string_view haystack, std::string_view needle, bool ignoreCase);
+
+#endif // SUBSTRINGSEARCH_H
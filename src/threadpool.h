@@ -5,33 +5,58 @@
 
 // C++ Standard Library Headers
 #include <algorithm>
+#include <array>
 #include <atomic>
+#include <bit>
+#include <chrono>
+#include <condition_variable>
+#include <coroutine>
 #include <cstddef>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <deque>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <stdexcept>
+#include <string>
 #include <thread>
 #include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+// C / System Headers
+#include <pthread.h>
+#include <unistd.h>
+
 // Project Headers
 #include "./concurrency.h"
+#include "./cpuTopology.h"
 
 /**
  * @file thread_pool.hpp
  * @brief Lock-free thread pool with type-erased move-only tasks.
  *
- * Provides four cooperative components:
+ * Provides nine cooperative components:
  *  - @ref MoveOnlyTask       – a small-buffer-optimised, move-only type-erased callable.
+ *  - @ref ObjectPool         – per-thread slot caches that recycle queue nodes and tasks.
  *  - @ref HazardPointerDomain – a process-wide hazard-pointer registry providing safe
  *                                deferred reclamation for lock-free node-based structures.
  *  - @ref LockFreeQueue      – a Michael–Scott lock-free FIFO queue built on raw
  *                                `atomic<Node*>`, reclaiming retired nodes via hazard pointers.
- *  - @ref ThreadPool         – a fully lock-free worker-thread pool built on the two above.
+ *  - @ref WorkStealingDeque  – a Chase–Lev deque: owner pushes/pops at the bottom,
+ *                                other threads steal from the top.
+ *  - @ref MpscChannel        – a bounded, segmented channel many tasks push results
+ *                                into without locks while one thread drains it.
+ *  - @ref ThreadPool         – a fully lock-free worker-thread pool built on the above.
+ *  - @ref TaskGroup          – a named batch of pool tasks with a priority, a
+ *                                concurrency limit and unit cancellation.
+ *  - @ref PipelineTask       – a coroutine run as a chain of TaskGroup tasks, one per
+ *                                stage, started and awaited through a @ref PipelineScope.
  *
  * @note Requires C++20 (`std::atomic::wait` / `notify_*`).
  *
@@ -221,6 +246,146 @@ private:
     }
 };
 
+// ─────────────────────────────────────────────────────────────────────────────
+//  ObjectPool
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * @class ObjectPool
+ * @brief Recycles fixed-size slots for one type, so queue nodes and queued
+ *        tasks cost no heap allocation in steady state.
+ *
+ * Each thread keeps a private free list (a "magazine") and allocates from and
+ * frees into it without synchronisation. When a magazine runs dry it takes a
+ * whole batch of @ref BATCH slots from a shared depot, and when it grows past
+ * two batches it hands one back, so the depot's mutex is taken once per
+ * @ref BATCH operations at most. That suits the pool's traffic pattern, where
+ * the submitting thread allocates and a worker frees: batches flow back to
+ * the submitter through the depot.
+ *
+ * Slots are carved from blocks that are never returned to the system; the
+ * pool holds at most its high-water mark. The depot is deliberately never
+ * destroyed so that worker threads exiting during static destruction can
+ * still return their slots.
+ *
+ * @tparam T Object type; @ref create placement-constructs it in a slot.
+ */
+template <typename T>
+class ObjectPool {
+public:
+    static constexpr std::size_t BATCH = 64;
+
+    template <typename... Args>
+    static T* create(Args&&... args) {
+        return ::new (acquire()) T(std::forward<Args>(args)...);
+    }
+
+    static void destroy(T* object) noexcept {
+        object->~T();
+        release(object);
+    }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    struct Chain {
+        Slot* head;
+        std::size_t count;
+    };
+
+    struct Depot {
+        std::mutex mutex;
+        std::vector<Chain> chains;
+        std::vector<std::unique_ptr<Slot[]>> blocks;
+
+        void pushChain(Chain chain) {
+            std::lock_guard<std::mutex> lock(mutex);
+            chains.push_back(chain);
+        }
+    };
+
+    /// Trivially destructible, so it stays usable while the thread's other
+    /// thread_local destructors (hazard-pointer retire lists) free into it.
+    struct Magazine {
+        Slot* head;
+        std::size_t count;
+        bool closed;   ///< Thread is exiting: frees go straight to the depot.
+    };
+
+    /// Returns the thread's magazine to the depot at thread exit.
+    struct MagazineCloser {
+        ~MagazineCloser() {
+            Magazine& m = magazine();
+            if (m.head) depot().pushChain({m.head, m.count});
+            m = {nullptr, 0, true};
+        }
+    };
+
+    static Depot& depot() {
+        static Depot* instance = new Depot();
+        return *instance;
+    }
+
+    static Magazine& magazine() noexcept {
+        static thread_local Magazine m{nullptr, 0, false};
+        return m;
+    }
+
+    static void* acquire() {
+        Magazine& m = magazine();
+        if (!m.head) refill(m);
+        Slot* slot = m.head;
+        m.head = slot->next;
+        --m.count;
+        return slot->bytes;
+    }
+
+    static void release(void* p) noexcept {
+        Slot* slot = static_cast<Slot*>(p);
+        Magazine& m = magazine();
+        if (m.closed) {
+            slot->next = nullptr;
+            depot().pushChain({slot, 1});
+            return;
+        }
+        slot->next = m.head;
+        m.head = slot;
+        if (++m.count >= 2 * BATCH) {
+            Slot* first = m.head;
+            Slot* last = first;
+            for (std::size_t i = 1; i < BATCH; ++i) last = last->next;
+            m.head = last->next;
+            m.count -= BATCH;
+            last->next = nullptr;
+            depot().pushChain({first, BATCH});
+        }
+    }
+
+    /// Takes a batch from the depot, carving a fresh block if it has none.
+    static void refill(Magazine& m) {
+        static thread_local MagazineCloser closer;
+        (void)closer;
+
+        Depot& d = depot();
+        std::lock_guard<std::mutex> lock(d.mutex);
+        if (!d.chains.empty()) {
+            m.head = d.chains.back().head;
+            m.count = d.chains.back().count;
+            d.chains.pop_back();
+            return;
+        }
+        d.blocks.emplace_back(new Slot[BATCH]);
+        Slot* block = d.blocks.back().get();
+        for (std::size_t i = 0; i + 1 < BATCH; ++i) block[i].next = &block[i + 1];
+        block[BATCH - 1].next = nullptr;
+        m.head = block;
+        m.count = BATCH;
+    }
+};
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  HazardPointerDomain
 // ─────────────────────────────────────────────────────────────────────────────
@@ -256,7 +421,8 @@ private:
  *  2. A thread that logically removes a node never `delete`s it directly.
  *     It calls @ref retire, which appends the node to that thread's private
  *     retire list.
- *  3. Once a thread's retire list grows past a threshold, it scans every
+ *  3. Once a thread's retire list grows past a threshold (see
+ *     @ref setRetireThreshold), it scans every
  *     *active* hazard-pointer record in the whole process, unions all
  *     currently-published addresses into one set, and only `delete`s the
  *     retired nodes that are **not** in that set. Anything still hazarded is
@@ -267,6 +433,10 @@ private:
  * dereference it — and every operation involved (`load`, `store`, CAS on the
  * hazard slots and on the registry's intrusive list) is itself lock-free.
  *
+ * Retired, reclaimed and orphaned node counts and scan times are kept in
+ * @ref statistics, so the bound can be checked under load (the `*stats` view
+ * prints them).
+ *
  * @note This is a compact, self-contained implementation intended for use by
  *       @ref LockFreeQueue. It is not a general-purpose replacement for
  *       `<experimental/hazard_pointer>` — in particular its retire-list scan
@@ -283,6 +453,33 @@ public:
     /// and `next` (the node whose data is being extracted).
     static constexpr std::size_t HAZARDS_PER_THREAD = 2;
 
+    /// @brief A generous upper bound on concurrent threads, used to size scans.
+    static constexpr std::size_t MAX_EXPECTED_THREADS = 128;
+
+    /// @brief Default retire-list length that triggers a reclamation scan:
+    /// even at @ref MAX_EXPECTED_THREADS, no more than a small multiple of
+    /// (threads × HAZARDS_PER_THREAD) retired nodes are outstanding at once.
+    static constexpr std::size_t DEFAULT_RETIRE_THRESHOLD = 2 * MAX_EXPECTED_THREADS * HAZARDS_PER_THREAD;
+    static constexpr std::size_t MIN_RETIRE_THRESHOLD = 16;
+
+    /// @brief Cumulative reclamation counters, see @ref statistics.
+    struct Statistics {
+        uint64_t retired = 0;      ///< Handed to @ref retire (counted at each thread's next scan).
+        uint64_t reclaimed = 0;    ///< Freed by a scan or at thread exit.
+        uint64_t orphaned = 0;     ///< Still hazarded when their thread exited.
+        uint64_t adopted = 0;      ///< Orphans taken over by a later scan.
+        uint64_t scans = 0;
+        uint64_t scanNsTotal = 0;
+        uint64_t scanNsMax = 0;
+        uint64_t largestScan = 0;  ///< Most nodes examined by one scan.
+        std::size_t threshold = 0;
+        std::size_t records = 0;   ///< Hazard records ever allocated (thread high-water mark).
+        std::size_t activeRecords = 0;
+
+        /// @brief Retired but not yet freed, as of the last scans (orphans included).
+        uint64_t pending() const noexcept { return retired > reclaimed ? retired - reclaimed : 0; }
+    };
+
     /// @brief One record per thread that has ever touched the queue, reused
     /// across a thread's lifetime and recyclable once a thread exits.
     struct HPRecord {
@@ -349,7 +546,7 @@ public:
      * @brief Defers reclamation of @p p until no hazard pointer protects it.
      *
      * Adds @p p to the calling thread's private retire list; once that list
-     * grows past @ref RETIRE_THRESHOLD entries, triggers a scan that frees
+     * grows past @ref retireThreshold entries, triggers a scan that frees
      * every retired node not currently published in any active hazard slot.
      *
      * @tparam T   Node type (deduced).
@@ -358,28 +555,82 @@ public:
      */
     template <typename T>
     void retire(T* p) {
+        retire(p, [](void* q) { delete static_cast<T*>(q); });
+    }
+
+    /// @brief As above, but reclaims @p p through @p reclaim instead of `delete`
+    ///        (e.g. to hand a node back to its @ref ObjectPool).
+    void retire(void* p, void (*reclaim)(void*)) {
         auto& list = retireList();
         list.ptrs.push_back(p);
-        list.deleters.push_back([](void* q) { delete static_cast<T*>(q); });
-        if (list.ptrs.size() >= RETIRE_THRESHOLD) {
+        list.deleters.push_back(reclaim);
+        ++list.unreported;
+        if (list.ptrs.size() >= retire_threshold_.load(std::memory_order_relaxed)) {
             scanAndReclaim();
         }
     }
 
+    /**
+     * @brief Sets the retire-list length that triggers a scan (clamped to at
+     *        least @ref MIN_RETIRE_THRESHOLD). Takes effect on each thread's next retire.
+     *
+     * Lower values bound unreclaimed memory more tightly at the cost of more
+     * frequent scans, each O(list length × active records).
+     */
+    void setRetireThreshold(std::size_t n) noexcept {
+        retire_threshold_.store(std::max(n, MIN_RETIRE_THRESHOLD), std::memory_order_relaxed);
+    }
+
+    std::size_t retireThreshold() const noexcept {
+        return retire_threshold_.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Snapshot of the reclamation counters and the record registry.
+    Statistics statistics() const {
+        Statistics s;
+        s.retired     = counters_.retired.load(std::memory_order_relaxed);
+        s.reclaimed   = counters_.reclaimed.load(std::memory_order_relaxed);
+        s.orphaned    = counters_.orphaned.load(std::memory_order_relaxed);
+        s.adopted     = counters_.adopted.load(std::memory_order_relaxed);
+        s.scans       = counters_.scans.load(std::memory_order_relaxed);
+        s.scanNsTotal = counters_.scan_ns.load(std::memory_order_relaxed);
+        s.scanNsMax   = counters_.max_scan_ns.load(std::memory_order_relaxed);
+        s.largestScan = counters_.largest_scan.load(std::memory_order_relaxed);
+        s.threshold   = retireThreshold();
+        for (HPRecord* rec = head_.load(std::memory_order_acquire); rec; rec = rec->next.load(std::memory_order_acquire)) {
+            ++s.records;
+            if (rec->active.load(std::memory_order_relaxed)) ++s.activeRecords;
+        }
+        return s;
+    }
+
 private:
-    /// @brief Batch size that triggers a reclamation scan. Sized relative to
-    /// a generous upper bound on concurrent threads so that, even at that
-    /// bound, no more than a small multiple of (threads × HAZARDS_PER_THREAD)
-    /// retired nodes are ever outstanding at once.
-    static constexpr std::size_t MAX_EXPECTED_THREADS = 128;
-    static constexpr std::size_t RETIRE_THRESHOLD = 2 * MAX_EXPECTED_THREADS * HAZARDS_PER_THREAD;
+    std::atomic<std::size_t> retire_threshold_{DEFAULT_RETIRE_THRESHOLD};
+
+    /// Updated once per scan rather than per retire, so retiring stays free of
+    /// shared writes; per-thread retire counts are folded in at each scan.
+    struct alignas(64) Counters {
+        std::atomic<uint64_t> retired{0};
+        std::atomic<uint64_t> reclaimed{0};
+        std::atomic<uint64_t> orphaned{0};
+        std::atomic<uint64_t> adopted{0};
+        std::atomic<uint64_t> scans{0};
+        std::atomic<uint64_t> scan_ns{0};
+        std::atomic<uint64_t> max_scan_ns{0};
+        std::atomic<uint64_t> largest_scan{0};
+    } counters_;
+
+    static void raiseTo(std::atomic<uint64_t>& max, uint64_t value) noexcept {
+        uint64_t seen = max.load(std::memory_order_relaxed);
+        while (seen < value && !max.compare_exchange_weak(seen, value, std::memory_order_relaxed)) {}
+    }
 
     /**
      * @brief Per-thread retire list.
      *
      * @par Thread-exit leak fix
      * A thread that retires only a handful of nodes (fewer than
-     * @ref RETIRE_THRESHOLD) and then exits would, under the original
+     * @ref retireThreshold) and then exits would, under the original
      * design, simply drop that list — the pointers it held were never
      * freed, because nothing but @ref retire's threshold check ever
      * triggered a scan. Confirmed by AddressSanitizer's LeakSanitizer:
@@ -401,10 +652,12 @@ private:
     struct RetireList {
         std::vector<void*> ptrs;
         std::vector<void (*)(void*)> deleters;
+        std::vector<void*> guarded;   ///< Scan scratch, reused so scans don't allocate.
+        uint64_t unreported = 0;      ///< Retired since the last scan, not yet in the counters.
 
         ~RetireList() {
             if (!ptrs.empty()) {
-                HazardPointerDomain::instance().reclaimOnThreadExit(ptrs, deleters);
+                HazardPointerDomain::instance().reclaimOnThreadExit(*this);
             }
         }
     };
@@ -446,10 +699,10 @@ private:
     /**
      * @brief Collects every address currently published in any active
      *        hazard-pointer slot, process-wide.
-     * @return Sorted vector suitable for `std::binary_search`.
+     * @param guarded  Filled sorted, suitable for `std::binary_search`.
      */
-    std::vector<void*> collectGuardedAddresses() {
-        std::vector<void*> guarded;
+    void collectGuardedAddresses(std::vector<void*>& guarded) {
+        guarded.clear();
         guarded.reserve(MAX_EXPECTED_THREADS * HAZARDS_PER_THREAD);
         HPRecord* rec = head_.load(std::memory_order_acquire);
         while (rec) {
@@ -462,7 +715,6 @@ private:
             rec = rec->next.load(std::memory_order_acquire);
         }
         std::sort(guarded.begin(), guarded.end());
-        return guarded;
     }
 
     /**
@@ -512,20 +764,25 @@ private:
      *        list at thread-exit time, called from @ref RetireList's
      *        destructor. Anything still hazarded goes to the orphan stack.
      */
-    void reclaimOnThreadExit(std::vector<void*>& ptrs, std::vector<void (*)(void*)>& deleters) {
-        std::vector<void*> guarded = collectGuardedAddresses();
+    void reclaimOnThreadExit(RetireList& list) {
+        collectGuardedAddresses(list.guarded);
 
         std::vector<void*> leftover_ptrs;
         std::vector<void (*)(void*)> leftover_deleters;
-        for (std::size_t i = 0; i < ptrs.size(); ++i) {
-            if (std::binary_search(guarded.begin(), guarded.end(), ptrs[i])) {
-                leftover_ptrs.push_back(ptrs[i]);
-                leftover_deleters.push_back(deleters[i]);
+        for (std::size_t i = 0; i < list.ptrs.size(); ++i) {
+            if (std::binary_search(list.guarded.begin(), list.guarded.end(), list.ptrs[i])) {
+                leftover_ptrs.push_back(list.ptrs[i]);
+                leftover_deleters.push_back(list.deleters[i]);
             } else {
-                deleters[i](ptrs[i]);
+                list.deleters[i](list.ptrs[i]);
             }
         }
         pushOrphans(leftover_ptrs, leftover_deleters);
+
+        counters_.retired.fetch_add(list.unreported, std::memory_order_relaxed);
+        counters_.reclaimed.fetch_add(list.ptrs.size() - leftover_ptrs.size(), std::memory_order_relaxed);
+        counters_.orphaned.fetch_add(leftover_ptrs.size(), std::memory_order_relaxed);
+        list.unreported = 0;
     }
 
     /**
@@ -535,30 +792,42 @@ private:
      * Also adopts and attempts to reclaim anything sitting in the global
      * orphan stack (see @ref reclaimOnThreadExit), so nodes left behind by
      * an exited thread are guaranteed to eventually be freed by whichever
-     * thread next crosses its own @ref RETIRE_THRESHOLD.
+     * thread next crosses its own @ref retireThreshold.
      */
     void scanAndReclaim() {
+        const auto begin = std::chrono::steady_clock::now();
         auto& list = retireList();
 
+        const std::size_t own = list.ptrs.size();
         adoptOrphans(list.ptrs, list.deleters);
+        const std::size_t examined = list.ptrs.size();
 
-        std::vector<void*> guarded = collectGuardedAddresses();
-
-        std::vector<void*> stillRetired;
-        std::vector<void (*)(void*)> stillDeleters;
-        stillRetired.reserve(list.ptrs.size());
-        stillDeleters.reserve(list.deleters.size());
+        collectGuardedAddresses(list.guarded);
 
+        // Compact survivors in place; the list keeps its capacity between scans.
+        std::size_t kept = 0;
         for (std::size_t i = 0; i < list.ptrs.size(); ++i) {
-            if (std::binary_search(guarded.begin(), guarded.end(), list.ptrs[i])) {
-                stillRetired.push_back(list.ptrs[i]);
-                stillDeleters.push_back(list.deleters[i]);
+            if (std::binary_search(list.guarded.begin(), list.guarded.end(), list.ptrs[i])) {
+                list.ptrs[kept] = list.ptrs[i];
+                list.deleters[kept] = list.deleters[i];
+                ++kept;
             } else {
                 list.deleters[i](list.ptrs[i]);
             }
         }
-        list.ptrs.swap(stillRetired);
-        list.deleters.swap(stillDeleters);
+        list.ptrs.resize(kept);
+        list.deleters.resize(kept);
+
+        const auto ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - begin).count());
+        counters_.retired.fetch_add(list.unreported, std::memory_order_relaxed);
+        counters_.reclaimed.fetch_add(examined - kept, std::memory_order_relaxed);
+        counters_.adopted.fetch_add(examined - own, std::memory_order_relaxed);
+        counters_.scans.fetch_add(1, std::memory_order_relaxed);
+        counters_.scan_ns.fetch_add(ns, std::memory_order_relaxed);
+        raiseTo(counters_.max_scan_ns, ns);
+        raiseTo(counters_.largest_scan, examined);
+        list.unreported = 0;
     }
 };
 
@@ -668,7 +937,7 @@ public:
      * @brief Constructs an empty queue with a single sentinel node.
      */
     LockFreeQueue() {
-        Node* dummy = new Node();
+        Node* dummy = ObjectPool<Node>::create();
         head.store(dummy, std::memory_order_relaxed);
         tail.store(dummy, std::memory_order_relaxed);
     }
@@ -688,7 +957,7 @@ public:
         Node* node = head.load(std::memory_order_relaxed);
         while (node) {
             Node* next = node->next.load(std::memory_order_relaxed);
-            delete node;
+            ObjectPool<Node>::destroy(node);
             node = next;
         }
     }
@@ -699,7 +968,7 @@ public:
     /**
      * @brief Appends @p value to the back of the queue.
      *
-     * Allocates a new node, then uses a CAS loop to link it after the current
+     * Takes a node from @ref ObjectPool, then uses a CAS loop to link it after the current
      * tail.  If the tail pointer has fallen behind (another thread enqueued but
      * did not yet swing the tail), this thread helps advance it first.
      *
@@ -711,7 +980,7 @@ public:
      * @param value The value to enqueue.  Moved into the new node.
      */
     void enqueue(T value) {
-        Node* new_node = new Node(std::move(value));
+        Node* new_node = ObjectPool<Node>::create(std::move(value));
         auto* hp = localHPRecord();
 
         while (true) {
@@ -797,7 +1066,7 @@ public:
                         result = std::move(next->data);
                         hp->hazards[0].store(nullptr, std::memory_order_release);
                         hp->hazards[1].store(nullptr, std::memory_order_release);
-                        HazardPointerDomain::instance().retire(first);
+                        HazardPointerDomain::instance().retire(first, &recycleNode);
                         return true;
                     }
                 }
@@ -807,6 +1076,10 @@ public:
     }
 
 private:
+    static void recycleNode(void* node) {
+        ObjectPool<Node>::destroy(static_cast<Node*>(node));
+    }
+
     /**
      * @brief Emits a CPU spin-loop hint or yields the thread.
      */
@@ -819,18 +1092,328 @@ private:
     }
 };
 
+// ─────────────────────────────────────────────────────────────────────────────
+//  WorkStealingDeque
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * @class WorkStealingDeque
+ * @brief Chase–Lev work-stealing deque of pointers (Lê et al., PPoPP 2013).
+ *
+ * Exactly one thread, the owner, calls @ref push and @ref pop; both work on
+ * the bottom end and touch no shared cache line unless the deque is nearly
+ * empty. Any thread may call @ref steal, which takes from the top with one
+ * CAS. The owner therefore sees LIFO order (hot caches for nested fan-out)
+ * and thieves FIFO order (the oldest, usually largest, work).
+ *
+ * The owner's bottom store in @ref pop and the thief's loads in @ref steal
+ * are sequentially consistent in place of the paper's standalone fences, which
+ * ThreadSanitizer cannot model.
+ *
+ * The ring grows by doubling when full. A replaced ring may still be read by
+ * a concurrent thief, so it is kept until the deque is destroyed; the rings
+ * form a geometric series, so this costs at most the live ring's size again.
+ *
+ * @tparam T Pointee type; the deque stores `T*` and never owns them.
+ */
+template <typename T>
+class WorkStealingDeque {
+private:
+    struct Ring {
+        const int64_t capacity;   ///< Power of two.
+        std::unique_ptr<std::atomic<T*>[]> slots;
+
+        explicit Ring(int64_t cap) : capacity(cap), slots(new std::atomic<T*>[static_cast<size_t>(cap)]) {}
+
+        T* get(int64_t i) const noexcept { return slots[i & (capacity - 1)].load(std::memory_order_relaxed); }
+        void put(int64_t i, T* v) noexcept { slots[i & (capacity - 1)].store(v, std::memory_order_relaxed); }
+    };
+
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    alignas(64) std::atomic<Ring*> ring;
+    std::vector<std::unique_ptr<Ring>> rings;   ///< Owner-only; keeps retired rings alive.
+
+public:
+    explicit WorkStealingDeque(int64_t initialCapacity = 256) {
+        rings.emplace_back(std::make_unique<Ring>(initialCapacity));
+        ring.store(rings.back().get(), std::memory_order_relaxed);
+    }
+
+    WorkStealingDeque(const WorkStealingDeque&) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque&) = delete;
+
+    /// @brief Owner only: pushes @p item at the bottom.
+    void push(T* item) {
+        const int64_t b = bottom.load(std::memory_order_relaxed);
+        const int64_t t = top.load(std::memory_order_acquire);
+        Ring* r = ring.load(std::memory_order_relaxed);
+
+        if (b - t > r->capacity - 1) {
+            auto bigger = std::make_unique<Ring>(r->capacity * 2);
+            for (int64_t i = t; i < b; ++i) bigger->put(i, r->get(i));
+            r = bigger.get();
+            rings.push_back(std::move(bigger));
+            ring.store(r, std::memory_order_release);
+        }
+        r->put(b, item);
+        bottom.store(b + 1, std::memory_order_release);
+    }
+
+    /// @brief Owner only: pops the most recently pushed item, or null if empty.
+    T* pop() {
+        const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        Ring* r = ring.load(std::memory_order_relaxed);
+        bottom.store(b, std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_seq_cst);
+
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        T* item = r->get(b);
+        if (t == b) {
+            // Last item: race thieves for it.
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                item = nullptr;
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+        return item;
+    }
+
+    /// @brief Any thread: takes the oldest item, or null if empty or lost to a race.
+    T* steal() {
+        int64_t t = top.load(std::memory_order_seq_cst);
+        const int64_t b = bottom.load(std::memory_order_seq_cst);
+        if (t >= b) return nullptr;
+
+        T* item = ring.load(std::memory_order_acquire)->get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return item;
+    }
+
+    /// @brief Approximate; exact only when no other thread is using the deque.
+    bool empty() const noexcept {
+        return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+    }
+};
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  MpscChannel
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * @class MpscChannel
+ * @brief Bounded multi-producer, single-consumer channel.
+ *
+ * Any number of threads call @ref push; exactly one thread at a time calls
+ * @ref drain. A push claims a position with one `fetch_add` on the tail,
+ * constructs the value in that position's slot and publishes it by bumping
+ * the slot's sequence number (Vyukov's bounded queue); producers never take
+ * a lock or contend on anything but the tail counter. The consumer walks the
+ * slots from the head, moving out every published value, and recycles each
+ * slot for the producer one lap ahead.
+ *
+ * Slots live in fixed segments of @c SEGMENT_SLOTS that are allocated the
+ * first time a producer reaches them, so a large channel that only ever
+ * carries a few results costs a few segments. Segments are never moved or
+ * freed before the channel is destroyed, so no reclamation scheme is needed.
+ *
+ * When the channel is full a producer sleeps on its slot's sequence number
+ * (`std::atomic::wait`) until the consumer drains past it. The consumer must
+ * therefore drain concurrently with producers that can fill the channel —
+ * see @ref TaskGroup::wait(Poll&&, std::chrono::milliseconds) — or size the
+ * channel for everything it will be sent.
+ *
+ * @tparam T Move-constructible value type.
+ */
+template <typename T>
+class MpscChannel {
+public:
+    static constexpr size_t SEGMENT_SLOTS = 64;
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+    /// @param capacity Rounded up to a power of two of at least @c SEGMENT_SLOTS.
+    explicit MpscChannel(size_t capacity = DEFAULT_CAPACITY)
+        : capacity_(std::bit_ceil(std::max(capacity, SEGMENT_SLOTS))),
+          segments_(new std::atomic<Segment*>[capacity_ / SEGMENT_SLOTS]) {
+        for (size_t s = 0; s < capacity_ / SEGMENT_SLOTS; ++s)
+            segments_[s].store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~MpscChannel() {
+        const uint64_t tail = tail_.load(std::memory_order_acquire);
+        for (uint64_t pos = head_; pos != tail; ++pos) {
+            Slot& slot = slotAt(pos);
+            if (slot.seq.load(std::memory_order_acquire) == pos + 1) slot.value()->~T();
+        }
+        for (size_t s = 0; s < capacity_ / SEGMENT_SLOTS; ++s)
+            delete segments_[s].load(std::memory_order_relaxed);
+    }
+
+    MpscChannel(const MpscChannel&) = delete;
+    MpscChannel& operator=(const MpscChannel&) = delete;
+
+    /// @brief Any thread: appends @p value, waiting while the channel is full.
+    void push(T value) {
+        const uint64_t pos = tail_.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = slotAt(pos);
+
+        uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        while (seq != pos) {
+            // The slot still holds the value from one lap ago.
+            slot.seq.wait(seq, std::memory_order_acquire);
+            seq = slot.seq.load(std::memory_order_acquire);
+        }
+        ::new (static_cast<void*>(slot.storage)) T(std::move(value));
+        slot.seq.store(pos + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consumer only: passes every value published so far, in claim
+     *        order, to @p sink and frees its slot.
+     *
+     * Stops at the first claimed-but-unpublished slot; values behind it are
+     * returned by a later call.
+     * @return The number of values drained.
+     */
+    template <class Sink>
+    size_t drain(Sink&& sink) {
+        size_t drained = 0;
+        for (;;) {
+            Segment* seg = segments_[(head_ & (capacity_ - 1)) / SEGMENT_SLOTS].load(std::memory_order_acquire);
+            if (!seg) break;
+            Slot& slot = seg->slots[head_ % SEGMENT_SLOTS];
+            if (slot.seq.load(std::memory_order_acquire) != head_ + 1) break;
+
+            T value(std::move(*slot.value()));
+            slot.value()->~T();
+            slot.seq.store(head_ + capacity_, std::memory_order_release);
+            slot.seq.notify_all();
+            ++head_;
+            ++drained;
+            sink(std::move(value));
+        }
+        return drained;
+    }
+
+    /// @brief Consumer only: true if nothing has been claimed past what was drained.
+    bool empty() const noexcept { return tail_.load(std::memory_order_acquire) == head_; }
+
+    size_t capacity() const noexcept { return capacity_; }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;   ///< pos: free for the push at pos; pos + 1: holds its value.
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    struct Segment {
+        Slot slots[SEGMENT_SLOTS];
+
+        explicit Segment(uint64_t first) {
+            for (size_t k = 0; k < SEGMENT_SLOTS; ++k) slots[k].seq.store(first + k, std::memory_order_relaxed);
+        }
+    };
+
+    /// @brief The slot for position @p pos, allocating its segment on first use.
+    Slot& slotAt(uint64_t pos) {
+        const size_t index = static_cast<size_t>(pos & (capacity_ - 1));
+        std::atomic<Segment*>& entry = segments_[index / SEGMENT_SLOTS];
+        Segment* seg = entry.load(std::memory_order_acquire);
+        if (!seg) {
+            auto* fresh = new Segment(index - index % SEGMENT_SLOTS);
+            if (entry.compare_exchange_strong(seg, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+                seg = fresh;
+            else
+                delete fresh;   // Another producer installed it first.
+        }
+        return seg->slots[index % SEGMENT_SLOTS];
+    }
+
+    const size_t capacity_;
+    const std::unique_ptr<std::atomic<Segment*>[]> segments_;
+
+    alignas(64) std::atomic<uint64_t> tail_{0};
+    alignas(64) uint64_t head_ = 0;   ///< Consumer-owned.
+};
+
 // ─────────────────────────────────────────────────────────────────────────────
 //  ThreadPool
 // ─────────────────────────────────────────────────────────────────────────────
 
+/**
+ * @brief Scheduling class of a pool task; lower values are served first.
+ *
+ * Priorities only order the queues idle workers look at; a running task is
+ * never preempted.
+ */
+enum class TaskPriority : uint8_t {
+    Interactive = 0,  ///< The user is waiting on it: filtering, sorting.
+    Foreground  = 1,  ///< User-started I/O: mount, copy, convert. The default.
+    Background  = 2,  ///< Nobody is waiting: auto_update import, index builds.
+};
+
+inline constexpr size_t TASK_PRIORITY_COUNT = 3;
+
 /**
  * @class ThreadPool
  * @brief Fully lock-free thread pool backed by C++20 atomic wait/notify.
  *
- * Manages a fixed set of worker threads that drain tasks from a @ref LockFreeQueue.
+ * Manages a fixed set of worker threads, each owning a @ref WorkStealingDeque.
  * Task submission is done via @ref enqueue, which returns a `std::future` allowing
  * the caller to obtain the result (or re-throw exceptions) asynchronously.
  *
+ * ### Scheduling
+ * A task submitted from one of the pool's own workers (nested fan-out, such
+ * as the directory walker) goes onto that worker's deque; a task submitted
+ * from any other thread goes onto the shared @ref LockFreeQueue injection
+ * queue. A worker looks for work in that order: its own deque (LIFO), the
+ * injection queue, then the other workers' deques (FIFO steal, starting at
+ * its right-hand neighbour). Workers thus mostly touch their own deque
+ * instead of all contending on one queue's head and tail.
+ *
+ * ### Priorities
+ * Each task carries a @ref TaskPriority and the injection queue is split per
+ * class. An idle worker looks, in order, at: interactive injections, its own
+ * deque, foreground injections, the other workers' deques, and only then
+ * background injections. Background tasks never go onto a deque, so they run
+ * only when no other work is waiting. A task submitted through plain
+ * @ref enqueue inherits the priority of the pool task submitting it (so a
+ * background import's helpers stay background); from any other thread it is
+ * @c Foreground. @ref enqueueAt sets the class explicitly, and
+ * @ref TaskGroup adds per-batch concurrency limits and cancellation.
+ *
+ * ### Adaptive sizing
+ * A pool built with bounds runs between @c minThreads and @c maxThreads
+ * workers. A control thread samples, every @ref CONTROL_INTERVAL, how long
+ * workers were busy running tasks, how much CPU time they used in that
+ * (per-thread CPU clocks), how long they sat runnable waiting for a CPU
+ * (`/proc/self/task/<tid>/schedstat`) and how long they waited on block I/O
+ * (`/proc/self/task/<tid>/stat` field 42; zero unless the kernel has delay
+ * accounting on). Busy time spent neither on a CPU nor waiting for one was
+ * blocked. With tasks waiting and workers mostly blocked — NFS or HDD scans,
+ * copies — the pool grows to about cores / (CPU share of a busy worker), so
+ * enough I/O stays outstanding to keep the cores fed; CPU-bound work
+ * (CHD/DAA decompression) halves the excess back toward one worker per core
+ * each tick, and an idle pool shrinks to @c minThreads, one worker per tick.
+ * Workers above the target finish their own deque and then park; none are
+ * destroyed. Every change is logged with its inputs and reason, see
+ * @ref telemetry. TaskGroup tasks additionally have their wall and CPU
+ * time totalled per group name.
+ *
+ * ### Placement
+ * A pool built with @c pinWorkers binds worker @c i to placement domain
+ * <tt>i % domains</tt> (see @ref cpuDomains): a NUMA node on multi-socket
+ * machines, otherwise a last-level cache. Workers then steal from deques on
+ * their own domain before crossing to another, and a @ref NodeLocalBuffer
+ * allocated inside a task lands on the node of the worker running it. Off by
+ * default; the scheduler's own balancing is usually the better choice on a
+ * single socket.
+ *
  * ### State encoding
  * A single 64-bit atomic `task_state` encodes two counters and a shutdown flag:
  * | Bits  | Meaning                                      |
@@ -859,6 +1442,11 @@ private:
  * is transparent to `ThreadPool`; its interface (`enqueue`/`dequeue`) is
  * unchanged.
  *
+ * Pending counts every queued task wherever it sits. A worker first claims
+ * one in @c task_state, then searches the queues; since each task is pushed
+ * before it is counted, a claim always has a task behind it, though a steal
+ * that loses a race may have to hand the claim back and retry.
+ *
  * ### Typical usage
  * @code
  *   ThreadPool pool(std::thread::hardware_concurrency());
@@ -873,9 +1461,52 @@ private:
  * @note The destructor calls @ref shutdown automatically, so explicit shutdown
  *       is only necessary when you need to drain the pool before destruction.
  */
+class TaskGroup;
+
 class ThreadPool {
+public:
+    /// @brief How often the adaptive controller samples and decides.
+    static constexpr std::chrono::milliseconds CONTROL_INTERVAL{200};
+
+    /// @brief Cumulative run time of the tasks of every group with one name.
+    struct GroupCounters {
+        explicit GroupCounters(std::string n) : name(std::move(n)) {}
+        const std::string name;
+        std::atomic<uint64_t> tasks{0};
+        std::atomic<uint64_t> wall_ns{0};
+        std::atomic<uint64_t> cpu_ns{0};
+    };
+
+    /// @brief One resize made by the controller, with the sample behind it.
+    struct SizingDecision {
+        std::chrono::steady_clock::time_point when;
+        size_t from = 0;
+        size_t to = 0;
+        double blocked = 0;       ///< Share of busy time not spent on CPU.
+        double utilisation = 0;   ///< Busy time / (interval × workers).
+        uint64_t pending = 0;
+        const char* reason = "";
+    };
+
+    /// @brief Snapshot returned by @ref telemetry for the instrumentation dump.
+    struct Telemetry {
+        size_t minThreads = 0, maxThreads = 0, started = 0, target = 0;
+        uint64_t active = 0, pending = 0;
+        double blocked = 0, utilisation = 0;   ///< Last sample.
+        uint64_t ioDelayMs = 0;                ///< Last sample's worker block-I/O delay.
+        std::vector<SizingDecision> decisions; ///< Oldest first.
+        struct Group { std::string name; uint64_t tasks, wall_ns, cpu_ns; };
+        std::vector<Group> groups;
+        bool pinned = false;                   ///< Workers bound to placement domains.
+        struct Domain { int node; bool numaNode; std::string cpus; size_t workers; };
+        std::vector<Domain> domains;           ///< Empty unless pinned.
+        uint64_t nodeBuffers = 0, firstTouchBuffers = 0;
+    };
+
 private:
-    const size_t num_threads;
+    const size_t min_threads;   ///< Adaptive bounds; equal for a fixed-size pool.
+    const size_t max_threads;
+    const bool pin_workers;     ///< Bind workers to placement domains (see "Placement").
 
     alignas(64) std::atomic<uint64_t> task_state{0};
 
@@ -884,18 +1515,88 @@ private:
     static constexpr uint64_t STOP_BIT    = uint64_t(1) << 31;
     static constexpr uint64_t ACTIVE_MASK = STOP_BIT - 1;
 
-    std::vector<std::thread> workers;
-    LockFreeQueue<MoveOnlyTask> task_queue;
+    /// @brief A queued task, the class it was submitted at and its group, if any.
+    struct PoolTask {
+        MoveOnlyTask fn;
+        TaskPriority priority = TaskPriority::Foreground;
+        TaskGroup* group = nullptr;
+    };
+
+    std::vector<std::thread> workers;            ///< Started lazily, up to max_threads.
+    std::vector<std::unique_ptr<WorkStealingDeque<PoolTask>>> local_queues;   ///< One per possible worker.
+    /// Injection queues for non-worker submitters and background tasks, one per priority.
+    std::array<LockFreeQueue<PoolTask>, TASK_PRIORITY_COUNT> task_queues;
     alignas(64) std::atomic<uint64_t> global_waiters{0};
 
+    /// @brief Identifies the pool (if any) the calling thread works for.
+    struct WorkerIdentity {
+        const ThreadPool* pool = nullptr;
+        size_t index = 0;
+        TaskPriority priority = TaskPriority::Foreground;  ///< Of the task being run.
+    };
+    static WorkerIdentity& currentWorker() noexcept {
+        static thread_local WorkerIdentity identity;
+        return identity;
+    }
+
+    // ── Adaptive sizing state ────────────────────────────────────────────────
+
+    std::atomic<size_t> started{0};                ///< Workers whose threads exist.
+    alignas(64) std::atomic<size_t> target{0};     ///< Workers allowed to take tasks.
+
+    /// Per-worker busy time (written by the worker) and CPU clock (read by the controller).
+    struct alignas(64) WorkerClock {
+        std::atomic<uint64_t> busy_ns{0};
+        std::atomic<bool> ready{false};
+        clockid_t cpu_clock{};
+        pid_t tid = 0;
+        std::atomic<int> domain{-1};   ///< Placement domain, -1 if unbound.
+        uint64_t last_busy_ns = 0;   ///< Controller-only.
+        uint64_t last_cpu_ns = 0;    ///< Controller-only.
+        uint64_t last_wait_ns = 0;   ///< Controller-only.
+        uint64_t last_io_ticks = 0;  ///< Controller-only.
+    };
+    std::unique_ptr<WorkerClock[]> clocks;
+
+    std::mutex control_mutex;
+    std::condition_variable control_cv;
+    bool control_stop = false;
+    std::thread controller;
+
+    static constexpr size_t DECISION_LOG = 8;
+    mutable std::mutex telemetry_mutex;
+    std::deque<SizingDecision> decisions;
+    double last_blocked = 0, last_utilisation = 0;
+    uint64_t last_io_delay_ms = 0;
+
+    mutable std::mutex group_mutex;
+    std::deque<GroupCounters> group_counters;   ///< Never shrinks, so entries stay put.
+
     static uint32_t pendingFromState(uint64_t s) noexcept { return static_cast<uint32_t>(s >> 32); }
     static uint32_t activeFromState(uint64_t s) noexcept  { return static_cast<uint32_t>(s & ACTIVE_MASK); }
     static bool stopFromState(uint64_t s) noexcept { return (s & STOP_BIT) != 0; }
 
-    void runTask(MoveOnlyTask& task) {
-        if (task) {
-            try { task(); } catch (...) {}
+    static uint64_t nowNs() noexcept {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static uint64_t cpuClockNs(clockid_t clock) noexcept {
+        timespec ts{};
+        if (clock_gettime(clock, &ts) != 0) return 0;
+        return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+    }
+
+    void runTask(PoolTask& task) {
+        WorkerIdentity& self = currentWorker();
+        self.priority = task.priority;
+        const uint64_t begin = nowNs();
+        if (task.group) {
+            runGroupTask(task);
+        } else if (task.fn) {
+            try { task.fn(); } catch (...) {}
         }
+        clocks[self.index].busy_ns.fetch_add(nowNs() - begin, std::memory_order_relaxed);
 
         uint64_t prev = task_state.fetch_sub(ACTIVE_ONE, std::memory_order_acq_rel);
 
@@ -904,7 +1605,113 @@ private:
         }
     }
 
-    void workerThread() {
+    LockFreeQueue<PoolTask>& injectionQueue(TaskPriority priority) {
+        return task_queues[static_cast<size_t>(priority)];
+    }
+
+    /**
+     * @brief Takes a task for worker @p self, in the order given in the class doc.
+     */
+    bool takeTask(size_t self, PoolTask& out) {
+        auto adopt = [&out](PoolTask* task) {
+            out = std::move(*task);
+            ObjectPool<PoolTask>::destroy(task);
+            return true;
+        };
+
+        if (injectionQueue(TaskPriority::Interactive).dequeue(out)) return true;
+        if (PoolTask* local = local_queues[self]->pop()) return adopt(local);
+        if (injectionQueue(TaskPriority::Foreground).dequeue(out)) return true;
+
+        // Steal on our own placement domain first: those tasks' data is local.
+        const size_t n = started.load(std::memory_order_acquire);
+        const int home = clocks[self].domain.load(std::memory_order_relaxed);
+        if (home >= 0) {
+            for (size_t k = 1; k < n; ++k) {
+                const size_t victim = (self + k) % n;
+                if (clocks[victim].domain.load(std::memory_order_relaxed) != home) continue;
+                if (PoolTask* stolen = local_queues[victim]->steal()) return adopt(stolen);
+            }
+        }
+        for (size_t k = 1; k < n; ++k) {
+            const size_t victim = (self + k) % n;
+            if (home >= 0 && clocks[victim].domain.load(std::memory_order_relaxed) == home) continue;
+            if (PoolTask* stolen = local_queues[victim]->steal()) return adopt(stolen);
+        }
+        return injectionQueue(TaskPriority::Background).dequeue(out);
+    }
+
+    /// Defined after @ref TaskGroup: runs @p task unless its group was
+    /// cancelled, then releases its slot in the group.
+    static void runGroupTask(PoolTask& task);
+    static void abandonGroupTask(PoolTask& task);
+
+    /**
+     * @brief Queues @p task; it is counted as pending once queued.
+     *
+     * A worker keeps its own non-background submissions on its deque; the
+     * deque holds pointers, so the task moves into an @ref ObjectPool slot.
+     */
+    void push(PoolTask&& task) {
+        const WorkerIdentity& self = currentWorker();
+        if (self.pool == this && task.priority != TaskPriority::Background) {
+            local_queues[self.index]->push(ObjectPool<PoolTask>::create(std::move(task)));
+        } else {
+            injectionQueue(task.priority).enqueue(std::move(task));
+        }
+
+        task_state.fetch_add(PENDING_ONE, std::memory_order_release);
+        task_state.notify_one();
+    }
+
+    TaskPriority callerPriority() const noexcept {
+        const WorkerIdentity& self = currentWorker();
+        return (self.pool == this) ? self.priority : TaskPriority::Foreground;
+    }
+
+    /// @brief Wraps @p f(args...) so its result or exception reaches the returned future.
+    template <class F, class... Args>
+    static auto package(F&& f, Args&&... args)
+        -> std::pair<MoveOnlyTask, std::future<std::invoke_result_t<F, Args...>>> {
+        using return_type = std::invoke_result_t<F, Args...>;
+
+        // The promise lives in the task itself; its shared state (which the
+        // future needs anyway) is the only allocation.
+        std::promise<return_type> promise;
+        std::future<return_type> result = promise.get_future();
+
+        MoveOnlyTask task([
+            func = std::forward<F>(f),
+            tup  = std::make_tuple(std::forward<Args>(args)...),
+            p    = std::move(promise)]() mutable
+        {
+            try {
+                if constexpr (std::is_void_v<return_type>) {
+                    std::apply(std::move(func), std::move(tup));
+                    p.set_value();
+                } else {
+                    p.set_value(std::apply(std::move(func), std::move(tup)));
+                }
+            } catch (...) {
+                p.set_exception(std::current_exception());
+            }
+        });
+        return {std::move(task), std::move(result)};
+    }
+
+    friend class TaskGroup;
+
+    void workerThread(size_t self) {
+        currentWorker() = {this, self};
+        clocks[self].tid = gettid();
+        if (pthread_getcpuclockid(pthread_self(), &clocks[self].cpu_clock) == 0)
+            clocks[self].ready.store(true, std::memory_order_release);
+        if (pin_workers) {
+            const size_t domain = self % cpuDomains().size();
+            if (bindCurrentThreadToDomain(domain))
+                clocks[self].domain.store(static_cast<int>(domain), std::memory_order_relaxed);
+        }
+
         while (true) {
             uint64_t current_state = task_state.load(std::memory_order_acquire);
 
@@ -912,6 +1719,15 @@ private:
                 return;
             }
 
+            // Above the target: finish our own deque (nobody else pops it
+            // LIFO), then park until the controller raises the target again.
+            const size_t allowed = target.load(std::memory_order_acquire);
+            if (self >= allowed && local_queues[self]->empty()) {
+                task_state.notify_one();   // pass on a wake-up that may have been meant for work
+                target.wait(allowed, std::memory_order_acquire);
+                continue;
+            }
+
             while (pendingFromState(current_state) == 0) {
                 task_state.wait(current_state, std::memory_order_relaxed);
                 current_state = task_state.load(std::memory_order_acquire);
@@ -932,8 +1748,8 @@ private:
                 continue;
             }
 
-            MoveOnlyTask task;
-            if (task_queue.dequeue(task)) {
+            PoolTask task;
+            if (takeTask(self, task)) {
                 runTask(task);
             } else {
                 uint64_t prev = task_state.fetch_add(PENDING_ONE - ACTIVE_ONE, std::memory_order_acq_rel);
@@ -945,12 +1761,162 @@ private:
         }
     }
 
-public:
-    explicit ThreadPool(size_t n) : num_threads(n) {
-        if (n == 0) throw std::invalid_argument("ThreadPool: n > 0 required");
-        workers.reserve(n);
+    /// @brief Starts workers up to @p n (called with control_mutex held, or before the controller runs).
+    void startWorkers(size_t n) {
+        for (size_t i = started.load(std::memory_order_relaxed); i < n; ++i) {
+            started.store(i + 1, std::memory_order_release);
+            workers.emplace_back(&ThreadPool::workerThread, this, i);
+        }
+    }
+
+    void setTarget(size_t n) {
+        target.store(n, std::memory_order_release);
+        target.notify_all();
+        startWorkers(n);
+    }
+
+    /// @brief Time thread @p tid has spent waiting on block I/O, in clock ticks
+    ///        (field 42 of its stat; 0 without delay accounting).
+    static uint64_t readIoDelayTicks(pid_t tid) {
+        char path[64];
+        std::snprintf(path, sizeof(path), "/proc/self/task/%d/stat", static_cast<int>(tid));
+        std::FILE* f = std::fopen(path, "r");
+        if (!f) return 0;
+        char buf[1024];
+        const size_t len = std::fread(buf, 1, sizeof(buf) - 1, f);
+        std::fclose(f);
+        buf[len] = '\0';
+
+        // The command name may contain spaces; fields are counted after its ')'.
+        const char* p = std::strrchr(buf, ')');
+        if (!p) return 0;
+        unsigned long long value = 0;
+        int field = 2;
+        for (const char* tok = p + 1; *tok; ) {
+            while (*tok == ' ') ++tok;
+            if (!*tok) break;
+            if (++field == 42) { value = std::strtoull(tok, nullptr, 10); break; }
+            while (*tok && *tok != ' ') ++tok;
+        }
+        return value;
+    }
+
+    /// @brief Time thread @p tid has spent runnable but waiting for a CPU, in ns
+    ///        (second field of its schedstat; 0 if the kernel lacks it).
+    static uint64_t readRunQueueWaitNs(pid_t tid) {
+        char path[64];
+        std::snprintf(path, sizeof(path), "/proc/self/task/%d/schedstat", static_cast<int>(tid));
+        std::FILE* f = std::fopen(path, "r");
+        if (!f) return 0;
+        unsigned long long run = 0, wait = 0;
+        const int fields = std::fscanf(f, "%llu %llu", &run, &wait);
+        std::fclose(f);
+        return fields == 2 ? wait : 0;
+    }
+
+    void controlLoop() {
+        uint64_t lastSample = nowNs();
+
+        std::unique_lock<std::mutex> lock(control_mutex);
+        while (!control_cv.wait_for(lock, CONTROL_INTERVAL, [this] { return control_stop; })) {
+            const uint64_t now = nowNs();
+            adjust(static_cast<double>(now - lastSample));
+            lastSample = now;
+        }
+    }
+
+    /**
+     * @brief One controller step: samples the workers, then resizes (see class doc).
+     * @param elapsedNs  Wall time since the previous step.
+     */
+    void adjust(double elapsedNs) {
+        static const double nsPerTick = 1e9 / static_cast<double>(std::max(1L, sysconf(_SC_CLK_TCK)));
+
+        // Busy time that was neither on a CPU nor queued for one was blocked.
+        // Run-queue wait is kept apart so that an oversubscribed CPU-bound
+        // pool is not mistaken for an I/O-bound one.
+        double busy = 0, cpu = 0, queued = 0, ioDelayNs = 0;
+        const size_t n = started.load(std::memory_order_acquire);
         for (size_t i = 0; i < n; ++i) {
-            workers.emplace_back(&ThreadPool::workerThread, this);
+            WorkerClock& c = clocks[i];
+            if (!c.ready.load(std::memory_order_acquire)) continue;
+            const uint64_t b = c.busy_ns.load(std::memory_order_relaxed);
+            const uint64_t t = cpuClockNs(c.cpu_clock);
+            const uint64_t w = readRunQueueWaitNs(c.tid);
+            const uint64_t io = readIoDelayTicks(c.tid);
+            busy   += static_cast<double>(b - c.last_busy_ns);
+            cpu    += static_cast<double>(t - std::min(t, c.last_cpu_ns));
+            queued += static_cast<double>(w - std::min(w, c.last_wait_ns));
+            ioDelayNs += static_cast<double>(io - std::min(io, c.last_io_ticks)) * nsPerTick;
+            c.last_busy_ns = b;
+            c.last_cpu_ns = t;
+            c.last_wait_ns = w;
+            c.last_io_ticks = io;
+        }
+
+        const size_t current = target.load(std::memory_order_relaxed);
+        const uint64_t pending = pendingCount();
+        double blocked = 0;
+        if (busy > 0) blocked = std::clamp(std::max(1.0 - (cpu + queued) / busy, ioDelayNs / busy), 0.0, 1.0);
+        const double utilisation = busy / (elapsedNs * static_cast<double>(std::max<size_t>(1, current)));
+
+        const size_t cores = std::max(1u, std::thread::hardware_concurrency());
+        const bool ioBound = blocked >= 0.3;
+        // Workers needed to keep every core busy when each uses only (1 - blocked) of one.
+        const size_t ideal = ioBound
+            ? static_cast<size_t>(static_cast<double>(cores) / std::max(0.05, 1.0 - blocked) + 0.999)
+            : cores;
+        const size_t baseline = std::max(min_threads, std::min(cores, max_threads));
+
+        size_t next = current;
+        const char* reason = nullptr;
+        if (pending > 0 && ideal > current) {
+            next = ideal;
+            reason = ioBound ? "grow: tasks waiting while workers block on I/O"
+                             : "grow: tasks waiting, fewer workers than cores";
+        } else if (current > baseline && busy > 0 && !ioBound) {
+            next = current - std::max<size_t>(1, (current - baseline) / 2);
+            reason = "shrink: CPU-bound, back toward one worker per core";
+        } else if (current > min_threads && pending == 0 && utilisation < 0.25) {
+            next = current - 1;
+            reason = "shrink: idle";
+        }
+        next = std::clamp(next, min_threads, max_threads);
+
+        std::lock_guard<std::mutex> tl(telemetry_mutex);
+        last_blocked = blocked;
+        last_utilisation = utilisation;
+        last_io_delay_ms = static_cast<uint64_t>(ioDelayNs / 1e6);
+        if (next == current || !reason) return;
+
+        setTarget(next);
+        decisions.push_back({std::chrono::steady_clock::now(), current, next, blocked, utilisation, pending, reason});
+        if (decisions.size() > DECISION_LOG) decisions.pop_front();
+    }
+
+public:
+    /// @brief A fixed-size pool of @p n workers.
+    explicit ThreadPool(size_t n) : ThreadPool(n, n, n) {}
+
+    /**
+     * @brief A pool that starts @p initial workers and resizes itself within
+     *        [@p minThreads, @p maxThreads] (see "Adaptive sizing"), with
+     *        workers bound to placement domains if @p pinWorkers (see "Placement").
+     */
+    ThreadPool(size_t initial, size_t minThreads, size_t maxThreads, bool pinWorkers = false)
+        : min_threads(std::max<size_t>(1, minThreads)),
+          max_threads(std::max(min_threads, maxThreads)),
+          pin_workers(pinWorkers) {
+        if (initial == 0) throw std::invalid_argument("ThreadPool: n > 0 required");
+        local_queues.reserve(max_threads);
+        for (size_t i = 0; i < max_threads; ++i) {
+            local_queues.push_back(std::make_unique<WorkStealingDeque<PoolTask>>());
+        }
+        clocks = std::make_unique<WorkerClock[]>(max_threads);
+        workers.reserve(max_threads);
+        setTarget(std::clamp(initial, min_threads, max_threads));
+        if (min_threads < max_threads) {
+            controller = std::thread(&ThreadPool::controlLoop, this);
         }
     }
 
@@ -958,34 +1924,38 @@ public:
         shutdown();
     }
 
+    /**
+     * @brief Submits @p f(args...) at the caller's priority (see class doc).
+     */
     template <class F, class... Args>
     auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
-        using return_type = std::invoke_result_t<F, Args...>;
-
-        auto promise = std::make_shared<std::promise<return_type>>();
-        std::future<return_type> result = promise->get_future();
+        return enqueueAt(callerPriority(), std::forward<F>(f), std::forward<Args>(args)...);
+    }
 
-        task_queue.enqueue(MoveOnlyTask([
-            func = std::forward<F>(f),
-            tup  = std::make_tuple(std::forward<Args>(args)...),
-            p    = std::move(promise)]() mutable
-        {
-            try {
-                if constexpr (std::is_void_v<return_type>) {
-                    std::apply(std::move(func), std::move(tup));
-                    p->set_value();
-                } else {
-                    p->set_value(std::apply(std::move(func), std::move(tup)));
-                }
-            } catch (...) {
-                p->set_exception(std::current_exception());
-            }
-        }));
+    /**
+     * @brief Submits @p f(args...) at an explicit @p priority.
+     */
+    template <class F, class... Args>
+    auto enqueueAt(TaskPriority priority, F&& f, Args&&... args)
+        -> std::future<std::invoke_result_t<F, Args...>> {
+        auto [task, result] = package(std::forward<F>(f), std::forward<Args>(args)...);
+        submit(std::move(task), priority);
+        return std::move(result);
+    }
 
-        task_state.fetch_add(PENDING_ONE, std::memory_order_release);
-        task_state.notify_one();
+    /**
+     * @brief Queues @p task at @p priority with no future attached.
+     *
+     * Nothing is allocated for a callable that fits @ref MoveOnlyTask's inline
+     * buffer; exceptions it throws are swallowed. Use a @ref TaskGroup to wait.
+     */
+    void submit(MoveOnlyTask task, TaskPriority priority) {
+        push(PoolTask{std::move(task), priority, nullptr});
+    }
 
-        return result;
+    /// @brief As above, at the caller's priority.
+    void submit(MoveOnlyTask task) {
+        submit(std::move(task), callerPriority());
     }
 
     void waitAllTasksCompleted() {
@@ -997,8 +1967,18 @@ public:
     }
 
     void shutdown() {
+        {
+            std::lock_guard<std::mutex> lock(control_mutex);
+            control_stop = true;
+        }
+        control_cv.notify_all();
+        if (controller.joinable()) controller.join();
+
         task_state.fetch_or(STOP_BIT, std::memory_order_release);
         task_state.notify_all();
+        // Wake parked workers too; they see the stop flag and exit.
+        target.store(max_threads + 1, std::memory_order_release);
+        target.notify_all();
 
         for (std::thread& worker : workers) {
             if (worker.joinable()) {
@@ -1006,9 +1986,28 @@ public:
             }
         }
 
-        MoveOnlyTask abandoned_task;
-        while (task_queue.dequeue(abandoned_task)) {
-            task_state.fetch_sub(PENDING_ONE, std::memory_order_acq_rel);
+        // Releasing an abandoned group task may hand the group's next backlog
+        // entry to the pool, so drain until a full pass finds nothing.
+        bool drained = true;
+        while (drained) {
+            drained = false;
+            PoolTask abandoned_task;
+            for (auto& queue : task_queues) {
+                while (queue.dequeue(abandoned_task)) {
+                    task_state.fetch_sub(PENDING_ONE, std::memory_order_acq_rel);
+                    abandonGroupTask(abandoned_task);
+                    drained = true;
+                }
+            }
+            // Workers are joined, so every deque can be drained from this thread.
+            for (auto& queue : local_queues) {
+                while (PoolTask* abandoned = queue->steal()) {
+                    task_state.fetch_sub(PENDING_ONE, std::memory_order_acq_rel);
+                    abandonGroupTask(*abandoned);
+                    ObjectPool<PoolTask>::destroy(abandoned);
+                    drained = true;
+                }
+            }
         }
         task_state.notify_all();
     }
@@ -1018,20 +2017,499 @@ public:
         return pendingFromState(s) == 0 && activeFromState(s) == 0;
     }
 
-    size_t threadCount() const { return num_threads; }
+    /// @brief Workers currently allowed to run tasks; size fan-out by this.
+    size_t threadCount() const { return target.load(std::memory_order_acquire); }
+    size_t minThreadCount() const { return min_threads; }
+    size_t maxThreadCount() const { return max_threads; }
     uint64_t pendingCount() const { return pendingFromState(task_state.load(std::memory_order_acquire)); }
     uint64_t activeCount() const { return activeFromState(task_state.load(std::memory_order_acquire)); }
+
+    /// @brief The shared counters for groups named @p name, created on first use.
+    GroupCounters* groupCounters(const std::string& name) {
+        std::lock_guard<std::mutex> lock(group_mutex);
+        for (GroupCounters& g : group_counters)
+            if (g.name == name) return &g;
+        return &group_counters.emplace_back(name);
+    }
+
+    /// @brief Sizing state, recent resize decisions, per-group run times and worker placement.
+    Telemetry telemetry() const {
+        Telemetry t;
+        t.minThreads = min_threads;
+        t.maxThreads = max_threads;
+        t.started = started.load(std::memory_order_acquire);
+        t.target = target.load(std::memory_order_acquire);
+        t.active = activeCount();
+        t.pending = pendingCount();
+        {
+            std::lock_guard<std::mutex> lock(telemetry_mutex);
+            t.blocked = last_blocked;
+            t.utilisation = last_utilisation;
+            t.ioDelayMs = last_io_delay_ms;
+            t.decisions.assign(decisions.begin(), decisions.end());
+        }
+        {
+            std::lock_guard<std::mutex> lock(group_mutex);
+            for (const GroupCounters& g : group_counters)
+                t.groups.push_back({g.name, g.tasks.load(std::memory_order_relaxed),
+                                    g.wall_ns.load(std::memory_order_relaxed),
+                                    g.cpu_ns.load(std::memory_order_relaxed)});
+        }
+
+        t.pinned = pin_workers;
+        if (pin_workers) {
+            for (const CpuDomain& d : cpuDomains()) t.domains.push_back({d.node, d.numaNode, d.cpuList, 0});
+            for (size_t i = 0; i < t.started; ++i) {
+                const int domain = clocks[i].domain.load(std::memory_order_relaxed);
+                if (domain >= 0) ++t.domains[static_cast<size_t>(domain)].workers;
+            }
+        }
+        t.nodeBuffers = nodeBufferCounters().bound.load(std::memory_order_relaxed);
+        t.firstTouchBuffers = nodeBufferCounters().firstTouch.load(std::memory_order_relaxed);
+        return t;
+    }
 };
 
 /**
  * @brief Thread-safe retrieval of the process-wide ThreadPool singleton.
  */
 inline ThreadPool& getStaticThreadPool() {
-    unsigned int maxThreads = std::max(2u, std::thread::hardware_concurrency());
-    static ThreadPool instance(
-        std::min({ static_cast<size_t>(maxThreads),
-                   GlobalConcurrency::MAX_USEFUL_THREADS }));
+    static ThreadPool instance = [] {
+        const size_t cores = std::max(2u, std::thread::hardware_concurrency());
+        const size_t maxThreads = std::max<size_t>(1, GlobalConcurrency::MAX_USEFUL_THREADS);
+        const size_t minThreads = std::min(maxThreads, GlobalConcurrency::MIN_POOL_THREADS == 0
+                                                           ? cores : GlobalConcurrency::MIN_POOL_THREADS);
+        return ThreadPool(std::min(cores, maxThreads), minThreads, maxThreads,
+                          GlobalConcurrency::PIN_POOL_WORKERS);
+    }();
     return instance;
 }
 
+// ─────────────────────────────────────────────────────────────────────────────
+//  TaskGroup
+// ─────────────────────────────────────────────────────────────────────────────
+
+/**
+ * @brief Pool task that resumes a suspended coroutine.
+ *
+ * If the task is dropped without running (its group was cancelled), the
+ * coroutine is destroyed instead, so its frame and its @ref PipelineScope
+ * count are still released.
+ */
+class CoroutineResumer {
+public:
+    explicit CoroutineResumer(std::coroutine_handle<> h) noexcept : handle_(h) {}
+    CoroutineResumer(CoroutineResumer&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    CoroutineResumer& operator=(CoroutineResumer&&) = delete;
+    ~CoroutineResumer() { if (handle_) handle_.destroy(); }
+
+    void operator()() { std::exchange(handle_, {}).resume(); }
+
+private:
+    std::coroutine_handle<> handle_;
+};
+
+/**
+ * @class TaskGroup
+ * @brief A named batch of pool tasks sharing a priority, a concurrency limit
+ *        and a cancellation flag; also the pool's "wait for all" latch.
+ *
+ * At most @c maxConcurrent of the group's tasks are in the pool at once; the
+ * rest wait in the group's backlog and are handed to the pool one by one as
+ * running ones finish, so a capped batch never occupies more workers than its
+ * limit however many tasks it submits. Tasks the group's own tasks submit
+ * through @ref ThreadPool::enqueue inherit its priority but not its limit.
+ *
+ * @ref submit is the cheap path: no promise, no future, and — for a callable
+ * that fits @ref MoveOnlyTask's inline buffer — no allocation at all, since
+ * queue nodes and deque slots come from @ref ObjectPool. Admission and
+ * completion are a few atomic operations; the mutex is only taken to touch
+ * the backlog or for the final completion that wakes @ref wait. Small tasks
+ * (a directory, a file) can therefore be submitted one by one. @ref enqueue
+ * adds a future for callers that need a result or an exception.
+ *
+ * The wall and CPU time of every task run is added to the pool's counters
+ * for the group's name, which @ref ThreadPool::telemetry reports.
+ *
+ * @ref cancel drops the backlog (their futures report `broken_promise`) and
+ * raises @ref cancelFlag, which running tasks should poll to stop early.
+ * The destructor waits for every task still in the pool.
+ *
+ * A coroutine can also run as the group's tasks: `co_await group.schedule()`
+ * suspends it and resumes it as a task of @c group, within its limit (see
+ * @ref PipelineTask).
+ *
+ * @code
+ *   TaskGroup copies("cp", TaskPriority::Foreground, GlobalConcurrency::CPMV_THREAD_CAP);
+ *   for (auto& chunk : chunks) copies.submit([&, chunk] { copyChunk(chunk); });
+ *   copies.wait();
+ * @endcode
+ */
+class TaskGroup {
+public:
+    static constexpr size_t UNLIMITED = SIZE_MAX;
+
+    TaskGroup(std::string name, TaskPriority priority, size_t maxConcurrent = UNLIMITED,
+              ThreadPool& pool = getStaticThreadPool())
+        : name_(std::move(name)), priority_(priority),
+          limit_(std::max<size_t>(1, maxConcurrent)), pool_(pool),
+          counters_(pool.groupCounters(name_)) {}
+
+    ~TaskGroup() { wait(); }
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    /**
+     * @brief Submits @p f as a task of this group, with no future attached.
+     *
+     * Exceptions thrown by @p f are swallowed. Once the group is cancelled
+     * the task is discarded.
+     */
+    template <class F>
+    void submit(F&& f) {
+        admit(MoveOnlyTask(std::forward<F>(f)));
+    }
+
+    /**
+     * @brief Submits @p f(args...) as a task of this group.
+     *
+     * Once the group is cancelled the task is discarded and the returned
+     * future reports `broken_promise`.
+     */
+    template <class F, class... Args>
+    auto enqueue(F&& f, Args&&... args) -> std::future<std::invoke_result_t<F, Args...>> {
+        auto [task, result] = ThreadPool::package(std::forward<F>(f), std::forward<Args>(args)...);
+        admit(std::move(task));
+        return std::move(result);
+    }
+
+    /// @brief Discards queued tasks and asks running ones to stop.
+    void cancel() {
+        std::deque<MoveOnlyTask> dropped;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cancelled_.store(true, std::memory_order_release);
+            dropped.swap(backlog_);
+            backlogSize_.store(0, std::memory_order_seq_cst);
+            if (outstanding_.fetch_sub(dropped.size(), std::memory_order_acq_rel) == dropped.size())
+                idle_.notify_all();
+        }
+        // `dropped` is destroyed outside the lock, breaking its promises.
+    }
+
+    /// @brief Blocks until every task of the group has finished or been dropped.
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return outstanding_.load(std::memory_order_acquire) == 0; });
+    }
+
+    /**
+     * @brief Like @ref wait, but calls @p poll every @p interval while tasks
+     *        remain and once more after the last one finishes.
+     *
+     * Lets the waiting thread consume what the tasks produce, e.g. drain an
+     * @ref MpscChannel they push into, so a bounded channel never stalls them
+     * for long and the final call sees everything.
+     */
+    template <class Poll>
+    void wait(Poll&& poll, std::chrono::milliseconds interval = std::chrono::milliseconds(10)) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!idle_.wait_for(lock, interval, [this] { return outstanding_.load(std::memory_order_acquire) == 0; })) {
+            lock.unlock();
+            poll();
+            lock.lock();
+        }
+        lock.unlock();
+        poll();
+    }
+
+    /**
+     * @brief Awaitable that moves the awaiting coroutine onto this group: it
+     *        is suspended and resumed as one of the group's tasks.
+     *
+     * The resumption waits for a free slot like any other task, so a stage
+     * awaited here never runs more than @ref limit wide. A coroutine already
+     * running in this group gives up its slot when the current task returns.
+     */
+    auto schedule() noexcept {
+        struct Awaiter {
+            TaskGroup& group;
+            bool await_ready() const noexcept { return false; }
+            // Nothing of the frame (this awaiter included) may be touched after
+            // submit: another worker may already be running the coroutine.
+            void await_suspend(std::coroutine_handle<> h) { group.submit(CoroutineResumer(h)); }
+            void await_resume() const noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+    bool cancelled() const noexcept { return cancelled_.load(std::memory_order_acquire); }
+
+    /// @brief The cancellation flag itself, for APIs that poll an atomic (e.g. a walk's stop flag).
+    const std::atomic<bool>& cancelFlag() const noexcept { return cancelled_; }
+
+    const std::string& name() const noexcept { return name_; }
+    TaskPriority priority() const noexcept { return priority_; }
+    size_t limit() const noexcept { return limit_; }
+
+    /// @brief Tasks queued in the group or in the pool, plus those running.
+    size_t outstanding() const noexcept { return outstanding_.load(std::memory_order_acquire); }
+
+private:
+    friend class ThreadPool;
+
+    void admit(MoveOnlyTask task) {
+        if (cancelled()) return;   // `task` is destroyed here, breaking its promise.
+        outstanding_.fetch_add(1, std::memory_order_relaxed);
+        if (tryAcquireSlot()) {
+            dispatch(std::move(task));
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            backlog_.push_back(std::move(task));
+            backlogSize_.fetch_add(1, std::memory_order_seq_cst);
+        }
+        // A slot may have been released between the failed claim and the push.
+        drainBacklog();
+    }
+
+    bool tryAcquireSlot() noexcept {
+        size_t running = running_.load(std::memory_order_seq_cst);
+        while (running < limit_) {
+            if (running_.compare_exchange_weak(running, running + 1, std::memory_order_seq_cst))
+                return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Moves backlog tasks into the pool while slots are free.
+     *
+     * Releasing a slot and pushing to the backlog are both followed by this
+     * check, and both sides use seq_cst, so one of them always sees the other.
+     */
+    void drainBacklog() {
+        while (backlogSize_.load(std::memory_order_seq_cst) > 0 && tryAcquireSlot()) {
+            MoveOnlyTask next;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!backlog_.empty()) {
+                    next = std::move(backlog_.front());
+                    backlog_.pop_front();
+                    backlogSize_.fetch_sub(1, std::memory_order_seq_cst);
+                }
+            }
+            if (!next) {
+                running_.fetch_sub(1, std::memory_order_seq_cst);
+                continue;
+            }
+            dispatch(std::move(next));
+        }
+    }
+
+    void dispatch(MoveOnlyTask task) {
+        pool_.push(ThreadPool::PoolTask{std::move(task), priority_, this});
+    }
+
+    /**
+     * @brief Called by the pool once a task of this group has run or been
+     *        abandoned; frees its slot and, if it was the last, wakes @ref wait.
+     *
+     * Only the final decrement takes the mutex, so a waiter that sees zero
+     * can destroy the group without racing this call.
+     */
+    void finished() {
+        running_.fetch_sub(1, std::memory_order_seq_cst);
+        drainBacklog();
+
+        size_t n = outstanding_.load(std::memory_order_acquire);
+        while (n > 1 && !outstanding_.compare_exchange_weak(n, n - 1, std::memory_order_acq_rel)) {}
+        if (n > 1) return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        outstanding_.fetch_sub(1, std::memory_order_acq_rel);
+        idle_.notify_all();
+    }
+
+    const std::string name_;
+    const TaskPriority priority_;
+    const size_t limit_;
+    ThreadPool& pool_;
+    ThreadPool::GroupCounters* const counters_;   ///< Shared by every group with this name.
+
+    alignas(64) std::atomic<size_t> running_{0};       ///< Tasks handed to the pool.
+    alignas(64) std::atomic<size_t> outstanding_{0};   ///< Admitted and not yet finished.
+    std::atomic<size_t> backlogSize_{0};
+    std::atomic<bool> cancelled_{false};
+
+    mutable std::mutex mutex_;
+    std::condition_variable idle_;
+    std::deque<MoveOnlyTask> backlog_;
+};
+
+/**
+ * @details The task's callable is destroyed by the caller after this returns,
+ * so the group slot is released first: its captures may own the group itself.
+ */
+inline void ThreadPool::runGroupTask(PoolTask& task) {
+    if (task.fn && !task.group->cancelled()) {
+        const uint64_t wall = nowNs();
+        const uint64_t cpu = cpuClockNs(CLOCK_THREAD_CPUTIME_ID);
+        try { task.fn(); } catch (...) {}
+        ThreadPool::GroupCounters& c = *task.group->counters_;
+        c.tasks.fetch_add(1, std::memory_order_relaxed);
+        c.wall_ns.fetch_add(nowNs() - wall, std::memory_order_relaxed);
+        c.cpu_ns.fetch_add(cpuClockNs(CLOCK_THREAD_CPUTIME_ID) - cpu, std::memory_order_relaxed);
+    }
+    task.group->finished();
+}
+
+inline void ThreadPool::abandonGroupTask(PoolTask& task) {
+    if (task.group) task.group->finished();
+}
+
+// ─────────────────────────────────────────────────────────────────────────────
+//  PipelineTask / PipelineScope
+// ─────────────────────────────────────────────────────────────────────────────
+
+class PipelineScope;
+
+/**
+ * @class PipelineTask
+ * @brief A coroutine that runs as a chain of pool tasks, one per stage.
+ *
+ * Each `co_await group.schedule()` ends the current pool task and continues
+ * the coroutine as a task of @c group, so one operation on one file can
+ * run its cheap stages (stat, checks, reporting) in a wide group and its
+ * heavy stage (the transfer, the mount) in a group capped to what the
+ * device can take, without ever holding a slot of either while waiting
+ * for the other. Spawning one pipeline per file instead of splitting a
+ * batch into per-thread chunks means a slow file only ever delays itself:
+ * workers pick up the next file's stage as soon as they are free.
+ *
+ * A pipeline starts suspended and is started by @ref PipelineScope::spawn;
+ * its frame is freed when it returns. Exceptions escaping the body are
+ * swallowed, as those of plain pool tasks are.
+ *
+ * @code
+ *   PipelineTask copyOne(TaskGroup& checks, TaskGroup& io, std::string path) {
+ *       co_await checks.schedule();
+ *       if (!precheck(path)) co_return;
+ *       co_await io.schedule();
+ *       transfer(path);
+ *   }
+ *
+ *   TaskGroup checks("cp.check", TaskPriority::Foreground);
+ *   TaskGroup io("cp", TaskPriority::Foreground, GlobalConcurrency::CPMV_THREAD_CAP);
+ *   PipelineScope scope;
+ *   for (const auto& p : paths) scope.spawn(checks, copyOne(checks, io, p));
+ *   scope.wait();
+ * @endcode
+ *
+ * @warning Reference parameters must outlive the scope's @ref PipelineScope::wait,
+ *          and so must every group the body awaits. By-value parameters are
+ *          destroyed just after the scope counts the pipeline finished, so
+ *          their destructors must not reach back into the caller's state.
+ */
+class PipelineTask {
+public:
+    struct promise_type {
+        PipelineScope* scope = nullptr;
+
+        PipelineTask get_return_object() noexcept {
+            return PipelineTask(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {}
+
+        /// Defined after @ref PipelineScope: counts the pipeline as finished.
+        ~promise_type();
+    };
+
+    PipelineTask(PipelineTask&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    PipelineTask& operator=(PipelineTask&&) = delete;
+    ~PipelineTask() { if (handle_) handle_.destroy(); }
+
+private:
+    friend class PipelineScope;
+    explicit PipelineTask(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+
+    std::coroutine_handle<promise_type> handle_;
+};
+
+/**
+ * @class PipelineScope
+ * @brief Starts @ref PipelineTask coroutines and waits for all of them.
+ *
+ * A pipeline counts as running from @ref spawn until its frame is destroyed,
+ * whichever groups it moves through on the way; @ref TaskGroup::wait alone
+ * can't tell, since a pipeline between two stages has no task in either.
+ * The destructor waits, so a scope declared after the groups its pipelines
+ * use is always finished with before they are.
+ */
+class PipelineScope {
+public:
+    PipelineScope() = default;
+    ~PipelineScope() { wait(); }
+
+    PipelineScope(const PipelineScope&) = delete;
+    PipelineScope& operator=(const PipelineScope&) = delete;
+
+    /// @brief Starts @p task as a task of @p group.
+    void spawn(TaskGroup& group, PipelineTask task) {
+        std::coroutine_handle<PipelineTask::promise_type> h = std::exchange(task.handle_, {});
+        h.promise().scope = this;
+        running_.fetch_add(1, std::memory_order_relaxed);
+        group.submit(CoroutineResumer(h));
+    }
+
+    /// @brief Blocks until every spawned pipeline has returned.
+    void wait() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return running_.load(std::memory_order_acquire) == 0; });
+    }
+
+    /// @brief Like @ref wait, calling @p poll as @ref TaskGroup::wait(Poll&&, std::chrono::milliseconds) does.
+    template <class Poll>
+    void wait(Poll&& poll, std::chrono::milliseconds interval = std::chrono::milliseconds(10)) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!idle_.wait_for(lock, interval, [this] { return running_.load(std::memory_order_acquire) == 0; })) {
+            lock.unlock();
+            poll();
+            lock.lock();
+        }
+        lock.unlock();
+        poll();
+    }
+
+    /// @brief Pipelines spawned and not yet returned.
+    size_t running() const noexcept { return running_.load(std::memory_order_acquire); }
+
+private:
+    friend struct PipelineTask::promise_type;
+
+    /// Same protocol as @ref TaskGroup::finished: only the last one locks.
+    void finished() {
+        size_t n = running_.load(std::memory_order_acquire);
+        while (n > 1 && !running_.compare_exchange_weak(n, n - 1, std::memory_order_acq_rel)) {}
+        if (n > 1) return;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_.fetch_sub(1, std::memory_order_acq_rel);
+        idle_.notify_all();
+    }
+
+    alignas(64) std::atomic<size_t> running_{0};
+    std::mutex mutex_;
+    std::condition_variable idle_;
+};
+
+inline PipelineTask::promise_type::~promise_type() {
+    if (scope) scope->finished();
+}
+
 #endif // THREAD_POOL_H
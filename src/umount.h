@@ -13,6 +13,8 @@
 // Project Headers
 #include "themes.h"
 
+class ResultChannel;
+
 /**
  * @brief Formatter for unmount-specific verbose terminal messages.
  * @details Generates ANSI color-coded strings for unmounting operations,
@@ -53,6 +55,6 @@ struct VerboseMessageFormatter {
     }
 };
 
-void unmountISO(const std::vector<std::string>& isoDirs, std::atomic<size_t>* completedTasks, std::atomic<size_t>* failedTasks, bool silentMode);
+void unmountISO(const std::vector<std::string>& isoDirs, std::atomic<size_t>* completedTasks, std::atomic<size_t>* failedTasks, bool silentMode, ResultChannel& results);
 
 #endif // UMOUNT_H
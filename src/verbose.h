@@ -7,10 +7,14 @@
 #include <atomic>
 #include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
+// Project Headers
+#include "./threadpool.h"
+
 /**
  * @brief Holds verbose output sets for operation results and user input.
  *
@@ -25,6 +29,8 @@
  *
  * Declared inline so the single definition lives in the header.
  * All concurrent writes must be protected by GlobalMutexes::globalSetsMutex.
+ * Pool tasks don't write here directly: they send results through a
+ * @ref ResultChannel, whose single consumer moves them in.
  */
 struct VerboseSets {
     std::unordered_set<std::string> operationCompleted;
@@ -48,6 +54,48 @@ inline void clearGlobalVerboseSets() {
     verboseSets.uniqueErrorTokenMessages.clear();
 }
 
+/**
+ * @class ResultChannel
+ * @brief Carries per-file results from the tasks of one operation to the
+ *        thread that waits for them.
+ *
+ * Tasks push completed/failed/skipped messages and produced output paths
+ * without taking a lock (see @ref MpscChannel); the waiting thread calls
+ * @ref collect — typically as the poll of @ref TaskGroup::wait or
+ * @ref PipelineScope::wait — which takes
+ * GlobalMutexes::globalSetsMutex once per batch rather than once per file.
+ *
+ * A channel that is pushed to and collected on the same thread must be
+ * constructed with room for every message it will carry.
+ */
+class ResultChannel {
+public:
+    explicit ResultChannel(std::size_t capacity = MpscChannel<Result>::DEFAULT_CAPACITY) : channel_(capacity) {}
+
+    void completed(std::string message) { channel_.push({Kind::Completed, std::move(message)}); }
+    void failed(std::string message)    { channel_.push({Kind::Failed, std::move(message)}); }
+    void skipped(std::string message)   { channel_.push({Kind::Skipped, std::move(message)}); }
+
+    /// @brief Records a file the operation created, for the caller to register.
+    void outputPath(std::string path)   { channel_.push({Kind::OutputPath, std::move(path)}); }
+
+    /**
+     * @brief Consumer only: moves queued messages into @ref verboseSets and
+     *        output paths into @p outputPaths (dropped if null).
+     */
+    void collect(std::vector<std::string>* outputPaths = nullptr);
+
+private:
+    enum class Kind : uint8_t { Completed, Failed, Skipped, OutputPath };
+
+    struct Result {
+        Kind kind;
+        std::string text;
+    };
+
+    MpscChannel<Result> channel_;
+};
+
 // --- Output & Logging Functions ---
 
 /**
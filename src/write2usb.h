@@ -46,40 +46,6 @@ struct ScopedMount {
     }
 };
 
-/**
- * @struct AlignedBuffer
- * @brief RAII wrapper for a posix_memalign'd I/O buffer.
- *
- * Allocates a buffer of at least `size` bytes, aligned to `alignment` bytes.
- * If `size` is not a multiple of `alignment`, it is rounded up to the next
- * multiple before allocation to satisfy std::aligned_alloc requirements.
- * The allocation is freed automatically on destruction.
- *
- * Non-copyable and non-movable — owns a unique heap allocation. Copying would
- * cause a double-free; move semantics are omitted for simplicity.
- */
-struct AlignedBuffer {
-    void*  ptr  = nullptr;
-    char*  data = nullptr;
-    size_t size; // Original requested size (actual allocation may be larger)
-    AlignedBuffer(size_t size, size_t alignment) : size(size) {
-        size_t remainder    = size % alignment;
-        size_t adjustedSize = (remainder == 0) ? size : (size + alignment - remainder);
-        ptr = std::aligned_alloc(alignment, adjustedSize);
-        if (ptr) {
-            data = static_cast<char*>(ptr);
-        }
-    }
-    // Non-copyable, non-movable — owns a unique heap allocation.
-    AlignedBuffer(const AlignedBuffer&)            = delete;
-    AlignedBuffer& operator=(const AlignedBuffer&) = delete;
-    AlignedBuffer(AlignedBuffer&&)                 = delete;
-    AlignedBuffer& operator=(AlignedBuffer&&)      = delete;
-    ~AlignedBuffer() { std::free(ptr); }
-    bool ok() const { return data != nullptr; }
-    explicit operator bool() const { return ok(); }
-};
-
 /**
  * @struct ThreadGuard
  * @brief RAII wrapper that stops and joins a background thread on destruction.